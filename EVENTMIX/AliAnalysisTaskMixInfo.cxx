@@ -23,6 +23,7 @@
 #include "AliAnalysisTaskMixInfo.h"
 #include "AliMixInfo.h"
 #include "AliMixEventPool.h"
+#include "AliMixEventRingPool.h"
 #include "AliMixEventCutObj.h"
 
 
@@ -142,6 +143,8 @@ void AliAnalysisTaskMixInfo::FinishTaskOutput()
 {
    // FinishTaskOutput
    if (fMixInfo) fMixInfo->Print();
+   // prints fill and eviction statistics of in-memory pool
+   if (fInputEHMix && fInputEHMix->GetRingPool()) fInputEHMix->GetRingPool()->Print();
 }
 
 
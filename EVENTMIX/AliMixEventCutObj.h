@@ -41,6 +41,7 @@ public:
    Float_t     GetMin() const { return fCutMin; }
    Float_t     GetMax() const { return fCutMax; }
    Float_t     GetStep() const { return fCutStep; }
+   Float_t     GetSmallValue() const { return fCutSmallVal; }
    Short_t     GetType() const { return fCutType; }
    Int_t       GetBinNumber(Float_t num) const;
    Int_t       GetIndex(AliVEvent *ev);
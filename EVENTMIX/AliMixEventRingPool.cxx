@@ -0,0 +1,434 @@
+//
+// Class AliMixEventRingPool
+//
+// AliMixEventRingPool keeps compact projections of accepted events
+// in fixed-capacity ring buffers, one per event-mixing bin.
+//
+// Usage (together with AliMixInputEventHandler):
+//
+//    AliMixEventRingPool *ringPool = new AliMixEventRingPool();
+//    ringPool->AddCuts(evPool);            // same axes as the entry-list pool
+//    ringPool->SetDepth(20);
+//    ringPool->SetMemoryBudgetMB(500);
+//    ringPool->AddPIDProjection(AliPIDResponse::kTPC, AliPID::kKaon);
+//    mixHandler->SetRingPool(ringPool);
+//
+// In UserExecMix() the task reads the mixed event from
+// mixHandler->GetRingPool() with bin = mixHandler->CurrentBinIndex() - 1
+// and iEvent = mixHandler->CurrentRingEvent().
+//
+
+#include <algorithm>
+
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+#include "AliAODTrack.h"
+#include "AliMixEventCutObj.h"
+#include "AliMixEventPool.h"
+
+#include "AliMixEventRingPool.h"
+
+ClassImp(AliMixEventRingPool)
+
+//_________________________________________________________________________________________________
+AliMixEventRingPool::AliMixEventRingPool(const char *name, const char *title) : TNamed(name, title),
+   fListOfEventCuts(),
+   fPIDDetector(),
+   fPIDSpecies(),
+   fDepth(10),
+   fMemoryBudget(0),
+   fFilterBit(0),
+   fPtMin(0.0),
+   fPtMax(1e10),
+   fEtaMin(-1e10),
+   fEtaMax(1e10),
+   fNBins(0),
+   fBinStride(),
+   fAxisLow(),
+   fAxisHigh(),
+   fHead(),
+   fCount(),
+   fSlots(),
+   fOldest(),
+   fLastBin(-1),
+   fNAdded(0),
+   fNOutOfRange(0),
+   fNEvictedDepth(0),
+   fNEvictedBudget(0),
+   fMemoryUsed(0)
+{
+   //
+   // Default constructor.
+   //
+   fListOfEventCuts.SetOwner(kTRUE);
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRingPool::AliMixEventRingPool(const AliMixEventRingPool &obj) : TNamed(obj),
+   fListOfEventCuts(),
+   fPIDDetector(obj.fPIDDetector),
+   fPIDSpecies(obj.fPIDSpecies),
+   fDepth(obj.fDepth),
+   fMemoryBudget(obj.fMemoryBudget),
+   fFilterBit(obj.fFilterBit),
+   fPtMin(obj.fPtMin),
+   fPtMax(obj.fPtMax),
+   fEtaMin(obj.fEtaMin),
+   fEtaMax(obj.fEtaMax),
+   fNBins(0),
+   fBinStride(),
+   fAxisLow(),
+   fAxisHigh(),
+   fHead(),
+   fCount(),
+   fSlots(),
+   fOldest(),
+   fLastBin(-1),
+   fNAdded(0),
+   fNOutOfRange(0),
+   fNEvictedDepth(0),
+   fNEvictedBudget(0),
+   fMemoryUsed(0)
+{
+   //
+   // Copy constructor (copies the configuration only, stored events are not copied)
+   //
+   fListOfEventCuts.SetOwner(kTRUE);
+   for (Int_t i = 0; i < obj.fListOfEventCuts.GetEntriesFast(); i++)
+      fListOfEventCuts.Add(new AliMixEventCutObj(*(AliMixEventCutObj *) obj.fListOfEventCuts.At(i)));
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRingPool &AliMixEventRingPool::operator=(const AliMixEventRingPool &obj)
+{
+   //
+   // Assigned operator (copies the configuration only, stored events are not copied)
+   //
+   if (&obj != this) {
+      TNamed::operator=(obj);
+      fListOfEventCuts.Delete();
+      for (Int_t i = 0; i < obj.fListOfEventCuts.GetEntriesFast(); i++)
+         fListOfEventCuts.Add(new AliMixEventCutObj(*(AliMixEventCutObj *) obj.fListOfEventCuts.At(i)));
+      fPIDDetector = obj.fPIDDetector;
+      fPIDSpecies = obj.fPIDSpecies;
+      fDepth = obj.fDepth;
+      fMemoryBudget = obj.fMemoryBudget;
+      fFilterBit = obj.fFilterBit;
+      fPtMin = obj.fPtMin;
+      fPtMax = obj.fPtMax;
+      fEtaMin = obj.fEtaMin;
+      fEtaMax = obj.fEtaMax;
+      fNBins = 0;
+      fBinStride.clear();
+      fAxisLow.clear();
+      fAxisHigh.clear();
+      fHead.clear();
+      fCount.clear();
+      fSlots.clear();
+      fOldest.clear();
+      fLastBin = -1;
+      fNAdded = 0;
+      fNOutOfRange = 0;
+      fNEvictedDepth = 0;
+      fNEvictedBudget = 0;
+      fMemoryUsed = 0;
+   }
+   return *this;
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRingPool::~AliMixEventRingPool()
+{
+   //
+   // Destructor
+   //
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::AddCut(AliMixEventCutObj *cut)
+{
+   //
+   // Adds cut (axis of the bins)
+   //
+   if (cut && cut->IsValid()) fListOfEventCuts.Add(new AliMixEventCutObj(*cut));
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::AddCuts(AliMixEventPool *pool)
+{
+   //
+   // Adds all cuts of an entry-list pool, so that both pools share the bin numbering
+   //
+   if (!pool) return;
+   TObjArrayIter next(pool->GetListOfEventCuts());
+   AliMixEventCutObj *cut;
+   while ((cut = (AliMixEventCutObj *) next())) AddCut(cut);
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::AddPIDProjection(AliPIDResponse::EDetector det, AliPID::EParticleType type)
+{
+   //
+   // Stores n-sigma of detector det for particle type for every track
+   //
+   Int_t n = fPIDDetector.GetSize();
+   fPIDDetector.Set(n + 1);
+   fPIDSpecies.Set(n + 1);
+   fPIDDetector[n] = (Int_t) det;
+   fPIDSpecies[n] = (Int_t) type;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventRingPool::Init()
+{
+   //
+   // Computes the bin strides and allocates the ring buffers
+   //
+   if (fDepth < 1) {
+      AliWarning(Form("Depth %d is not valid, using 1", fDepth));
+      fDepth = 1;
+   }
+   Int_t numCuts = fListOfEventCuts.GetEntriesFast();
+   fBinStride.assign(numCuts, 1);
+   fAxisLow.assign(numCuts, std::vector<Float_t>());
+   fAxisHigh.assign(numCuts, std::vector<Float_t>());
+   fNBins = 1;
+   for (Int_t i = 0; i < numCuts; i++) {
+      AliMixEventCutObj *cut = (AliMixEventCutObj *) fListOfEventCuts.At(i);
+      fBinStride[i] = fNBins;
+      fNBins *= cut->GetNumberOfBins();
+      // edges are accumulated in Float_t exactly as in AliMixEventCutObj::GetBinNumber,
+      // so that events on the bin edges end up in the same bin as with AliMixEventPool
+      Float_t step = cut->GetStep();
+      Float_t smallVal = cut->GetSmallValue();
+      for (Float_t iCurrent = cut->GetMin(); iCurrent < cut->GetMax(); iCurrent += step) {
+         fAxisLow[i].push_back(iCurrent);
+         fAxisHigh[i].push_back(iCurrent + step - smallVal);
+      }
+   }
+   if (fBinStride.empty()) fBinStride.push_back(1);
+   fHead.assign(fNBins, 0);
+   fCount.assign(fNBins, 0);
+   fSlots.clear();
+   fSlots.resize((size_t) fNBins * fDepth);
+   fOldest.clear();
+   fLastBin = -1;
+   fMemoryUsed = 0;
+   AliInfo(Form("%d bins x %d events, memory budget %lld bytes", fNBins, fDepth, fMemoryBudget));
+   return 0;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::Clear(Option_t *)
+{
+   //
+   // Removes all stored events and releases their memory
+   //
+   for (size_t i = 0; i < fSlots.size(); i++) {
+      std::vector<AliMixTrack>().swap(fSlots[i].fTracks);
+      std::vector<Float_t>().swap(fSlots[i].fPID);
+   }
+   fHead.assign(fHead.size(), 0);
+   fCount.assign(fCount.size(), 0);
+   fOldest.clear();
+   fLastBin = -1;
+   fMemoryUsed = 0;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventRingPool::FindBin(AliVEvent *ev) const
+{
+   //
+   // Returns bin index (starting with 0, first cut runs fastest, as in
+   // AliMixEventPool::SetCutValuesFromBinIndex) or -1 when out of range.
+   //
+   if (!ev) return -1;
+   Int_t bin = 0;
+   Int_t numCuts = fListOfEventCuts.GetEntriesFast();
+   for (Int_t i = 0; i < numCuts; i++) {
+      AliMixEventCutObj *cut = (AliMixEventCutObj *) fListOfEventCuts.At(i);
+      Int_t idx = FindAxisBin(i, cut->GetValue(ev));
+      if (idx < 0) return -1;
+      bin += idx * fBinStride[i];
+   }
+   return bin;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventRingPool::FindAxisBin(Int_t iCut, Float_t val) const
+{
+   //
+   // Returns bin (starting with 0) of val on axis iCut, i.e. AliMixEventCutObj::GetBinNumber(val)-1,
+   // or -1 when out of range. The bins do not overlap, so the first bin containing val
+   // is found by a binary search on the lower edges.
+   //
+   if (iCut < 0 || iCut >= (Int_t) fAxisLow.size()) return -1;
+   const std::vector<Float_t> &low = fAxisLow[iCut];
+   Int_t idx = (Int_t)(std::upper_bound(low.begin(), low.end(), val) - low.begin()) - 1;
+   if (idx < 0 || !(val < fAxisHigh[iCut][idx])) return -1;
+   // rounding in the accumulation of the edges can give one more bin than GetNumberOfBins()
+   if (idx >= ((AliMixEventCutObj *) fListOfEventCuts.At(iCut))->GetNumberOfBins()) return -1;
+   return idx;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventRingPool::AddEvent(AliVEvent *ev, AliPIDResponse *pidResponse, Long64_t id, Int_t bin)
+{
+   //
+   // Stores the projection of event ev in its bin (bin=-2 finds it).
+   // When the bin is full, the oldest event of the bin is overwritten.
+   // When the memory budget is exceeded, the oldest events of the pool are dropped.
+   // Returns the bin or -1 if the event was not stored.
+   //
+   if (!ev) return -1;
+   if (NeedInit()) Init();
+   if (bin == -2) bin = FindBin(ev);
+   if (bin < 0 || bin >= fNBins) {
+      fNOutOfRange++;
+      return -1;
+   }
+
+   AliMixEventSlot &slot = fSlots[(size_t) bin * fDepth + fHead[bin]];
+   if (fCount[bin]) fOldest.erase(std::make_pair(Slot(bin, fCount[bin] - 1).fId, bin));
+   if (fCount[bin] == fDepth) {
+      fNEvictedDepth++;
+   } else {
+      fCount[bin]++;
+   }
+   fMemoryUsed -= SlotBytes(slot);
+   fHead[bin] = (fHead[bin] + 1) % fDepth;
+
+   // fills projection (capacity of the slot is reused)
+   Int_t nPID = fPIDDetector.GetSize();
+   slot.fId = id;
+   slot.fTracks.clear();
+   slot.fPID.clear();
+   Int_t nTracks = ev->GetNumberOfTracks();
+   for (Int_t i = 0; i < nTracks; i++) {
+      AliVTrack *track = dynamic_cast<AliVTrack *>(ev->GetTrack(i));
+      if (!track) continue;
+      AliAODTrack *aodTrack = dynamic_cast<AliAODTrack *>(track);
+      if (fFilterBit && aodTrack && !aodTrack->TestFilterBit(fFilterBit)) continue;
+      Double_t pt = track->Pt();
+      Double_t eta = track->Eta();
+      if (pt < fPtMin || pt > fPtMax || eta < fEtaMin || eta > fEtaMax) continue;
+      AliMixTrack t;
+      t.fPt = pt;
+      t.fEta = eta;
+      t.fPhi = track->Phi();
+      t.fID = track->GetID();
+      t.fFlags = aodTrack ? aodTrack->GetFilterMap() : (UInt_t) track->GetStatus();
+      t.fCharge = track->Charge();
+      slot.fTracks.push_back(t);
+      for (Int_t j = 0; j < nPID; j++) {
+         Float_t nSigma = -999.;
+         if (pidResponse) nSigma = pidResponse->NumberOfSigmas((AliPIDResponse::EDetector) fPIDDetector[j], track, (AliPID::EParticleType) fPIDSpecies[j]);
+         slot.fPID.push_back(nSigma);
+      }
+   }
+   fMemoryUsed += SlotBytes(slot);
+   fOldest.insert(std::make_pair(Slot(bin, fCount[bin] - 1).fId, bin));
+   fLastBin = bin;
+   fNAdded++;
+
+   // respect memory budget, the event just stored is kept in any case
+   if (fMemoryBudget > 0) {
+      while (fMemoryUsed > fMemoryBudget) {
+         if (!EvictOldest()) break;
+      }
+   }
+   return bin;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventRingPool::EvictOldest()
+{
+   //
+   // Drops the oldest stored event of the whole pool (the most recent one is never dropped)
+   //
+   if (fOldest.empty()) return kFALSE;
+   Int_t oldestBin = fOldest.begin()->second;
+   if (oldestBin == fLastBin && fCount[oldestBin] == 1) return kFALSE;
+   fOldest.erase(fOldest.begin());
+
+   Int_t idx = (fHead[oldestBin] - fCount[oldestBin] + fDepth) % fDepth;
+   AliMixEventSlot &slot = fSlots[(size_t) oldestBin * fDepth + idx];
+   fMemoryUsed -= SlotBytes(slot);
+   std::vector<AliMixTrack>().swap(slot.fTracks);
+   std::vector<Float_t>().swap(slot.fPID);
+   fCount[oldestBin]--;
+   if (fCount[oldestBin]) fOldest.insert(std::make_pair(Slot(oldestBin, fCount[oldestBin] - 1).fId, oldestBin));
+   fNEvictedBudget++;
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventRingPool::GetNumberOfEvents(Int_t bin) const
+{
+   //
+   // Returns number of stored events in bin
+   //
+   if (bin < 0 || bin >= (Int_t) fCount.size()) return 0;
+   return fCount[bin];
+}
+
+//_________________________________________________________________________________________________
+const AliMixEventRingPool::AliMixEventSlot &AliMixEventRingPool::Slot(Int_t bin, Int_t iEvent) const
+{
+   //
+   // Returns stored event iEvent (0 is the most recent one) of bin
+   //
+   Int_t idx = (fHead[bin] - 1 - iEvent + 2 * fDepth) % fDepth;
+   return fSlots[(size_t) bin * fDepth + idx];
+}
+
+//_________________________________________________________________________________________________
+const AliMixEventRingPool::AliMixTrack *AliMixEventRingPool::GetTracks(Int_t bin, Int_t iEvent) const
+{
+   //
+   // Returns array of GetNumberOfTracks(bin, iEvent) track projections
+   //
+   const AliMixEventSlot &slot = Slot(bin, iEvent);
+   return slot.fTracks.empty() ? 0 : &slot.fTracks[0];
+}
+
+//_________________________________________________________________________________________________
+Float_t AliMixEventRingPool::GetPID(Int_t bin, Int_t iEvent, Int_t iTrack, Int_t iPID) const
+{
+   //
+   // Returns PID projection iPID (in order of AddPIDProjection) of track iTrack
+   //
+   return Slot(bin, iEvent).fPID[(size_t) iTrack * fPIDDetector.GetSize() + iPID];
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventRingPool::SlotBytes(const AliMixEventSlot &slot) const
+{
+   //
+   // Memory held by slot (the capacity is kept when the slot is reused)
+   //
+   return (Long64_t)(slot.fTracks.capacity() * sizeof(AliMixTrack) + slot.fPID.capacity() * sizeof(Float_t));
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::Print(const Option_t *option) const
+{
+   //
+   // Prints configuration and pool statistics
+   //
+   TObjArrayIter next(&fListOfEventCuts);
+   AliMixEventCutObj *cut;
+   while ((cut = (AliMixEventCutObj *) next())) cut->Print(option);
+
+   Long64_t nStored = 0;
+   Int_t nFull = 0, nEmpty = 0;
+   for (Int_t bin = 0; bin < (Int_t) fCount.size(); bin++) {
+      nStored += fCount[bin];
+      if (fCount[bin] == fDepth) nFull++;
+      if (!fCount[bin]) nEmpty++;
+   }
+   AliInfo(Form("bins=%d depth=%d PID projections=%d", fNBins, fDepth, fPIDDetector.GetSize()));
+   AliInfo(Form("stored=%lld (full bins=%d empty bins=%d) memory=%lld/%lld bytes", nStored, nFull, nEmpty, fMemoryUsed, fMemoryBudget));
+   AliInfo(Form("added=%lld outOfRange=%lld evictedDepth=%lld evictedBudget=%lld", fNAdded, fNOutOfRange, fNEvictedDepth, fNEvictedBudget));
+}
@@ -0,0 +1,130 @@
+//
+// Class AliMixEventRingPool
+//
+// AliMixEventRingPool keeps compact projections of accepted events
+// (track kinematics, a few flags and optional PID n-sigmas) in
+// fixed-capacity ring buffers, one per event-mixing bin. Mixed events
+// are then read from memory instead of being re-read from the input
+// chain. The bins are defined by the same AliMixEventCutObj axes as
+// AliMixEventPool, with the same edges as AliMixEventCutObj::GetBinNumber,
+// and are found by a binary search on the precomputed edges.
+//
+
+#ifndef ALIMIXEVENTRINGPOOL_H
+#define ALIMIXEVENTRINGPOOL_H
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <TNamed.h>
+#include <TObjArray.h>
+#include <TArrayI.h>
+
+#include "AliPID.h"
+#include "AliPIDResponse.h"
+
+class AliVEvent;
+class AliMixEventCutObj;
+class AliMixEventPool;
+class AliMixEventRingPool : public TNamed {
+public:
+
+   // projection of one track of a stored event
+   struct AliMixTrack {
+      Float_t  fPt;      // transverse momentum
+      Float_t  fEta;     // pseudorapidity
+      Float_t  fPhi;     // azimuthal angle
+      Int_t    fID;      // track ID in the original event
+      UInt_t   fFlags;   // AOD filter map or lower bits of the ESD status
+      Short_t  fCharge;  // charge
+   };
+
+   AliMixEventRingPool(const char *name = "mixEventRingPool", const char *title = "Mix event ring pool");
+   AliMixEventRingPool(const AliMixEventRingPool &obj);
+   AliMixEventRingPool &operator=(const AliMixEventRingPool &obj);
+   virtual ~AliMixEventRingPool();
+
+   virtual void      Print(const Option_t *option = "") const;
+
+   // configuration
+   void              AddCut(AliMixEventCutObj *cut);
+   void              AddCuts(AliMixEventPool *pool);
+   void              AddPIDProjection(AliPIDResponse::EDetector det, AliPID::EParticleType type);
+   void              SetDepth(Int_t depth) { fDepth = depth; }
+   void              SetMemoryBudget(Long64_t bytes) { fMemoryBudget = bytes; }
+   void              SetMemoryBudgetMB(Double_t mb) { fMemoryBudget = (Long64_t)(mb * 1024 * 1024); }
+   void              SetFilterBit(UInt_t bit) { fFilterBit = bit; }
+   void              SetPtRange(Float_t min, Float_t max) { fPtMin = min; fPtMax = max; }
+   void              SetEtaRange(Float_t min, Float_t max) { fEtaMin = min; fEtaMax = max; }
+
+   Int_t             Init();
+   Bool_t            NeedInit() const { return (fBinStride.size() == 0); }
+
+   // filling and lookup
+   Int_t             FindBin(AliVEvent *ev) const;
+   Int_t             FindAxisBin(Int_t iCut, Float_t val) const;
+   Int_t             AddEvent(AliVEvent *ev, AliPIDResponse *pidResponse, Long64_t id, Int_t bin = -2);
+   virtual void      Clear(Option_t *option = "");
+
+   // access to stored events (iEvent = 0 is the most recent one)
+   Int_t             GetNumberOfBins() const { return fNBins; }
+   Int_t             GetNumberOfEvents(Int_t bin) const;
+   Long64_t          GetEventId(Int_t bin, Int_t iEvent) const { return Slot(bin, iEvent).fId; }
+   Int_t             GetNumberOfTracks(Int_t bin, Int_t iEvent) const { return (Int_t)Slot(bin, iEvent).fTracks.size(); }
+   const AliMixTrack *GetTracks(Int_t bin, Int_t iEvent) const;
+   Float_t           GetPID(Int_t bin, Int_t iEvent, Int_t iTrack, Int_t iPID) const;
+   Int_t             GetNumberOfPIDProjections() const { return fPIDDetector.GetSize(); }
+
+   // statistics
+   Long64_t          GetNumberOfAdded() const { return fNAdded; }
+   Long64_t          GetNumberOfOutOfRange() const { return fNOutOfRange; }
+   Long64_t          GetNumberOfEvictedDepth() const { return fNEvictedDepth; }
+   Long64_t          GetNumberOfEvictedBudget() const { return fNEvictedBudget; }
+   Long64_t          GetMemoryUsed() const { return fMemoryUsed; }
+   Int_t             GetDepth() const { return fDepth; }
+   Long64_t          GetMemoryBudget() const { return fMemoryBudget; }
+
+private:
+
+   struct AliMixEventSlot {
+      Long64_t                 fId;      // id of the stored event (entry counter)
+      std::vector<AliMixTrack> fTracks;  // track projections
+      std::vector<Float_t>     fPID;     // PID projections (nTracks x nPID)
+   };
+
+   const AliMixEventSlot &Slot(Int_t bin, Int_t iEvent) const;
+   Long64_t          SlotBytes(const AliMixEventSlot &slot) const;
+   Bool_t            EvictOldest();
+
+   TObjArray         fListOfEventCuts;   // list of event cuts (bin axes)
+   TArrayI           fPIDDetector;       // detectors of the PID projections
+   TArrayI           fPIDSpecies;        // species of the PID projections
+   Int_t             fDepth;             // number of events kept per bin
+   Long64_t          fMemoryBudget;      // maximum size of the stored projections in bytes (<=0 no limit)
+   UInt_t            fFilterBit;         // AOD filter bit of stored tracks (0 all)
+   Float_t           fPtMin;             // minimum pt of stored tracks
+   Float_t           fPtMax;             // maximum pt of stored tracks
+   Float_t           fEtaMin;            // minimum eta of stored tracks
+   Float_t           fEtaMax;            // maximum eta of stored tracks
+
+   Int_t                        fNBins;       //! total number of bins
+   std::vector<Int_t>           fBinStride;   //! stride of each axis in the bin index
+   std::vector<std::vector<Float_t> > fAxisLow;  //! lower edge of the bins of each axis
+   std::vector<std::vector<Float_t> > fAxisHigh; //! upper edge (excluded) of the bins of each axis
+   std::vector<Int_t>           fHead;        //! next slot to be written in each bin
+   std::vector<Int_t>           fCount;       //! number of stored events in each bin
+   std::vector<AliMixEventSlot> fSlots;       //! ring buffers (nBins x fDepth)
+   std::set<std::pair<Long64_t, Int_t> > fOldest; //! id of the oldest stored event of each non-empty bin
+   Int_t                        fLastBin;     //! bin of the event stored last
+
+   Long64_t          fNAdded;            //! number of stored events
+   Long64_t          fNOutOfRange;       //! number of events outside of the bins
+   Long64_t          fNEvictedDepth;     //! number of events overwritten because the bin was full
+   Long64_t          fNEvictedBudget;    //! number of events dropped to respect the memory budget
+   Long64_t          fMemoryUsed;        //! current size of the stored projections in bytes
+
+   ClassDef(AliMixEventRingPool, 1)
+};
+
+#endif
@@ -11,12 +11,14 @@
 #include <TChain.h>
 #include <TChainElement.h>
 #include <TSystem.h>
+#include <TMath.h>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventRingPool.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
 
@@ -31,6 +33,7 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fMixIntupHandlerInfoTmp(0),
    fEntryCounter(0),
    fEventPool(0),
+   fRingPool(0),
    fNumberMixed(0),
    fMixNumber(mixNum),
    fUseDefautProcess(kFALSE),
@@ -43,7 +46,8 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fCurrentRingEvent(-1)
 {
    //
    // Default constructor.
@@ -160,6 +164,8 @@ Bool_t AliMixInputEventHandler::Notify(const char *path)
    AliDebug(AliLog::kDebug + 5, Form("fEntryCounter=%lld", fEntryCounter));
    if (fEventPool && fEventPool->NeedInit())
       fEventPool->Init();
+   if (fRingPool && fRingPool->NeedInit())
+      fRingPool->Init();
    if (fUseDefautProcess) {
       AliDebug(AliLog::kDebug, Form("-> SKIPPED"));
       return AliMultiInputEventHandler::Notify(path);
@@ -192,7 +198,10 @@ Bool_t AliMixInputEventHandler::GetEntry()
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
 
-   if (!fEventPool) {
+   if (fRingPool) {
+      MixRingPool();
+   }
+   else if (!fEventPool) {
       MixStd();
    }
    // if buffer size is higher then 1
@@ -495,6 +504,69 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithBuffer()
    return kFALSE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::MixRingPool()
+{
+   //
+   // Mix with events stored in memory (AliMixEventRingPool).
+   // No input handler is prepared, tasks read the mixed event from
+   // GetRingPool() using bin CurrentBinIndex()-1 and event CurrentRingEvent().
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   AliDebug(AliLog::kDebug + 1, "Mix method");
+   // get correct handler
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   AliMultiInputEventHandler *mh = dynamic_cast<AliMultiInputEventHandler *>(mgr->GetInputEventHandler());
+   AliInputEventHandler *inEvHMain = 0;
+   if (mh) inEvHMain = dynamic_cast<AliInputEventHandler *>(mh->GetFirstInputEventHandler());
+   else inEvHMain = dynamic_cast<AliInputEventHandler *>(mgr->GetInputEventHandler());
+   if (!inEvHMain) return kFALSE;
+
+   // check for PhysSelection
+   if (!IsEventCurrentSelected()) return kFALSE;
+
+   if (fRingPool->NeedInit()) fRingPool->Init();
+
+   fCurrentMixEntry.Reset();
+   fNumberMixed = 0;
+   fCurrentRingEvent = -1;
+   AliVEvent *ev = inEvHMain->GetEvent();
+   Int_t bin = fRingPool->FindBin(ev);
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld (ring bin %d) +++++++++++++++++++", fEntryCounter, bin));
+   if (bin < 0) {
+      UserExecMixAllTasks(fEntryCounter, -1, fEntryCounter, -1, 0);
+      fRingPool->AddEvent(ev, inEvHMain->GetPIDResponse(), fEntryCounter, bin);
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (out of bins) +++++++++++++++++++", fEntryCounter));
+      return kTRUE;
+   }
+
+   Int_t idEntryList = bin + 1;
+   Int_t nStored = fRingPool->GetNumberOfEvents(bin);
+   if (!nStored || (!fDoMixIfNotEnoughEvents && nStored < fMixNumber)) {
+      if (!nStored && !fDoMixIfNotEnoughEvents) idEntryList = -1;
+      UserExecMixAllTasks(fEntryCounter, idEntryList, fEntryCounter, -1, 0);
+      fRingPool->AddEvent(ev, inEvHMain->GetPIDResponse(), fEntryCounter, bin);
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (%d) NOT ENOUGH EVENTS TO MIX +++++++++++++++++++", fEntryCounter, nStored));
+      return kTRUE;
+   }
+
+   Int_t mixNum = TMath::Min(fMixNumber, nStored);
+   for (Int_t counter = 0; counter < mixNum; counter++) {
+      fCurrentRingEvent = counter;
+      fNumberMixed++;
+      UserExecMixAllTasks(fEntryCounter, idEntryList, fEntryCounter, fRingPool->GetEventId(bin, counter), fNumberMixed);
+   }
+   fCurrentRingEvent = -1;
+
+   // current event is stored after mixing, so it is never mixed with itself
+   fRingPool->AddEvent(ev, inEvHMain->GetPIDResponse(), fEntryCounter, bin);
+
+   AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   AliDebug(AliLog::kDebug + 5, "->");
+   return kTRUE;
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::FinishEvent()
 {
@@ -21,6 +21,7 @@
 class TChain;
 class TChainElement;
 class AliMixEventPool;
+class AliMixEventRingPool;
 class AliMixInputHandlerInfo;
 class AliInputEventHandler;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
@@ -42,8 +43,10 @@ public:
 
    void                    SetInputHandlerForMixing(const AliInputEventHandler *const inHandler);
    void                    SetEventPool(AliMixEventPool *const evPool) { fEventPool = evPool; }
+   void                    SetRingPool(AliMixEventRingPool *const ringPool) { fRingPool = ringPool; }
 
    AliMixEventPool        *GetEventPool() const { return fEventPool; }
+   AliMixEventRingPool    *GetRingPool() const { return fRingPool; }
    Int_t                   BufferSize() const { return fBufferSize; }
    Int_t                   NumberMixedTimes() const { return fNumberMixed; }
    Int_t                   MixNumber() const { return fMixNumber; }
@@ -64,6 +67,7 @@ public:
    Long64_t                CurrentEntryMain() const { return fCurrentEntryMain; }
    Long64_t                CurrentEntryMix() const { return fCurrentEntryMix; }
    Int_t                   NumberMixed() const { return fNumberMixed; }
+   Int_t                   CurrentRingEvent() const { return fCurrentRingEvent; }
 
    void                    SelectCollisionCandidates(UInt_t offlineTriggerMask = AliVEvent::kMB) {fOfflineTriggerMask = offlineTriggerMask;}
    Bool_t                  IsEventCurrentSelected();
@@ -80,6 +84,7 @@ protected:
    AliMixInputHandlerInfo *fMixIntupHandlerInfoTmp;//! mix input handler info full chain
    Long64_t                fEntryCounter;          // entry counter
    AliMixEventPool        *fEventPool;             // event pool
+   AliMixEventRingPool    *fRingPool;              // in-memory event pool (mixed events are not re-read from input)
    Int_t                   fNumberMixed;           // number of mixed events with current event
    Int_t                   fMixNumber;             // user's mix number request
 
@@ -99,18 +104,20 @@ private:
 
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
+   Int_t    fCurrentRingEvent;     //! index of current mixed event in ring pool bin (0 is the most recent)
 
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
+   virtual Bool_t          MixRingPool();
 
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
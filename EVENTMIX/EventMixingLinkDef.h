@@ -2,6 +2,7 @@
 
 #pragma link C++ class AliMixEventCutObj+;
 #pragma link C++ class AliMixEventPool+;
+#pragma link C++ class AliMixEventRingPool+;
 
 #pragma link C++ class AliMixInfo+;
 #pragma link C++ class AliMixInputHandlerInfo+;
@@ -14,6 +14,7 @@
 
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -35,10 +36,49 @@ AliExternalBDT::AliExternalBDT(std::string name) :
   fModelPath{""},
   fModelName{""},
   fCompiler{},
-  fPredictor{}
+  fPredictor{},
+  fEntries{},
+  fBatchData{},
+  fBatchScores{},
+  fBatch{nullptr},
+  fBatchRows{0u},
+  fBatchCols{0u}
 {
 }
 
+AliExternalBDT::~AliExternalBDT() {
+  ResetBatch();
+}
+
+AliExternalBDT::AliExternalBDT(const AliExternalBDT &source) :
+  fBDTname{source.fBDTname},
+  fModel{source.fModel},
+  fModelPath{source.fModelPath},
+  fModelName{source.fModelName},
+  fCompiler{source.fCompiler},
+  fPredictor{source.fPredictor},
+  fEntries{},
+  fBatchData{},
+  fBatchScores{},
+  fBatch{nullptr},
+  fBatchRows{0u},
+  fBatchCols{0u}
+{
+  /// the batch buffers are private to each instance and rebuilt on demand
+}
+
+AliExternalBDT &AliExternalBDT::operator=(const AliExternalBDT &source) {
+  if (&source == this) return *this;
+  ResetBatch();
+  fBDTname   = source.fBDTname;
+  fModel     = source.fModel;
+  fModelPath = source.fModelPath;
+  fModelName = source.fModelName;
+  fCompiler  = source.fCompiler;
+  fPredictor = source.fPredictor;
+  return *this;
+}
+
 
 bool AliExternalBDT::CompileAndLoadModelLibrary() {
   std::string path = GetUniquePath();
@@ -127,17 +167,67 @@ bool AliExternalBDT::LoadModelLibrary(std::string path) {
   return true;
 }
 
+void AliExternalBDT::ResetBatch() {
+  if (fBatch) {
+    TreeliteDeleteDenseBatch(fBatch);
+  }
+  fBatch = nullptr;
+  fBatchRows = 0u;
+  fBatchCols = 0u;
+}
+
 double AliExternalBDT::Predict(double *features, int size, bool useRawScore) {
-  std::vector<TreelitePredictorEntry> entries(size);
-  for (size_t iEntry = 0; iEntry < entries.size(); ++iEntry) {
-    entries[iEntry].fvalue = static_cast<float>(features[iEntry]);
+  fEntries.resize(size);
+  for (size_t iEntry = 0; iEntry < fEntries.size(); ++iEntry) {
+    fEntries[iEntry].fvalue = static_cast<float>(features[iEntry]);
   }
   size_t out_size{0u};
   TreelitePredictorQueryResultSizeSingleInst(fPredictor, &out_size);
   assert(out_size == 1);
   float output = 0.f;
-  TreelitePredictorPredictInst(fPredictor, entries.data(),
+  TreelitePredictorPredictInst(fPredictor, fEntries.data(),
       static_cast<int>(useRawScore), &output,
       &out_size);
   return output;
 }
+
+bool AliExternalBDT::PredictBatch(const double *features, int nRows, int nCols, double *scores, bool useRawScore) {
+  if (nRows <= 0) return true;
+  const size_t rows = static_cast<size_t>(nRows);
+  const size_t cols = static_cast<size_t>(nCols);
+
+  /// the dense batch only points to fBatchData, so it is assembled again only
+  /// when the shape changes or the buffer had to grow
+  const float *oldData = fBatchData.data();
+  fBatchData.resize(rows * cols);
+  if (!fBatch || rows != fBatchRows || cols != fBatchCols || oldData != fBatchData.data()) {
+    ResetBatch();
+    const int status = TreeliteAssembleDenseBatch(fBatchData.data(), std::numeric_limits<float>::quiet_NaN(),
+        rows, cols, &fBatch);
+    if (status != 0) {
+      std::cerr << "Dense batch creation failed." << std::endl;
+      fBatch = nullptr;
+      return false;
+    }
+    fBatchRows = rows;
+    fBatchCols = cols;
+  }
+  for (size_t iEntry = 0; iEntry < rows * cols; ++iEntry) {
+    fBatchData[iEntry] = static_cast<float>(features[iEntry]);
+  }
+
+  size_t out_size{0u};
+  TreelitePredictorQueryResultSize(fPredictor, fBatch, 0, &out_size);
+  assert(out_size == rows);
+  fBatchScores.resize(out_size);
+  const int status = TreelitePredictorPredictBatch(fPredictor, fBatch, 0, 0, static_cast<int>(useRawScore),
+      fBatchScores.data(), &out_size);
+  if (status != 0) {
+    std::cerr << "Batch prediction failed." << std::endl;
+    return false;
+  }
+  for (size_t iRow = 0; iRow < rows; ++iRow) {
+    scores[iRow] = fBatchScores[iRow];
+  }
+  return true;
+}
@@ -23,19 +23,26 @@
 class AliExternalBDT {
 public:
   AliExternalBDT(std::string name = "");
-  virtual ~AliExternalBDT(){};
+  virtual ~AliExternalBDT();
+
+  AliExternalBDT(const AliExternalBDT &source);
+  AliExternalBDT &operator=(const AliExternalBDT &source);
 
   bool LoadLightGBMModel(std::string path);
   bool LoadModelLibrary(std::string path);
   bool LoadXGBoostModel(std::string path);
 
   double Predict(double *features, int size, bool useRaw = false);
+  /// Evaluate nRows candidates stored row-major in features (nRows x nCols),
+  /// writing one score per row in the caller-owned scores array
+  bool PredictBatch(const double *features, int nRows, int nCols, double *scores, bool useRaw = false);
 
 private:
   bool CompileAndLoadModelLibrary();
   bool CreateModelCode();
   std::string GetUniquePath();
   bool LoadModel(const std::string &path, int type);
+  void ResetBatch();
 
   std::string fBDTname;       /// Unique name of this external BDT handler
   ModelHandle fModel;
@@ -43,6 +50,13 @@ private:
   std::string fModelName;
   CompilerHandle fCompiler;
   PredictorHandle fPredictor;
+
+  std::vector<TreelitePredictorEntry> fEntries; /// single instance buffer, reused across calls
+  std::vector<float> fBatchData;                /// row-major feature buffer for batch prediction
+  std::vector<float> fBatchScores;              /// output buffer for batch prediction
+  DenseBatchHandle fBatch;                      /// dense batch wrapping fBatchData
+  size_t fBatchRows;                            /// rows covered by fBatch
+  size_t fBatchCols;                            /// columns covered by fBatch
 };
 
 #endif
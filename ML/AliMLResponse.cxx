@@ -12,6 +12,8 @@
 
 #include "AliMLResponse.h"
 
+#include <algorithm>
+
 #include "yaml-cpp/yaml.h"
 
 #include "AliExternalBDT.h"
@@ -29,7 +31,8 @@ ClassImp(AliMLResponse);
 //_______________________________________________________________________________
 AliMLResponse::AliMLResponse()
     : TNamed(), fConfigFilePath{}, fModels{}, fCentClasses{}, fBins{}, fVariableNames{}, fNBins{}, fNVariables{},
-      fBinsBegin{}, fRaw{} {
+      fBinsBegin{}, fFeatures{}, fBatchModel{}, fBatchOffsets{}, fBatchOrder{}, fBatchFeatures{}, fBatchScores{},
+      fRaw{} {
   //
   // Default constructor
   //
@@ -38,7 +41,8 @@ AliMLResponse::AliMLResponse()
 //_______________________________________________________________________________
 AliMLResponse::AliMLResponse(const Char_t *name, const Char_t *title)
     : TNamed(name, title), fConfigFilePath{""}, fModels{}, fCentClasses{}, fBins{}, fVariableNames{}, fNBins{},
-      fNVariables{}, fBinsBegin{}, fRaw{} {
+      fNVariables{}, fBinsBegin{}, fFeatures{}, fBatchModel{}, fBatchOffsets{}, fBatchOrder{}, fBatchFeatures{},
+      fBatchScores{}, fRaw{} {
   //
   // Standard constructor
   //
@@ -55,7 +59,8 @@ AliMLResponse::~AliMLResponse() {
 AliMLResponse::AliMLResponse(const AliMLResponse &source)
     : TNamed(source.GetName(), source.GetTitle()), fConfigFilePath{source.fConfigFilePath}, fModels{source.fModels},
       fCentClasses{source.fCentClasses}, fBins{source.fBins}, fVariableNames{source.fVariableNames},
-      fNBins{source.fNBins}, fNVariables{source.fNVariables}, fBinsBegin{source.fBinsBegin}, fRaw{source.fRaw} {
+      fNBins{source.fNBins}, fNVariables{source.fNVariables}, fBinsBegin{source.fBinsBegin}, fFeatures{},
+      fBatchModel{}, fBatchOffsets{}, fBatchOrder{}, fBatchFeatures{}, fBatchScores{}, fRaw{source.fRaw} {
   //
   // Copy constructor
   //
@@ -147,17 +152,18 @@ int AliMLResponse::FindBin(double binvar) {
 }
 
 //_______________________________________________________________________________
-double AliMLResponse::Predict(double binvar, map<string, double> varmap) {
+double AliMLResponse::Predict(double binvar, const map<string, double> &varmap) {
   if ((int)varmap.size() < fNVariables) {
     AliFatal("The variable map you provided to the predictor has a size smaller than the variable list size! Exit");
   }
 
-  vector<double> features;
+  fFeatures.clear();
   for (const auto &varname : fVariableNames) {
-    if (varmap.find(varname) == varmap.end()) {
+    auto var = varmap.find(varname);
+    if (var == varmap.end()) {
       AliFatal(Form("Variable |%s| not found in variable list provided in config! Exit", varname.data()));
     }
-    features.push_back(varmap[varname]);
+    fFeatures.push_back(var->second);
   }
 
   int bin = FindBin(binvar);
@@ -166,11 +172,11 @@ double AliMLResponse::Predict(double binvar, map<string, double> varmap) {
     return -999.;
   }
 
-  return fModels[bin - 1].GetModel()->Predict(&features[0], fNVariables, fRaw);
+  return fModels[bin - 1].GetModel()->Predict(&fFeatures[0], fNVariables, fRaw);
 }
 
 //_______________________________________________________________________________
-double AliMLResponse::Predict(double binvar, vector<double> variables) {
+double AliMLResponse::Predict(double binvar, const vector<double> &variables) {
   if ((int)variables.size() != fNVariables) {
     AliFatal(Form("Number of variables passed (%d) different from the one used in the model (%d)! Exit",
                   (int)variables.size(), fNVariables));
@@ -182,17 +188,88 @@ double AliMLResponse::Predict(double binvar, vector<double> variables) {
     return -999.;
   }
 
-  return fModels[bin - 1].GetModel()->Predict(&variables[0], fNVariables, fRaw);
+  return fModels[bin - 1].GetModel()->Predict(const_cast<double *>(&variables[0]), fNVariables, fRaw);
+}
+
+//_______________________________________________________________________________
+void AliMLResponse::PredictBatch(const double *binvars, const double *features, int nCand, double *scores) {
+  if (nCand <= 0) return;
+
+  /// counting sort of the candidates per model, so that each model sees a contiguous block
+  const int nModels = (int)fModels.size();
+  fBatchModel.resize(nCand);
+  fBatchOffsets.assign(nModels + 1, 0);
+  int nOutside{0};
+  for (int iCand = 0; iCand < nCand; ++iCand) {
+    int bin = FindBin(binvars[iCand]);
+    if (bin == 0 || bin == fNBins || bin > nModels) {
+      fBatchModel[iCand] = -1;
+      scores[iCand] = -999.;
+      ++nOutside;
+      continue;
+    }
+    fBatchModel[iCand] = bin - 1;
+    ++fBatchOffsets[bin];
+  }
+  if (nOutside) {
+    AliWarning(Form("Binned variable outside range for %d candidates, no model available!", nOutside));
+  }
+  for (int iModel = 0; iModel < nModels; ++iModel) {
+    fBatchOffsets[iModel + 1] += fBatchOffsets[iModel];
+  }
+
+  const int nGrouped = fBatchOffsets[nModels];
+  if (!nGrouped) return;
+  fBatchOrder.resize(nGrouped);
+  fBatchFeatures.resize((size_t)nGrouped * fNVariables);
+  fBatchScores.resize(nGrouped);
+  /// fBatchOffsets is used as running insertion pointer and restored afterwards
+  for (int iCand = 0; iCand < nCand; ++iCand) {
+    const int iModel = fBatchModel[iCand];
+    if (iModel < 0) continue;
+    const int iRow = fBatchOffsets[iModel]++;
+    fBatchOrder[iRow] = iCand;
+    std::copy(features + (size_t)iCand * fNVariables, features + (size_t)(iCand + 1) * fNVariables,
+              fBatchFeatures.begin() + (size_t)iRow * fNVariables);
+  }
+  for (int iModel = nModels; iModel > 0; --iModel) {
+    fBatchOffsets[iModel] = fBatchOffsets[iModel - 1];
+  }
+  fBatchOffsets[0] = 0;
+
+  for (int iModel = 0; iModel < nModels; ++iModel) {
+    const int first = fBatchOffsets[iModel];
+    const int nRows = fBatchOffsets[iModel + 1] - first;
+    if (!nRows) continue;
+    bool status = fModels[iModel].GetModel()->PredictBatch(&fBatchFeatures[(size_t)first * fNVariables], nRows,
+                                                           fNVariables, &fBatchScores[first], fRaw);
+    if (!status) {
+      AliFatal(Form("Batch prediction failed for model %d! Exit", iModel));
+    }
+  }
+  for (int iRow = 0; iRow < nGrouped; ++iRow) {
+    scores[fBatchOrder[iRow]] = fBatchScores[iRow];
+  }
+}
+
+//_______________________________________________________________________________
+void AliMLResponse::IsSelectedBatch(const double *binvars, const double *features, int nCand, double *scores,
+                                    bool *selected) {
+  PredictBatch(binvars, features, nCand, scores);
+  for (int iCand = 0; iCand < nCand; ++iCand) {
+    const int iModel = fBatchModel[iCand];
+    selected[iCand] = iModel >= 0 && scores[iCand] >= fModels[iModel].GetScoreCut();
+  }
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::IsSelected(double binvar, std::map<std::string, double> varmap) {
+bool AliMLResponse::IsSelected(double binvar, const std::map<std::string, double> &varmap) {
   double score{0.};
   return IsSelected(binvar, varmap, score);
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::IsSelected(double binvar, std::vector<double> variables) {
+bool AliMLResponse::IsSelected(double binvar, const std::vector<double> &variables) {
   double score{0.};
   return IsSelected(binvar, variables, score);
 }
\ No newline at end of file
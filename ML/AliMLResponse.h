@@ -49,17 +49,24 @@ public:
   /// return the bin index
   int FindBin(double binvar);
   /// return the ML model predicted score (raw or proba, depending on useraw)
-  double Predict(double binvar, std::map<std::string, double> varmap);
+  double Predict(double binvar, const std::map<std::string, double> &varmap);
   /// overload to pass directly a vector of variables
-  double Predict(double binvar, std::vector<double> variables);
+  double Predict(double binvar, const std::vector<double> &variables);
   /// return true if predicted score for map is above the threshold given in the config
-  bool IsSelected(double binvar, std::map<std::string, double> varmap);
+  bool IsSelected(double binvar, const std::map<std::string, double> &varmap);
   /// overload for getting the model score too
-  template <typename F> bool IsSelected(double binvar, std::map<std::string, double> varmap, F &score);
+  template <typename F> bool IsSelected(double binvar, const std::map<std::string, double> &varmap, F &score);
   /// overload to pass directly a vector of variables
-  bool IsSelected(double binvar, std::vector<double> variables);
+  bool IsSelected(double binvar, const std::vector<double> &variables);
   /// overload for getting the model score too
-  template <typename F> bool IsSelected(double binvar, std::vector<double> variables, F &score);
+  template <typename F> bool IsSelected(double binvar, const std::vector<double> &variables, F &score);
+
+  /// batch prediction for nCand candidates: features is a row-major (nCand x NUM_VAR) matrix in the
+  /// VAR_NAMES order, candidates are grouped per bin and each model is queried once per call.
+  /// Scores are written in the caller-owned scores array (-999 for candidates outside the binning)
+  void PredictBatch(const double *binvars, const double *features, int nCand, double *scores);
+  /// batch selection, fills both scores and selection flags (caller-owned, nCand long)
+  void IsSelectedBatch(const double *binvars, const double *features, int nCand, double *scores, bool *selected);
 
 protected:
   std::string fConfigFilePath;    /// path of the config file
@@ -74,6 +81,13 @@ protected:
 
   std::vector<float>::iterator fBinsBegin;    //!<!  evaluate just once is better
 
+  std::vector<double> fFeatures;              //!<! feature buffer reused by the map based Predict
+  std::vector<int> fBatchModel;               //!<! model index of each candidate in the batch (-1 if outside)
+  std::vector<int> fBatchOffsets;             //!<! first grouped row of each model in the batch
+  std::vector<int> fBatchOrder;               //!<! candidate index of each grouped row
+  std::vector<double> fBatchFeatures;         //!<! features grouped per model
+  std::vector<double> fBatchScores;           //!<! scores grouped per model
+
   bool fRaw;    /// set to true to use raw score instead of probability
 
   /// \cond CLASSIMP
@@ -81,13 +95,13 @@ protected:
   /// \endcond
 };
 
-template <typename F> bool AliMLResponse::IsSelected(double binvar, std::map<std::string, double> varmap, F &score) {
+template <typename F> bool AliMLResponse::IsSelected(double binvar, const std::map<std::string, double> &varmap, F &score) {
   int bin = FindBin(binvar);
   score   = Predict(binvar, varmap);
   return score >= fModels[bin - 1].GetScoreCut();
 }
 
-template <typename F> bool AliMLResponse::IsSelected(double binvar, std::vector<double> variables, F &score) {
+template <typename F> bool AliMLResponse::IsSelected(double binvar, const std::vector<double> &variables, F &score) {
   int bin = FindBin(binvar);
   score   = Predict(binvar, variables);
   return score >= fModels[bin - 1].GetScoreCut();
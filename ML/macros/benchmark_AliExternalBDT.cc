@@ -0,0 +1,111 @@
+#include <TFile.h>
+#include <TStopwatch.h>
+#include <TTree.h>
+#include <TTreeReader.h>
+#include <TTreeReaderValue.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AliExternalBDT.h"
+
+#define DELTA 1.0e-6
+
+/// Compare per-candidate and batched throughput of AliExternalBDT on the
+/// test sample used by test_AliEsternalBDT.cc. The batch size mimics the
+/// number of candidates per event passed at once to PredictBatch.
+int benchmark_AliExternalBDT(string path = "", int batchSize = 100, int nRepeat = 10) {
+
+  string tree_path, model_path;
+
+  if (path == "") {
+    tree_path  = "test_tree_pt8_12.root";
+    model_path = "test_xgboost_pt8_12.model";
+  } else {
+    tree_path  = path + "/" + "test_tree_pt8_12.root";
+    model_path = path + "/" + "test_xgboost_pt8_12.model";
+  }
+
+  const int nFeatures = 12;
+  std::vector<double> features;
+
+  TFile *fInput = new TFile(tree_path.data(), "READ");
+
+  TTreeReader fReader("tree_real_data", fInput);
+
+  TTreeReaderValue<float> fValueDeltaMass(fReader, "delta_mass_KK");
+  TTreeReaderValue<float> fValueDLen(fReader, "d_len");
+  TTreeReaderValue<float> fValueNormDLXY(fReader, "norm_dl_xy");
+  TTreeReaderValue<float> fValueSigVert(fReader, "sig_vert");
+  TTreeReaderValue<float> fValueCosPiKPhi(fReader, "cos_PiKPhi_3");
+  TTreeReaderValue<float> fValueNormIP(fReader, "norm_IP");
+  TTreeReaderValue<float> fValueSigCombK0(fReader, "sigComb_K_0");
+  TTreeReaderValue<float> fValueSigCombK1(fReader, "sigComb_K_1");
+  TTreeReaderValue<float> fValueSigCombK2(fReader, "sigComb_K_2");
+  TTreeReaderValue<float> fValueSigCombPi0(fReader, "sigComb_Pi_0");
+  TTreeReaderValue<float> fValueSigCombPi1(fReader, "sigComb_Pi_1");
+  TTreeReaderValue<float> fValueSigCombPi2(fReader, "sigComb_Pi_2");
+
+  while (fReader.Next()) {
+    double row[nFeatures] = {*fValueDeltaMass,  *fValueDLen,       *fValueNormDLXY,
+                             *fValueSigVert,    *fValueCosPiKPhi,  *fValueNormIP,
+                             *fValueSigCombK0,  *fValueSigCombK1,  *fValueSigCombK2,
+                             *fValueSigCombPi0, *fValueSigCombPi1, *fValueSigCombPi2};
+    features.insert(features.end(), row, row + nFeatures);
+  }
+  fInput->Close();
+
+  const int nCand = features.size() / nFeatures;
+  if (!nCand) {
+    std::cout << "TEST: Fail! Empty input sample" << std::endl;
+    return 1;
+  }
+
+  AliExternalBDT *fBDT = new AliExternalBDT();
+
+  if (!fBDT->LoadXGBoostModel(model_path.data())) {
+    return 1;
+  }
+
+  std::vector<double> scoresSingle(nCand), scoresBatch(nCand);
+  TStopwatch timer;
+
+  timer.Start();
+  for (int iRepeat = 0; iRepeat < nRepeat; ++iRepeat) {
+    for (int iCand = 0; iCand < nCand; ++iCand) {
+      scoresSingle[iCand] = fBDT->Predict(&features[iCand * nFeatures], nFeatures, true);
+    }
+  }
+  timer.Stop();
+  const double timeSingle = timer.RealTime();
+
+  timer.Start();
+  for (int iRepeat = 0; iRepeat < nRepeat; ++iRepeat) {
+    for (int iCand = 0; iCand < nCand; iCand += batchSize) {
+      const int nRows = std::min(batchSize, nCand - iCand);
+      fBDT->PredictBatch(&features[iCand * nFeatures], nRows, nFeatures, &scoresBatch[iCand], true);
+    }
+  }
+  timer.Stop();
+  const double timeBatch = timer.RealTime();
+
+  delete fBDT;
+
+  const double nEval = (double)nCand * nRepeat;
+  std::cout << Form("Per-candidate: %.3f s, %.0f candidates/s", timeSingle, nEval / timeSingle) << std::endl;
+  std::cout << Form("Batch (%d):    %.3f s, %.0f candidates/s", batchSize, timeBatch, nEval / timeBatch) << std::endl;
+  std::cout << Form("Speed-up: %.2f", timeSingle / timeBatch) << std::endl;
+
+  for (int iCand = 0; iCand < nCand; ++iCand) {
+    if (std::abs(scoresSingle[iCand] - scoresBatch[iCand]) > DELTA) {
+      std::cout << "TEST: Fail! Batch and per-candidate scores differ" << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << "TEST: Success!" << std::endl;
+  return 0;
+}
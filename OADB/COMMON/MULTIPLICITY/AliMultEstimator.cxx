@@ -19,20 +19,31 @@
 #include "TObjString.h"
 #include "TBrowser.h"
 #include "TFormula.h"
+#include "TH1.h"
+#include "TMath.h"
 #include "RVersion.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 ClassImp(AliMultEstimator);
 //________________________________________________________________
 AliMultEstimator::AliMultEstimator() :
   TNamed(), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
-fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
+fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0),
+fCode(), fConst(), fVariables(), fVariablesInput(0),
+fCalibNbins(0), fCalibXmin(0), fCalibXmax(0), fCalibEdges(), fCalibContent()
 {
   // Constructor
   
 }
 AliMultEstimator::AliMultEstimator(const char * name, const char * title, TString lInitDef):
 TNamed(name,title), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
-fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
+fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0),
+fCode(), fConst(), fVariables(), fVariablesInput(0),
+fCalibNbins(0), fCalibXmin(0), fCalibXmax(0), fCalibEdges(), fCalibContent()
 {
     //Named, titled, definition constructor
     fDefinition=lInitDef;
@@ -48,7 +59,16 @@ fPercentile(e.fPercentile),
 fFormula(0),
 fkUseAnchor(e.fkUseAnchor),
 fAnchorPoint(e.fAnchorPoint),
-fAnchorPercentile(e.fAnchorPercentile)
+fAnchorPercentile(e.fAnchorPercentile),
+fCode(e.fCode),
+fConst(e.fConst),
+fVariables(e.fVariables),
+fVariablesInput(e.fVariablesInput),
+fCalibNbins(e.fCalibNbins),
+fCalibXmin(e.fCalibXmin),
+fCalibXmax(e.fCalibXmax),
+fCalibEdges(e.fCalibEdges),
+fCalibContent(e.fCalibContent)
 {
   if (e.fFormula) fFormula = new TFormula(*e.fFormula);
 }
@@ -67,6 +87,17 @@ AliMultEstimator& AliMultEstimator::operator=(const AliMultEstimator& e)
     if (fFormula) delete fFormula;
     fFormula = 0;
     if (e.fFormula) fFormula = new TFormula(*e.fFormula);
+    fCode           = e.fCode;
+    fConst          = e.fConst;
+    fVariables      = e.fVariables;
+    fVariablesInput = e.fVariablesInput;
+    
+    //Calibration look-up table
+    fCalibNbins   = e.fCalibNbins;
+    fCalibXmin    = e.fCalibXmin;
+    fCalibXmax    = e.fCalibXmax;
+    fCalibEdges   = e.fCalibEdges;
+    fCalibContent = e.fCalibContent;
     
     //Anchor point configs
     fkUseAnchor         = e.fkUseAnchor;
@@ -121,20 +152,254 @@ void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
         lVarName.Prepend("(");
         expr.ReplaceAll(lVarName, repl);
     }
+    ResolveVariables(lInput);
+    
+    //Compile the definition once: a small postfix program over the
+    //variable values, evaluated in double precision in the same order
+    //as the TFormula would do it. Anything the compiler does not know
+    //(functions, comparisons, integer divisions, ...) is left to TFormula.
+    fCode.clear();
+    fConst.clear();
+    const char* lPos = expr.Data();
+    Bool_t lIsInt = kFALSE;
+    Int_t lDepth = 0, lMaxDepth = 0;
+    Bool_t lOk = CompileSum(lPos, lIsInt, lDepth, lMaxDepth);
+    while (lOk && isspace(*lPos)) lPos++;
+    for (Int_t i = 0; lOk && i < (Int_t)fCode.size(); i += 2)
+        if (fCode[i] == kOpVar && fCode[i+1] >= nVar) lOk = kFALSE;
+    if (!lOk || *lPos != '\0' || lDepth != 1 || lMaxDepth > kMaxStack) {
+        fCode.clear();
+        fConst.clear();
+    }
+    
+    if (fFormula) delete fFormula;
+    fFormula = 0;
+    if (IsCompiled()) return;
+    
     fFormula = new TFormula(Form("e%s", GetName()), expr);
 #if ROOT_VERSION_CODE < ROOT_VERSION(5,99,4)
     fFormula->Optimize();
 #endif
 }
 //________________________________________________________________
+void AliMultEstimator::ResolveVariables(const AliMultInput* lInput)
+{
+    //TList::At is a linear walk: keep direct pointers per index
+    fVariablesInput = lInput;
+    fVariables.resize(lInput->GetNVariables());
+    for (Int_t i = 0; i < (Int_t)fVariables.size(); i++)
+        fVariables[i] = lInput->GetVariable(i);
+}
+//________________________________________________________________
+void AliMultEstimator::Emit(Int_t lOp, Int_t lArg, Int_t& lDepth, Int_t& lMaxDepth, Int_t lPush)
+{
+    fCode.push_back(lOp);
+    fCode.push_back(lArg);
+    lDepth += lPush;
+    if (lDepth > lMaxDepth) lMaxDepth = lDepth;
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::CompileSum(const char*& lPos, Bool_t& lIsInt, Int_t& lDepth, Int_t& lMaxDepth)
+{
+    // sum := product { ('+'|'-') product }
+    if (!CompileProduct(lPos, lIsInt, lDepth, lMaxDepth)) return kFALSE;
+    while (kTRUE) {
+        while (isspace(*lPos)) lPos++;
+        const char lOp = *lPos;
+        if (lOp != '+' && lOp != '-') return kTRUE;
+        lPos++;
+        Bool_t lIsIntRight = kFALSE;
+        if (!CompileProduct(lPos, lIsIntRight, lDepth, lMaxDepth)) return kFALSE;
+        Emit(lOp == '+' ? kOpAdd : kOpSub, 0, lDepth, lMaxDepth, -1);
+        lIsInt = lIsInt && lIsIntRight;
+    }
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::CompileProduct(const char*& lPos, Bool_t& lIsInt, Int_t& lDepth, Int_t& lMaxDepth)
+{
+    // product := unary { ('*'|'/') unary }
+    if (!CompileUnary(lPos, lIsInt, lDepth, lMaxDepth)) return kFALSE;
+    while (kTRUE) {
+        while (isspace(*lPos)) lPos++;
+        const char lOp = *lPos;
+        if (lOp != '*' && lOp != '/') return kTRUE;
+        lPos++;
+        Bool_t lIsIntRight = kFALSE;
+        if (!CompileUnary(lPos, lIsIntRight, lDepth, lMaxDepth)) return kFALSE;
+        //Integer division of literals: leave it to TFormula
+        if (lOp == '/' && lIsInt && lIsIntRight) return kFALSE;
+        Emit(lOp == '*' ? kOpMul : kOpDiv, 0, lDepth, lMaxDepth, -1);
+        lIsInt = lIsInt && lIsIntRight;
+    }
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::CompileUnary(const char*& lPos, Bool_t& lIsInt, Int_t& lDepth, Int_t& lMaxDepth)
+{
+    // unary := ('-'|'+'|'!') unary | primary
+    while (isspace(*lPos)) lPos++;
+    const char lOp = *lPos;
+    if (lOp == '-' || lOp == '+' || lOp == '!') {
+        lPos++;
+        if (!CompileUnary(lPos, lIsInt, lDepth, lMaxDepth)) return kFALSE;
+        if (lOp == '-') Emit(kOpNeg, 0, lDepth, lMaxDepth, 0);
+        if (lOp == '!') {
+            Emit(kOpNot, 0, lDepth, lMaxDepth, 0);
+            lIsInt = kTRUE;
+        }
+        return kTRUE;
+    }
+    return CompilePrimary(lPos, lIsInt, lDepth, lMaxDepth);
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::CompilePrimary(const char*& lPos, Bool_t& lIsInt, Int_t& lDepth, Int_t& lMaxDepth)
+{
+    // primary := number | '[' index ']' | '(' sum ')' | function '(' sum [',' sum] ')'
+    while (isspace(*lPos)) lPos++;
+    if (isdigit(*lPos) || *lPos == '.') {
+        char* lEnd = 0;
+        const Double_t lValue = strtod(lPos, &lEnd);
+        if (lEnd == lPos) return kFALSE;
+        lIsInt = kTRUE;
+        for (const char* c = lPos; c < lEnd; c++)
+            if (*c == '.' || *c == 'e' || *c == 'E') lIsInt = kFALSE;
+        lPos = lEnd;
+        fConst.push_back(lValue);
+        Emit(kOpConst, fConst.size()-1, lDepth, lMaxDepth, 1);
+        return kTRUE;
+    }
+    if (*lPos == '[') {
+        char* lEnd = 0;
+        const Long_t lIndex = strtol(lPos+1, &lEnd, 10);
+        if (lEnd == lPos+1 || *lEnd != ']' || lIndex < 0) return kFALSE;
+        lPos = lEnd+1;
+        lIsInt = kFALSE; //parameters are doubles
+        Emit(kOpVar, lIndex, lDepth, lMaxDepth, 1);
+        return kTRUE;
+    }
+    if (*lPos == '(') {
+        lPos++;
+        if (!CompileSum(lPos, lIsInt, lDepth, lMaxDepth)) return kFALSE;
+        while (isspace(*lPos)) lPos++;
+        if (*lPos != ')') return kFALSE;
+        lPos++;
+        return kTRUE;
+    }
+    //Functions
+    static const struct { const char* fName; Int_t fOp; } lFunctions[] = {
+        { "TMath::Power", kOpPow  }, { "pow",  kOpPow  },
+        { "TMath::Abs",   kOpAbs  }, { "fabs", kOpAbs  }, { "abs", kOpAbs },
+        { "TMath::Sqrt",  kOpSqrt }, { "sqrt", kOpSqrt },
+        { "TMath::Exp",   kOpExp  }, { "exp",  kOpExp  },
+        { "TMath::Log",   kOpLog  }, { "log",  kOpLog  }
+    };
+    for (UInt_t iFun = 0; iFun < sizeof(lFunctions)/sizeof(lFunctions[0]); iFun++) {
+        const size_t lLength = strlen(lFunctions[iFun].fName);
+        if (strncmp(lPos, lFunctions[iFun].fName, lLength)) continue;
+        const char* lArg = lPos + lLength;
+        while (isspace(*lArg)) lArg++;
+        if (*lArg != '(') continue;
+        lPos = lArg+1;
+        if (!CompileSum(lPos, lIsInt, lDepth, lMaxDepth)) return kFALSE;
+        while (isspace(*lPos)) lPos++;
+        if (lFunctions[iFun].fOp == kOpPow) {
+            if (*lPos != ',') return kFALSE;
+            lPos++;
+            Bool_t lIsIntExp = kFALSE;
+            if (!CompileSum(lPos, lIsIntExp, lDepth, lMaxDepth)) return kFALSE;
+            while (isspace(*lPos)) lPos++;
+            Emit(kOpPow, 0, lDepth, lMaxDepth, -1);
+        } else {
+            //abs() of an integer stays an integer, the rest goes to double
+            if (lIsInt && lFunctions[iFun].fOp != kOpAbs) return kFALSE;
+            Emit(lFunctions[iFun].fOp, 0, lDepth, lMaxDepth, 0);
+        }
+        if (*lPos != ')') return kFALSE;
+        lPos++;
+        lIsInt = lIsInt && lFunctions[iFun].fOp == kOpAbs;
+        return kTRUE;
+    }
+    return kFALSE;
+}
+//________________________________________________________________
 Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
 {
+    if (lInput != fVariablesInput || (Long_t)fVariables.size() != lInput->GetNVariables())
+        ResolveVariables(lInput);
+    
+    if (IsCompiled()) {
+        Double_t lStack[kMaxStack];
+        Int_t lTop = -1;
+        const Int_t lNCode = fCode.size();
+        for (Int_t i = 0; i < lNCode; i += 2) {
+            switch (fCode[i]) {
+                case kOpConst: lStack[++lTop] = fConst[fCode[i+1]]; break;
+                case kOpVar: {
+                    const AliMultVariable* v = fVariables[fCode[i+1]];
+                    lStack[++lTop] = v->IsInteger() ? v->GetValueInteger() : v->GetValue();
+                    break;
+                }
+                case kOpAdd:  lTop--; lStack[lTop] = lStack[lTop] + lStack[lTop+1]; break;
+                case kOpSub:  lTop--; lStack[lTop] = lStack[lTop] - lStack[lTop+1]; break;
+                case kOpMul:  lTop--; lStack[lTop] = lStack[lTop] * lStack[lTop+1]; break;
+                case kOpDiv:  lTop--; lStack[lTop] = lStack[lTop] / lStack[lTop+1]; break;
+                case kOpPow:  lTop--; lStack[lTop] = std::pow(lStack[lTop], lStack[lTop+1]); break;
+                case kOpNeg:  lStack[lTop] = -lStack[lTop]; break;
+                case kOpNot:  lStack[lTop] = !lStack[lTop]; break;
+                case kOpAbs:  lStack[lTop] = TMath::Abs(lStack[lTop]); break;
+                case kOpSqrt: lStack[lTop] = std::sqrt(lStack[lTop]); break;
+                case kOpExp:  lStack[lTop] = std::exp(lStack[lTop]); break;
+                case kOpLog:  lStack[lTop] = std::log(lStack[lTop]); break;
+            }
+        }
+        return fValue = lStack[0];
+    }
+    
     if (!fFormula) return fValue = 0;
-    for (Int_t i = 0; i < lInput->GetNVariables(); i++) {
-        AliMultVariable* v = lInput->GetVariable(i);
+    for (Int_t i = 0; i < (Int_t)fVariables.size(); i++) {
+        AliMultVariable* v = fVariables[i];
         fFormula->SetParameter(i, v->IsInteger() ?
                                v->GetValueInteger() :
                                v->GetValue());
     }
     return fValue = fFormula->Eval(0);
 }
+//________________________________________________________________
+void AliMultEstimator::SetupCalibration(const TH1* lCalib)
+{
+    //Copy the calibration histogram into a flat table: the look-up is then
+    //what TH1::FindBin + GetBinContent return, without the virtual calls
+    //and histogram access for every estimator in every event
+    fCalibNbins = 0;
+    fCalibEdges.clear();
+    fCalibContent.clear();
+    if (!lCalib) return;
+    
+    const TAxis* lAxis = lCalib->GetXaxis();
+    fCalibNbins = lAxis->GetNbins();
+    fCalibXmin  = lAxis->GetXmin();
+    fCalibXmax  = lAxis->GetXmax();
+    if (lAxis->GetXbins()->GetSize()) {
+        const TArrayD* lEdges = lAxis->GetXbins();
+        fCalibEdges.assign(lEdges->GetArray(), lEdges->GetArray() + lEdges->GetSize());
+    }
+    fCalibContent.resize(fCalibNbins+2);
+    for (Int_t ibin = 0; ibin < fCalibNbins+2; ibin++)
+        fCalibContent[ibin] = lCalib->GetBinContent(ibin);
+}
+//________________________________________________________________
+Float_t AliMultEstimator::GetCalibratedPercentile(Double_t lValue) const
+{
+    //Same binning logic as TAxis::FindBin
+    Int_t lBin = 0;
+    if (lValue < fCalibXmin) {
+        lBin = 0;
+    } else if (!(lValue < fCalibXmax)) {
+        lBin = fCalibNbins+1;
+    } else if (fCalibEdges.empty()) {
+        lBin = 1 + int (fCalibNbins*(lValue-fCalibXmin)/(fCalibXmax-fCalibXmin));
+    } else {
+        //edges are monotone: last edge not above the value
+        lBin = std::upper_bound(fCalibEdges.begin(), fCalibEdges.end(), lValue) - fCalibEdges.begin();
+    }
+    return fCalibContent[lBin];
+}
@@ -1,8 +1,11 @@
 #ifndef AliMultEstimator_H
 #define AliMultEstimator_H
 #include <TNamed.h>
+#include <vector>
 class AliMultInput;
+class AliMultVariable;
 class TFormula;
+class TH1;
 
 class AliMultEstimator : public TNamed {
     
@@ -43,8 +46,26 @@ public:
     //Pre-processing for speed
     void SetupFormula(const AliMultInput* lInput);
     Float_t Evaluate(const AliMultInput* lInput);
+    Bool_t IsCompiled() const { return !fCode.empty(); }
+    
+    //Calibration histogram as a look-up table (content of the bin of a value)
+    void    SetupCalibration(const TH1* lCalib);
+    Bool_t  HasCalibration() const { return fCalibNbins > 0; }
+    Float_t GetCalibratedPercentile(Double_t lValue) const;
     
 private:
+    //Expression compiler: recursive descent into a postfix program
+    enum EOpCode { kOpConst, kOpVar, kOpAdd, kOpSub, kOpMul, kOpDiv,
+        kOpNeg, kOpNot, kOpPow, kOpAbs, kOpSqrt, kOpExp, kOpLog };
+    enum { kMaxStack = 64 };
+    Bool_t CompileSum    (const char*& lPos, Bool_t& lIsInt, Int_t& lDepth, Int_t& lMaxDepth);
+    Bool_t CompileProduct(const char*& lPos, Bool_t& lIsInt, Int_t& lDepth, Int_t& lMaxDepth);
+    Bool_t CompileUnary  (const char*& lPos, Bool_t& lIsInt, Int_t& lDepth, Int_t& lMaxDepth);
+    Bool_t CompilePrimary(const char*& lPos, Bool_t& lIsInt, Int_t& lDepth, Int_t& lMaxDepth);
+    void   Emit(Int_t lOp, Int_t lArg, Int_t& lDepth, Int_t& lMaxDepth, Int_t lPush);
+    void   ResolveVariables(const AliMultInput* lInput);
+    
+
     TString fDefinition; //How to evaluate based on AliMultVariables
     Bool_t fIsInteger; //Requires special treatment when calibrating
     
@@ -58,6 +79,21 @@ private:
     Float_t fAnchorPoint;       //Raw value below which
     Float_t fAnchorPercentile;  //Percentile of X-section at anchor point
     
-    ClassDef(AliMultEstimator, 1)
+    //Compiled definition (empty if TFormula has to be used)
+    std::vector<Int_t>    fCode;      //! (opcode, argument) pairs
+    std::vector<Double_t> fConst;     //! constants of the program
+    std::vector<AliMultVariable*> fVariables; //! variables of fVariablesInput, by index
+    const AliMultInput*   fVariablesInput; //! input fVariables was resolved from
+    
+    //Calibration look-up table
+    Int_t                 fCalibNbins;   //! 0: no calibration
+    Double_t              fCalibXmin;    //!
+    Double_t              fCalibXmax;    //!
+    std::vector<Double_t> fCalibEdges;   //! bin edges, empty for equidistant bins
+    std::vector<Float_t>  fCalibContent; //! content including under/overflow
+    
+    ClassDef(AliMultEstimator, 2)
+    // 1 - original implementation
+    // 2 - compiled definition and calibration look-up table (transient)
 };
 #endif
@@ -0,0 +1,204 @@
+/**********************************************
+ *
+ * Mergeable quantile sketch for the single-pass
+ * calibration of AliMultSelectionCalibrator
+ *
+ *  --- floating point values: merging t-digest
+ *      with the k2 scale function, i.e. centroid
+ *      sizes proportional to q(1-q): both tails
+ *      (0-0.01% and 99-100%) are kept with
+ *      single-entry centroids, which are exact
+ *  --- integer values: exact count per value
+ *
+ *  Sketches filled on different file shards are
+ *  combined with Merge (hadd-compatible)
+ *
+ **********************************************/
+
+#include "AliMultQuantileSketch.h"
+#include "TCollection.h"
+#include "TMath.h"
+#include <algorithm>
+#include <utility>
+
+ClassImp(AliMultQuantileSketch);
+
+//________________________________________________________________
+AliMultQuantileSketch::AliMultQuantileSketch() :
+  TNamed(), fIsInteger(kFALSE), fCompression(2000.), fEntries(0), fSum(0), fMin(0), fMax(0),
+fkUseThreshold(kFALSE), fThreshold(0), fNAboveThreshold(0), fMeans(), fWeights(), fBuffer()
+{
+  // Constructor
+
+}
+//________________________________________________________________
+AliMultQuantileSketch::AliMultQuantileSketch(const char * name, Double_t lCompression, Bool_t lIsInteger):
+TNamed(name,"Quantile sketch"), fIsInteger(lIsInteger), fCompression(lCompression), fEntries(0), fSum(0), fMin(0), fMax(0),
+fkUseThreshold(kFALSE), fThreshold(0), fNAboveThreshold(0), fMeans(), fWeights(), fBuffer()
+{
+  // Named constructor
+  if ( fCompression < 10. ) fCompression = 10.;
+}
+//________________________________________________________________
+AliMultQuantileSketch::~AliMultQuantileSketch(){
+  // destructor
+
+}
+//________________________________________________________________
+void AliMultQuantileSketch::Fill( Double_t lValue )
+{
+    if ( fEntries == 0 || lValue < fMin ) fMin = lValue;
+    if ( fEntries == 0 || lValue > fMax ) fMax = lValue;
+    fEntries++;
+    fSum += lValue;
+    if ( fkUseThreshold && lValue > fThreshold ) fNAboveThreshold++;
+
+    fBuffer.push_back( lValue );
+    if ( fBuffer.size() >= fCompression ) Compress();
+}
+//________________________________________________________________
+Bool_t AliMultQuantileSketch::Add( const AliMultQuantileSketch* lOther )
+{
+    //Returns kFALSE if the sketches count above different thresholds
+    if ( !lOther || lOther->fEntries == 0 ) return kTRUE;
+    if ( fEntries == 0 ) {
+        //Empty target: take over the threshold settings
+        fkUseThreshold = lOther->fkUseThreshold;
+        fThreshold     = lOther->fThreshold;
+    } else if ( fkUseThreshold != lOther->fkUseThreshold ||
+               ( fkUseThreshold && fThreshold != lOther->fThreshold ) ) {
+        Error("Add", "Cannot merge sketch %s: threshold %s%f vs %s%f", GetName(),
+              fkUseThreshold ? "" : "(unused) ", fThreshold,
+              lOther->fkUseThreshold ? "" : "(unused) ", lOther->fThreshold);
+        return kFALSE;
+    }
+    if ( fEntries == 0 || lOther->fMin < fMin ) fMin = lOther->fMin;
+    if ( fEntries == 0 || lOther->fMax > fMax ) fMax = lOther->fMax;
+    fEntries += lOther->fEntries;
+    fSum     += lOther->fSum;
+    fNAboveThreshold += lOther->fNAboveThreshold;
+
+    fMeans  .insert( fMeans  .end(), lOther->fMeans  .begin(), lOther->fMeans  .end() );
+    fWeights.insert( fWeights.end(), lOther->fWeights.begin(), lOther->fWeights.end() );
+    fBuffer .insert( fBuffer .end(), lOther->fBuffer .begin(), lOther->fBuffer .end() );
+    Compress();
+    return kTRUE;
+}
+//________________________________________________________________
+Long64_t AliMultQuantileSketch::Merge( TCollection* lList )
+{
+    if ( !lList ) return fEntries;
+    TIter next(lList);
+    TObject* obj = 0;
+    while ((obj = next())) {
+        AliMultQuantileSketch* lOther = dynamic_cast<AliMultQuantileSketch*>(obj);
+        if ( !lOther ) {
+            Error("Merge", "Cannot merge an object of class %s", obj->ClassName());
+            return -1;
+        }
+        if ( !Add( lOther ) ) return -1;
+    }
+    return fEntries;
+}
+//________________________________________________________________
+Double_t AliMultQuantileSketch::ScaleK( Double_t q, Double_t lNorm ) const
+{
+    //k2 scale function: fine steps at both ends of the distribution
+    if ( q <= 0 ) return -1e+300;
+    if ( q >= 1 ) return  1e+300;
+    return fCompression/lNorm * TMath::Log( q/(1.-q) );
+}
+//________________________________________________________________
+Double_t AliMultQuantileSketch::ScaleKInv( Double_t k, Double_t lNorm ) const
+{
+    const Double_t lArg = -k*lNorm/fCompression;
+    if ( lArg >  700 ) return 0;
+    if ( lArg < -700 ) return 1;
+    return 1./(1.+TMath::Exp( lArg ));
+}
+//________________________________________________________________
+void AliMultQuantileSketch::Compress()
+{
+    //Sort centroids and buffered values together, then merge neighbours
+    //as long as the merged centroid spans less than one unit of k
+    std::vector< std::pair<Double_t,Double_t> > lItems;
+    lItems.reserve( fMeans.size() + fBuffer.size() );
+    for ( size_t i = 0; i < fMeans.size(); i++ ) lItems.push_back( std::make_pair(fMeans[i], fWeights[i]) );
+    for ( size_t i = 0; i < fBuffer.size(); i++ ) lItems.push_back( std::make_pair(fBuffer[i], 1.) );
+    fBuffer.clear();
+    fMeans.clear();
+    fWeights.clear();
+    if ( lItems.empty() ) return;
+    std::sort( lItems.begin(), lItems.end() );
+
+    Double_t lTotal = 0;
+    for ( size_t i = 0; i < lItems.size(); i++ ) lTotal += lItems[i].second;
+    const Double_t lNorm = 4.*TMath::Log( TMath::Max( lTotal/fCompression, 1. ) ) + 24.;
+
+    Double_t lMean   = lItems[0].first;
+    Double_t lWeight = lItems[0].second;
+    Double_t lSoFar  = 0; //weight of the centroids already written
+    Double_t lQLimit = ScaleKInv( ScaleK( 0., lNorm ) + 1., lNorm );
+    for ( size_t i = 1; i < lItems.size(); i++ ) {
+        Bool_t lMerge = kFALSE;
+        if ( fIsInteger ) lMerge = ( lItems[i].first == lMean );
+        else lMerge = ( (lSoFar + lWeight + lItems[i].second)/lTotal <= lQLimit );
+        if ( lMerge ) {
+            lWeight += lItems[i].second;
+            lMean   += (lItems[i].first - lMean)*lItems[i].second/lWeight;
+            continue;
+        }
+        fMeans  .push_back( lMean   );
+        fWeights.push_back( lWeight );
+        lSoFar += lWeight;
+        lQLimit = ScaleKInv( ScaleK( lSoFar/lTotal, lNorm ) + 1., lNorm );
+        lMean   = lItems[i].first;
+        lWeight = lItems[i].second;
+    }
+    fMeans  .push_back( lMean   );
+    fWeights.push_back( lWeight );
+}
+//________________________________________________________________
+Int_t AliMultQuantileSketch::GetNCentroids()
+{
+    if ( !fBuffer.empty() ) Compress();
+    return fMeans.size();
+}
+//________________________________________________________________
+Double_t AliMultQuantileSketch::GetValueAtRank( Double_t lRank )
+{
+    //Entries inside a centroid are assumed evenly spread around its
+    //mean; between centroid centres the value is interpolated linearly.
+    //Single-entry centroids (tails) return the exact value.
+    const Int_t lN = GetNCentroids();
+    if ( lN == 0 ) return 0;
+    if ( lRank <= 0 ) return fMin;
+    if ( lRank >= fEntries-1 ) return fMax;
+
+    Double_t lCumulative = 0;
+    Double_t lPrevCentre = 0, lPrevValue = fMin;
+    for ( Int_t i = 0; i < lN; i++ ) {
+        if ( fIsInteger && lRank < lCumulative + fWeights[i] ) return fMeans[i];
+        const Double_t lCentre = lCumulative + 0.5*(fWeights[i]-1.);
+        if ( lRank <= lCentre ) {
+            if ( lCentre <= lPrevCentre ) return fMeans[i];
+            return lPrevValue + (fMeans[i]-lPrevValue)*(lRank-lPrevCentre)/(lCentre-lPrevCentre);
+        }
+        lPrevCentre  = lCentre;
+        lPrevValue   = fMeans[i];
+        lCumulative += fWeights[i];
+    }
+    //between the last centre and the largest value
+    const Double_t lLast = fEntries-1;
+    if ( lLast <= lPrevCentre ) return fMax;
+    return lPrevValue + (fMax-lPrevValue)*(lRank-lPrevCentre)/(lLast-lPrevCentre);
+}
+//________________________________________________________________
+void AliMultQuantileSketch::Print(Option_t* option) const
+{
+    printf("%s: %s (%s) entries=%lld mean=%f min=%f max=%f centroids=%d",
+           ClassName(), GetName(), (IsInteger() ? "integer" : "float"),
+           fEntries, GetMean(), fMin, fMax, (Int_t)fMeans.size());
+    if ( fkUseThreshold ) printf(" above %f: %lld", fThreshold, fNAboveThreshold);
+    printf("\n");
+}
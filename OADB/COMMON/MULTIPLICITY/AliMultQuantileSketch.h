@@ -0,0 +1,60 @@
+#ifndef AliMultQuantileSketch_H
+#define AliMultQuantileSketch_H
+#include <TNamed.h>
+#include <vector>
+class TCollection;
+
+class AliMultQuantileSketch : public TNamed {
+
+public:
+    AliMultQuantileSketch();
+    AliMultQuantileSketch(const char * name, Double_t lCompression = 2000., Bool_t lIsInteger = kFALSE);
+    ~AliMultQuantileSketch();
+
+    //Counting of values above a threshold (exact, e.g. anchor point)
+    void     SetThreshold ( Double_t lVal ) { fThreshold = lVal; fkUseThreshold = kTRUE; }
+    Double_t GetThreshold () const { return fThreshold; }
+    Long64_t GetNAboveThreshold () const { return fNAboveThreshold; }
+
+    void Fill ( Double_t lValue );
+    Bool_t Add ( const AliMultQuantileSketch* lOther );
+    Long64_t Merge ( TCollection* lList );
+
+    Bool_t   IsInteger   () const { return fIsInteger; }
+    Long64_t GetEntries  () const { return fEntries; }
+    Double_t GetMean     () const { return fEntries > 0 ? fSum/fEntries : 0; }
+    Double_t GetMin      () const { return fMin; }
+    Double_t GetMax      () const { return fMax; }
+
+    //Value of the entry with (0-based) rank lRank in ascending order
+    Double_t GetValueAtRank ( Double_t lRank );
+
+    //Access to the centroids (exact value/count pairs in integer mode)
+    Int_t    GetNCentroids();
+    Double_t GetCentroidMean   ( Int_t i ) const { return fMeans[i];   }
+    Double_t GetCentroidWeight ( Int_t i ) const { return fWeights[i]; }
+
+    void Print(Option_t* option="") const;
+
+private:
+    void Compress();
+    Double_t ScaleK  ( Double_t q, Double_t lNorm ) const;
+    Double_t ScaleKInv ( Double_t k, Double_t lNorm ) const;
+
+    Bool_t   fIsInteger;   //Exact counts per value, no compression
+    Double_t fCompression; //t-digest compression (~ number of centroids)
+    Long64_t fEntries;     //Number of values
+    Double_t fSum;         //Sum of values (for the mean)
+    Double_t fMin;         //Smallest value
+    Double_t fMax;         //Largest value
+    Bool_t   fkUseThreshold;   //Count values above fThreshold
+    Double_t fThreshold;       //Threshold
+    Long64_t fNAboveThreshold; //Values above threshold
+
+    std::vector<Double_t> fMeans;   //Centroid means, ascending
+    std::vector<Double_t> fWeights; //Centroid weights
+    std::vector<Double_t> fBuffer;  //Values not yet merged into centroids
+
+    ClassDef(AliMultQuantileSketch, 1)
+};
+#endif
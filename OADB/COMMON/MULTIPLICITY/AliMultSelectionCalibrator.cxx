@@ -22,12 +22,17 @@
 #include "AliMultInput.h"
 #include "AliMultSelection.h"
 #include "AliMultSelectionCalibrator.h"
+#include "AliMultQuantileSketch.h"
 #include "AliVEvent.h"
 #include "AliESDEvent.h"
 #include "TList.h"
 #include "TFile.h"
 #include "TStopwatch.h"
 #include "TArrayL64.h"
+#include "TKey.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include <vector>
 
 ClassImp(AliMultSelectionCalibrator);
 
@@ -37,7 +42,12 @@ fRunToUseAsDefault(-1), fMaxEventsPerRun(1e+9), fCheckTriggerType(kFALSE),
 fTrigType(AliVEvent::kAny), fPrefilterOnly(kFALSE), fFiredTrigString(""),
 fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0),
 fInputFileName(""), fBufferFileName("buffer.root"),
-fOutputFileName(""), fMultSelectionCuts(0), fCalibHists(0)
+fOutputFileName(""), fSketchFileName("sketches.root"), fSketchCompression(2000.),
+fMultSelectionCuts(0), fCalibHists(0),
+fInputFile(0), fTree(0), fEvSel_IsNotPileupInMultBins(kFALSE), fEvSel_Triggered(kFALSE),
+fEvSel_INELgtZERO(kFALSE), fEvSel_PassesTrackletVsCluster(kFALSE), fEvSel_HasNoInconsistentVertices(kFALSE),
+fEvSel_IsNotAsymmetricInVZERO(kFALSE), fEvSel_IsNotIncompleteDAQ(kFALSE), fEvSel_HasGoodVertex2016(kFALSE),
+fRunNumber(0), fnContributors(1000), fEvSel_TriggerMask(0), fFiredTriggerClasses(0)
 {
     // Constructor
 
@@ -67,7 +77,12 @@ fRunToUseAsDefault(-1), fMaxEventsPerRun(1e+9), fCheckTriggerType(kFALSE),
 fTrigType(AliVEvent::kAny), fPrefilterOnly(kFALSE), fFiredTrigString(""),
 fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0),
 fInputFileName(""), fBufferFileName("buffer.root"),
-fOutputFileName(""), fMultSelectionCuts(0), fCalibHists(0)
+fOutputFileName(""), fSketchFileName("sketches.root"), fSketchCompression(2000.),
+fMultSelectionCuts(0), fCalibHists(0),
+fInputFile(0), fTree(0), fEvSel_IsNotPileupInMultBins(kFALSE), fEvSel_Triggered(kFALSE),
+fEvSel_INELgtZERO(kFALSE), fEvSel_PassesTrackletVsCluster(kFALSE), fEvSel_HasNoInconsistentVertices(kFALSE),
+fEvSel_IsNotAsymmetricInVZERO(kFALSE), fEvSel_IsNotIncompleteDAQ(kFALSE), fEvSel_HasGoodVertex2016(kFALSE),
+fRunNumber(0), fnContributors(1000), fEvSel_TriggerMask(0), fFiredTriggerClasses(0)
 {
     // Named Constructor
 
@@ -120,6 +135,10 @@ AliMultSelectionCalibrator::~AliMultSelectionCalibrator() {
         delete fCalibHists;
         fCalibHists = 0x0;
     }
+    if ( fFiredTriggerClasses ) {
+        delete fFiredTriggerClasses;
+        fFiredTriggerClasses = 0x0;
+    }
 }
 //________________________________________________________________
 void AliMultSelectionCalibrator::AddRunRange ( Int_t lFirst, Int_t lLast, AliMultSelection *lMultSelProvided ){
@@ -138,61 +157,36 @@ void AliMultSelectionCalibrator::AddRunRange ( Int_t lFirst, Int_t lLast, AliMul
     fNRunRanges++;
 }
 //________________________________________________________________
-Bool_t AliMultSelectionCalibrator::Calibrate() {
-    // Function meant to generate calibration OADB
-    //
-    // --- input : fInputFileName, containing a TTree object
-    // --- output: fOutputFileName, containing OABD object
-    //
-    // Steps involved:
-    //  (1) Set up basic I/O
-    //  (2) Detect Runs From Input File
-    //  (3) Determine Averages
-    //     (3a) Create run-by-run buffer files with averages
-    //  (4) Determine Quantile Boundaries
-    //     (4a) Create run-by-run buffer files (requires averages)
-    //     (4b) Compute Quantile Boundaries for all estimators
-    //  (4) Save Quantiles + AliMultSelectionCuts to OADB File
+Bool_t AliMultSelectionCalibrator::OpenInputTree() {
+    // Open fInputFileName and bind the event selection and input
+    // variables of its fTreeEvent (shared by Calibrate and FillSketches)
 
-    cout<<"=== STARTING CALIBRATION PROCEDURE ==="<<endl;
-    cout<<" * Input File.....: "<<fInputFileName.Data()<<endl;
-    cout<<" * Output File....: "<<fOutputFileName.Data()<<endl;
-    cout<<endl;
-    cout<<" * Event Selection Peformed: "<<endl;
-    fMultSelectionCuts -> Print();
-    cout<<endl;
-
-    // STEP 1: Basic I/O
-    cout<<"(1) Opening File"<<endl;
-
-    //Open File
-    TFile *fInputFile = TFile::Open( fInputFileName.Data(), "READ");
-    if(!fInputFile) {
+    TFile *lFile = TFile::Open( fInputFileName.Data(), "READ");
+    if(!lFile) {
         AliWarningF("File %s not found!", fInputFileName.Data() );
         return kFALSE;
     }
     //Locate TTree object
-    TTree* fTree = (TTree*)fInputFile->FindObjectAny("fTreeEvent");
-    if(!fTree) {
+    TTree* lTree = (TTree*)lFile->FindObjectAny("fTreeEvent");
+    if(!lTree) {
         AliWarning("fTreeEvent object not found!" );
         return kFALSE;
     }
+    fInputFile = lFile;
+    fTree      = lTree;
 
     //Event Selection Variables
-    Bool_t fEvSel_IsNotPileupInMultBins      = kFALSE ;
-    Bool_t fEvSel_Triggered                  = kFALSE ;
-    Bool_t fEvSel_INELgtZERO                 = kFALSE ;
-    Bool_t fEvSel_PassesTrackletVsCluster    = kFALSE ;
-    Bool_t fEvSel_HasNoInconsistentVertices  = kFALSE ;
-    Bool_t fEvSel_IsNotAsymmetricInVZERO     = kFALSE ;
-    Bool_t fEvSel_IsNotIncompleteDAQ         = kFALSE ;
-    Bool_t fEvSel_HasGoodVertex2016          = kFALSE ;
-    Int_t fRunNumber;
+    fEvSel_IsNotPileupInMultBins      = kFALSE ;
+    fEvSel_Triggered                  = kFALSE ;
+    fEvSel_INELgtZERO                 = kFALSE ;
+    fEvSel_PassesTrackletVsCluster    = kFALSE ;
+    fEvSel_HasNoInconsistentVertices  = kFALSE ;
+    fEvSel_IsNotAsymmetricInVZERO     = kFALSE ;
+    fEvSel_IsNotIncompleteDAQ         = kFALSE ;
+    fEvSel_HasGoodVertex2016          = kFALSE ;
 
     //FIXME/CAUTION: non-zero if using tree without that branch
-    Int_t fnContributors = 1000;
-
-    UInt_t fEvSel_TriggerMask; //! save full info for checking later
+    fnContributors = 1000;
 
     //SetBranchAddresses for event Selection Variables
     //(multiplicity related will be done automatically!)
@@ -208,14 +202,8 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     fTree->SetBranchAddress("fEvSel_IsNotIncompleteDAQ", &fEvSel_IsNotIncompleteDAQ);
     fTree->SetBranchAddress("fEvSel_HasGoodVertex2016", &fEvSel_HasGoodVertex2016);
 
-    TString *fFiredTriggerClasses = new TString();
+    if ( !fFiredTriggerClasses ) fFiredTriggerClasses = new TString();
     fTree->SetBranchAddress("fFiredTriggerClasses",&fFiredTriggerClasses);
-    
-    //============================================================
-    // Auto-configure Input
-    //============================================================
-
-    Bool_t lAutoDiscover = kFALSE;
 
     if ( fInput->GetNVariables() < 1 ){
         cout<<"Error: No Input Variables configured!"<<endl;
@@ -223,6 +211,79 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
         return kFALSE; //failure to calibrate
     }
 
+    //Binding to input variables
+    for(Long_t iVar=0; iVar<fInput->GetNVariables(); iVar++) {
+        if( !fInput->GetVariable(iVar)->IsInteger() ) {
+            fTree->SetBranchAddress(fInput->GetVariable(iVar)->GetName(),&fInput->GetVariable(iVar)->GetRValue());
+        } else {
+            fTree->SetBranchAddress(fInput->GetVariable(iVar)->GetName(),&fInput->GetVariable(iVar)->GetRValueInteger());
+        }
+    }
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultSelectionCalibrator::IsSelectedEvent( AliMultVariable *lVtxZ ) const {
+    // Event selection for the current entry of fTree
+
+    //Apply trigger mask (will only work if not kAny)
+    Bool_t isSelected = fEvSel_TriggerMask & fTrigType;
+    if(!isSelected && fCheckTriggerType) return kFALSE;
+
+    if(fFiredTrigString.EqualTo("")==kFALSE) {
+        if (fFiredTriggerClasses->Contains( fFiredTrigString.Data() ) == kFALSE ) return kFALSE;
+    }
+
+    //Check Selections as they are in the fMultSelectionCuts Object
+    if( fMultSelectionCuts->GetTriggerCut()    && ! fEvSel_Triggered  ) return kFALSE;
+    if( fMultSelectionCuts->GetINELgtZEROCut() && ! fEvSel_INELgtZERO ) return kFALSE;
+    if( TMath::Abs( lVtxZ->GetValue() ) > fMultSelectionCuts->GetVzCut()      ) return kFALSE;
+    //ADD ME HERE: Tracklets Vs Clusters Cut?
+    if( fMultSelectionCuts->GetRejectPileupInMultBinsCut() && ! fEvSel_IsNotPileupInMultBins    ) return kFALSE;
+    if( fMultSelectionCuts->GetTrackletsVsClustersCut()    && ! fEvSel_PassesTrackletVsCluster  ) return kFALSE;
+    if( fMultSelectionCuts->GetVertexConsistencyCut()      && ! fEvSel_HasNoInconsistentVertices) return kFALSE;
+    if( fMultSelectionCuts->GetNonZeroNContribs()          &&  fnContributors < 1 ) return kFALSE;
+    if( fMultSelectionCuts->GetIsNotAsymmetricInVZERO()    && ! fEvSel_IsNotAsymmetricInVZERO) return kFALSE;
+    if( fMultSelectionCuts->GetIsNotIncompleteDAQ()        && ! fEvSel_IsNotIncompleteDAQ) return kFALSE;
+    if( fMultSelectionCuts->GetHasGoodVertex2016()         && ! fEvSel_HasGoodVertex2016) return kFALSE;
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultSelectionCalibrator::Calibrate() {
+    // Function meant to generate calibration OADB
+    //
+    // --- input : fInputFileName, containing a TTree object
+    // --- output: fOutputFileName, containing OABD object
+    //
+    // Steps involved:
+    //  (1) Set up basic I/O
+    //  (2) Detect Runs From Input File
+    //  (3) Determine Averages
+    //     (3a) Create run-by-run buffer files with averages
+    //  (4) Determine Quantile Boundaries
+    //     (4a) Create run-by-run buffer files (requires averages)
+    //     (4b) Compute Quantile Boundaries for all estimators
+    //  (4) Save Quantiles + AliMultSelectionCuts to OADB File
+
+    cout<<"=== STARTING CALIBRATION PROCEDURE ==="<<endl;
+    cout<<" * Input File.....: "<<fInputFileName.Data()<<endl;
+    cout<<" * Output File....: "<<fOutputFileName.Data()<<endl;
+    cout<<endl;
+    cout<<" * Event Selection Peformed: "<<endl;
+    fMultSelectionCuts -> Print();
+    cout<<endl;
+
+    // STEP 1: Basic I/O
+    cout<<"(1) Opening File"<<endl;
+
+    //Open File, bind event selection and input variables
+    if ( !OpenInputTree() ) return kFALSE;
+
+    //============================================================
+    // Auto-configure Input
+    //============================================================
+
+    Bool_t lAutoDiscover = kFALSE;
+
     if ( fMultSelectionList->GetEntries() == 0 ){
         AliInfo("===============================================");
         AliInfo(" Calibrator invoked without run mappings");
@@ -237,15 +298,6 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
         return kFALSE; //failure to calibrate
     }
 
-    //Binding to input variables
-    for(Long_t iVar=0; iVar<fInput->GetNVariables(); iVar++) {
-        if( !fInput->GetVariable(iVar)->IsInteger() ) {
-            fTree->SetBranchAddress(fInput->GetVariable(iVar)->GetName(),&fInput->GetVariable(iVar)->GetRValue());
-        } else {
-            fTree->SetBranchAddress(fInput->GetVariable(iVar)->GetName(),&fInput->GetVariable(iVar)->GetRValueInteger());
-        }
-    }
-
     Long64_t lNEv = fTree->GetEntries();
     cout<<"(1) File opened, event count is "<<lNEv<<endl;
 
@@ -346,29 +398,7 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
         }
         fTree->GetEntry(iEv);
         //Perform Event selection
-        Bool_t lSaveThisEvent = kTRUE; //let's be optimistic
-
-        //Apply trigger mask (will only work if not kAny)
-        Bool_t isSelected = 0;
-        isSelected = fEvSel_TriggerMask & fTrigType;
-        if(!isSelected && fCheckTriggerType) lSaveThisEvent = kFALSE;
-
-        if(fFiredTrigString.EqualTo("")==kFALSE) {
-            if (fFiredTriggerClasses->Contains( fFiredTrigString.Data() ) == kFALSE ) lSaveThisEvent = kFALSE;
-        }
-        
-        //Check Selections as they are in the fMultSelectionCuts Object
-        if( fMultSelectionCuts->GetTriggerCut()    && ! fEvSel_Triggered  ) lSaveThisEvent = kFALSE;
-        if( fMultSelectionCuts->GetINELgtZEROCut() && ! fEvSel_INELgtZERO ) lSaveThisEvent = kFALSE;
-        if( TMath::Abs( lVtxZLocalPointer->GetValue() ) > fMultSelectionCuts->GetVzCut()      ) lSaveThisEvent = kFALSE;
-        //ADD ME HERE: Tracklets Vs Clusters Cut?
-        if( fMultSelectionCuts->GetRejectPileupInMultBinsCut() && ! fEvSel_IsNotPileupInMultBins    ) lSaveThisEvent = kFALSE;
-        if( fMultSelectionCuts->GetTrackletsVsClustersCut()    && ! fEvSel_PassesTrackletVsCluster  ) lSaveThisEvent = kFALSE;
-        if( fMultSelectionCuts->GetVertexConsistencyCut()      && ! fEvSel_HasNoInconsistentVertices) lSaveThisEvent = kFALSE;
-        if( fMultSelectionCuts->GetNonZeroNContribs()          &&  fnContributors < 1 ) lSaveThisEvent = kFALSE;
-        if( fMultSelectionCuts->GetIsNotAsymmetricInVZERO()    && ! fEvSel_IsNotAsymmetricInVZERO) lSaveThisEvent = kFALSE;
-        if( fMultSelectionCuts->GetIsNotIncompleteDAQ()        && ! fEvSel_IsNotIncompleteDAQ) lSaveThisEvent = kFALSE;
-        if( fMultSelectionCuts->GetHasGoodVertex2016()         && ! fEvSel_HasGoodVertex2016) lSaveThisEvent = kFALSE;
+        Bool_t lSaveThisEvent = IsSelectedEvent( lVtxZLocalPointer );
 
         Int_t lIndex = -1;
         if ( !lAutoDiscover ){
@@ -774,6 +804,451 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     return kTRUE;
 }
 //________________________________________________________________
+Bool_t AliMultSelectionCalibrator::FillSketches() {
+    // Single pass over fInputFileName: same event selection as Calibrate(),
+    // every estimator value goes into a quantile sketch per run (range).
+    //
+    // --- input : fInputFileName, containing a TTree object
+    // --- output: fSketchFileName, one directory per run (run_<number>)
+    //             or run range (range_<index>) with one sketch per estimator
+    //
+    // Can be run on shards of the input in parallel, the outputs are
+    // merged by CalibrateFromSketches() or hadd. N.B.: fMaxEventsPerRun
+    // then applies per shard.
+
+    cout<<"=== FILLING QUANTILE SKETCHES ==="<<endl;
+    cout<<" * Input File.....: "<<fInputFileName.Data()<<endl;
+    cout<<" * Sketch File....: "<<fSketchFileName.Data()<<endl;
+    cout<<" * Compression....: "<<fSketchCompression<<endl;
+    cout<<endl;
+    cout<<" * Event Selection Peformed: "<<endl;
+    fMultSelectionCuts -> Print();
+    cout<<endl;
+
+    if ( !OpenInputTree() ) return kFALSE;
+
+    const Bool_t lAutoDiscover = ( fMultSelectionList->GetEntries() == 0 );
+    if ( lAutoDiscover && !fSelection ) {
+        cout<<"Error: no default AliMultSelection defined!"<<endl;
+        cout<<"The simplest way to get rid of this problem is to remember to call SetMultSelection(...)!"<<endl;
+        return kFALSE; //failure to calibrate
+    }
+
+    //Estimator evaluation set up once per AliMultSelection
+    if ( lAutoDiscover ) {
+        fSelection->Setup ( fInput );
+    } else {
+        for(Int_t iRange=0; iRange<fNRunRanges; iRange++)
+            ((AliMultSelection*) fMultSelectionList->At(iRange))->Setup ( fInput );
+    }
+
+    //Sketches per run (auto-discovery) or per run range index
+    std::map<Int_t, TList*> lSketches;
+    std::map<Int_t, AliMultSelection*> lSelections;
+
+    AliMultVariable *lVtxZLocalPointer = fInput -> GetVariable("fEvSel_VtxZ");
+
+    TStopwatch* timer = new TStopwatch();
+    timer->Start ( kTRUE );
+
+    const Long64_t lNEv = fTree->GetEntries();
+    cout<<"File opened, event count is "<<lNEv<<endl;
+    for(Long64_t iEv = 0; iEv<lNEv; iEv++) {
+        if ( iEv % 1000000 == 0 ) {
+            timer->Stop();
+            cout << "Event # " << iEv << "/" << lNEv << ", working at "<< ((Double_t) iEv)/timer->RealTime() <<" Events/s..." << endl;
+            timer->Start ( kFALSE );
+        }
+        fTree->GetEntry(iEv);
+
+        if ( !IsSelectedEvent( lVtxZLocalPointer ) ) continue;
+
+        Int_t lKey = fRunNumber;
+        if ( !lAutoDiscover ){
+            //Consult map for run range equivalency
+            if ( fRunRangesMap.find( fRunNumber ) == fRunRangesMap.end() ) continue;
+            lKey = fRunRangesMap[ fRunNumber ];
+        }
+
+        TList *lList = lSketches[lKey];
+        if ( !lList ) {
+            AliMultSelection *lSel = lAutoDiscover ? fSelection : (AliMultSelection*) fMultSelectionList->At(lKey);
+            if ( lAutoDiscover ) cout<<"(Autodiscover) New Run Found: "<<fRunNumber<<endl;
+            lList = new TList();
+            lList->SetOwner(kTRUE);
+            for(Long_t iEst=0; iEst<lSel->GetNEstimators(); iEst++) {
+                AliMultEstimator *lEst = lSel->GetEstimator(iEst);
+                AliMultQuantileSketch *lSketch = new AliMultQuantileSketch(lEst->GetName(), fSketchCompression, lEst->IsInteger());
+                if ( lEst->GetUseAnchor() ) lSketch->SetThreshold( lEst->GetAnchorPoint() );
+                lList->Add( lSketch );
+            }
+            lSketches[lKey]   = lList;
+            lSelections[lKey] = lSel;
+        }
+        AliMultQuantileSketch *lFirst = (AliMultQuantileSketch*) lList->First();
+        if ( lFirst && lFirst->GetEntries() >= fMaxEventsPerRun ) continue;
+
+        AliMultSelection *lSel = lSelections[lKey];
+        lSel->Evaluate ( fInput );
+        TIter lNextEst(lSel->GetEstimatorList());
+        TIter lNextSketch(lList);
+        AliMultEstimator *lEst = 0x0;
+        while ( (lEst = (AliMultEstimator*) lNextEst()) )
+            ((AliMultQuantileSketch*) lNextSketch())->Fill( lEst->GetValue() );
+    }
+    timer->Stop();
+    cout<<"Done in "<<timer->RealTime()<<" s, writing sketches for "<<lSketches.size()<<(lAutoDiscover?" runs":" run ranges")<<endl;
+
+    TFile *lOutput = new TFile (fSketchFileName.Data(), "RECREATE");
+    for(std::map<Int_t, TList*>::iterator it = lSketches.begin(); it != lSketches.end(); ++it) {
+        TDirectory *lDir = lOutput->mkdir( Form(lAutoDiscover ? "run_%i" : "range_%i", it->first) );
+        lDir->cd();
+        TIter lNext(it->second);
+        TObject *lObj = 0x0;
+        while ( (lObj = lNext()) ) lObj->Write();
+        delete it->second;
+    }
+    lOutput->Close();
+    delete lOutput;
+    fInputFile->Close();
+    delete fInputFile;
+    fInputFile = 0x0;
+    fTree = 0x0;
+    delete timer;
+    return kTRUE;
+}
+//________________________________________________________________
+AliOADBMultSelection* AliMultSelectionCalibrator::CreateOADBObject( const char *lName, AliMultSelection *lSel, TH1F **lCalib, const Double_t *lAv ) const {
+    AliOADBMultSelection *oadbMultSelection = lName ? new AliOADBMultSelection(lName) : new AliOADBMultSelection();
+    AliMultSelection *fsels = new AliMultSelection( lSel );
+    oadbMultSelection->SetEventCuts    ( new AliMultSelectionCuts(*fMultSelectionCuts) );
+    oadbMultSelection->SetMultSelection( fsels );
+    for ( Int_t iEst=0; iEst<lSel->GetNEstimators(); iEst++) {
+        fsels->GetEstimator(iEst)->SetMean( lAv[iEst] );
+        TH1F *hCalibData = (TH1F*) lCalib[iEst]->Clone( Form("hCalib_%s",lSel->GetEstimator(iEst)->GetName()) );
+        hCalibData->SetDirectory(0);
+        oadbMultSelection->AddCalibHisto( hCalibData );
+    }
+    return oadbMultSelection;
+}
+//________________________________________________________________
+Bool_t AliMultSelectionCalibrator::CalibrateFromSketches() {
+    // Generate the calibration OADB from quantile sketches
+    //
+    // --- input : fSketchFileName, comma-separated list of FillSketches() outputs
+    // --- output: fOutputFileName, containing OABD object
+    //
+    // Boundaries are derived as in Calibrate(): the boundary at percentile P
+    // is the value at position 0.01*P*N of the descending ordering, here
+    // taken from the sketch. Integer estimators are exact (value counts).
+
+    cout<<"=== STARTING CALIBRATION FROM QUANTILE SKETCHES ==="<<endl;
+    cout<<" * Sketch File(s).: "<<fSketchFileName.Data()<<endl;
+    cout<<" * Output File....: "<<fOutputFileName.Data()<<endl;
+
+    const Bool_t lAutoDiscover = ( fMultSelectionList->GetEntries() == 0 );
+    if ( lAutoDiscover && !fSelection ) {
+        cout<<"Error: no default AliMultSelection defined!"<<endl;
+        return kFALSE;
+    }
+
+    //Read and merge the sketches of all shards
+    std::map<Int_t, TList*> lSketches;
+    TObjArray *lFiles = fSketchFileName.Tokenize(",");
+    for(Int_t iFile=0; iFile<lFiles->GetEntriesFast(); iFile++) {
+        TString lFileName = ((TObjString*) lFiles->At(iFile))->GetString().Strip(TString::kBoth);
+        TFile *lFile = TFile::Open( lFileName.Data(), "READ");
+        if ( !lFile ) {
+            AliWarningF("File %s not found!", lFileName.Data() );
+            delete lFiles;
+            return kFALSE;
+        }
+        TIter lNextDir(lFile->GetListOfKeys());
+        TKey *lDirKey = 0x0;
+        while ( (lDirKey = (TKey*) lNextDir()) ) {
+            TString lDirName = lDirKey->GetName();
+            const TString lPrefix = lAutoDiscover ? "run_" : "range_";
+            if ( !lDirName.BeginsWith(lPrefix) ) {
+                AliWarningF("Skipping %s in %s (expected %s<index>)", lDirName.Data(), lFileName.Data(), lPrefix.Data());
+                continue;
+            }
+            TString lIndex = lDirName;
+            lIndex.Remove(0, lPrefix.Length());
+            const Int_t lKey = lIndex.Atoi();
+            TDirectory *lDir = (TDirectory*) lFile->Get( lDirName.Data() );
+            TList *&lList = lSketches[lKey];
+            if ( !lList ) {
+                lList = new TList();
+                lList->SetOwner(kTRUE);
+            }
+            TIter lNextKey(lDir->GetListOfKeys());
+            TKey *lKeySketch = 0x0;
+            while ( (lKeySketch = (TKey*) lNextKey()) ) {
+                AliMultQuantileSketch *lSketch = dynamic_cast<AliMultQuantileSketch*>( lKeySketch->ReadObj() );
+                if ( !lSketch ) continue;
+                AliMultQuantileSketch *lExisting = (AliMultQuantileSketch*) lList->FindObject( lSketch->GetName() );
+                if ( lExisting ) {
+                    const Bool_t lMerged = lExisting->Add( lSketch );
+                    delete lSketch;
+                    if ( !lMerged ) {
+                        AliWarningF("Sketches in %s were filled with different anchor settings!", lFileName.Data() );
+                        lFile->Close();
+                        delete lFile;
+                        delete lFiles;
+                        return kFALSE;
+                    }
+                } else {
+                    lList->Add( lSketch );
+                }
+            }
+        }
+        lFile->Close();
+        delete lFile;
+    }
+    delete lFiles;
+    if ( lSketches.empty() ) {
+        AliWarning("No sketches found!");
+        return kFALSE;
+    }
+
+    Double_t lNrawBoundaries[1000];
+    Double_t lMiddleOfBins[1000];
+    for( Long_t lB=1; lB<lNDesiredBoundaries; lB++) {
+        //place squarely at the middle to ensure it's all fine
+        lMiddleOfBins[lB-1] = 0.5*(lDesiredBoundaries[lB]+lDesiredBoundaries[lB-1]);
+    }
+
+    TFile * f = new TFile (fOutputFileName.Data(), "recreate");
+    AliOADBContainer * oadbContMS = new AliOADBContainer("MultSel");
+
+    //Kept for the default object
+    AliMultSelection *lLastSelection = 0x0;
+    std::vector<TH1F*>    lLastCalib;
+    std::vector<Double_t> lLastAv;
+    Bool_t lDefaultSaved = kFALSE;
+
+    for(std::map<Int_t, TList*>::iterator it = lSketches.begin(); it != lSketches.end(); ++it) {
+        const Int_t lKey = it->first;
+        if ( !lAutoDiscover && lKey >= fNRunRanges ) {
+            AliWarningF("Sketches for unknown run range #%i, skipped", lKey);
+            continue;
+        }
+        AliMultSelection *lSel = lAutoDiscover ? fSelection : (AliMultSelection*) fMultSelectionList->At(lKey);
+        const Int_t lFirstRun = lAutoDiscover ? lKey : fFirstRun[lKey];
+        const Int_t lLastRun  = lAutoDiscover ? lKey : fLastRun [lKey];
+        cout<<"--- Processing run (range) "<<lFirstRun<<"-"<<lLastRun<<endl;
+
+        const Int_t lNEstimatorsThis = lSel->GetNEstimators();
+        std::vector<TH1F*>    hCalib(lNEstimatorsThis, (TH1F*)0x0);
+        std::vector<Double_t> lAvEst(lNEstimatorsThis, -1.);
+        Long64_t lRunStats = 0;
+
+        for(Int_t iEst=0; iEst<lNEstimatorsThis; iEst++) {
+            AliMultEstimator *lEst = lSel->GetEstimator(iEst);
+            AliMultQuantileSketch *lSketch = (AliMultQuantileSketch*) it->second->FindObject( lEst->GetName() );
+            const Long64_t ntot = lSketch ? lSketch->GetEntries() : 0;
+            if ( ntot > 0 ) lAvEst[iEst] = lSketch->GetMean();
+            lRunStats = ntot;
+            cout<<"--- "<<lEst->GetName()<<": N = "<<ntot<<", Min = "<<(lSketch?lSketch->GetMin():0)<<", Max = "<<(lSketch?lSketch->GetMax():0)<<", Av = "<<lAvEst[iEst]<<endl;
+
+            if( ! lEst->IsInteger() ) {
+                //==== Floating Point Calibration Engine ====
+                const Bool_t lInsane = ( ntot < 1 || TMath::Abs( lSketch->GetMin() - lSketch->GetMax() ) < 1e-6 );
+                if ( lInsane ) {
+                    //There was insufficient information to generate a meaningful calibration for this estimator!
+                    hCalib[iEst] = new TH1F(Form("hCalib_%i_%s",lFirstRun,lEst->GetName()),"",1,0,1);
+                    hCalib[iEst]->SetDirectory(0);
+                    hCalib[iEst]->SetBinContent(0,AliMultSelectionCuts::kNoCalib);
+                    hCalib[iEst]->SetBinContent(1,AliMultSelectionCuts::kNoCalib);
+                    hCalib[iEst]->SetBinContent(2,AliMultSelectionCuts::kNoCalib);
+                    continue;
+                }
+                Long64_t lAcceptedEvents = ntot;
+                if( lEst->GetUseAnchor() ){
+                    lAcceptedEvents = lSketch->GetNAboveThreshold();
+                    lRunStats = lAcceptedEvents;
+                }
+                lNrawBoundaries[0] = 0.0; //Defined OK even if anchored
+                //Overwrite lower boundary in case this has a negative minimum...
+                if ( lSketch->GetMin() < 0 ) lNrawBoundaries[0] = lSketch->GetMin();
+
+                for( Long_t lB=1; lB<lNDesiredBoundaries; lB++) {
+                    Long64_t position = (Long64_t) ( 0.01 * ((Double_t)(ntot)* lDesiredBoundaries[lB] ) );
+                    if( lEst->GetUseAnchor() ){
+                        //Make sure index position lAnchorEst corresponds to lAnchorPercentile
+                        Double_t lAnchorPercentile = (Double_t) lEst->GetAnchorPercentile();
+                        Double_t lFractionAccepted = (((Double_t) lAcceptedEvents )/((Double_t) ntot));
+                        Double_t lScalingFactor    = lFractionAccepted/((0.01)*lAnchorPercentile);
+                        position = (Long64_t) ( ( 0.01 * ((Double_t)(ntot)* lDesiredBoundaries[lB] ) ) * lScalingFactor );
+                    }
+                    if(position > ntot-1 ) position = ntot-1; //protection !
+                    //position counts from the largest value
+                    lNrawBoundaries[lB] = lSketch->GetValueAtRank( ntot-1-position );
+                }
+                //Cross-check correct rejection of anything beyond anchor point
+                if( lEst->GetUseAnchor() ){
+                    for( Long_t lB=0; lB<lNDesiredBoundaries-1; lB++) {
+                        if (lNrawBoundaries[lB+1]>lEst->GetAnchorPoint() && lNrawBoundaries[lB]<lEst->GetAnchorPoint()){
+                            //This is the threshold, should actually be identical to anchor point please
+                            lNrawBoundaries[lB] = lEst->GetAnchorPoint();
+                        }
+                    }
+                }
+                hCalib[iEst] = new TH1F(Form("hCalib_%i_%s",lFirstRun,lEst->GetName()),"",lNDesiredBoundaries-1,lNrawBoundaries);
+                hCalib[iEst]->SetDirectory(0);
+                hCalib[iEst]->SetBinContent(0,100.5); //Just in case correction functions screw up the values ...
+                for(Long_t ibin=1; ibin<hCalib[iEst]->GetNbinsX()+1; ibin++){
+                    hCalib[iEst] -> SetBinContent(ibin, lMiddleOfBins[ibin-1]);
+                    //override in case anchored!
+                    if( lEst->GetUseAnchor() && hCalib[iEst]->GetBinCenter(ibin) < lEst->GetAnchorPoint() )
+                        hCalib[iEst] -> SetBinContent(ibin, 100.5);
+                }
+                //==== End Floating Point Calibration Engine ====
+            } else {
+                //==== Integer Value Calibration Engine ====
+                if( ntot < 1 ) {
+                    //Case of an empty run!
+                    hCalib[iEst] = new TH1F(Form("hCalib_%i_%s",lFirstRun,lEst->GetName()),"",1,0,1);
+                    hCalib[iEst]->SetDirectory(0);
+                    continue;
+                }
+                const Long_t lNBins    = lSketch->GetMax()-lSketch->GetMin()+1;
+                Float_t lLowEdge = lSketch->GetMin()-0.5;
+                Float_t lHighEdge= lSketch->GetMax()+0.5;
+                TH1F *hTemporary = new TH1F("hTemporary", "", lNBins, lSketch->GetMin()-0.5, lSketch->GetMax()+0.5 );
+                hTemporary->SetDirectory(0);
+                //Exact value counts
+                for(Int_t iC=0; iC<lSketch->GetNCentroids(); iC++)
+                    hTemporary->Fill( lSketch->GetCentroidMean(iC), lSketch->GetCentroidWeight(iC) );
+                hTemporary->Scale(1./((double)(ntot)));
+
+                std::vector<Float_t> lBoundaries(lNBins+1); //to store cumulative function
+                lBoundaries[0] = 0;
+                for(Long_t iB=1; iB<hTemporary->GetNbinsX()+1; iB++) {
+                    lBoundaries[iB] = lBoundaries[iB-1]+hTemporary->GetBinContent(iB);
+                }
+                hCalib[iEst] = new TH1F(Form("hCalib_%i_%s",lFirstRun,lEst->GetName()),"",lNBins,lLowEdge,lHighEdge);
+                hCalib[iEst]->SetDirectory(0);
+                for(Long_t ibin=1; ibin<hCalib[iEst]->GetNbinsX()+1; ibin++) hCalib[iEst] -> SetBinContent(ibin, 100.0-50.0*(lBoundaries[ibin-1]+lBoundaries[ibin]));
+                delete hTemporary;
+            }
+        }
+
+        //Protection against saving a calibration object that has been acquired
+        //with insufficient statistics
+        if ( lRunStats > 1000 ) {
+            oadbContMS->AppendObject( CreateOADBObject(0x0, lSel, &hCalib[0], &lAvEst[0]), lFirstRun, lLastRun );
+        } else {
+            AliWarningF("Run (range) %i-%i: only %lld events, not saved", lFirstRun, lLastRun, lRunStats);
+        }
+        if ( fRunToUseAsDefault >= 0 && lFirstRun <= fRunToUseAsDefault && fRunToUseAsDefault <= lLastRun ) {
+            cout<<" Detected that this particular run / run range is special, will save it as default"<<endl;
+            oadbContMS->AddDefaultObject( CreateOADBObject("Default", lSel, &hCalib[0], &lAvEst[0]) );
+            lDefaultSaved = kTRUE;
+        }
+
+        for(UInt_t iEst=0; iEst<lLastCalib.size(); iEst++) delete lLastCalib[iEst];
+        lLastSelection = lSel;
+        lLastCalib     = hCalib;
+        lLastAv        = lAvEst;
+    }
+    if( !lDefaultSaved && lLastSelection ){
+        cout<<" Warning: default object corresponds to the last calibrated run!"<<endl;
+        oadbContMS->AddDefaultObject( CreateOADBObject("Default", lLastSelection, &lLastCalib[0], &lLastAv[0]) );
+    }
+    for(UInt_t iEst=0; iEst<lLastCalib.size(); iEst++) delete lLastCalib[iEst];
+    for(std::map<Int_t, TList*>::iterator it = lSketches.begin(); it != lSketches.end(); ++it) delete it->second;
+
+    cout<<"All done, will write OADB..."<<endl;
+    f->cd();
+    oadbContMS->Write();
+    f->Close();
+    cout<<" Done!"<<endl;
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultSelectionCalibrator::ValidateCalibration( TString lExactFile, TString lSketchCalibFile, Double_t lTolerance ) {
+    // Validation report: compares the boundaries of two calibration OADB
+    // files, typically Calibrate() and CalibrateFromSketches() outputs
+    // made with the same boundaries (SetBoundaries) and estimators.
+    //
+    // For floating point estimators each boundary of the sketch calibration
+    // is converted to a percentile with the exact calibration (linear
+    // interpolation between the exact boundaries); the deviation from the
+    // requested percentile is reported. Integer estimators are compared
+    // bin by bin. Returns kFALSE if any deviation exceeds lTolerance (%).
+
+    TFile *lFileExact  = TFile::Open( lExactFile.Data(), "READ");
+    TFile *lFileSketch = TFile::Open( lSketchCalibFile.Data(), "READ");
+    if ( !lFileExact || !lFileSketch ) {
+        AliWarning("Calibration file(s) not found!");
+        return kFALSE;
+    }
+    AliOADBContainer *lContExact  = (AliOADBContainer*) lFileExact ->Get("MultSel");
+    AliOADBContainer *lContSketch = (AliOADBContainer*) lFileSketch->Get("MultSel");
+    if ( !lContExact || !lContSketch ) {
+        AliWarning("MultSel container(s) not found!");
+        return kFALSE;
+    }
+
+    cout<<"=== VALIDATION: "<<lSketchCalibFile.Data()<<" vs "<<lExactFile.Data()<<" (tolerance "<<lTolerance<<"%) ==="<<endl;
+    Bool_t lAllGood = kTRUE;
+    Double_t lWorst = 0;
+    for(Int_t k=0; k<lContSketch->GetNumberOfEntries(); k++) {
+        const Int_t lRun = lContSketch->LowerLimit(k);
+        AliOADBMultSelection *lSketchOADB = (AliOADBMultSelection*) lContSketch->GetObjectByIndex(k);
+        AliOADBMultSelection *lExactOADB  = (AliOADBMultSelection*) lContExact->GetObject(lRun);
+        if ( !lExactOADB ) {
+            cout<<" Run "<<lRun<<": no exact calibration, skipped"<<endl;
+            continue;
+        }
+        AliMultSelection *lSel = lSketchOADB->GetMultSelection();
+        for(Long_t iEst=0; iEst<lSel->GetNEstimators(); iEst++) {
+            TString lName = Form("hCalib_%s", lSel->GetEstimator(iEst)->GetName());
+            TH1F *hSketch = lSketchOADB->GetCalibHisto(lName);
+            TH1F *hExact  = lExactOADB ->GetCalibHisto(lName);
+            if ( !hSketch || !hExact ) continue;
+            const Int_t lNBins = hSketch->GetNbinsX();
+            Double_t lMaxDev = 0;
+            Double_t lMaxDevAt = 0;
+            if ( lSel->GetEstimator(iEst)->IsInteger() || lNBins != lNDesiredBoundaries-1 || hExact->GetNbinsX() != lNBins ) {
+                //bin by bin (integer estimators, kNoCalib)
+                for(Int_t ibin=1; ibin<=lNBins; ibin++) {
+                    const Double_t lDev = TMath::Abs( hSketch->GetBinContent(ibin) - hExact->GetBinContent(hExact->FindBin(hSketch->GetBinCenter(ibin))) );
+                    if ( lDev > lMaxDev ) { lMaxDev = lDev; lMaxDevAt = hSketch->GetBinContent(ibin); }
+                }
+            } else {
+                const Double_t *lEdgesExact  = hExact ->GetXaxis()->GetXbins()->GetArray();
+                const Double_t *lEdgesSketch = hSketch->GetXaxis()->GetXbins()->GetArray();
+                if ( !lEdgesExact || !lEdgesSketch ) continue;
+                for(Long_t lB=1; lB<lNDesiredBoundaries; lB++) {
+                    //percentile of the sketch boundary according to the exact boundaries
+                    const Double_t x = lEdgesSketch[lB];
+                    Double_t lPercentile = lDesiredBoundaries[lNDesiredBoundaries-1];
+                    if ( x <= lEdgesExact[0] ) lPercentile = lDesiredBoundaries[0];
+                    for(Long_t j=0; j<lNDesiredBoundaries-1; j++) {
+                        if ( x < lEdgesExact[j] || x > lEdgesExact[j+1] ) continue;
+                        const Double_t lWidth = lEdgesExact[j+1]-lEdgesExact[j];
+                        lPercentile = lDesiredBoundaries[j];
+                        if ( lWidth > 0 ) lPercentile += (lDesiredBoundaries[j+1]-lDesiredBoundaries[j])*(x-lEdgesExact[j])/lWidth;
+                        break;
+                    }
+                    const Double_t lDev = TMath::Abs( lPercentile - lDesiredBoundaries[lB] );
+                    if ( lDev > lMaxDev ) { lMaxDev = lDev; lMaxDevAt = lDesiredBoundaries[lB]; }
+                }
+            }
+            const Bool_t lGood = ( lMaxDev <= lTolerance );
+            if ( !lGood ) lAllGood = kFALSE;
+            if ( lMaxDev > lWorst ) lWorst = lMaxDev;
+            cout<<" Run "<<lRun<<" "<<lSel->GetEstimator(iEst)->GetName()<<": max deviation "<<lMaxDev<<"% (at "<<lMaxDevAt<<"%)"<<(lGood?"":" <-- above tolerance")<<endl;
+        }
+    }
+    cout<<"=== Largest deviation: "<<lWorst<<"%, "<<(lAllGood?"all within tolerance":"TOLERANCE EXCEEDED")<<" ==="<<endl;
+    lFileExact->Close();
+    lFileSketch->Close();
+    return lAllGood;
+}
+//________________________________________________________________
 Float_t AliMultSelectionCalibrator::MinVal( Float_t A, Float_t B ) {
     if( A < B ) {
         return A;
@@ -9,6 +9,11 @@
 
 using namespace std;
 class AliESDEvent;
+class AliOADBMultSelection;
+class TH1F;
+class TFile;
+class TTree;
+class AliMultVariable;
 class AliMultSelectionCalibrator : public TNamed {
     
 public:
@@ -77,10 +82,31 @@ public:
     //Master Function in this Class: To be called once filenames are set
     Bool_t Calibrate();
     
+    //_________________________________________________________________________
+    //Single-pass calibration with mergeable quantile sketches
+    //(no buffer file, no sorting). Typical use:
+    // - FillSketches() once per input file shard (own sketch file each)
+    // - CalibrateFromSketches() with all sketch files, comma-separated
+    //   (or a single file merged with hadd)
+    // - ValidateCalibration() against an exact Calibrate() output
+    void SetSketchFile ( TString lFile ) { fSketchFileName = lFile.Data(); }
+    void SetSketchCompression ( Double_t lVal ) { fSketchCompression = lVal; }
+    Double_t GetSketchCompression () const { return fSketchCompression; }
+    Bool_t FillSketches();
+    Bool_t CalibrateFromSketches();
+    Bool_t CalibrateStreaming() { return FillSketches() && CalibrateFromSketches(); }
+    //Percentile deviation of all boundaries, kFALSE if above lTolerance (in %)
+    Bool_t ValidateCalibration ( TString lExactFile, TString lSketchCalibFile, Double_t lTolerance = 0.1 );
+    
     //Helper
     Float_t MinVal( Float_t A, Float_t B );
     
 private:
+    AliOADBMultSelection *CreateOADBObject( const char *lName, AliMultSelection *lSel, TH1F **lCalib, const Double_t *lAv ) const;
+    //Input tree and event selection shared by Calibrate() and FillSketches()
+    Bool_t OpenInputTree();
+    Bool_t IsSelectedEvent( AliMultVariable *lVtxZ ) const;
+    
     AliMultInput     *fInput;     //Object for all input
     AliMultSelection *fSelection; //(current) transient pointer object
 
@@ -108,6 +134,8 @@ private:
     TString fInputFileName;  // Filename for TTree object for calibration purposes
     TString fBufferFileName; // Filename for TTree object (buffer file)
     TString fOutputFileName; // Filename for calibration OADB output
+    TString fSketchFileName; // Filename for quantile sketches (single-pass mode)
+    Double_t fSketchCompression; // Compression of the quantile sketches
     
     // Object for storing event selection configuration
     AliMultSelectionCuts *fMultSelectionCuts;
@@ -115,10 +143,27 @@ private:
     // TList object for storing histograms
     TList *fCalibHists; 
 
-    ClassDef(AliMultSelectionCalibrator, 2);
+    //Input tree and its event selection variables (OpenInputTree)
+    TFile   *fInputFile;                      //! input file
+    TTree   *fTree;                           //! fTreeEvent of the input file
+    Bool_t   fEvSel_IsNotPileupInMultBins;    //!
+    Bool_t   fEvSel_Triggered;                //!
+    Bool_t   fEvSel_INELgtZERO;               //!
+    Bool_t   fEvSel_PassesTrackletVsCluster;  //!
+    Bool_t   fEvSel_HasNoInconsistentVertices;//!
+    Bool_t   fEvSel_IsNotAsymmetricInVZERO;   //!
+    Bool_t   fEvSel_IsNotIncompleteDAQ;       //!
+    Bool_t   fEvSel_HasGoodVertex2016;        //!
+    Int_t    fRunNumber;                      //!
+    Int_t    fnContributors;                  //!
+    UInt_t   fEvSel_TriggerMask;              //! save full info for checking later
+    TString *fFiredTriggerClasses;            //!
+
+    ClassDef(AliMultSelectionCalibrator, 3);
     //(this classdef is only for bookkeeping, class will not usually
     // be streamed according to current workflow except in very specific
     // tests!) 
     //2 - Adjustments of extra event selections
+    //3 - Single-pass calibration with quantile sketches
 };
 #endif
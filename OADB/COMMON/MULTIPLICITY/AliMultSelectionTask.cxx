@@ -1801,24 +1801,22 @@ void AliMultSelectionTask::UserExec(Option_t *)
         fEvSelCode = lSelection->GetEvSelCode();
         
         //Determine Quantiles from calibration histogram
-        TH1F *lThisCalibHisto = 0x0;
-        TString lThisCalibHistoName;
+        //(look-up tables prepared from hCalib_<estimator> at run setup)
+        AliMultEstimator *lThisEstimator = 0x0;
         Float_t lThisQuantile = -1;
-        for(Long_t iEst=0; iEst<lSelection->GetNEstimators(); iEst++) {
+        TIter lNextEstimator(lSelection->GetEstimatorList());
+        for(Long_t iEst=0; (lThisEstimator = static_cast<AliMultEstimator*>(lNextEstimator())); iEst++) {
             //Changed: no need for run number, object already matches required one
-            lThisCalibHistoName = Form("hCalib_%s",lSelection->GetEstimator(iEst)->GetName());
-            lThisCalibHisto = 0x0;
-            lThisCalibHisto = fOadbMultSelection->GetCalibHisto( lThisCalibHistoName );
-            if ( ! lThisCalibHisto ) {
+            if ( ! lThisEstimator->HasCalibration() ) {
                 lThisQuantile = AliMultSelectionCuts::kNoCalib;
                 if( iEst < fNDebug ) fQuantiles[iEst] = lThisQuantile;
-                lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
+                lThisEstimator->SetPercentile(lThisQuantile);
             } else {
-                lThisQuantile = lThisCalibHisto->GetBinContent( lThisCalibHisto->FindBin( lSelection->GetEstimator(iEst)->GetValue() ));
+                lThisQuantile = lThisEstimator->GetCalibratedPercentile( lThisEstimator->GetValue() );
                 if( iEst < fNDebug ) {
                     fQuantiles[iEst] = lThisQuantile; //Debug, please
                 }
-                lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
+                lThisEstimator->SetPercentile(lThisQuantile);
             }
         }
         
@@ -243,6 +243,8 @@ void AliOADBMultSelection::Setup()
         
         TString name(Form("hCalib_%s", e->GetName()));
         TH1F*   h = GetCalibHisto(name);
+        //Percentile look-up table (none if not calibrated)
+        e->SetupCalibration(h);
         if (!h) continue;
         
         fMap->Add(e, h);
@@ -37,6 +37,7 @@
 #pragma link C++ class AliMultSelectionTask+;
 #pragma link C++ class AliMultSelectionCalibrator+;
 #pragma link C++ class AliMultSelectionCalibratorMC+;
+#pragma link C++ class AliMultQuantileSketch+;
 #pragma link C++ class AliMultGlauberNBDFitter+;
 
 #endif
@@ -26,6 +26,8 @@
 #include <TMath.h>
 #include <TRandom.h>
 #include <TChain.h>
+#include <TChainElement.h>
+#include <TEnv.h>
 #include <TGrid.h>
 #include <TGridResult.h>
 #include <TSystem.h>
@@ -169,7 +171,13 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fTreeCacheSize(-1),
+  fTreeCacheBranches(),
+  fAsyncPrefetching(false),
+  fPreOpenNextFile(false),
+  fTreeCacheConfigured(false),
+  fPreOpenedFilename("")
 {
   if (fgInstance != nullptr) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -243,7 +251,13 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fTreeCacheSize(-1),
+  fTreeCacheBranches(),
+  fAsyncPrefetching(false),
+  fPreOpenNextFile(false),
+  fTreeCacheConfigured(false),
+  fPreOpenedFilename("")
 {
   if (fgInstance != 0) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -328,6 +342,10 @@ void AliAnalysisTaskEmcalEmbeddingHelper::RetrieveTaskPropertiesFromYAMLConfig()
   res = fYAMLConfig.GetProperty("randomFileAccess", fRandomFileAccess, false);
   res = fYAMLConfig.GetProperty("createHisto", fCreateHisto, false);
   res = fYAMLConfig.GetProperty("printTimingInfoInLog", fPrintTimingInfoToLog, false);
+  res = fYAMLConfig.GetProperty("treeCacheSize", fTreeCacheSize, false);
+  res = fYAMLConfig.GetProperty("treeCacheBranches", fTreeCacheBranches, false);
+  res = fYAMLConfig.GetProperty("asyncPrefetching", fAsyncPrefetching, false);
+  res = fYAMLConfig.GetProperty("preOpenNextFile", fPreOpenNextFile, false);
   // More general embedding helper properties
   res = fYAMLConfig.GetProperty("filePattern", fFilePattern, false);
   res = fYAMLConfig.GetProperty("inputFilename", fInputFilename, false);
@@ -1323,6 +1341,15 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
     AliErrorStream() << "Number of input files (" << fFilenames.size() << ") is larger than the number of available files (" << fMaxNumberOfFiles << "). Something went wrong when adding some of those files to the TChain!\n";
   }
 
+  // Setup the read ahead of the chain. Must happen before the first entry is loaded, as the
+  // prefetching setting is only picked up when the cache of a file is created.
+  if (fAsyncPrefetching) {
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+  }
+  if (fTreeCacheSize >= 0) {
+    fChain->SetCacheSize(fTreeCacheSize);
+  }
+
   // Setup input event
   Bool_t res = InitEvent();
   if (!res) return kFALSE;
@@ -1330,6 +1357,51 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
   return kTRUE;
 }
 
+/**
+ * Restricts the TTreeCache of the chain to the branches given by the user. The cache of the
+ * chain is kept when moving to the next file, so this only needs to be done once, after the
+ * first tree has been loaded. If no branches are given, the cache keeps learning which
+ * branches are read during the first entries, such that only those are prefetched.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::ConfigureTreeCache()
+{
+  fTreeCacheConfigured = true;
+
+  if (fTreeCacheBranches.size() == 0 || !fChain->GetCacheSize()) {
+    return;
+  }
+
+  for (auto branch : fTreeCacheBranches)
+  {
+    AliDebugStream(2) << "Adding branch \"" << branch << "\" to the cache of the embedded input chain.\n";
+    fChain->AddBranchToCache(branch.c_str(), kTRUE);
+  }
+  fChain->StopCacheLearningPhase();
+}
+
+/**
+ * Opens the file following the current one in the chain asynchronously, such that the file
+ * is ready (in particular on AliEn) when InitTree() moves to it. TChain picks up the pending
+ * handle when it opens the file under the same name.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::PreOpenNextFile()
+{
+  Int_t nextTreeNumber = fChain->GetTreeNumber() + 1;
+  if (nextTreeNumber <= 0 || nextTreeNumber >= fChain->GetListOfFiles()->GetEntries()) {
+    return;
+  }
+
+  TChainElement * element = static_cast<TChainElement *>(fChain->GetListOfFiles()->At(nextTreeNumber));
+  std::string filename = element->GetTitle();
+  if (filename == fPreOpenedFilename) {
+    return;
+  }
+
+  AliDebugStream(2) << "Opening the next file of the embedded input chain \"" << filename << "\" asynchronously.\n";
+  TFile::AsyncOpen(filename.c_str());
+  fPreOpenedFilename = filename;
+}
+
 /**
  * Check if the file pythia base filename can be found in the folder or archive corresponding where
  * the external event input file is found.
@@ -1442,6 +1514,14 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   // next tree (in the next file) since entries are indexed starting from 0.
   fChain->GetEntry(fUpperEntry);
 
+  // Restrict the cache to the requested branches and start opening the following file
+  if (!fTreeCacheConfigured) {
+    ConfigureTreeCache();
+  }
+  if (fPreOpenNextFile) {
+    PreOpenNextFile();
+  }
+
   // Determine tree size and current entry
   // Set the limits of the new tree
   fLowerEntry = fUpperEntry;
@@ -1889,6 +1969,12 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "File list filename: \"" << fFileListFilename << "\"\n";
   tempSS << "Tree name: " << fTreeName << "\n";
   tempSS << "Print timing info to log: " << fPrintTimingInfoToLog << "\n";
+  tempSS << "Tree cache size: " << fTreeCacheSize << "\n";
+  tempSS << "Tree cache branches: ";
+  for (auto branch : fTreeCacheBranches) { tempSS << "\"" << branch << "\" "; }
+  tempSS << "\n";
+  tempSS << "Async prefetching: " << fAsyncPrefetching << "\n";
+  tempSS << "Pre-open next file: " << fPreOpenNextFile << "\n";
   tempSS << "Random event number access: " << fRandomEventNumberAccess << "\n";
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
@@ -116,6 +116,10 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Int_t GetStartingFileIndex()                              const { return fFilenameIndex; }
   TString GetFileListFilename()                             const { return fFileListFilename; }
   bool GetCreateHistos()                                    const { return fCreateHisto; }
+  Long64_t GetTreeCacheSize()                               const { return fTreeCacheSize; }
+  std::vector<std::string> GetTreeCacheBranches()           const { return fTreeCacheBranches; }
+  bool GetAsyncPrefetching()                                const { return fAsyncPrefetching; }
+  bool GetPreOpenNextFile()                                 const { return fPreOpenNextFile; }
 
   // Set
   /// Set the pt hard bin which will be added into the file pattern. Can also be omitted and set directly in the pattern.
@@ -128,6 +132,14 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetAOD(const char * treeName = "aodTree")                  { fTreeName     = treeName; }
   /// Set whether to print and plot execution time of InitTree()
   void SetPrintTimingInfoToLog(bool b)                            { fPrintTimingInfoToLog = b;}
+  /// Set the size (in bytes) of the TTreeCache of the external event chain. -1 keeps the ROOT default, 0 disables the cache.
+  void SetTreeCacheSize(Long64_t size)                            { fTreeCacheSize = size; }
+  /// Restrict the TTreeCache to the given branches (wildcards allowed). If empty, the cache learns the branches which are read.
+  void SetTreeCacheBranches(const std::vector<std::string> & branches) { fTreeCacheBranches = branches; }
+  /// Set whether the TTreeCache baskets are read ahead in a background thread (sets TFile.AsyncPrefetching for the whole process)
+  void SetAsyncPrefetching(bool b)                                { fAsyncPrefetching = b; }
+  /// Set whether the next file of the chain is opened asynchronously while the current one is being embedded
+  void SetPreOpenNextFile(bool b)                                 { fPreOpenNextFile = b; }
   /**
    * Enable to begin embedding at a random entry in each embedded file. Will then loop around in order
    * so that all entries are made available.
@@ -299,6 +311,8 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   virtual Bool_t  CheckIsEmbeddedEventSelected();
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
+  void            ConfigureTreeCache()  ;
+  void            PreOpenNextFile()     ;
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
   // Validation helper
   void            ValidatePhysicsSelectionForInternalEventSelection();
@@ -375,6 +389,13 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   bool                                          fPrintTimingInfoToLog; ///< Flag to print time to execute InitTree(), for logging purposes
   TStopwatch                                    fTimer            ;    //!<! Timer for the InitTree() function
 
+  Long64_t                                      fTreeCacheSize    ; ///< Size of the TTreeCache of the external event chain (-1: ROOT default)
+  std::vector<std::string>                      fTreeCacheBranches; ///< Branches to be cached. If empty, the cache learns them from the first entries
+  bool                                          fAsyncPrefetching ; ///< Read ahead the baskets of the TTreeCache in a background thread
+  bool                                          fPreOpenNextFile  ; ///< Open the next file of the chain asynchronously
+  bool                                          fTreeCacheConfigured; //!<! Whether the cached branches have been set
+  std::string                                   fPreOpenedFilename; //!<! Name of the file which was last opened asynchronously
+
   static AliAnalysisTaskEmcalEmbeddingHelper   *fgInstance        ; //!<! Global instance of this class
 
  private:
@@ -382,7 +403,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 12);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 13);
   /// \endcond
 };
 #endif
@@ -863,22 +863,27 @@ void AliFlowAnalysisWithMultiparticleCorrelations::CalculateEtaGaps(AliFlowEvent
  Double_t dPhi=0.,dPt=0.,dEta=0.;
  Double_t wPhi=1.,wPt=1.,wEta=1.;
  Double_t wToPowerP=1.;
+ anEvent->FillTrackStore(); // flat phi, pt, eta and flags of all tracks
+ const Double_t *storePhi = anEvent->GetStorePhi();
+ const Double_t *storePt = anEvent->GetStorePt();
+ const Double_t *storeEta = anEvent->GetStoreEta();
  for(Int_t t=0;t<nTracks;t++) // loop over all tracks
  {
-  AliFlowTrackSimple *pTrack = anEvent->GetTrack(t);
-  if(!pTrack){printf("\n pTrack is NULL in MPC::CalculateEtaGaps(AliFlowEventSimple *anEvent) !!!!"); continue;}
-  if(!(pTrack->InRPSelection() || pTrack->InPOISelection())){printf("\n pTrack is neither RP nor POI !!!!"); continue;}
+  Int_t iTrack = anEvent->TrackStoreIndex(t);
+  if(iTrack<0){printf("\n pTrack is NULL in MPC::CalculateEtaGaps(AliFlowEventSimple *anEvent) !!!!"); continue;}
+  Bool_t bRP = anEvent->StoreInRPSelection(iTrack);
+  if(!(bRP || anEvent->StoreInPOISelection(iTrack))){printf("\n pTrack is neither RP nor POI !!!!"); continue;}
 
-  if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
+  if(bRP) // fill Q-vector components only with reference particles
   {
    // Access kinematic variables for RP and corresponding weights:
-   dPhi = pTrack->Phi(); // azimuthal angle
+   dPhi = storePhi[iTrack]; // azimuthal angle
    if(fUseWeights[0][0]){wPhi = Weight(dPhi,"RP","phi");} // corresponding phi weight
    //if(dPhi < 0.){dPhi += TMath::TwoPi();} TBI
    //if(dPhi > TMath::TwoPi()){dPhi -= TMath::TwoPi();} TBI
-   dPt = pTrack->Pt();
+   dPt = storePt[iTrack];
    if(fUseWeights[0][1]){wPt = Weight(dPt,"RP","pt");} // corresponding pT weight
-   dEta = pTrack->Eta();
+   dEta = storeEta[iTrack];
    if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
    if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]){wToPowerP = wPhi*wPt*wEta;}
    // Calculate Qa and Qb vectors:
@@ -886,11 +891,12 @@ void AliFlowAnalysisWithMultiparticleCorrelations::CalculateEtaGaps(AliFlowEvent
    {
     for(Int_t h=fLowestHarmonicEtaGaps-1;h<=fHighestHarmonicEtaGaps-1;h++)
     {
+     TComplex wQ(wToPowerP*TMath::Cos((h+1)*dPhi),wToPowerP*TMath::Sin((h+1)*dPhi)); // same for all eta gaps
      for(Int_t eg=0;eg<11;eg++) // eta gaps
      {  
       if(dEta<-1.*dEtaGaps[eg]/2.)  
       {
-       Qa[h][eg] += TComplex(wToPowerP*TMath::Cos((h+1)*dPhi),wToPowerP*TMath::Sin((h+1)*dPhi));
+       Qa[h][eg] += wQ;
        Ma[h][eg]+=wToPowerP;
       } 
      } // for(Int_t eg=0;eg<11;eg++) // eta gaps
@@ -900,17 +906,18 @@ void AliFlowAnalysisWithMultiparticleCorrelations::CalculateEtaGaps(AliFlowEvent
    {
     for(Int_t h=fLowestHarmonicEtaGaps-1;h<=fHighestHarmonicEtaGaps-1;h++)
     {
+     TComplex wQ(wToPowerP*TMath::Cos((h+1)*dPhi),wToPowerP*TMath::Sin((h+1)*dPhi)); // same for all eta gaps
      for(Int_t eg=0;eg<11;eg++) // eta gaps
      {  
       if(dEta>dEtaGaps[eg]/2.)  
       {
-       Qb[h][eg] += TComplex(wToPowerP*TMath::Cos((h+1)*dPhi),wToPowerP*TMath::Sin((h+1)*dPhi));
+       Qb[h][eg] += wQ;
        Mb[h][eg]+=wToPowerP;
       } 
      } // for(Int_t eg=0;eg<11;eg++) // eta gaps
     } // for(Int_t h=fLowestHarmonicEtaGaps-1;h<=fHighestHarmonicEtaGaps-1;h++)
    }
-  } // if(pTrack->InRPSelection())
+  } // if(bRP)
  } // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
 
  // Calculate 2-p correlations with eta gaps from Qa and Qb vectors:
@@ -1283,9 +1290,16 @@ Bool_t AliFlowAnalysisWithMultiparticleCorrelations::TrackIsInSpecifiedIntervals
 
  if(!pTrack){exit(0);} // TBI
 
- Double_t dPhi = pTrack->Phi();
- Double_t dPt = pTrack->Pt();
- Double_t dEta = pTrack->Eta();
+ return TrackIsInSpecifiedIntervals(pTrack->Phi(),pTrack->Pt(),pTrack->Eta());
+
+} // Bool_t AliFlowAnalysisWithMultiparticleCorrelations::TrackIsInSpecifiedIntervals(AliFlowTrackSimple *pTrack)
+
+//=======================================================================================================================
+
+Bool_t AliFlowAnalysisWithMultiparticleCorrelations::TrackIsInSpecifiedIntervals(Double_t dPhi, Double_t dPt, Double_t dEta)
+{
+ // Same as above, for kinematics taken from the event's track store.
+
  Double_t dPhiPtEta[3] = {dPhi,dPt,dEta};
 
  // Skip some intervals: TBI promote eventually to AFTC class 
@@ -1306,7 +1320,7 @@ Bool_t AliFlowAnalysisWithMultiparticleCorrelations::TrackIsInSpecifiedIntervals
 
  return bPasses;  
 
-} // Bool_t AliFlowAnalysisWithMultiparticleCorrelations::TrackIsInSpecifiedIntervals(AliFlowTrackSimple *pTrack)
+} // Bool_t AliFlowAnalysisWithMultiparticleCorrelations::TrackIsInSpecifiedIntervals(Double_t dPhi, Double_t dPt, Double_t dEta)
 
 //=======================================================================================================================
 
@@ -2000,26 +2014,33 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
  Double_t dPt = 0., wPt = 1.; // transverse momentum and corresponding pT weight
  Double_t dEta = 0., wEta = 1.; // pseudorapidity and corresponding eta weight
  Double_t wToPowerP = 1.; // weight raised to power p
+ Double_t dCos = 0., dSin = 0.; // cos(h*phi) and sin(h*phi), shared by all weight powers
  Int_t nCounterRPs = 0;
+ anEvent->FillTrackStore(); // flat phi, pt, eta and flags of all tracks
+ const Double_t *storePhi = anEvent->GetStorePhi();
+ const Double_t *storePt = anEvent->GetStorePt();
+ const Double_t *storeEta = anEvent->GetStoreEta();
  for(Int_t t=0;t<nTracks;t++) // loop over all tracks
  {
-  AliFlowTrackSimple *pTrack = NULL;
+  Int_t iTrack = -1; // index in the track store
   if(!fSelectRandomlyRPs) // TBI hw RPs
   {
-   pTrack = anEvent->GetTrack(t);
+   iTrack = anEvent->TrackStoreIndex(t);
   }
   else
   {
-   pTrack = anEvent->GetTrack((Int_t)fRandomIndicesRPs->GetAt(t));
+   iTrack = anEvent->TrackStoreIndex((Int_t)fRandomIndicesRPs->GetAt(t));
   }
 
-  if(!pTrack){printf("\n Error: pTrack is NULL in MPC::FillQvector(...) !!!!"); continue;}
+  if(iTrack<0){printf("\n Error: pTrack is NULL in MPC::FillQvector(...) !!!!"); continue;}
 
-  if(!TrackIsInSpecifiedIntervals(pTrack)){continue;} // TBI tmp gym
+  if(!TrackIsInSpecifiedIntervals(storePhi[iTrack],storePt[iTrack],storeEta[iTrack])){continue;} // TBI tmp gym
 
-  if(!(pTrack->InRPSelection() || pTrack->InPOISelection())){printf("\n Error: pTrack is neither RP nor POI !!!!"); continue;}
+  Bool_t bRP = anEvent->StoreInRPSelection(iTrack);
+  Bool_t bPOI = anEvent->StoreInPOISelection(iTrack);
+  if(!(bRP || bPOI)){printf("\n Error: pTrack is neither RP nor POI !!!!"); continue;}
 
-  if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
+  if(bRP) // fill Q-vector components only with reference particles
   {
    nCounterRPs++;
    if(fSelectRandomlyRPs && nCounterRPs == fnSelectedRandomlyRPs){break;} // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
@@ -2027,40 +2048,42 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
    wPhi = 1.; wPt = 1.; wEta = 1.; wToPowerP = 1.; // TBI this shall go somewhere else, for performance sake
 
    // Access kinematic variables for RP and corresponding weights:
-   dPhi = pTrack->Phi(); // azimuthal angle
+   dPhi = storePhi[iTrack]; // azimuthal angle
    if(fUseWeights[0][0]){wPhi = Weight(dPhi,"RP","phi");} // corresponding phi weight
    //if(dPhi < 0.){dPhi += TMath::TwoPi();} TBI
    //if(dPhi > TMath::TwoPi()){dPhi -= TMath::TwoPi();} TBI
-   dPt = pTrack->Pt();
+   dPt = storePt[iTrack];
    if(fUseWeights[0][1]){wPt = Weight(dPt,"RP","pt");} // corresponding pT weight
-   dEta = pTrack->Eta();
+   dEta = storeEta[iTrack];
    if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
 
    // Calculate Q-vector components:
    for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
    {
+    dCos = TMath::Cos(h*dPhi);
+    dSin = TMath::Sin(h*dPhi);
     for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
     {
      if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fQvector[h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
+     fQvector[h][wp] += TComplex(wToPowerP*dCos,wToPowerP*dSin);
     } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
    } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
-  } // if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
+  } // if(bRP) // fill Q-vector components only with reference particles
 
   // Differential Q-vectors (a.k.a. p-vector and q-vector):
   if(!fCalculateDiffQvectors){continue;}
-  if(pTrack->InPOISelection()) 
+  if(bPOI) 
   {
    wPhi = 1.; wPt = 1.; wEta = 1.; wToPowerP = 1.; // TBI this shall go somewhere else, for performance sake
 
    // Access kinematic variables for POI and corresponding weights:
-   dPhi = pTrack->Phi(); // azimuthal angle
+   dPhi = storePhi[iTrack]; // azimuthal angle
    if(fUseWeights[1][0]){wPhi = Weight(dPhi,"POI","phi");} // corresponding phi weight
    //if(dPhi < 0.){dPhi += TMath::TwoPi();} TBI
    //if(dPhi > TMath::TwoPi()){dPhi -= TMath::TwoPi();} TBI
-   dPt = pTrack->Pt();
+   dPt = storePt[iTrack];
    if(fUseWeights[1][1]){wPt = Weight(dPt,"POI","pt");} // corresponding pT weight
-   dEta = pTrack->Eta();
+   dEta = storeEta[iTrack];
    if(fUseWeights[1][2]){wEta = Weight(dEta,"POI","eta");} // corresponding eta weight
 
    // Determine bin:
@@ -2075,12 +2098,14 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
    // Calculate p-vector components:
    for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
    {
+    dCos = TMath::Cos(h*dPhi);
+    dSin = TMath::Sin(h*dPhi);
     for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
     {
      if(fUseWeights[1][0]||fUseWeights[1][1]||fUseWeights[1][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fpvector[binNo-1][h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
+     fpvector[binNo-1][h][wp] += TComplex(wToPowerP*dCos,wToPowerP*dSin);
 
-     if(pTrack->InRPSelection()) 
+     if(bRP) 
      {
       // Fill q-vector components:
       wPhi = 1.; wPt = 1.; wEta = 1.; wToPowerP = 1.; // TBI this shall go somewhere else, for performance sake
@@ -2096,12 +2121,12 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
       if(fUseWeights[1][1]){wPt = Weight(dPt,"POI","pt");} // corresponding pT weight
       if(fUseWeights[1][2]){wEta = Weight(dEta,"POI","eta");} // corresponding eta weight
       if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]||fUseWeights[1][0]||fUseWeights[1][1]||fUseWeights[1][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-      fqvector[binNo-1][h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
-     } // if(pTrack->InRPSelection()) 
+      fqvector[binNo-1][h][wp] += TComplex(wToPowerP*dCos,wToPowerP*dSin);
+     } // if(bRP) 
 
     } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
    } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
-  } // if(pTrack->InPOISelection()) 
+  } // if(bPOI) 
 
  } // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
 
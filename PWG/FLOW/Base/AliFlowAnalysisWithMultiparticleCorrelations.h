@@ -323,6 +323,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   TH1D* GetHistogramWithWeights(const char *filePath, const char *listName, const char *type, const char *variable, const char *production);
   virtual Double_t CorrelationPsi2nPsi1n(Int_t n, Int_t k=0);
   Bool_t TrackIsInSpecifiedIntervals(AliFlowTrackSimple *);
+  Bool_t TrackIsInSpecifiedIntervals(Double_t dPhi, Double_t dPt, Double_t dEta);
 
  private:
   AliFlowAnalysisWithMultiparticleCorrelations(const AliFlowAnalysisWithMultiparticleCorrelations& afawQc);
@@ -137,6 +137,10 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fReQ(NULL),
  fImQ(NULL),
  fSpk(NULL),
+ fQvectorEngineTracks(),
+ fQvectorEngineRPisPOI(),
+ fQvectorEngineTables(),
+ fQvectorEngineBins(),
  fIntFlowCorrelationsEBE(NULL),
  fIntFlowEventWeightsForCorrelationsEBE(NULL),
  fIntFlowCorrelationsAllEBE(NULL),
@@ -368,7 +372,6 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  fNumberOfPOIsEBE = anEvent->GetNumberOfPOIs(); // number of POIs (i.e. number of particles of interest)
  fReferenceMultiplicityEBE = anEvent->GetReferenceMultiplicity(); // reference multiplicity for current event
  //Printf("Reference multiplicity (QC): %.1f",fReferenceMultiplicityEBE);
- Double_t ptEta[2] = {0.,0.}; // 0 = dPt, 1 = dEta
   
  // c) Fill the common control histograms and call the method to fill fAvMultiplicity:
  this->FillCommonControlHistograms(anEvent);                                                               
@@ -376,22 +379,47 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  if(fStoreControlHistograms){this->FillControlHistograms(anEvent);}                                                              
                                                                                                                                                                                                                                                                                         
  // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
+ //  d1) collect RPs and POIs together with their particle weights (in the order of AliFlowEventSimple::GetTrack);
+ //  d2) feed them block by block to the Q-vector engine.
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
- AliFlowTrackSimple *aftsTrack = NULL;
- Int_t n = fHarmonic; // shortcut for the harmonic 
+ anEvent->FillTrackStore(); // flat phi, pt, eta, weight and flags of all tracks
+ const Double_t *storePhi = anEvent->GetStorePhi();
+ const Double_t *storePt = anEvent->GetStorePt();
+ const Double_t *storeEta = anEvent->GetStoreEta();
+ const Double_t *storeWeight = anEvent->GetStoreWeight();
+ if(fQvectorEngineTracks.GetSize() < 8*nPrim)
+ {
+  fQvectorEngineTracks.Set(8*nPrim);
+  fQvectorEngineRPisPOI.Set(nPrim);
+ }
+ Double_t *rpPhi = fQvectorEngineTracks.GetArray(); // [0=phi,1=weight,2=pt,3=eta][RP]
+ Double_t *rpWeight = rpPhi+nPrim;
+ Double_t *rpPt = rpPhi+2*nPrim;
+ Double_t *rpEta = rpPhi+3*nPrim;
+ Double_t *poiPhi = rpPhi+4*nPrim; // [0=phi,1=weight,2=pt,3=eta][POI]
+ Double_t *poiWeight = rpPhi+5*nPrim;
+ Double_t *poiPt = rpPhi+6*nPrim;
+ Double_t *poiEta = rpPhi+7*nPrim;
+ Int_t *rpIsPOI = fQvectorEngineRPisPOI.GetArray();
+ Int_t nRPs = 0; // number of RPs collected for the Q-vector engine
+ Int_t nPOIs = 0; // number of POIs collected for the Q-vector engine
+ Int_t iTrack = -1; // index in the track store of the i-th track
+ Bool_t bRP = kFALSE, bPOI = kFALSE;
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
-  aftsTrack=anEvent->GetTrack(i);
-  if(aftsTrack)
+  iTrack=anEvent->TrackStoreIndex(i);
+  if(iTrack>=0)
   {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())){continue;} // safety measure: consider only tracks which are RPs or POIs
-   if(aftsTrack->InRPSelection()) // RP condition:
+   bRP = anEvent->StoreInRPSelection(iTrack);
+   bPOI = anEvent->StoreInPOISelection(iTrack);
+   if(!(bRP || bPOI)){continue;} // safety measure: consider only tracks which are RPs or POIs
+   if(bRP) // RP condition:
    {    
     nCounterNoRPs++;
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
+    dPhi = storePhi[iTrack];
+    dPt  = storePt[iTrack];
+    dEta = storeEta[iTrack];
     if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
@@ -407,147 +435,87 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     // Access track weight:
     if(fUseTrackWeights)
     {
-     wTrack = aftsTrack->Weight(); 
-    }
-    // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
-    {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
+     wTrack = storeWeight[iTrack]; 
     }
-    // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
-    {
-     for(Int_t k=0;k<9;k++)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
-     }
-    } 
-    // Differential flow:
-    if(fCalculateDiffFlow || fCalculate2DDiffFlow)
-    {
-     ptEta[0] = dPt; 
-     ptEta[1] = dEta; 
-     // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs): 
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      {
-       if(fCalculateDiffFlow)
-       {
-        for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-        {
-         fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-       } // end of if(fCalculateDiffFlow) 
-       if(fCalculate2DDiffFlow)
-       {
-        fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-        if(m==0) // s_{p,k} does not depend on index m
-        {
-         fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
-        } // end of if(m==0) // s_{p,k} does not depend on index m
-       } // end of if(fCalculate2DDiffFlow)
-      } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     // Checking if RP particle is also POI particle:      
-     if(aftsTrack->InPOISelection())
-     {
-      // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs): 
-      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-      {
-       for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-       {
-        if(fCalculateDiffFlow)
-        {
-         for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-         {
-          fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-          fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-          if(m==0) // s_{p,k} does not depend on index m
-          {
-           fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-          } // end of if(m==0) // s_{p,k} does not depend on index m
-         } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-        } // end of if(fCalculateDiffFlow) 
-        if(fCalculate2DDiffFlow)
-        {
-         fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of if(fCalculate2DDiffFlow)
-       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-     } // end of if(aftsTrack->InPOISelection())  
-    } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)         
-   } // end of if(pTrack->InRPSelection())
-   if(aftsTrack->InPOISelection())
-   {
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
+    rpPhi[nRPs] = dPhi;
+    rpWeight[nRPs] = wPhi*wPt*wEta*wTrack;
+    rpPt[nRPs] = dPt;
+    rpEta[nRPs] = dEta;
+    rpIsPOI[nRPs] = bPOI; // RP particle is also POI particle
+    nRPs++;
+   } // end of if(bRP)
+   if(bPOI)
+   {
+    dPhi = storePhi[iTrack];
+    dPt  = storePt[iTrack];
+    dEta = storeEta[iTrack];
     wPhi = 1.;
     wPt  = 1.;
     wEta = 1.;
     wTrack = 1.;
-    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && aftsTrack->InRPSelection()) // determine phi weight for POI && RP particle:
+    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && bRP) // determine phi weight for POI && RP particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
     }
-    if(fUsePtWeights && fPtWeights && fnBinsPt && aftsTrack->InRPSelection()) // determine pt weight for POI && RP particle:
+    if(fUsePtWeights && fPtWeights && fnBinsPt && bRP) // determine pt weight for POI && RP particle:
     {
      wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
     }              
-    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && aftsTrack->InRPSelection()) // determine eta weight for POI && RP particle: 
+    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && bRP) // determine eta weight for POI && RP particle: 
     {
      wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
     }      
     // Access track weight for POI && RP particle:
-    if(aftsTrack->InRPSelection() && fUseTrackWeights)
+    if(bRP && fUseTrackWeights)
     {
-     wTrack = aftsTrack->Weight(); 
+     wTrack = storeWeight[iTrack]; 
     }
-    ptEta[0] = dPt;
-    ptEta[1] = dEta;
-    // Calculate p_{m*n,k} ('p-vector' for POIs): 
-    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-    {
-     for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     {
-      if(fCalculateDiffFlow)
-      {
-       for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-       {
-        fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-       } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-      } // end of if(fCalculateDiffFlow) 
-      if(fCalculate2DDiffFlow)
-      {
-       fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-       fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-      } // end of if(fCalculate2DDiffFlow)
-     } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-    } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-   } // end of if(pTrack->InPOISelection())    
-  } else // to if(aftsTrack)
+    poiPhi[nPOIs] = dPhi;
+    poiWeight[nPOIs] = wPhi*wPt*wEta*wTrack;
+    poiPt[nPOIs] = dPt;
+    poiEta[nPOIs] = dEta;
+    nPOIs++;
+   } // end of if(bPOI)    
+  } else // to if(iTrack>=0)
     {
      printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
+ // d2) Q-vector engine: Q_{m*n,k} and S_{p,k} from RPs, r_{m*n,k} and q_{m*n,k} (and s_{p,k}) from RPs 
+ //     and RPs && POIs, p_{m*n,k} from POIs:
+ Bool_t bDiffFlowEBE = (fCalculateDiffFlow || fCalculate2DDiffFlow);
+ if(fQvectorEngineTables.GetSize() < 33*fgkQvectorEngineBlock)
+ {
+  fQvectorEngineTables.Set(33*fgkQvectorEngineBlock);
+  fQvectorEngineBins.Set(3*fgkQvectorEngineBlock);
+ }
+ if(bDiffFlowEBE && fDiffFlowEntriesEBE.GetSize() < 3*this->GetDiffFlowEBECells(3))
+ {
+  fDiffFlowEntriesEBE.Set(3*this->GetDiffFlowEBECells(3));
+ }
+ for(Int_t b=0;b<nRPs;b+=fgkQvectorEngineBlock)
+ {
+  Int_t nBlock = TMath::Min(fgkQvectorEngineBlock,nRPs-b);
+  this->CalculateQvectorTables(nBlock,rpPhi+b,rpWeight+b,12);
+  this->FillQvectorsFromTables(nBlock);
+  if(bDiffFlowEBE)
+  {
+   this->FillDiffFlowEBEFromTables(0,nBlock,rpPt+b,rpEta+b,NULL); // r_{m*n,k}
+   this->FillDiffFlowEBEFromTables(2,nBlock,rpPt+b,rpEta+b,rpIsPOI+b); // q_{m*n,k}
+  }
+ } // end of for(Int_t b=0;b<nRPs;b+=fgkQvectorEngineBlock)
+ if(bDiffFlowEBE)
+ {
+  for(Int_t b=0;b<nPOIs;b+=fgkQvectorEngineBlock)
+  {
+   Int_t nBlock = TMath::Min(fgkQvectorEngineBlock,nPOIs-b);
+   this->CalculateQvectorTables(nBlock,poiPhi+b,poiWeight+b,4);
+   this->FillDiffFlowEBEFromTables(1,nBlock,poiPt+b,poiEta+b,NULL); // p_{m*n,k}
+  } // end of for(Int_t b=0;b<nPOIs;b+=fgkQvectorEngineBlock)
+  this->FlushDiffFlowEntriesEBE();
+ } // end of if(bDiffFlowEBE)
+
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
  {
@@ -700,6 +668,246 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithQCumulants::CalculateQvectorTables(Int_t nTracks, const Double_t *phi, const Double_t *weight, Int_t nMultiples)
+{
+ // Q-vector engine: for a block of at most fgkQvectorEngineBlock tracks tabulate cos((m+1)*n*phi) and 
+ // sin((m+1)*n*phi) for m = 0,...,nMultiples-1, and w^k for k = 0,...,8, in fQvectorEngineTables.
+ // Only cos(n*phi) and sin(n*phi) are evaluated, higher multiples follow from the Chebyshev recurrence
+ //  cos((m+1)x) = 2cos(x)cos(mx) - cos((m-1)x), sin((m+1)x) = 2cos(x)sin(mx) - sin((m-1)x).
+ // Tables are flat [row][track], so all loops below run over tracks and can be vectorised.
+
+ const Int_t kBlock = fgkQvectorEngineBlock;
+ Double_t *cosTable = fQvectorEngineTables.GetArray(); // [m][track]
+ Double_t *sinTable = cosTable+12*kBlock; // [m][track]
+ Double_t *powTable = cosTable+24*kBlock; // [k][track]
+ Int_t n = fHarmonic; // shortcut for the harmonic
+
+ for(Int_t i=0;i<nTracks;i++)
+ {
+  cosTable[i] = TMath::Cos(n*phi[i]);
+  sinTable[i] = TMath::Sin(n*phi[i]);
+ }
+ if(nMultiples>1)
+ {
+  for(Int_t i=0;i<nTracks;i++)
+  {
+   cosTable[kBlock+i] = 2.*cosTable[i]*cosTable[i]-1.;
+   sinTable[kBlock+i] = 2.*cosTable[i]*sinTable[i];
+  }
+ }
+ for(Int_t m=2;m<nMultiples;m++)
+ {
+  Double_t *cosM = cosTable+m*kBlock;
+  Double_t *sinM = sinTable+m*kBlock;
+  for(Int_t i=0;i<nTracks;i++)
+  {
+   cosM[i] = 2.*cosTable[i]*cosM[i-kBlock]-cosM[i-2*kBlock];
+   sinM[i] = 2.*cosTable[i]*sinM[i-kBlock]-sinM[i-2*kBlock];
+  }
+ } // end of for(Int_t m=2;m<nMultiples;m++)
+ for(Int_t i=0;i<nTracks;i++)
+ {
+  powTable[i] = 1.;
+ }
+ for(Int_t k=1;k<9;k++)
+ {
+  Double_t *powK = powTable+k*kBlock;
+  for(Int_t i=0;i<nTracks;i++)
+  {
+   powK[i] = powK[i-kBlock]*weight[i];
+  }
+ } // end of for(Int_t k=1;k<9;k++)
+
+} // end of void AliFlowAnalysisWithQCumulants::CalculateQvectorTables(Int_t nTracks, const Double_t *phi, const Double_t *weight, Int_t nMultiples)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FillQvectorsFromTables(Int_t nTracks)
+{
+ // Add Re[Q_{m*n,k}], Im[Q_{m*n,k}] (m = 1,2,...,12, k = 0,1,...,8) and S_{p,k} (before the final power) 
+ // of one block of RPs tabulated by CalculateQvectorTables(). Tracks are summed in their original order.
+
+ const Int_t kBlock = fgkQvectorEngineBlock;
+ const Double_t *cosTable = fQvectorEngineTables.GetArray();
+ const Double_t *sinTable = cosTable+12*kBlock;
+ const Double_t *powTable = cosTable+24*kBlock;
+
+ for(Int_t m=0;m<12;m++) 
+ {
+  const Double_t *cosM = cosTable+m*kBlock;
+  const Double_t *sinM = sinTable+m*kBlock;
+  for(Int_t k=0;k<9;k++)
+  {
+   const Double_t *powK = powTable+k*kBlock;
+   Double_t dReQ = (*fReQ)(m,k);
+   Double_t dImQ = (*fImQ)(m,k);
+   for(Int_t i=0;i<nTracks;i++)
+   {
+    dReQ += powK[i]*cosM[i];
+    dImQ += powK[i]*sinM[i];
+   }
+   (*fReQ)(m,k) = dReQ;
+   (*fImQ)(m,k) = dImQ;
+  } // end of for(Int_t k=0;k<9;k++)
+ } // end of for(Int_t m=0;m<12;m++) 
+ for(Int_t k=0;k<9;k++)
+ {
+  const Double_t *powK = powTable+k*kBlock;
+  Double_t dS = (*fSpk)(0,k);
+  for(Int_t i=0;i<nTracks;i++)
+  {
+   dS += powK[i];
+  }
+  for(Int_t p=0;p<8;p++) // all rows are the same before the final power
+  {
+   (*fSpk)(p,k) = dS;
+  }
+ } // end of for(Int_t k=0;k<9;k++)
+
+} // end of void AliFlowAnalysisWithQCumulants::FillQvectorsFromTables(Int_t nTracks)
+
+//=======================================================================================================================
+
+Int_t AliFlowAnalysisWithQCumulants::GetDiffFlowEBECells(Int_t pe)
+{
+ // Number of cells of the e-b-e differential flow profiles in pt (pe = 0), eta (pe = 1) or (pt,eta) (pe = 2),
+ // 0 if they are not used. For pe = 3 the sum of all three, i.e. the stride of fDiffFlowEntriesEBE per type.
+
+ Int_t nCells[3] = {0,0,0};
+ if(fCalculateDiffFlow)
+ {
+  nCells[0] = fReRPQ1dEBE[0][0][0][0]->GetNbinsX()+2;
+  if(fCalculateDiffFlowVsEta){nCells[1] = fReRPQ1dEBE[0][1][0][0]->GetNbinsX()+2;}
+ }
+ if(fCalculate2DDiffFlow)
+ {
+  nCells[2] = (fReRPQ2dEBE[0][0][0]->GetNbinsX()+2)*(fReRPQ2dEBE[0][0][0]->GetNbinsY()+2);
+ }
+
+ return (pe<3) ? nCells[pe] : nCells[0]+nCells[1]+nCells[2];
+
+} // end of Int_t AliFlowAnalysisWithQCumulants::GetDiffFlowEBECells(Int_t pe)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FillDiffFlowEBEFromTables(Int_t t, Int_t nTracks, const Double_t *pt, const Double_t *eta, const Int_t *select)
+{
+ // Add one block of tracks tabulated by CalculateQvectorTables() to the e-b-e profiles of type t 
+ // (0 = r_{m*n,k}, 1 = p_{m*n,k}, 2 = q_{m*n,k}, and s_{p,k} for t = 0 and 2). If select is given,
+ // only tracks with select[i] are used. Contributions go straight into the bin sums, the bin entries 
+ // are only counted in fDiffFlowEntriesEBE and set by FlushDiffFlowEntriesEBE(). Only bin contents
+ // and bin entries of these profiles are used, for which this is the same as Fill(x,y,1.) per track.
+
+ const Int_t kBlock = fgkQvectorEngineBlock;
+ const Double_t *cosTable = fQvectorEngineTables.GetArray();
+ const Double_t *sinTable = cosTable+12*kBlock;
+ const Double_t *powTable = cosTable+24*kBlock;
+ Double_t *entries = fDiffFlowEntriesEBE.GetArray()+t*this->GetDiffFlowEBECells(3); // [0=pt,1=eta,2=(pt,eta)][bin]
+ Bool_t bFillS = (t != 1); // s_{p,k} is not needed for POIs
+
+ for(Int_t pe=0;pe<3;pe++) // pt, eta or (pt,eta)
+ {
+  Int_t nCells = this->GetDiffFlowEBECells(pe);
+  if(0 == nCells){continue;}
+  Double_t *entriesPe = entries;
+  entries += nCells;
+  // Determine the bin of each track once for all profiles:
+  Int_t *bins = fQvectorEngineBins.GetArray()+pe*kBlock;
+  for(Int_t i=0;i<nTracks;i++)
+  {
+   if(select && !select[i]){bins[i] = -1; continue;}
+   if(pe<2)
+   {
+    bins[i] = fReRPQ1dEBE[t][pe][0][0]->GetXaxis()->FindBin(0==pe ? pt[i] : eta[i]);
+   } else
+     {
+      bins[i] = fReRPQ2dEBE[t][0][0]->GetBin(fReRPQ2dEBE[t][0][0]->GetXaxis()->FindBin(pt[i]),
+                                             fReRPQ2dEBE[t][0][0]->GetYaxis()->FindBin(eta[i]));
+     }
+   entriesPe[bins[i]] += 1.;
+  } // end of for(Int_t i=0;i<nTracks;i++)
+  // Add the contributions:
+  for(Int_t m=0;m<4;m++)
+  {
+   const Double_t *cosM = cosTable+m*kBlock;
+   const Double_t *sinM = sinTable+m*kBlock;
+   for(Int_t k=0;k<9;k++)
+   {
+    const Double_t *powK = powTable+k*kBlock;
+    Double_t *re = (pe<2) ? fReRPQ1dEBE[t][pe][m][k]->GetArray() : fReRPQ2dEBE[t][m][k]->GetArray();
+    Double_t *im = (pe<2) ? fImRPQ1dEBE[t][pe][m][k]->GetArray() : fImRPQ2dEBE[t][m][k]->GetArray();
+    for(Int_t i=0;i<nTracks;i++)
+    {
+     if(bins[i]<0){continue;}
+     re[bins[i]] += powK[i]*cosM[i];
+     im[bins[i]] += powK[i]*sinM[i];
+    }
+   } // end of for(Int_t k=0;k<9;k++)
+  } // end of for(Int_t m=0;m<4;m++)
+  if(!bFillS){continue;}
+  for(Int_t k=0;k<9;k++)
+  {
+   const Double_t *powK = powTable+k*kBlock;
+   Double_t *s = (pe<2) ? fs1dEBE[t][pe][k]->GetArray() : fs2dEBE[t][k]->GetArray();
+   for(Int_t i=0;i<nTracks;i++)
+   {
+    if(bins[i]<0){continue;}
+    s[bins[i]] += powK[i];
+   }
+  } // end of for(Int_t k=0;k<9;k++)
+ } // end of for(Int_t pe=0;pe<3;pe++) // pt, eta or (pt,eta)
+
+} // end of void AliFlowAnalysisWithQCumulants::FillDiffFlowEBEFromTables(Int_t t, Int_t nTracks, const Double_t *pt, const Double_t *eta, const Int_t *select)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FlushDiffFlowEntriesEBE()
+{
+ // Set the bin entries of the e-b-e differential flow profiles counted in FillDiffFlowEBEFromTables()
+ // and clear the counts for the next event.
+
+ Double_t *entries = fDiffFlowEntriesEBE.GetArray(); // [t][0=pt,1=eta,2=(pt,eta)][bin]
+ for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
+ {
+  for(Int_t pe=0;pe<3;pe++) // pt, eta or (pt,eta)
+  {
+   Int_t nCells = this->GetDiffFlowEBECells(pe);
+   for(Int_t b=0;b<nCells;b++)
+   {
+    if(entries[b] == 0.){continue;}
+    for(Int_t m=0;m<4;m++)
+    {
+     for(Int_t k=0;k<9;k++)
+     {
+      if(pe<2)
+      {
+       fReRPQ1dEBE[t][pe][m][k]->SetBinEntries(b,entries[b]);
+       fImRPQ1dEBE[t][pe][m][k]->SetBinEntries(b,entries[b]);
+      } else
+        {
+         fReRPQ2dEBE[t][m][k]->SetBinEntries(b,entries[b]);
+         fImRPQ2dEBE[t][m][k]->SetBinEntries(b,entries[b]);
+        }
+     } // end of for(Int_t k=0;k<9;k++)
+    } // end of for(Int_t m=0;m<4;m++)
+    if(t != 1) // s_{p,k} is not filled for POIs
+    {
+     for(Int_t k=0;k<9;k++)
+     {
+      if(pe<2){fs1dEBE[t][pe][k]->SetBinEntries(b,entries[b]);}
+      else{fs2dEBE[t][k]->SetBinEntries(b,entries[b]);}
+     }
+    }
+    entries[b] = 0.;
+   } // end of for(Int_t b=0;b<nCells;b++)
+   entries += nCells;
+  } // end of for(Int_t pe=0;pe<3;pe++) // pt, eta or (pt,eta)
+ } // end of for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
+
+} // end of void AliFlowAnalysisWithQCumulants::FlushDiffFlowEntriesEBE()
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithQCumulants::Finish()
 {
  // Calculate the final results.
@@ -15,6 +15,8 @@
 #define ALIFLOWANALYSISWITHQCUMULANTS_H
 
 #include "TMatrixD.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
 #include "TH2D.h"
 #include "TRandom3.h"
 #include "AliFlowCommonConstants.h"
@@ -82,6 +84,8 @@ class AliFlowAnalysisWithQCumulants{
     virtual void FillCommonControlHistograms(AliFlowEventSimple *anEvent);
     virtual void FillControlHistograms(AliFlowEventSimple *anEvent);
     virtual void ResetEventByEventQuantities();
+    virtual void CalculateQvectorTables(Int_t nTracks, const Double_t *phi, const Double_t *weight, Int_t nMultiples);
+    virtual void FillQvectorsFromTables(Int_t nTracks);
     // 2b.) Reference flow:
     virtual void CalculateIntFlowCorrelations(); 
     virtual void CalculateIntFlowCorrelationsUsingParticleWeights();
@@ -113,6 +117,9 @@ class AliFlowAnalysisWithQCumulants{
     virtual void CalculateDiffFlowCorrectionsForNUACosTermsUsingParticleWeights(TString type, TString ptOrEta);
     virtual void CalculateDiffFlowCorrectionsForNUASinTerms(TString type, TString ptOrEta);  
     virtual void CalculateDiffFlowCorrectionsForNUASinTermsUsingParticleWeights(TString type, TString ptOrEta);  
+    virtual Int_t GetDiffFlowEBECells(Int_t pe); // pe = 0 (pt), 1 (eta), 2 (pt,eta), 3 (all)
+    virtual void FillDiffFlowEBEFromTables(Int_t t, Int_t nTracks, const Double_t *pt, const Double_t *eta, const Int_t *select);
+    virtual void FlushDiffFlowEntriesEBE();
     // 2e.) 2D differential flow:
     virtual void Calculate2DDiffFlowCorrelations(TString type); // type = RP or POI
     // 2f.) Other differential correlators (i.e. Teaney-Yan correlator):    
@@ -632,6 +639,11 @@ class AliFlowAnalysisWithQCumulants{
   TMatrixD *fReQ; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
   TMatrixD *fImQ; //! fImQ[m][k] = sum_{i=1}^{M} w_{i}^{k} sin(m*phi_{i})
   TMatrixD *fSpk; //! fSM[p][k] = (sum_{i=1}^{M} w_{i}^{k})^{p+1}
+  static const Int_t fgkQvectorEngineBlock = 64; // number of tracks tabulated at once by the Q-vector engine
+  TArrayD fQvectorEngineTracks; //! RPs and POIs of the current event, flat [0=RP,1=POI][0=phi,1=weight,2=pt,3=eta][track]
+  TArrayI fQvectorEngineRPisPOI; //! is the i-th RP in fQvectorEngineTracks also a POI
+  TArrayD fQvectorEngineTables; //! one block of tracks: cos((m+1)*n*phi), sin((m+1)*n*phi) [m=0..11], w^k [k=0..8], flat [row][track]
+  TArrayI fQvectorEngineBins; //! one block of tracks: bin of the e-b-e profiles, flat [0=pt,1=eta,2=(pt,eta)][track]
   TH1D *fIntFlowCorrelationsEBE; // 1st bin: <2>, 2nd bin: <4>, 3rd bin: <6>, 4th bin: <8>
   TH1D *fIntFlowEventWeightsForCorrelationsEBE; // 1st bin: eW_<2>, 2nd bin: eW_<4>, 3rd bin: eW_<6>, 4th bin: eW_<8>
   TH1D *fIntFlowCorrelationsAllEBE; // to be improved (add comment)
@@ -720,6 +732,7 @@ class AliFlowAnalysisWithQCumulants{
   TProfile2D *fReRPQ2dEBE[3][4][9]; // real part of r_{m*n,k}(pt,eta), p_{m*n,k}(pt,eta) and q_{m*n,k}(pt,eta)
   TProfile2D *fImRPQ2dEBE[3][4][9]; // imaginary part of r_{m*n,k}(pt,eta), p_{m*n,k}(pt,eta) and q_{m*n,k}(pt,eta)
   TProfile2D *fs2dEBE[3][9]; //! [t][k] // to be improved
+  TArrayD fDiffFlowEntriesEBE; //! bin entries of the e-b-e profiles above, flat [t][0=pt,1=eta,2=(pt,eta)][bin]
   //  4d.) profiles:
   //   1D:
   TProfile *fDiffFlowCorrelationsPro[2][2][4]; //! [0=RP,1=POI][0=pt,1=eta][correlation index]
@@ -847,7 +860,7 @@ class AliFlowAnalysisWithQCumulants{
   TH2D *fBootstrapCumulants; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; y-axis => subsample # 
   TH2D *fBootstrapCumulantsVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; y-axis => subsample # 
 
-  ClassDef(AliFlowAnalysisWithQCumulants, 4);
+  ClassDef(AliFlowAnalysisWithQCumulants, 5);
 
 };
 
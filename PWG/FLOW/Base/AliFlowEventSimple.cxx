@@ -88,6 +88,14 @@ AliFlowEventSimple::AliFlowEventSimple():
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fStorePhi(),
+  fStoreEta(),
+  fStorePt(),
+  fStoreWeight(),
+  fStoreFlowBits(),
+  fStoreSubevents(),
+  fTrackStoreSize(0),
+  fTrackStoreValid(kFALSE),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(NULL)
 {
@@ -147,6 +155,14 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fStorePhi(),
+  fStoreEta(),
+  fStorePt(),
+  fStoreWeight(),
+  fStoreFlowBits(),
+  fStoreSubevents(),
+  fTrackStoreSize(0),
+  fTrackStoreValid(kFALSE),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -210,6 +226,14 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZPCM(anEvent.fZPCM),
   fZPAM(anEvent.fZPAM),
   fAbsOrbit(anEvent.fAbsOrbit),
+  fStorePhi(),
+  fStoreEta(),
+  fStorePt(),
+  fStoreWeight(),
+  fStoreFlowBits(),
+  fStoreSubevents(),
+  fTrackStoreSize(0),
+  fTrackStoreValid(kFALSE),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -299,6 +323,8 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
   fZPCM = anEvent.fZPCM;
   fZPAM = anEvent.fZPAM;
   fAbsOrbit = anEvent.fAbsOrbit;
+  fTrackStoreSize = 0;
+  fTrackStoreValid = kFALSE;
   for(Int_t i(0); i < 3; i++) {
     fVtxPos[i] = anEvent.fVtxPos[i];
   }
@@ -427,6 +453,8 @@ AliFlowTrackSimple* AliFlowEventSimple::GetTrack(Int_t i)
     trackIndex=fShuffledIndexes[i];
   }
   AliFlowTrackSimple* pTrack = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(trackIndex)) ;
+  //the caller may modify the track
+  fTrackStoreValid=kFALSE;
   return pTrack;
 }
 
@@ -470,6 +498,7 @@ void AliFlowEventSimple::TrackAdded()
 {
   //book keeping after a new track has been added
   fNumberOfTracks++;
+  fTrackStoreValid=kFALSE;
   if (fShuffledIndexes)
   {
     delete [] fShuffledIndexes;
@@ -480,6 +509,7 @@ void AliFlowEventSimple::TrackAdded()
 //-----------------------------------------------------------------------
 AliFlowTrackSimple* AliFlowEventSimple::MakeNewTrack()
 {
+   fTrackStoreValid=kFALSE;
    AliFlowTrackSimple *t=dynamic_cast<AliFlowTrackSimple *>(fTrackCollection->RemoveAt(fNumberOfTracks));
    if( !t ) {  // If there was no track at the end of the list then create a new track
       t=new AliFlowTrackSimple();
@@ -488,6 +518,70 @@ AliFlowTrackSimple* AliFlowEventSimple::MakeNewTrack()
    return t;
 }
 
+//-----------------------------------------------------------------------
+void AliFlowEventSimple::FillTrackStore()
+{
+  //copy phi, eta, pt, weight and the selection bits of all tracks into
+  //contiguous arrays (collection order) so Q-vectors can be built without
+  //touching the track objects; the store is kept until the tracks may have
+  //changed: GetTrack hands out non-const tracks, so it invalidates the store
+  //like adding tracks, ClearFast and the methods modifying the tracks do;
+  //use TrackStoreIndex to visit it in GetTrack order
+  if (fTrackStoreValid) return;
+  if (fStorePhi.GetSize()<fNumberOfTracks)
+  {
+    fStorePhi.Set(fNumberOfTracks);
+    fStoreEta.Set(fNumberOfTracks);
+    fStorePt.Set(fNumberOfTracks);
+    fStoreWeight.Set(fNumberOfTracks);
+    fStoreFlowBits.Set(fNumberOfTracks);
+    fStoreSubevents.Set(fNumberOfTracks);
+  }
+  Double_t* phi = fStorePhi.GetArray();
+  Double_t* eta = fStoreEta.GetArray();
+  Double_t* pt = fStorePt.GetArray();
+  Double_t* weight = fStoreWeight.GetArray();
+  Int_t* flowBits = fStoreFlowBits.GetArray();
+  Int_t* subevents = fStoreSubevents.GetArray();
+
+  for(Int_t i=0; i<fNumberOfTracks; i++)
+  {
+    AliFlowTrackSimple* pTrack = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
+    if(!pTrack)
+    {
+      //no selection bits, so every loop over the store skips it
+      cerr << "no particle!!!"<<endl;
+      phi[i] = 0.; eta[i] = 0.; pt[i] = 0.; weight[i] = 0.;
+      flowBits[i] = 0; subevents[i] = 0;
+      continue;
+    }
+    phi[i] = pTrack->Phi();
+    eta[i] = pTrack->Eta();
+    pt[i] = pTrack->Pt();
+    weight[i] = pTrack->Weight();
+    const TBits* poiBits = pTrack->GetPOItype();
+    UInt_t bits = 0;
+    for(UInt_t p=poiBits->FirstSetBit(); p<poiBits->GetNbits() && p<32; p=poiBits->FirstSetBit(p+1))
+    {
+      bits |= (1u<<p);
+    }
+    flowBits[i] = (Int_t)bits;
+    subevents[i] = (pTrack->InSubevent(0)?1:0) | (pTrack->InSubevent(1)?2:0);
+  }
+  fTrackStoreSize = fNumberOfTracks;
+  fTrackStoreValid = kTRUE;
+}
+
+//-----------------------------------------------------------------------
+Int_t AliFlowEventSimple::TrackStoreIndex(Int_t i)
+{
+  //store index of the track GetTrack(i) returns, -1 if there is none
+  if (i<0 || i>=fNumberOfTracks) return -1;
+  if (!fShuffleTracks) return i;
+  if (!fShuffledIndexes) ShuffleTracks();
+  return fShuffledIndexes[i];
+}
+
 //-----------------------------------------------------------------------
 AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
                                         TList *weightsList,
@@ -508,8 +602,6 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
   Double_t dEta = 0.;
   Double_t dWeight = 1.;
 
-  AliFlowTrackSimple* pTrack = NULL;
-
   Int_t nBinsPhi = 0;
   Double_t dBinWidthPt = 0.;
   Double_t dPtMin = 0.;
@@ -551,48 +643,46 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
     }
   } // end of if(weightsList)
 
+  FillTrackStore(); //no-op while the tracks are unchanged
+  const Double_t* storePhi = GetStorePhi();
+  const Double_t* storePt = GetStorePt();
+  const Double_t* storeEta = GetStoreEta();
+  const Double_t* storeWeight = GetStoreWeight();
+
   // loop over tracks
-  for(Int_t i=0; i<fNumberOfTracks; i++)
+  for(Int_t i=0; i<fTrackStoreSize; i++)
   {
-    pTrack = (AliFlowTrackSimple*)fTrackCollection->At(i);
-    if(pTrack)
+    if(StoreInRPSelection(i))
     {
-      if(pTrack->InRPSelection())
-      {
-        dPhi = pTrack->Phi();
-        dPt  = pTrack->Pt();
-        dEta = pTrack->Eta();
-	      dWeight = pTrack->Weight();
+      dPhi = storePhi[i];
+      dPt  = storePt[i];
+      dEta = storeEta[i];
+      dWeight = storeWeight[i];
 
-        // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
-        if(phiWeights && nBinsPhi)
-        {
-          wPhi = phiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*nBinsPhi/TMath::TwoPi())));
-        }
-        // determine v'(pt) weight:
-        if(ptWeights && dBinWidthPt)
-        {
-          wPt=ptWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-dPtMin)/dBinWidthPt)));
-        }
-        // determine v'(eta) weight:
-        if(etaWeights && dBinWidthEta)
-        {
-          wEta=etaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-dEtaMin)/dBinWidthEta)));
-        }
+      // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
+      if(phiWeights && nBinsPhi)
+      {
+        wPhi = phiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*nBinsPhi/TMath::TwoPi())));
+      }
+      // determine v'(pt) weight:
+      if(ptWeights && dBinWidthPt)
+      {
+        wPt=ptWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-dPtMin)/dBinWidthPt)));
+      }
+      // determine v'(eta) weight:
+      if(etaWeights && dBinWidthEta)
+      {
+        wEta=etaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-dEtaMin)/dBinWidthEta)));
+      }
 
-        // building up the weighted Q-vector:
-        dQX += dWeight*wPhi*wPt*wEta*TMath::Cos(iOrder*dPhi);
-        dQY += dWeight*wPhi*wPt*wEta*TMath::Sin(iOrder*dPhi);
+      // building up the weighted Q-vector:
+      dQX += dWeight*wPhi*wPt*wEta*TMath::Cos(iOrder*dPhi);
+      dQY += dWeight*wPhi*wPt*wEta*TMath::Sin(iOrder*dPhi);
 
-        // weighted multiplicity:
-        sumOfWeights += dWeight*wPhi*wPt*wEta;
+      // weighted multiplicity:
+      sumOfWeights += dWeight*wPhi*wPt*wEta;
 
-      } // end of if (pTrack->InRPSelection())
-    } // end of if (pTrack)
-    else
-    {
-      cerr << "no particle!!!"<<endl;
-    }
+    } // end of if (StoreInRPSelection(i))
   } // loop over particles
 
   vQ.Set(dQX,dQY);
@@ -625,8 +715,6 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
   Double_t dEta = 0.;
   Double_t dWeight = 1.;
 
-  AliFlowTrackSimple* pTrack = NULL;
-
   Int_t    iNbinsPhiSub0 = 0;
   Int_t    iNbinsPhiSub1 = 0;
   Double_t dBinWidthPt = 0.;
@@ -676,24 +764,24 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
     }
   } // end of if(weightsList)
 
+  FillTrackStore(); //no-op while the tracks are unchanged
+  const Double_t* storePhi = GetStorePhi();
+  const Double_t* storePt = GetStorePt();
+  const Double_t* storeEta = GetStoreEta();
+  const Double_t* storeWeight = GetStoreWeight();
+
   //loop over the two subevents
   for (Int_t s=0; s<2; s++)
   {
     // loop over tracks
-    for(Int_t i=0; i<fNumberOfTracks; i++)
+    for(Int_t i=0; i<fTrackStoreSize; i++)
     {
-      pTrack = (AliFlowTrackSimple*)fTrackCollection->At(i);
-      if(!pTrack)
-      {
-        cerr << "no particle!!!"<<endl;
-        continue;
-      }
-      if(pTrack->InRPSelection() && (pTrack->InSubevent(s)))
+      if(StoreInRPSelection(i) && StoreInSubevent(i,s))
       {
-        dPhi    = pTrack->Phi();
-        dPt     = pTrack->Pt();
-        dEta    = pTrack->Eta();
-        dWeight = pTrack->Weight();
+        dPhi    = storePhi[i];
+        dPt     = storePt[i];
+        dEta    = storeEta[i];
+        dWeight = storeWeight[i];
 
         // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
         //subevent 0
@@ -734,7 +822,7 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
         // weighted multiplicity:
         sumOfWeights+=dWeight*dWphi*dWpt*dWeta;
 
-      } // end of if (pTrack->InRPSelection())
+      } // end of if (StoreInRPSelection(i) && StoreInSubevent(i,s))
     } // loop over particles
 
     Qarray[s].Set(dQX,dQY);
@@ -896,6 +984,14 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fStorePhi(),
+  fStoreEta(),
+  fStorePt(),
+  fStoreWeight(),
+  fStoreFlowBits(),
+  fStoreSubevents(),
+  fTrackStoreSize(0),
+  fTrackStoreValid(kFALSE),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -977,6 +1073,7 @@ void AliFlowEventSimple::CloneTracks(Int_t n)
 void AliFlowEventSimple::ResolutionPt(Double_t res)
 {
   //smear pt of all tracks by gaussian with sigma=res
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -992,6 +1089,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
                                             Double_t etaMaxB )
 {
   //Flag two subevents in given eta ranges
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1007,6 +1105,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
 void AliFlowEventSimple::TagSubeventsByCharge()
 {
   //Flag two subevents in given eta ranges
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1022,6 +1121,7 @@ void AliFlowEventSimple::TagSubeventsByCharge()
 void AliFlowEventSimple::AddV1( Double_t v1 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1039,6 +1139,7 @@ void AliFlowEventSimple::AddV1( Double_t v1 )
 void AliFlowEventSimple::AddV2( Double_t v2 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1056,6 +1157,7 @@ void AliFlowEventSimple::AddV2( Double_t v2 )
 void AliFlowEventSimple::AddV3( Double_t v3 )
 {
   //add v3 to all tracks wrt the reaction plane angle
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1073,6 +1175,7 @@ void AliFlowEventSimple::AddV3( Double_t v3 )
 void AliFlowEventSimple::AddV4( Double_t v4 )
 {
   //add v4 to all tracks wrt the reaction plane angle
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1090,6 +1193,7 @@ void AliFlowEventSimple::AddV4( Double_t v4 )
 void AliFlowEventSimple::AddV5( Double_t v5 )
 {
   //add v4 to all tracks wrt the reaction plane angle
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1108,6 +1212,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
                                   Double_t rp1, Double_t rp2, Double_t rp3, Double_t rp4, Double_t rp5 )
 {
   //add flow to all tracks wrt the reaction plane angle, for all harmonic separate angle
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1120,6 +1225,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
 void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_t v4, Double_t v5 )
 {
   //add flow to all tracks wrt the reaction plane angle
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1132,6 +1238,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
 void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1146,6 +1253,7 @@ void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
 void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1160,6 +1268,7 @@ void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 {
   //tag tracks as reference particles (RPs)
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1182,6 +1291,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiType )
 {
   //tag tracks as particles of interest (POIs)
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1215,6 +1325,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
 {
   //mark tracks in given eta-phi region as dead
   //by resetting the flow bits
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1238,6 +1349,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
   //remove tracks that have no flow tags set and cleanup the container
   //returns number of cleaned tracks
   Int_t ncleaned=0;
+  fTrackStoreValid=kFALSE; //the tracks are modified
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1286,4 +1398,6 @@ void AliFlowEventSimple::ClearFast()
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  fTrackStoreSize = 0;
+  fTrackStoreValid = kFALSE;
 }
@@ -19,6 +19,8 @@
 #include "TObject.h"
 #include "TParameter.h"
 #include "TMath.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
 #include "AliFlowVector.h"
 class TTree;
 class TF1;
@@ -119,6 +121,24 @@ class AliFlowEventSimple: public TObject {
 
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
+
+  // struct-of-arrays snapshot of the track collection, for Q-vector loops;
+  // refilled only after the tracks may have changed (GetTrack, AddTrack, ClearFast, ...)
+  void     FillTrackStore();
+  void     InvalidateTrackStore()                   { fTrackStoreValid=kFALSE; }
+  Bool_t   IsTrackStoreValid() const                { return fTrackStoreValid; }
+  Int_t    TrackStoreIndex(Int_t i);
+  Int_t    GetTrackStoreSize() const                { return fTrackStoreSize; }
+  const Double_t* GetStorePhi() const               { return fStorePhi.GetArray(); }
+  const Double_t* GetStoreEta() const               { return fStoreEta.GetArray(); }
+  const Double_t* GetStorePt() const                { return fStorePt.GetArray(); }
+  const Double_t* GetStoreWeight() const            { return fStoreWeight.GetArray(); }
+  const Int_t*    GetStoreFlowBits() const          { return fStoreFlowBits.GetArray(); }
+  const Int_t*    GetStoreSubevents() const         { return fStoreSubevents.GetArray(); }
+  Bool_t   StoreInPOISelection(Int_t j, Int_t poiType=1) const
+                                                    { return (poiType<32) && (((UInt_t)fStoreFlowBits.GetArray()[j]>>poiType)&1u); }
+  Bool_t   StoreInRPSelection(Int_t j) const        { return StoreInPOISelection(j,0); }
+  Bool_t   StoreInSubevent(Int_t j, Int_t s) const  { return (s<2) && ((fStoreSubevents.GetArray()[j]>>s)&1); }
   virtual void GetZDC2Qsub(AliFlowVector* Qarray);
   virtual void SetZDC2Qsub(Double_t* QVC, Double_t MC, Double_t* QVA, Double_t MA);
   // begin test methods for LHC15o VZERO calibration, do not use
@@ -204,12 +224,20 @@ class AliFlowEventSimple: public TObject {
   Double_t                fZPAM;                      // total energy from ZPC-A
   Double_t                fVtxPos[3];                 // Primary vertex position (x,y,z)
   UInt_t                  fAbsOrbit;                  // Absolute orbit number
+  TArrayD                 fStorePhi;                  //! track store: phi, collection order
+  TArrayD                 fStoreEta;                  //! track store: eta
+  TArrayD                 fStorePt;                   //! track store: pt
+  TArrayD                 fStoreWeight;               //! track store: track weight
+  TArrayI                 fStoreFlowBits;             //! track store: bit p set if in POI selection p (p<32, RP is 0)
+  TArrayI                 fStoreSubevents;            //! track store: bit s set if in subevent s (s<2)
+  Int_t                   fTrackStoreSize;            //! number of tracks in the store
+  Bool_t                  fTrackStoreValid;           //! store is up to date with the track collection
 
  private:
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
   Int_t*                  fNumberOfPOIs;          //[fNumberOfPOItypes] number of tracks that have passed the POI selection
 
-  ClassDef(AliFlowEventSimple,7)
+  ClassDef(AliFlowEventSimple,8)
 };
 
 #endif
@@ -168,6 +168,8 @@ AliFlowTrack* AliFlowEvent::GetTrack(Int_t i)
   //get track i from collection
   if (i>=fNumberOfTracks) return NULL;
   AliFlowTrack* pTrack = static_cast<AliFlowTrack*>(fTrackCollection->At(i)) ;
+  //the caller may modify the track
+  InvalidateTrackStore();
   return pTrack;
 }
 
@@ -832,6 +834,7 @@ void AliFlowEvent::FindDaughters(Bool_t keepDaughtersInRPselection)
   //each flow track holds it's esd track index as well as its daughters esd index.
   //fill the array of daughters for every track with the pointers to flow tracks
   //to associate the mothers with daughters directly
+  InvalidateTrackStore(); //daughters may leave the RP selection
   for (Int_t iTrack=0; iTrack<fMothersCollection->GetEntriesFast(); iTrack++)
   {
     AliFlowTrack* mother = static_cast<AliFlowTrack*>(fMothersCollection->At(iTrack));
@@ -1029,6 +1032,7 @@ void AliFlowEvent::InsertTrack(AliFlowTrack *track) {
 AliFlowTrack* AliFlowEvent::ReuseTrack(Int_t i)
 {
   //try to reuse an existing track, if empty, make new one
+  InvalidateTrackStore();
   AliFlowTrack* pTrack = static_cast<AliFlowTrack*>(fTrackCollection->At(i));
   if (pTrack)
   {
@@ -26,12 +26,15 @@
 #include <TMath.h>
 #include <TEllipse.h>
 #include <TRandom.h>
+#include <TRandom3.h>
 #include <TNamed.h>
 #include <TObjArray.h>
 #include <TNtuple.h>
 #include <TFile.h>
 #include <TTree.h>
 #include <TF1.h>
+#include <algorithm>
+#include <thread>
 
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
@@ -172,7 +175,22 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fNThreads(1),
+  fSeed(0),
+  fRandom(0),
+  fSigFlucCdf(),
+  fNucA(),
+  fNucB(),
+  fXA(),
+  fYA(),
+  fSigA(),
+  fXB(),
+  fYB(),
+  fSigB(),
+  fCellStart(),
+  fCellIndex(),
+  fPairs()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -322,7 +340,22 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc),
+  fNThreads(in.fNThreads),
+  fSeed(in.fSeed),
+  fRandom(0),
+  fSigFlucCdf(),
+  fNucA(),
+  fNucB(),
+  fXA(),
+  fYA(),
+  fSigA(),
+  fXB(),
+  fYB(),
+  fSigB(),
+  fCellStart(),
+  fCellIndex(),
+  fPairs()
 {
   //copy ctor
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
@@ -453,6 +486,8 @@ AliGlauberMC& AliGlauberMC::operator=(const AliGlauberMC& in)
   fSxyCom=in.fSxyCom;
   fX=in.fX;
   fNpp=in.fNpp;
+  fNThreads=in.fNThreads;
+  fSeed=in.fSeed;
   return *this;
 }
 
@@ -461,83 +496,60 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
 {
   // prepare event
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-  }
+  if (fDoFluc) InitSigFluc();
 
   fANucleus.ThrowNucleons(-bgen/2.);
   fNucleonsA = fANucleus.GetNucleons();
   fAN = fANucleus.GetN();
   fQAN = fAN * 3;
   //fAN = 3 * fANucleus.GetN(); // for Pb, Number of quark = 3*208;
+  fNucA.resize(fAN);
+  fXA.resize(fAN);
+  fYA.resize(fAN);
+  fSigA.resize(fAN);
   for (Int_t i = 0; i<fAN; i++)
   {
     AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i));
     nucleonA->SetInNucleusA();
     nucleonA->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonA->SetSigNN(fSigFluc->GetRandom());
+      nucleonA->SetSigNN(GetRandomSigNN());
+    fNucA[i] = nucleonA;
+    fXA[i]   = nucleonA->GetX();
+    fYA[i]   = nucleonA->GetY();
+    fSigA[i] = nucleonA->GetSigNN();
   }
   fBNucleus.ThrowNucleons(bgen/2.);
   fNucleonsB = fBNucleus.GetNucleons();
   //fBN = 3 * fBNucleus.GetN(); // Number of quark = number of nucleus*3;
   fBN = fBNucleus.GetN();
   fQBN = fBN * 3;
+  fNucB.resize(fBN);
+  fXB.resize(fBN);
+  fYB.resize(fBN);
+  fSigB.resize(fBN);
   for (Int_t i = 0; i<fBN; i++)
   {
     AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
     nucleonB->SetInNucleusB();
     nucleonB->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonB->SetSigNN(fSigFluc->GetRandom());
+      nucleonB->SetSigNN(GetRandomSigNN());
+    fNucB[i] = nucleonB;
+    fXB[i]   = nucleonB->GetX();
+    fYB[i]   = nucleonB->GetY();
+    fSigB[i] = nucleonB->GetSigNN();
   }
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-    fXSect = fSigFluc->GetRandom();
-  }
+  if (fDoFluc)
+    fXSect = GetRandomSigNN();
   // "ball" diameter = distance at which two balls interact
   Double_t d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
 
   Double_t bNN   = 0;
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
-
-  // for each of the A nucleons in nucleus B
-  for (Int_t i = 0; i<fBN; i++)
-  {
-    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-    for (Int_t j = 0 ; j < fAN ; j++)
-    {
-      AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
-      Double_t dx = nucleonB->GetX()-nucleonA->GetX();
-      Double_t dy = nucleonB->GetY()-nucleonA->GetY();
-      Double_t dij = dx*dx+dy*dy;
-      if (fDoFluc) {
-	//fXSect = nucleonA->GetSigNN();
-	//fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
-	fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
-	d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
-      }
-      if (dij < d2)
-      {
-	bNN += dij;
-	++Nco;
-        nucleonB->Collide();
-        nucleonA->Collide();
-	if (dij<d2/4)
-	  ++Ncohc;
-      }
-    }
-  }
+  FindCollisions(d2,bNN,Nco,Ncohc);
 
   if (Nco>0) {
     fNcollw = Ncohc;
@@ -554,6 +566,149 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
   return CalcResults(bgen);
 }
 
+//______________________________________________________________________________
+void AliGlauberMC::FindCollisions(Double_t d2, Double_t &bNN, Double_t &nco, Double_t &ncohc)
+{
+  // Collision search in the transverse plane. The nucleons of A are
+  // sorted into a grid with cells as large as the largest interaction
+  // distance, so only the 3x3 cells around each nucleon of B are tested.
+  // Pairs are accumulated in the order of the full A x B loop (B outer,
+  // A inner), which keeps bNN bit-identical to the brute-force search.
+  // With fluctuating cross sections d2 is taken pair by pair from the
+  // larger sigNN, and fXSect is left at the value of the last pair.
+
+  if (fAN<=0 || fBN<=0) return;
+
+  Double_t d2max = d2;
+  if (fDoFluc) {
+    Double_t sigmax = 0;
+    for (Int_t j = 0; j<fAN; j++) sigmax = TMath::Max(sigmax,fSigA[j]);
+    for (Int_t i = 0; i<fBN; i++) sigmax = TMath::Max(sigmax,fSigB[i]);
+    d2max = sigmax/(TMath::Pi()*10);
+  }
+
+  Double_t xmin = fXA[0], xmax = fXA[0];
+  Double_t ymin = fYA[0], ymax = fYA[0];
+  for (Int_t j = 1; j<fAN; j++) {
+    xmin = TMath::Min(xmin,fXA[j]);
+    xmax = TMath::Max(xmax,fXA[j]);
+    ymin = TMath::Min(ymin,fYA[j]);
+    ymax = TMath::Max(ymax,fYA[j]);
+  }
+  const Int_t kMaxCells = 64; // per dimension
+  Double_t h = TMath::Sqrt(TMath::Max(d2max,0.))*(1+1e-6);
+  h = TMath::Max(h,(xmax-xmin)/kMaxCells);
+  h = TMath::Max(h,(ymax-ymin)/kMaxCells);
+  Int_t nx = (h>0) ? (Int_t)((xmax-xmin)/h)+1 : 1;
+  Int_t ny = (h>0) ? (Int_t)((ymax-ymin)/h)+1 : 1;
+  nx = TMath::Min(nx,kMaxCells);
+  ny = TMath::Min(ny,kMaxCells);
+  Bool_t useGrid = (h>0) && (fAN*fBN>256) && (nx*ny>1);
+
+  if (useGrid) {
+    // counting sort of A by cell, indices ascending inside each cell
+    fCellStart.assign(nx*ny+1,0);
+    fCellIndex.resize(fAN);
+    for (Int_t j = 0; j<fAN; j++) {
+      Int_t ix = TMath::Min((Int_t)((fXA[j]-xmin)/h),nx-1);
+      Int_t iy = TMath::Min((Int_t)((fYA[j]-ymin)/h),ny-1);
+      fCellStart[ix*ny+iy+1]++;
+    }
+    for (Int_t c = 0; c<nx*ny; c++) fCellStart[c+1] += fCellStart[c];
+    fCellIndex.assign(fAN,0);
+    std::vector<Int_t> fill(fCellStart.begin(),fCellStart.end()-1);
+    for (Int_t j = 0; j<fAN; j++) {
+      Int_t ix = TMath::Min((Int_t)((fXA[j]-xmin)/h),nx-1);
+      Int_t iy = TMath::Min((Int_t)((fYA[j]-ymin)/h),ny-1);
+      fCellIndex[fill[ix*ny+iy]++] = j;
+    }
+  }
+
+  // for each of the A nucleons in nucleus B
+  for (Int_t i = 0; i<fBN; i++)
+  {
+    const Double_t xb = fXB[i];
+    const Double_t yb = fYB[i];
+    fPairs.clear();
+    if (useGrid) {
+      Int_t ix = (Int_t)TMath::Floor((xb-xmin)/h);
+      Int_t iy = (Int_t)TMath::Floor((yb-ymin)/h);
+      Int_t ix0 = TMath::Max(ix-1,0), ix1 = TMath::Min(ix+1,nx-1);
+      Int_t iy0 = TMath::Max(iy-1,0), iy1 = TMath::Min(iy+1,ny-1);
+      for (Int_t cx = ix0; cx<=ix1; cx++) {
+        for (Int_t cy = iy0; cy<=iy1; cy++) {
+          Int_t c = cx*ny+cy;
+          for (Int_t k = fCellStart[c]; k<fCellStart[c+1]; k++) {
+            Int_t j = fCellIndex[k];
+            Double_t dx = xb-fXA[j];
+            Double_t dy = yb-fYA[j];
+            Double_t dij = dx*dx+dy*dy;
+            Double_t d2ij = fDoFluc ? TMath::Max(fSigA[j],fSigB[i])/(TMath::Pi()*10) : d2;
+            if (dij < d2ij)
+              fPairs.push_back(std::make_pair(j,dij));
+          }
+        }
+      }
+      std::sort(fPairs.begin(),fPairs.end());
+    } else {
+      for (Int_t j = 0 ; j < fAN ; j++)
+      {
+        Double_t dx = xb-fXA[j];
+        Double_t dy = yb-fYA[j];
+        Double_t dij = dx*dx+dy*dy;
+        Double_t d2ij = fDoFluc ? TMath::Max(fSigA[j],fSigB[i])/(TMath::Pi()*10) : d2;
+        if (dij < d2ij)
+          fPairs.push_back(std::make_pair(j,dij));
+      }
+    }
+    for (UInt_t k = 0; k<fPairs.size(); k++)
+    {
+      Int_t j = fPairs[k].first;
+      Double_t dij = fPairs[k].second;
+      Double_t d2ij = fDoFluc ? TMath::Max(fSigA[j],fSigB[i])/(TMath::Pi()*10) : d2;
+      bNN += dij;
+      ++nco;
+      fNucB[i]->Collide();
+      fNucA[j]->Collide();
+      if (dij<d2ij/4)
+        ++ncohc;
+    }
+  }
+
+  if (fDoFluc)
+    fXSect = TMath::Max(fSigA[fAN-1],fSigB[fBN-1]);
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::InitSigFluc()
+{
+  // create the sigNN fluctuation function once
+  if (fSigFluc) return;
+  fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
+  fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
+  cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberMC::GetRandomSigNN()
+{
+  // fluctuating sigNN; Run workers sample from a table with their own generator
+  if (fRandom) {
+    if (fSigFlucCdf.empty())
+      AliGlauberNucleus::MakeCumulative(fSigFluc,fSigFlucCdf);
+    if (!fSigFlucCdf.empty())
+      return AliGlauberNucleus::GetRandomFromCumulative(fSigFluc,fSigFlucCdf,fRandom);
+  }
+  return fSigFluc->GetRandom();
+}
+
+//______________________________________________________________________________
+TRandom *AliGlauberMC::GetRandomGen() const
+{
+  // random generator of this instance
+  return fRandom ? fRandom : gRandom;
+}
+
 //______________________________________________________________________________
 Bool_t AliGlauberMC::CalcResults(Double_t bgen)
 {
@@ -1267,7 +1422,7 @@ Int_t AliGlauberMC::NegativeBinomialRandom(Int_t k, Double_t nmean) const
   {
     array[i] = NegativeBinomialDistribution(i,k,nmean) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandomGen()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 
 }
@@ -1278,7 +1433,7 @@ Int_t AliGlauberMC::NegativeBinomialRandomSV(Double_t k, Double_t nbar) const
   // negative binomial distribution generator, S. Voloshin, 09-May-2007
   Double_t sum=0.;
   Int_t i=0;
-  Double_t ran=gRandom->Rndm();
+  Double_t ran=GetRandomGen()->Rndm();
   Double_t trm=1./pow(1.+nbar/k,k);
   if (trm==0.)
   {
@@ -1308,7 +1463,7 @@ Int_t AliGlauberMC::DoubleNegativeBinomialRandom( Int_t k,
   {
     array[i] = alpha*NegativeBinomialDistribution(i,k,nmean)+(1-alpha)*NegativeBinomialDistribution(i,k2,nmean2) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandomGen()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 }
 
@@ -1506,7 +1661,7 @@ Bool_t AliGlauberMC::NextEvent(Double_t bgen)
   {
     if(bgen<0||!succes) //get impactparameter
     {
-      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*gRandom->Rndm()+fBMin*fBMin);
+      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*GetRandomGen()->Rndm()+fBMin*fBMin);
     }
     if ( (succes=CalcEvent(bgen)) ) break; //ends if we have particparts
   }
@@ -1694,6 +1849,11 @@ void AliGlauberMC::Run(Int_t nevents)
                       "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
     fnt->SetDirectory(0);
   }
+  if (fNThreads>1)
+  {
+    RunParallel(nevents);
+    return;
+  }
   Int_t q = 0;
   Int_t u = 0;
   for (Int_t i = 0; i<nevents; i++)
@@ -1707,67 +1867,7 @@ void AliGlauberMC::Run(Int_t nevents)
 
     q++;
     Float_t v[48];
-    v[0]  = GetNpart();
-    v[1]  = GetNcoll();
-    v[2]  = fBMC;
-    v[3]  = fMeanXParts;
-    v[4]  = fMeanYParts;
-    v[5]  = fMeanX2Parts;
-    v[6]  = fMeanY2Parts;
-    v[7]  = fMeanXYParts;
-    v[8]  = fSx2Parts;
-    v[9]  = fSy2Parts;
-    v[10] = fSxyParts;
-    v[11] = fMeanXSystem;
-    v[12] = fMeanYSystem;
-    v[13] = fMeanXA;
-    v[14] = fMeanYA;
-    v[15] = fMeanXB;
-    v[16] = fMeanYB;
-    v[17] = GetEccentricity();
-    v[18] = GetStoa();
-    v[19] = GetEccentricityColl();
-    v[20] = GetEccentricityCom();
-    v[21] = GetEccentricityPart();
-    v[22] = GetEccentricityPartColl();
-    v[23] = GetEccentricityPartCom();
-    if (fDoPartProd)
-    {
-      v[24] = GetdNdEta();
-      v[25] = GetdNdEta();
-      v[26] = v[24]+v[25];
-    }
-    else
-    {
-      v[24] = 0;
-      v[25] = 0;
-      v[26] = 0;
-    }
-    v[27]=fXSect;
-
-    Float_t mytAA=-999;
-    if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
-    v[28]=mytAA;
-    //_____________epsilon2,3,4,4_______
-    v[29] = GetEpsilon2Part();
-    v[30] = GetEpsilon3Part();
-    v[31] = GetEpsilon4Part();
-    v[32] = GetEpsilon5Part();
-    v[33] = GetEpsilon2Coll();
-    v[34] = GetEpsilon3Coll();
-    v[35] = GetEpsilon4Coll();
-    v[36] = GetEpsilon5Coll();
-    v[37] = GetEpsilon2Com();
-    v[38] = GetEpsilon3Com();
-    v[39] = GetEpsilon4Com();
-    v[40] = GetEpsilon5Com();
-    v[41] = GetPsi2();
-    v[42] = GetPsi3();
-    v[43] = GetPsi4();
-    v[44] = GetPsi5();
-    v[45] = fBNN;
-    v[46] = fXSect;
-    v[47] = fNcollw;
+    FillRow(v);
 
     //always at the end
     fnt->Fill(v);
@@ -1777,6 +1877,181 @@ void AliGlauberMC::Run(Int_t nevents)
   std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
 }
 
+//______________________________________________________________________________
+void AliGlauberMC::FillRow(Float_t *v) const
+{
+  // ntuple row of the current event
+  v[0]  = GetNpart();
+  v[1]  = GetNcoll();
+  v[2]  = fBMC;
+  v[3]  = fMeanXParts;
+  v[4]  = fMeanYParts;
+  v[5]  = fMeanX2Parts;
+  v[6]  = fMeanY2Parts;
+  v[7]  = fMeanXYParts;
+  v[8]  = fSx2Parts;
+  v[9]  = fSy2Parts;
+  v[10] = fSxyParts;
+  v[11] = fMeanXSystem;
+  v[12] = fMeanYSystem;
+  v[13] = fMeanXA;
+  v[14] = fMeanYA;
+  v[15] = fMeanXB;
+  v[16] = fMeanYB;
+  v[17] = GetEccentricity();
+  v[18] = GetStoa();
+  v[19] = GetEccentricityColl();
+  v[20] = GetEccentricityCom();
+  v[21] = GetEccentricityPart();
+  v[22] = GetEccentricityPartColl();
+  v[23] = GetEccentricityPartCom();
+  if (fDoPartProd)
+  {
+    v[24] = GetdNdEta();
+    v[25] = GetdNdEta();
+    v[26] = v[24]+v[25];
+  }
+  else
+  {
+    v[24] = 0;
+    v[25] = 0;
+    v[26] = 0;
+  }
+  v[27]=fXSect;
+
+  Float_t mytAA=-999;
+  if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
+  v[28]=mytAA;
+  //_____________epsilon2,3,4,4_______
+  v[29] = GetEpsilon2Part();
+  v[30] = GetEpsilon3Part();
+  v[31] = GetEpsilon4Part();
+  v[32] = GetEpsilon5Part();
+  v[33] = GetEpsilon2Coll();
+  v[34] = GetEpsilon3Coll();
+  v[35] = GetEpsilon4Coll();
+  v[36] = GetEpsilon5Coll();
+  v[37] = GetEpsilon2Com();
+  v[38] = GetEpsilon3Com();
+  v[39] = GetEpsilon4Com();
+  v[40] = GetEpsilon5Com();
+  v[41] = GetPsi2();
+  v[42] = GetPsi3();
+  v[43] = GetPsi4();
+  v[44] = GetPsi5();
+  v[45] = fBNN;
+  v[46] = fXSect;
+  v[47] = fNcollw;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunBlock(Int_t nevents, UInt_t seed, std::vector<Float_t> *rows, Int_t *nfailed)
+{
+  // generate one block of events with its own random stream (worker thread)
+  fRandom->SetSeed(seed);
+  // CalcResults carries the participant second moments over from the
+  // previous event; start each block as a fresh object would, so a block
+  // does not depend on which worker generated it
+  fMeanX2Parts = 0;
+  fMeanY2Parts = 0;
+  fMeanXYParts = 0;
+  rows->clear();
+  rows->reserve(48*nevents);
+  *nfailed = 0;
+  Float_t v[48];
+  for (Int_t i = 0; i<nevents; i++)
+  {
+    if(!NextEvent())
+    {
+      (*nfailed)++;
+      continue;
+    }
+    FillRow(v);
+    rows->insert(rows->end(),v,v+48);
+  }
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunParallel(Int_t nevents)
+{
+  // Threaded Run: the events are cut into blocks of fixed size, each
+  // generated with a TRandom3 seeded by fSeed and the block number. The
+  // workers are copies of this object with their own nuclei and
+  // generators; rows are appended to the ntuple in block order, so the
+  // output depends on fSeed only, not on the number of threads.
+  // Note: the radial densities and sigNN fluctuations are sampled from
+  // tables (see AliGlauberNucleus::SetRandom), hence a threaded sample is
+  // statistically, but not event by event, equivalent to a serial one.
+  const Int_t kBlockSize = 10000;
+  Int_t nthreads = fNThreads;
+  UInt_t seed = fSeed;
+  if (seed==0)
+    seed = gRandom->Integer(kMaxUInt);
+  cout << "Using " << nthreads << " threads, seed " << seed << endl;
+
+  if (fDoFluc) InitSigFluc();
+  std::vector<AliGlauberMC*> workers(nthreads);
+  for (Int_t t = 0; t<nthreads; t++)
+  {
+    AliGlauberMC *w = new AliGlauberMC(*this);
+    w->fnt = 0;
+    w->fNThreads = 1;
+    w->fEvents = 0;
+    w->fTotalEvents = 0;
+    w->fMaxNpartFound = 0;
+    w->fRandom = new TRandom3(seed);
+    w->fANucleus.SetRandom(w->fRandom);
+    w->fBNucleus.SetRandom(w->fRandom);
+    if (w->fDoFluc)
+      AliGlauberNucleus::MakeCumulative(w->fSigFluc,w->fSigFlucCdf);
+    workers[t] = w;
+  }
+
+  Int_t nblocks = (nevents+kBlockSize-1)/kBlockSize;
+  std::vector<std::vector<Float_t> > rows(nthreads);
+  std::vector<Int_t> nfailed(nthreads,0);
+  Int_t q = 0;
+  Int_t u = 0;
+  for (Int_t first = 0; first<nblocks; first += nthreads)
+  {
+    Int_t nrun = TMath::Min(nthreads,nblocks-first);
+    std::vector<std::thread> threads;
+    for (Int_t t = 0; t<nrun; t++)
+    {
+      Int_t block = first+t;
+      Int_t n = TMath::Min(kBlockSize,nevents-block*kBlockSize);
+      UInt_t blockseed = seed+(UInt_t)block;
+      if (blockseed==0) blockseed = kMaxUInt; // 0 would make TRandom3 pick a random seed
+      threads.push_back(std::thread(&AliGlauberMC::RunBlock,workers[t],n,blockseed,&rows[t],&nfailed[t]));
+    }
+    for (Int_t t = 0; t<nrun; t++)
+      threads[t].join();
+    for (Int_t t = 0; t<nrun; t++)
+    {
+      for (UInt_t r = 0; r<rows[t].size(); r += 48)
+        fnt->Fill(&rows[t][r]);
+      q += rows[t].size()/48;
+      u += nfailed[t];
+    }
+    std::cout << "Generating Event # " << TMath::Min(nevents,(first+nrun)*kBlockSize) << "... \r" << flush;
+  }
+
+  for (Int_t t = 0; t<nthreads; t++)
+  {
+    AliGlauberMC *w = workers[t];
+    fEvents += w->fEvents;
+    fTotalEvents += w->fTotalEvents;
+    fMaxNpartFound = TMath::Max(fMaxNpartFound,w->fMaxNpartFound);
+    w->fANucleus.SetRandom(0);
+    w->fBNucleus.SetRandom(0);
+    delete w->fRandom;
+    w->fRandom = 0;
+    w->fSigFluc = 0;
+    delete w;
+  }
+  std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
 //---------------------------------------------------------------------------------
 void AliGlauberMC::RunAndSaveNtuple( Int_t n,
                                      const Option_t *sysA,
@@ -1785,13 +2060,15 @@ void AliGlauberMC::RunAndSaveNtuple( Int_t n,
                                      Double_t mind,
                                      Double_t r,
                                      Double_t a,
-                                     const char *fname)
+                                     const char *fname,
+                                     Int_t nthreads)
 {
   //example run
   AliGlauberMC mcg(sysA,sysB,signn);
   mcg.SetMinDistance(mind);
   mcg.Setr(r);
   mcg.Seta(a);
+  mcg.SetNThreads(nthreads);
   mcg.Run(n);
   TNtuple  *nt=mcg.GetNtuple();
   TFile out(fname,"recreate",fname,9);
@@ -16,9 +16,13 @@
 #include "AliGlauberNucleus.h"
 #include <Riostream.h>
 #include <TNamed.h>
+#include <utility>
+#include <vector>
 
 class TObjArray;
 class TNtuple;
+class TRandom;
+class AliGlauberNucleon;
 
 using std::cout;
 using std::endl;
@@ -100,6 +104,10 @@ public:
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
             {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;}
+   void   SetNThreads(Int_t n)        {fNThreads = n;}
+   void   SetSeed(UInt_t seed)        {fSeed = seed;}
+   Int_t  GetNThreads()         const {return fNThreads;}
+   UInt_t GetSeed()             const {return fSeed;}
    static void       PrintVersion()         {cout << "AliGlauberMC " << Version() << endl;}
    static const char *Version()             {return "v1.2";}
    static void       RunAndSaveNtuple( Int_t n,
@@ -109,7 +117,8 @@ public:
                                        Double_t mind=0.4,
 				       Double_t r=6.62,
 				       Double_t a=0.546,
-                                       const char *fname="glau_pbpb_ntuple.root");
+                                       const char *fname="glau_pbpb_ntuple.root",
+                                       Int_t nthreads=1);
    void RunAndSaveNucleons( Int_t n,
                             const Option_t *sysA,
                             const Option_t *sysB,
@@ -251,9 +260,32 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   Int_t        fNThreads;       //Number of threads used by Run (<=1: serial, gRandom)
+   UInt_t       fSeed;           //Seed of the per-block random streams of a threaded Run (0: from gRandom)
+   TRandom     *fRandom;         //!Own random generator of a Run worker (0 = gRandom)
+   std::vector<Double_t> fSigFlucCdf;        //!Tabulated fSigFluc, used with fRandom
+   std::vector<AliGlauberNucleon*> fNucA;    //!Nucleons of A in the current event
+   std::vector<AliGlauberNucleon*> fNucB;    //!Nucleons of B in the current event
+   std::vector<Double_t> fXA;                //!x of nucleons in A (SoA copy)
+   std::vector<Double_t> fYA;                //!y of nucleons in A
+   std::vector<Double_t> fSigA;              //!sigNN of nucleons in A
+   std::vector<Double_t> fXB;                //!x of nucleons in B
+   std::vector<Double_t> fYB;                //!y of nucleons in B
+   std::vector<Double_t> fSigB;              //!sigNN of nucleons in B
+   std::vector<Int_t>    fCellStart;         //!Grid over A: first entry of each cell in fCellIndex
+   std::vector<Int_t>    fCellIndex;         //!Grid over A: nucleon indices ordered by cell
+   std::vector<std::pair<Int_t,Double_t> > fPairs; //!Colliding partners (index, d^2) of one B nucleon
+
    Bool_t       CalcResults(Double_t bgen);
+   void         InitSigFluc();
+   Double_t     GetRandomSigNN();
+   TRandom     *GetRandomGen() const;
+   void         FindCollisions(Double_t d2, Double_t &bNN, Double_t &nco, Double_t &ncohc);
+   void         FillRow(Float_t *v) const;
+   void         RunBlock(Int_t nevents, UInt_t seed, std::vector<Float_t> *rows, Int_t *nfailed);
+   void         RunParallel(Int_t nevents);
 
-   ClassDef(AliGlauberMC,4)
+   ClassDef(AliGlauberMC,5)
 };
 
 #endif
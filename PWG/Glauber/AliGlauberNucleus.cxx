@@ -30,6 +30,7 @@
 #include <TObjArray.h>
 #include <TF1.h>
 #include <TRandom.h>
+#include <algorithm>
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
 
@@ -49,7 +50,12 @@ AliGlauberNucleus::AliGlauberNucleus(Option_t* iname, Int_t iN, Double_t iR, Dou
   fF(0),
   fTrials(0),
   fFunction(ifunc),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fRandom(0),
+  fRadialCdf(),
+  fXs(),
+  fYs(),
+  fZs()
 {
    if (fN==0) {
       cout << "Setting up nucleus " << iname << endl;
@@ -76,10 +82,17 @@ AliGlauberNucleus::AliGlauberNucleus(const AliGlauberNucleus& in):
   fMinDist(in.fMinDist),
   fF(in.fF),
   fTrials(in.fTrials),
-  fFunction(in.fFunction),
-  fNucleons(NULL)
+  fFunction(0),
+  fNucleons(NULL),
+  fRandom(0),
+  fRadialCdf(),
+  fXs(),
+  fYs(),
+  fZs()
 {
   //copy ctor
+  if (in.fFunction)
+    fFunction=static_cast<TF1*>(in.fFunction->Clone());
   if (in.fNucleons)
     fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
 }
@@ -96,10 +109,18 @@ AliGlauberNucleus& AliGlauberNucleus::operator=(const AliGlauberNucleus& in)
   fMinDist=in.fMinDist;
   fF=in.fF;
   fTrials=in.fTrials;
-  fFunction=in.fFunction;
+  delete fFunction;
+  fFunction=0;
+  if (in.fFunction)
+    fFunction=static_cast<TF1*>(in.fFunction->Clone());
+  fRandom=0;
+  fRadialCdf.clear();
   delete fNucleons;
-  fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
-  fNucleons->SetOwner();
+  fNucleons=0;
+  if (in.fNucleons) {
+    fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
+    fNucleons->SetOwner();
+  }
   return *this;
 }
 
@@ -177,6 +198,7 @@ void AliGlauberNucleus::Lookup(Option_t* name)
 void AliGlauberNucleus::SetR(Double_t ir)
 {
    fR = ir;
+   fRadialCdf.clear();
    switch (fF)
    {
       case 0: // Proton
@@ -195,6 +217,7 @@ void AliGlauberNucleus::SetR(Double_t ir)
 void AliGlauberNucleus::SetA(Double_t ia)
 {
    fA = ia;
+   fRadialCdf.clear();
    switch (fF)
    {
       case 0: // Proton
@@ -212,6 +235,7 @@ void AliGlauberNucleus::SetA(Double_t ia)
 void AliGlauberNucleus::SetW(Double_t iw)
 {
    fW = iw;
+   fRadialCdf.clear();
    switch (fF)
    {
       case 0: // Proton
@@ -225,6 +249,61 @@ void AliGlauberNucleus::SetW(Double_t iw)
    }
 }
 
+//______________________________________________________________________________
+void AliGlauberNucleus::SetRandom(TRandom* rnd)
+{
+   // Use an own random generator instead of gRandom. The radial density
+   // is then sampled from a table built here, so that no call to
+   // TF1::GetRandom (which always draws from gRandom) is made while
+   // throwing nucleons. Must be called from the thread owning the nucleus
+   // before it is handed to a worker thread.
+   fRandom = rnd;
+   fRadialCdf.clear();
+   if (fRandom && fFunction)
+      MakeCumulative(fFunction,fRadialCdf);
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::MakeCumulative(TF1* f, std::vector<Double_t>& cdf, Int_t npx)
+{
+   // Tabulate the normalised cumulative of f on npx equidistant bins of
+   // its range (Simpson rule per bin)
+   cdf.assign(npx+1,0.);
+   Double_t xmin = f->GetXmin();
+   Double_t dx = (f->GetXmax()-xmin)/npx;
+   Double_t flo = TMath::Max(f->Eval(xmin),0.);
+   for (Int_t i = 0; i<npx; i++) {
+      Double_t x0 = xmin + i*dx;
+      Double_t fmid = TMath::Max(f->Eval(x0+dx/2),0.);
+      Double_t fhi = TMath::Max(f->Eval(x0+dx),0.);
+      cdf[i+1] = cdf[i] + dx*(flo+4*fmid+fhi)/6.;
+      flo = fhi;
+   }
+   if (cdf[npx]<=0) {
+      cdf.clear();
+      return;
+   }
+   for (Int_t i = 1; i<=npx; i++)
+      cdf[i] /= cdf[npx];
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::GetRandomFromCumulative(const TF1* f, const std::vector<Double_t>& cdf, TRandom* rnd)
+{
+   // Inverse-transform sampling on a table made by MakeCumulative,
+   // linear within a bin
+   Int_t npx = cdf.size()-1;
+   Double_t xmin = f->GetXmin();
+   Double_t dx = (f->GetXmax()-xmin)/npx;
+   Double_t u = rnd->Rndm();
+   Int_t bin = std::upper_bound(cdf.begin(),cdf.end(),u)-cdf.begin()-1;
+   if (bin<0) bin = 0;
+   if (bin>=npx) return f->GetXmax();
+   Double_t w = cdf[bin+1]-cdf[bin];
+   Double_t frac = (w>0) ? (u-cdf[bin])/w : 0.5;
+   return xmin + (bin+frac)*dx;
+}
+
 //______________________________________________________________________________
 void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
 {
@@ -239,6 +318,15 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    
    fTrials = 0;
 
+   TRandom *rnd = fRandom ? fRandom : gRandom;
+   if (fRandom && fRadialCdf.empty() && fFunction)
+      MakeCumulative(fFunction,fRadialCdf);
+   Bool_t useTable = fRandom && !fRadialCdf.empty();
+   fXs.resize(fN);
+   fYs.resize(fN);
+   fZs.resize(fN);
+   Double_t mind2 = fMinDist*fMinDist*(1+1e-9); // prefilter, the test itself is unchanged
+
    Double_t sumx=0;       
    Double_t sumy=0;       
    Double_t sumz=0;       
@@ -246,9 +334,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    Bool_t hulthen = (TString(GetName())=="dh");
    if (fN==2 && hulthen) { //special treatmeant for Hulten
 
-      Double_t r = fFunction->GetRandom()/2;
-      Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-      Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+      Double_t r = (useTable ? GetRandomFromCumulative(fFunction,fRadialCdf,rnd) : fFunction->GetRandom())/2;
+      Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+      Double_t ctheta = 2*rnd->Rndm() - 1 ;
       Double_t stheta = sqrt(1-ctheta*ctheta);
      
       AliGlauberNucleon *nucleon1=(AliGlauberNucleon*)(fNucleons->UncheckedAt(0));
@@ -270,9 +358,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
       nucleon->Reset();
       while(1) {
          fTrials++;
-         Double_t r = fFunction->GetRandom();
-         Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-         Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+         Double_t r = useTable ? GetRandomFromCumulative(fFunction,fRadialCdf,rnd) : fFunction->GetRandom();
+         Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+         Double_t ctheta = 2*rnd->Rndm() - 1 ;
          Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
          Double_t x = r * stheta * cos(phi) + xshift;
          Double_t y = r * stheta * sin(phi);      
@@ -281,13 +369,12 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
          if(fMinDist<0) break;
          Bool_t test=1;
          for (Int_t j = 0; j<i; j++) {
-            AliGlauberNucleon *other=(AliGlauberNucleon*)fNucleons->UncheckedAt(j);
-            Double_t xo=other->GetX();
-            Double_t yo=other->GetY();
-            Double_t zo=other->GetZ();
-            Double_t dist = TMath::Sqrt((x-xo)*(x-xo)+
-                                       (y-yo)*(y-yo)+
-                                       (z-zo)*(z-zo));
+            Double_t dx = x-fXs[j];
+            Double_t dy = y-fYs[j];
+            Double_t dz = z-fZs[j];
+            Double_t dist2 = dx*dx+dy*dy+dz*dz;
+            if (dist2>=mind2) continue; // certainly outside, skip the sqrt
+            Double_t dist = TMath::Sqrt(dist2);
 	       
             if(dist<fMinDist) {
                test=0;
@@ -296,6 +383,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
          }
          if (test) break; //found nucleuon outside of mindist
       }
+      fXs[i] = nucleon->GetX();
+      fYs[i] = nucleon->GetY();
+      fZs[i] = nucleon->GetZ();
            
       sumx += nucleon->GetX();
       sumy += nucleon->GetY();
@@ -16,8 +16,10 @@
 
 //class TNamed;
 #include <TNamed.h>
+#include <vector>
 class TObjArray;
 class TF1;
+class TRandom;
 
 class AliGlauberNucleus : public TNamed {
 private:
@@ -30,6 +32,11 @@ private:
    Int_t      fTrials;     //Store trials needed to complete nucleus
    TF1*       fFunction;   //Probability density function rho(r)
    TObjArray* fNucleons;   //Array of nucleons
+   TRandom*   fRandom;     //!Random generator (0 = gRandom and TF1::GetRandom)
+   std::vector<Double_t> fRadialCdf; //!Tabulated cumulative of fFunction, used with fRandom
+   std::vector<Double_t> fXs;        //!x of the nucleons placed so far (SoA copy for the min. distance test)
+   std::vector<Double_t> fYs;        //!y of the nucleons placed so far
+   std::vector<Double_t> fZs;        //!z of the nucleons placed so far
 
    void       Lookup(Option_t* name);
 
@@ -52,9 +59,13 @@ public:
    void       SetA(Double_t ia);
    void       SetW(Double_t iw);
    void       SetMinDist(Double_t min) {fMinDist=min;}
+   void       SetRandom(TRandom* rnd);
    void       ThrowNucleons(Double_t xshift=0.);
 
-   ClassDef(AliGlauberNucleus,1)
+   static void     MakeCumulative(TF1* f, std::vector<Double_t>& cdf, Int_t npx=2000);
+   static Double_t GetRandomFromCumulative(const TF1* f, const std::vector<Double_t>& cdf, TRandom* rnd);
+
+   ClassDef(AliGlauberNucleus,2)
 };
 
 #endif
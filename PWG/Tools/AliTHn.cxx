@@ -39,6 +39,7 @@
 #include "TArrayD.h"
 #include "THnSparse.h"
 #include "TMath.h"
+#include "TBuffer.h"
 
 templateClassImp(AliTHnT)
 
@@ -53,7 +54,15 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fUniformCache(0),
+  fXminCache(0),
+  fXmaxCache(0),
+  fNThreads(0),
+  fShadowValues(0),
+  fShadowSumw2(0),
+  fShadowLastVars(0),
+  fShadowLastBins(0)
 {
   // Constructor
 }
@@ -69,7 +78,15 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fUniformCache(0),
+  fXminCache(0),
+  fXmaxCache(0),
+  fNThreads(0),
+  fShadowValues(0),
+  fShadowSumw2(0),
+  fShadowLastVars(0),
+  fShadowLastBins(0)
 {
   // Constructor
 
@@ -106,12 +123,23 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fUniformCache(0),
+  fXminCache(0),
+  fXmaxCache(0),
+  fNThreads(0),
+  fShadowValues(0),
+  fShadowSumw2(0),
+  fShadowLastVars(0),
+  fShadowLastBins(0)
 {
   //
   // AliTHnT copy constructor
   //
 
+  // shadow containers are not copied, their content is added to the copied containers
+  const_cast<AliTHnT&>(c).MergeShadows();
+
   memset(fValues,0,fNSteps*sizeof(TemplateArray*));
   memset(fSumw2,0,fNSteps*sizeof(TemplateArray*));
 
@@ -128,6 +156,7 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   // Destructor
   
   DeleteContainers();
+  DeleteShadows();
   
   delete[] fValues;
   delete[] fSumw2;
@@ -135,6 +164,9 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   delete[] fNbinsCache;
   delete[] fLastVars;
   delete[] fLastBins;
+  delete[] fUniformCache;
+  delete[] fXminCache;
+  delete[] fXmaxCache;
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -165,6 +197,8 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
   // assigment operator
 
   if (this != &c) {
+    const_cast<AliTHnT&>(c).MergeShadows();
+    DeleteShadows();
     AliCFContainer::operator=(c);
     fNBins=c.fNBins;
     fNVars=c.fNVars;
@@ -191,9 +225,21 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
       fValues = 0;
       fSumw2 = 0;
     }
+    // the caches are rebuilt from the own axes at the next Fill
     delete [] axisCache;
-    axisCache = new TAxis*[fNVars];
-    memcpy(axisCache, c.axisCache, fNVars*sizeof(TAxis*));
+    delete [] fNbinsCache;
+    delete [] fLastVars;
+    delete [] fLastBins;
+    delete [] fUniformCache;
+    delete [] fXminCache;
+    delete [] fXmaxCache;
+    axisCache = 0;
+    fNbinsCache = 0;
+    fLastVars = 0;
+    fLastBins = 0;
+    fUniformCache = 0;
+    fXminCache = 0;
+    fXmaxCache = 0;
   }
   return *this;
 }
@@ -206,6 +252,7 @@ void AliTHnT<TemplateArray, TemplateType>::Copy(TObject& c) const
 
   AliTHnT& target = (AliTHnT &) c;
   
+  const_cast<AliTHnT*>(this)->MergeShadows();
   AliCFContainer::Copy(target);
   
   target.fNSteps = fNSteps;
@@ -244,6 +291,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
   
   AliCFContainer::Merge(list);
 
+  MergeShadows();
+
   TIterator* iter = list->MakeIterator();
   TObject* obj;
   
@@ -254,6 +303,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     if (entry == 0) 
       continue;
 
+    entry->MergeShadows();
+
     for (Int_t i=0; i<fNSteps; i++)
     {
       if (entry->fValues[i])
@@ -282,82 +333,312 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 }
 
 template <class TemplateArray, typename TemplateType>
-void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+void AliTHnT<TemplateArray, TemplateType>::InitCache(const Double_t *var)
 {
-  // fills an entry
+  // fills axis cache
 
-  // fill axis cache
-  if (!axisCache)
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  fUniformCache = new Bool_t[fNVars];
+  fXminCache = new Double_t[fNVars];
+  fXmaxCache = new Double_t[fNVars];
+  for (Int_t i=0; i<fNVars; i++)
   {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
-    
-    fLastVars = new Double_t[fNVars];
-    fLastBins = new Int_t[fNVars];
-    
-    // initial values to prevent checking for 0 below
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      fLastBins[i] = axisCache[i]->FindBin(var[i]);
-      fLastVars[i] = var[i];
-    }
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+    fUniformCache[i] = (axisCache[i]->GetXbins()->GetSize() == 0);
+    fXminCache[i] = axisCache[i]->GetXmin();
+    fXmaxCache[i] = axisCache[i]->GetXmax();
   }
   
-  // calculate global bin index
+  fLastVars = new Double_t[fNVars];
+  fLastBins = new Int_t[fNVars];
+  
+  // initial values to prevent checking for 0 below
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    fLastBins[i] = (var) ? FindBinFast(i, var[i]) : -1;
+    fLastVars[i] = (var) ? var[i] : TMath::QuietNaN();
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+inline Int_t AliTHnT<TemplateArray, TemplateType>::FindBinFast(Int_t i, Double_t x) const
+{
+  // same result as TAxis::FindBin, but without virtual call and binary search for fixed bin width
+  
+  if (!fUniformCache[i])
+    return axisCache[i]->FindBin(x);
+  
+  if (x < fXminCache[i])
+    return 0;
+  if (!(x < fXmaxCache[i]))
+    return fNbinsCache[i] + 1;
+  return 1 + Int_t(fNbinsCache[i] * (x - fXminCache[i]) / (fXmaxCache[i] - fXminCache[i]));
+}
+
+template <class TemplateArray, typename TemplateType>
+inline Long64_t AliTHnT<TemplateArray, TemplateType>::FindGlobalBin(const Double_t *var, Double_t* lastVars, Int_t* lastBins) const
+{
+  // calculate global bin index, -1 for under/overflow
+  
   Long64_t bin = 0;
   for (Int_t i=0; i<fNVars; i++)
   {
     bin *= fNbinsCache[i];
     
     Int_t tmpBin = 0;
-    if (fLastVars[i] == var[i])
-      tmpBin = fLastBins[i];
+    if (lastVars[i] == var[i])
+      tmpBin = lastBins[i];
     else
     {
-      tmpBin = axisCache[i]->FindBin(var[i]);
-      fLastBins[i] = tmpBin;
-      fLastVars[i] = var[i];
+      tmpBin = FindBinFast(i, var[i]);
+      lastBins[i] = tmpBin;
+      lastVars[i] = var[i];
     }
-    //Printf("%d", tmpBin);
 
     // under/overflow not supported
     if (tmpBin < 1 || tmpBin > fNbinsCache[i])
-      return;
+      return -1;
     
     // bins start from 0 here
     bin += tmpBin - 1;
-//     Printf("%lld", bin);
   }
+  return bin;
+}
 
-  if (!fValues[istep])
+template <class TemplateArray, typename TemplateType>
+inline void AliTHnT<TemplateArray, TemplateType>::AddToBin(TemplateArray** values, TemplateArray** sumw2, Int_t istep, Long64_t bin, Double_t weight, Bool_t verbose)
+{
+  // adds weight to bin of step istep, creating the containers when needed
+
+  if (!values[istep])
   {
-    fValues[istep] = new TemplateArray(fNBins);
-    AliInfo(Form("Created values container for step %d", istep));
+    values[istep] = new TemplateArray(fNBins);
+    if (verbose)
+      AliInfo(Form("Created values container for step %d", istep));
   }
 
   if (weight != 1)
   {
     // initialize with already filled entries (which have been filled with weight == 1), in this case fSumw2 := fValues
-    if (!fSumw2[istep])
+    if (!sumw2[istep])
     {
-      fSumw2[istep] = new TemplateArray(*fValues[istep]);
-      AliInfo(Form("Created sumw2 container for step %d", istep));
+      sumw2[istep] = new TemplateArray(*values[istep]);
+      if (verbose)
+        AliInfo(Form("Created sumw2 container for step %d", istep));
     }
   }
 
-  fValues[istep]->GetArray()[bin] += weight;
-  if (fSumw2[istep])
-    fSumw2[istep]->GetArray()[bin] += weight * weight;
-  
-//   Printf("%f", fValues[istep][bin]);
+  values[istep]->GetArray()[bin] += weight;
+  if (sumw2[istep])
+    sumw2[istep]->GetArray()[bin] += weight * weight;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry
+
+  if (!axisCache)
+    InitCache(var);
   
-  // debug
-//   AliCFContainer::Fill(var, istep, weight);
+  Long64_t bin = FindGlobalBin(var, fLastVars, fLastBins);
+  if (bin < 0)
+    return;
+
+  AddToBin(fValues, fSumw2, istep, bin, weight, kTRUE);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight, Int_t thread)
+{
+  // fills an entry into the shadow containers of thread <thread> (0 <= thread < GetNumberOfThreads())
+  // can be called concurrently for different threads, see SetNumberOfThreads
+  // thread < 0 fills the main containers (not thread safe)
+
+  if (thread >= fNThreads)
+  {
+    Error("Fill", "Thread %d requested but only %d shadow containers prepared (see SetNumberOfThreads), filling the main containers", thread, fNThreads);
+    thread = -1;
+  }
+
+  if (thread < 0)
+  {
+    Fill(var, istep, weight);
+    return;
+  }
+
+  Long64_t bin = FindGlobalBin(var, fShadowLastVars + thread * fNVars, fShadowLastBins + thread * fNVars);
+  if (bin < 0)
+    return;
+
+  AddToBin(fShadowValues + thread * fNSteps, fShadowSumw2 + thread * fNSteps, istep, bin, weight, kFALSE);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillN(Int_t n, const Double_t *var, Int_t istep, const Double_t *weights, Int_t thread)
+{
+  // fills n entries, var contains n points of GetNVar() values each (row-major)
+  // weights (if given) contains n weights
+  // thread >= 0 fills the shadow containers of that thread (see Fill)
+
+  if (n <= 0)
+    return;
+
+  if (thread >= fNThreads)
+  {
+    Error("FillN", "Thread %d requested but only %d shadow containers prepared (see SetNumberOfThreads), filling the main containers", thread, fNThreads);
+    thread = -1;
+  }
+
+  TemplateArray** values = fValues;
+  TemplateArray** sumw2 = fSumw2;
+  Double_t* lastVars = fLastVars;
+  Int_t* lastBins = fLastBins;
+  Bool_t verbose = kTRUE;
+  if (thread < 0)
+  {
+    if (!axisCache)
+      InitCache(var);
+    lastVars = fLastVars;
+    lastBins = fLastBins;
+  }
+  else
+  {
+    values = fShadowValues + thread * fNSteps;
+    sumw2 = fShadowSumw2 + thread * fNSteps;
+    lastVars = fShadowLastVars + thread * fNVars;
+    lastBins = fShadowLastBins + thread * fNVars;
+    verbose = kFALSE;
+  }
+
+  for (Int_t j=0; j<n; j++)
+  {
+    Long64_t bin = FindGlobalBin(var + (Long64_t) j * fNVars, lastVars, lastBins);
+    if (bin < 0)
+      continue;
+    AddToBin(values, sumw2, istep, bin, (weights) ? weights[j] : 1., verbose);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetNumberOfThreads(Int_t nThreads)
+{
+  // prepares nThreads shadow containers for concurrent filling with Fill(var, istep, weight, thread)
+  // needs to be called outside of the parallel region; the axes must not be changed afterwards
+  // each thread allocates its own copy of the containers of the steps it fills
+
+  MergeShadows();
+  DeleteShadows();
+
+  if (!axisCache)
+    InitCache(0);
+
+  if (nThreads <= 0)
+    return;
+
+  fNThreads = nThreads;
+  fShadowValues = new TemplateArray*[fNThreads * fNSteps];
+  fShadowSumw2 = new TemplateArray*[fNThreads * fNSteps];
+  memset(fShadowValues, 0, fNThreads * fNSteps * sizeof(TemplateArray*));
+  memset(fShadowSumw2, 0, fNThreads * fNSteps * sizeof(TemplateArray*));
+  fShadowLastVars = new Double_t[fNThreads * fNVars];
+  fShadowLastBins = new Int_t[fNThreads * fNVars];
+  for (Int_t i=0; i<fNThreads * fNVars; i++)
+  {
+    fShadowLastVars[i] = TMath::QuietNaN();
+    fShadowLastBins[i] = -1;
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::MergeShadows()
+{
+  // adds the content of the shadow containers to the main containers and resets them
+  // threads are added in increasing order, so that the result does not depend on the scheduling
+  // must not be called while other threads are filling
+
+  for (Int_t t=0; t<fNThreads; t++)
+  {
+    for (Int_t i=0; i<fNSteps; i++)
+    {
+      TemplateArray* values = fShadowValues[t * fNSteps + i];
+      TemplateArray* sumw2 = fShadowSumw2[t * fNSteps + i];
+      if (!values)
+        continue;
+
+      if (!fValues[i])
+      {
+        fValues[i] = new TemplateArray(fNBins);
+        AliInfo(Form("Created values container for step %d", i));
+      }
+
+      // without sumw2 container, sumw2 is equal to the values
+      if (sumw2 && !fSumw2[i])
+      {
+        fSumw2[i] = new TemplateArray(*fValues[i]);
+        AliInfo(Form("Created sumw2 container for step %d", i));
+      }
+      if (fSumw2[i])
+      {
+        TemplateType* source = (sumw2) ? sumw2->GetArray() : values->GetArray();
+        TemplateType* target = fSumw2[i]->GetArray();
+        for (Long64_t l = 0; l<fNBins; l++)
+          target[l] += source[l];
+      }
+
+      TemplateType* source = values->GetArray();
+      TemplateType* target = fValues[i]->GetArray();
+      for (Long64_t l = 0; l<fNBins; l++)
+        target[l] += source[l];
+
+      values->Reset();
+      if (sumw2)
+      {
+        delete sumw2;
+        fShadowSumw2[t * fNSteps + i] = 0;
+      }
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::DeleteShadows()
+{
+  // deletes the shadow containers (their content is lost, see MergeShadows)
+
+  for (Int_t i=0; i<fNThreads * fNSteps; i++)
+  {
+    delete fShadowValues[i];
+    delete fShadowSumw2[i];
+  }
+  delete[] fShadowValues;
+  delete[] fShadowSumw2;
+  delete[] fShadowLastVars;
+  delete[] fShadowLastBins;
+  fShadowValues = 0;
+  fShadowSumw2 = 0;
+  fShadowLastVars = 0;
+  fShadowLastBins = 0;
+  fNThreads = 0;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Streamer(TBuffer &R__b)
+{
+  // stream an object of class AliTHnT
+  // the shadow containers are merged before writing, so that no entry is lost
+
+  if (R__b.IsReading())
+  {
+    R__b.ReadClassBuffer(AliTHnT::Class(), this);
+  }
+  else
+  {
+    MergeShadows();
+    R__b.WriteClassBuffer(AliTHnT::Class(), this);
+  }
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -382,6 +663,8 @@ void AliTHnT<TemplateArray, TemplateType>::FillContainer(AliCFContainer* cont)
 {
   // fills the information stored in the buffer in this class into the container <cont>
   
+  MergeShadows();
+
   for (Int_t i=0; i<fNSteps; i++)
   {
     if (!fValues[i])
@@ -459,6 +742,8 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
   
   Int_t axis = fNVars-1;
   
+  MergeShadows();
+
   for (Int_t i=0; i<fNSteps; i++)
   {
     if (!fValues[i])
@@ -9,6 +9,11 @@
 // Use AliTHn instead of AliCFContainer and your memory consumption will be drastically reduced
 // As AliTHn derives from AliCFContainer, you can just replace your current AliCFContainer object by AliTHn
 // Once you have the merged output, call FillParent() and you can use AliCFContainer as usual
+//
+// Parallel filling: call SetNumberOfThreads(n) once before the parallel region and fill with
+// Fill(var, istep, weight, thread) / FillN(..., thread). Each thread fills its own shadow copy
+// of the containers, which are added to the main containers in thread order by MergeShadows().
+// This is done automatically by FillParent(), Merge(), GetValues(), GetSumw2() and when the object is written.
 
 #include "TObject.h"
 #include "TString.h"
@@ -26,12 +31,17 @@ public:
   AliTHnBase(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn) : AliCFContainer(name, title, nSelStep, nVarIn, nBinIn) { }
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void Fill(const Double_t *var, Int_t istep, Double_t weight, Int_t thread) = 0;
+  virtual void FillN(Int_t n, const Double_t *var, Int_t istep, const Double_t *weights = 0, Int_t thread = -1) = 0;
   virtual void FillParent() = 0;
   virtual void FillContainer(AliCFContainer* cont) = 0;
 
   virtual TArray* GetValues(Int_t step) = 0;
   virtual TArray* GetSumw2(Int_t step) = 0;
 
+  virtual void SetNumberOfThreads(Int_t nThreads) = 0;
+  virtual void MergeShadows() = 0;
+
   virtual void DeleteContainers() = 0;
   virtual void ReduceAxis() = 0;  
   
@@ -48,11 +58,17 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void Fill(const Double_t *var, Int_t istep, Double_t weight, Int_t thread);
+  virtual void FillN(Int_t n, const Double_t *var, Int_t istep, const Double_t *weights = 0, Int_t thread = -1);
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
-  virtual TArray* GetValues(Int_t step) { return fValues[step]; }
-  virtual TArray* GetSumw2(Int_t step)  { return fSumw2[step]; }
+  virtual TArray* GetValues(Int_t step) { MergeShadows(); return fValues[step]; }
+  virtual TArray* GetSumw2(Int_t step)  { MergeShadows(); return fSumw2[step]; }
+
+  virtual void SetNumberOfThreads(Int_t nThreads);
+  Int_t GetNumberOfThreads() const { return fNThreads; }
+  virtual void MergeShadows();
   
   virtual void DeleteContainers();
   virtual void ReduceAxis();
@@ -65,6 +81,11 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitCache(const Double_t *var);
+  void DeleteShadows();
+  inline Int_t FindBinFast(Int_t i, Double_t x) const;
+  inline Long64_t FindGlobalBin(const Double_t *var, Double_t* lastVars, Int_t* lastBins) const;
+  inline void AddToBin(TemplateArray** values, TemplateArray** sumw2, Int_t istep, Long64_t bin, Double_t weight, Bool_t verbose);
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
   
   Long64_t fNBins;   // number of total bins
@@ -77,6 +98,15 @@ protected:
   Int_t* fNbinsCache; //! cache Nbins per axis
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+  Bool_t* fUniformCache; //! axis has fixed bin width (bin computed arithmetically instead of binary search)
+  Double_t* fXminCache; //! lower edge per axis
+  Double_t* fXmaxCache; //! upper edge per axis
+
+  Int_t fNThreads;                 //! number of thread-local shadow containers
+  TemplateArray** fShadowValues;   //! [fNThreads*fNSteps] shadow data containers
+  TemplateArray** fShadowSumw2;    //! [fNThreads*fNSteps] shadow sumw2 containers
+  Double_t* fShadowLastVars;       //! [fNThreads*fNVars] last used vars per thread
+  Int_t* fShadowLastBins;          //! [fNThreads*fNVars] last used bins per thread
   
   ClassDef(AliTHnT, 5) // THn like container
 };
@@ -12,6 +12,7 @@
  * about the suitability of this software for any purpose. It is          *
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
+#include <algorithm>
 #include <cfloat>
 #include <cstring>
 #include <iostream>   // for unit tests
@@ -42,14 +43,18 @@ ClassImp(THistManager)
 THistManager::THistManager():
 		TNamed(),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fCountFillsByName(false),
+		fFillsByName()
 {
 }
 
 THistManager::THistManager(const char *name):
 		TNamed(name, Form("Histogram container %s", name)),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fCountFillsByName(false),
+		fFillsByName()
 {
 	fHistos = new THashList();
 	fHistos->SetName(Form("histos%s", name));
@@ -409,6 +414,7 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
+	CountFillByName(name);
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent){
@@ -420,18 +426,11 @@ void THistManager::FillTH1(const char *name, double x, double weight, Option_t *
 		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
 		return;
 	}
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
-	  // use bin width as weight
-	  Int_t bin = hist->GetXaxis()->FindBin(x);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
-	}
-	hist->Fill(x, weight);
+	hist->Fill(x, WeightTH1(hist, x, weight, opt));
 }
 
 void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
+  CountFillByName(name);
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent){
@@ -456,6 +455,7 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
 }
 
 void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
+	CountFillByName(name);
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent){
@@ -467,20 +467,11 @@ void THistManager::FillTH2(const char *name, double x, double y, double weight,
 		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
 		return;
 	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(x, y, myweight);
+	hist->Fill(x, y, WeightTH2(hist, x, y, weight, opt));
 }
 
 void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
+	CountFillByName(name);
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent){
@@ -506,6 +497,7 @@ void THistManager::FillTH2(const char *name, double *point, double weight, Optio
 }
 
 void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
+  CountFillByName(name);
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent){
@@ -531,6 +523,7 @@ void THistManager::FillTH2(const char *name, const char *labelX, const char *lab
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
+	CountFillByName(name);
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent){
@@ -560,6 +553,7 @@ void THistManager::FillTH3(const char* name, double x, double y, double z, doubl
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
+	CountFillByName(name);
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent){
@@ -589,6 +583,7 @@ void THistManager::FillTH3(const char* name, const double* point, double weight,
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
+	CountFillByName(name);
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent){
@@ -615,6 +610,7 @@ void THistManager::FillTHnSparse(const char *name, const double *x, double weigh
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
+  CountFillByName(name);
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent)
@@ -625,6 +621,103 @@ void THistManager::FillProfile(const char* name, double x, double y, double weig
   hist->Fill(x, y, weight);
 }
 
+template<typename HistType>
+HistType *THistManager::FindHistogramForHandle(const char *name, const char *caller) const {
+	TString dirname(basename(name)), hname(histname(name));
+	THashList *parent(FindGroup(dirname));
+	if(!parent){
+		Fatal(caller, "Parent group %s does not exist", dirname.Data());
+		return nullptr;
+	}
+	HistType *hist = dynamic_cast<HistType *>(parent->FindObject(hname));
+	if(!hist){
+		Fatal(caller, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		return nullptr;
+	}
+	return hist;
+}
+
+THistManager::TH1Handle THistManager::GetTH1Handle(const char *name) const {
+	return TH1Handle(FindHistogramForHandle<TH1>(name, "THistManager::GetTH1Handle"));
+}
+
+THistManager::TH2Handle THistManager::GetTH2Handle(const char *name) const {
+	return TH2Handle(FindHistogramForHandle<TH2>(name, "THistManager::GetTH2Handle"));
+}
+
+THistManager::TH3Handle THistManager::GetTH3Handle(const char *name) const {
+	return TH3Handle(FindHistogramForHandle<TH3>(name, "THistManager::GetTH3Handle"));
+}
+
+THistManager::THnSparseHandle THistManager::GetTHnSparseHandle(const char *name) const {
+	return THnSparseHandle(FindHistogramForHandle<THnSparse>(name, "THistManager::GetTHnSparseHandle"));
+}
+
+THistManager::TProfileHandle THistManager::GetTProfileHandle(const char *name) const {
+	return TProfileHandle(FindHistogramForHandle<TProfile>(name, "THistManager::GetTProfileHandle"));
+}
+
+void THistManager::Fill(const TH1Handle &handle, double x, double weight, Option_t *opt) {
+	handle->Fill(x, WeightTH1(handle.Get(), x, weight, opt));
+}
+
+void THistManager::Fill(const TH2Handle &handle, double x, double y, double weight, Option_t *opt) {
+	handle->Fill(x, y, WeightTH2(handle.Get(), x, y, weight, opt));
+}
+
+void THistManager::Fill(const TH3Handle &handle, double x, double y, double z, double weight) {
+	handle->Fill(x, y, z, weight);
+}
+
+void THistManager::Fill(const THnSparseHandle &handle, const double *x, double weight) {
+	handle->Fill(x, weight);
+}
+
+void THistManager::Fill(const TProfileHandle &handle, double x, double y, double weight) {
+	handle->Fill(x, y, weight);
+}
+
+double THistManager::WeightTH1(const TH1 *hist, double x, double weight, Option_t *opt) const {
+	TString optionstring(opt);
+	if(optionstring.Contains("w")){
+	  // use bin width as weight
+	  Int_t bin = hist->GetXaxis()->FindBin(x);
+	  // check if not overflow or underflow bin
+	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
+	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+	}
+	return weight;
+}
+
+double THistManager::WeightTH2(const TH2 *hist, double x, double y, double weight, Option_t *opt) const {
+	TString optstring(opt);
+	Double_t myweight = optstring.Contains("w") ? 1. : weight;
+	if(optstring.Contains("wx")){
+	  Int_t binx = hist->GetXaxis()->FindBin(x);
+	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	}
+	if(optstring.Contains("wy")){
+	  Int_t biny = hist->GetYaxis()->FindBin(y);
+	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	}
+	return myweight;
+}
+
+unsigned long THistManager::GetNumberOfFillsByName(const char *name) const {
+	std::map<std::string, unsigned long>::const_iterator found = fFillsByName.find(name);
+	return found == fFillsByName.end() ? 0 : found->second;
+}
+
+void THistManager::PrintFillsByName() const {
+	std::vector<std::pair<unsigned long, std::string> > sorted;
+	for(std::map<std::string, unsigned long>::const_iterator it = fFillsByName.begin(); it != fFillsByName.end(); ++it)
+		sorted.push_back(std::make_pair(it->second, it->first));
+	std::sort(sorted.begin(), sorted.end());
+	std::cout << "Fills by name in histogram manager " << GetName() << ":" << std::endl;
+	for(std::vector<std::pair<unsigned long, std::string> >::reverse_iterator it = sorted.rbegin(); it != sorted.rend(); ++it)
+		std::cout << "  " << it->second << ": " << it->first << std::endl;
+}
+
 TObject *THistManager::FindObject(const char *name) const {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
@@ -1030,6 +1123,104 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandleHistograms(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Group1/Test1", "Test fill 1D histogram via handle", 1, 0., 1.);
+    testmgr.CreateTH2("Group1/Test2", "Test fill 2D histogram via handle", 1, 0., 1., 1, 0., 1.);
+    testmgr.CreateTH3("Group2/Test3", "Test fill 3D histogram via handle", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    testmgr.CreateTHnSparse("Group2/TestN", "Test fill THnSparse via handle", 4, nbins, min, max);
+    testmgr.CreateTProfile("Group3/Subgroup1/TestProfile", "Test fill profile via handle", 1, 0., 1.);
+    double widthbins[5] = {0., 0.5, 1., 2., 4.};
+    testmgr.CreateTH1("Group4/TestWidthName", "Test fill 1D histogram with bin width by name", 4, widthbins);
+    testmgr.CreateTH1("Group4/TestWidthHandle", "Test fill 1D histogram with bin width via handle", 4, widthbins);
+    testmgr.CreateTH2("Group4/TestWidth2DName", "Test fill 2D histogram with bin width by name", 4, widthbins, 4, widthbins);
+    testmgr.CreateTH2("Group4/TestWidth2DHandle", "Test fill 2D histogram with bin width via handle", 4, widthbins, 4, widthbins);
+
+    THistManager::TH1Handle handle1 = testmgr.GetTH1Handle("Group1/Test1");
+    THistManager::TH2Handle handle2 = testmgr.GetTH2Handle("Group1/Test2");
+    THistManager::TH3Handle handle3 = testmgr.GetTH3Handle("Group2/Test3");
+    THistManager::THnSparseHandle handleN = testmgr.GetTHnSparseHandle("Group2/TestN");
+    THistManager::TProfileHandle handleProfile = testmgr.GetTProfileHandle("Group3/Subgroup1/TestProfile");
+    THistManager::TH1Handle handleWidth = testmgr.GetTH1Handle("Group4/TestWidthHandle");
+    THistManager::TH2Handle handleWidth2D = testmgr.GetTH2Handle("Group4/TestWidth2DHandle");
+
+    bool success(true);
+    if(!(handle1.IsValid() && handle2.IsValid() && handle3.IsValid() && handleN.IsValid() && handleProfile.IsValid())){
+      std::cout << "Invalid handle" << std::endl;
+      return 1;
+    }
+
+    testmgr.SetCountFillsByName();
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 100; i++){
+      testmgr.Fill(handle1, 0.5);
+      testmgr.Fill(handle2, 0.5, 0.5);
+      testmgr.Fill(handle3, 0.5, 0.5, 0.5);
+      testmgr.Fill(handleN, point);
+      testmgr.Fill(handleProfile, 0.5, 1.);
+    }
+    for(int i = 0; i < 10; i++) testmgr.FillTH1("Group1/Test1", 0.5);
+    double values[5] = {0.25, 0.75, 1.5, 3., 5.};
+    for(int i = 0; i < 5; i++){
+      testmgr.FillTH1("Group4/TestWidthName", values[i], 3., "w");
+      testmgr.Fill(handleWidth, values[i], 3., "w");
+      testmgr.FillTH2("Group4/TestWidth2DName", values[i], values[4-i], 3., "wxwy");
+      testmgr.Fill(handleWidth2D, values[i], values[4-i], 3., "wxwy");
+    }
+
+    // Evaluate test
+    if(TMath::Abs(handle1.Get()->GetBinContent(1) - 110) > DBL_EPSILON){
+      std::cout << "Group1/Test1: Value mismatch: expected 110, found " << handle1.Get()->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(handle2.Get()->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test2: Value mismatch: expected 100, found " << handle2.Get()->GetBinContent(1, 1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(handle3.Get()->GetBinContent(1, 1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group2/Test3: Value mismatch: expected 100, found " << handle3.Get()->GetBinContent(1, 1, 1) << std::endl;
+      success = false;
+    }
+    int index[4] = {1,1,1,1};
+    if(TMath::Abs(handleN.Get()->GetBinContent(index) - 100) > DBL_EPSILON){
+      std::cout << "Group2/TestN: Value mismatch: expected 100, found " << handleN.Get()->GetBinContent(index) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(handleProfile.Get()->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "Group3/Subgroup1/TestProfile: Value mismatch: expected 1, found " << handleProfile.Get()->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    TH1 *widthName = static_cast<TH1 *>(testmgr.FindObject("Group4/TestWidthName"));
+    TH2 *width2DName = static_cast<TH2 *>(testmgr.FindObject("Group4/TestWidth2DName"));
+    for(int ib = 0; ib <= 5; ib++){
+      if(TMath::Abs(handleWidth.Get()->GetBinContent(ib) - widthName->GetBinContent(ib)) > DBL_EPSILON){
+        std::cout << "Group4/TestWidthHandle: Value mismatch in bin " << ib << ": expected " << widthName->GetBinContent(ib) << ", found " << handleWidth.Get()->GetBinContent(ib) << std::endl;
+        success = false;
+      }
+      for(int jb = 0; jb <= 5; jb++){
+        if(TMath::Abs(handleWidth2D.Get()->GetBinContent(ib, jb) - width2DName->GetBinContent(ib, jb)) > DBL_EPSILON){
+          std::cout << "Group4/TestWidth2DHandle: Value mismatch in bin " << ib << "," << jb << ": expected " << width2DName->GetBinContent(ib, jb) << ", found " << handleWidth2D.Get()->GetBinContent(ib, jb) << std::endl;
+          success = false;
+        }
+      }
+    }
+    if(TMath::Abs(widthName->GetBinContent(2) - 2.) > DBL_EPSILON){
+      std::cout << "Group4/TestWidthName: Value mismatch: expected 2, found " << widthName->GetBinContent(2) << std::endl;
+      success = false;
+    }
+    if(testmgr.GetNumberOfFillsByName("Group1/Test1") != 10){
+      std::cout << "Group1/Test1: Fills by name mismatch: expected 10, found " << testmgr.GetNumberOfFillsByName("Group1/Test1") << std::endl;
+      success = false;
+    }
+    if(testmgr.GetNumberOfFillsByName("Group1/Test2") != 0){
+      std::cout << "Group1/Test2: Fills by name mismatch: expected 0, found " << testmgr.GetNumberOfFillsByName("Group1/Test2") << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1241,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handle" << std::endl;
+    testresult += testsuite.TestFillHandleHistograms();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1267,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandle(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandleHistograms();
+  }
 }
@@ -7,6 +7,8 @@
 #include <TIterator.h>
 #include <TNamed.h>
 #include <iterator>
+#include <map>
+#include <string>
 
 class TArrayD;
 class TAxis;
@@ -95,6 +97,26 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * # Filling histograms via handles
+ *
+ * Filling by name needs to split the name into group and histogram name and to
+ * look up both in the hash lists for every single fill. For histograms filled
+ * many times per event (i.e. per track) the histogram can be resolved once,
+ * typically in UserCreateOutputObjects, and filled via a handle afterwards:
+ *
+ * ~~~{.cxx}
+ * // UserCreateOutputObjects
+ * mgr.CreateTH1("tracks/hPt", "pt-distribution", TLinearBinning(100, 0., 100.));
+ * fPtHandle = mgr.GetTH1Handle("tracks/hPt");
+ * // UserExec
+ * mgr.Fill(fPtHandle, pt);
+ * ~~~
+ *
+ * Handles are not streamed and need to be resolved again after reading the
+ * histogram manager from file. In order to find remaining fill calls by name,
+ * the number of fills by name can be counted per histogram (SetCountFillsByName)
+ * and printed with PrintFillsByName.
  */
 class THistManager : public TNamed {
 public:
@@ -229,6 +251,48 @@ public:
     iterator();
   };
 
+  /**
+   * @class Handle
+   * @brief Lightweight reference to a histogram in the histogram manager
+   * @ingroup Histmanager
+   *
+   * Handles are obtained from the Get...Handle functions and used in
+   * the corresponding Fill functions. They only contain the pointer to
+   * the histogram, so they can be copied and stored as data members.
+   */
+  template<typename HistType>
+  class Handle {
+  public:
+    /**
+     * @brief Constructor, creating an invalid handle unless a histogram is provided
+     * @param[in] hist Histogram the handle points to
+     */
+    explicit Handle(HistType *hist = nullptr): fHistogram(hist) {}
+
+    /**
+     * @brief Check whether the handle points to a histogram
+     * @return True if the handle is valid
+     */
+    bool IsValid() const { return fHistogram != nullptr; }
+
+    /**
+     * @brief Access to the underlying histogram
+     * @return Histogram the handle points to
+     */
+    HistType *Get() const { return fHistogram; }
+
+    HistType *operator->() const { return fHistogram; }
+
+  private:
+    HistType *fHistogram;     ///< Histogram the handle points to (not owned)
+  };
+
+  typedef Handle<TH1> TH1Handle;                ///< Handle to a 1D histogram
+  typedef Handle<TH2> TH2Handle;                ///< Handle to a 2D histogram
+  typedef Handle<TH3> TH3Handle;                ///< Handle to a 3D histogram
+  typedef Handle<THnSparse> THnSparseHandle;    ///< Handle to a THnSparse
+  typedef Handle<TProfile> TProfileHandle;      ///< Handle to a profile histogram
+
   /**
    * @brief Default constructor.
    *
@@ -634,6 +698,117 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Resolve a 1D histogram once for filling via handle.
+   *
+   * The histogram name also contains the parent group(s)
+   * according to the common group notation.
+   * @param[in] name Name of the histogram
+   * @return Handle to the histogram (fatal if the histogram does not exist)
+   */
+  TH1Handle GetTH1Handle(const char *name) const;
+
+  /**
+   * @brief Resolve a 2D histogram once for filling via handle.
+   * @param[in] name Name of the histogram (including parent groups)
+   * @return Handle to the histogram (fatal if the histogram does not exist)
+   */
+  TH2Handle GetTH2Handle(const char *name) const;
+
+  /**
+   * @brief Resolve a 3D histogram once for filling via handle.
+   * @param[in] name Name of the histogram (including parent groups)
+   * @return Handle to the histogram (fatal if the histogram does not exist)
+   */
+  TH3Handle GetTH3Handle(const char *name) const;
+
+  /**
+   * @brief Resolve a THnSparse once for filling via handle.
+   * @param[in] name Name of the histogram (including parent groups)
+   * @return Handle to the histogram (fatal if the histogram does not exist)
+   */
+  THnSparseHandle GetTHnSparseHandle(const char *name) const;
+
+  /**
+   * @brief Resolve a profile histogram once for filling via handle.
+   * @param[in] name Name of the histogram (including parent groups)
+   * @return Handle to the histogram (fatal if the histogram does not exist)
+   */
+  TProfileHandle GetTProfileHandle(const char *name) const;
+
+  /**
+   * @brief Fill a 1D histogram via handle.
+   * @param[in] handle Handle obtained from GetTH1Handle
+   * @param[in] x x-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] opt Optional filling arguments, as in FillTH1
+   */
+  void Fill(const TH1Handle &handle, double x, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 2D histogram via handle.
+   * @param[in] handle Handle obtained from GetTH2Handle
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] opt Optional filling arguments, as in FillTH2
+   */
+  void Fill(const TH2Handle &handle, double x, double y, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 3D histogram via handle.
+   *
+   * No filling arguments: the bin width options of FillTH3 do not change the filled weight.
+   * @param[in] handle Handle obtained from GetTH3Handle
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] z z-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const TH3Handle &handle, double x, double y, double z, double weight = 1.);
+
+  /**
+   * @brief Fill a THnSparse via handle.
+   *
+   * No filling arguments: the bin width options of FillTHnSparse do not change the filled weight.
+   * @param[in] handle Handle obtained from GetTHnSparseHandle
+   * @param[in] x coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const THnSparseHandle &handle, const double *x, double weight = 1.);
+
+  /**
+   * @brief Fill a profile histogram via handle.
+   * @param[in] handle Handle obtained from GetTProfileHandle
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const TProfileHandle &handle, double x, double y, double weight = 1.);
+
+  /**
+   * @brief Switch on/off counting of fills by name (debugging).
+   *
+   * When switched on, every call of a Fill function with a histogram name
+   * is counted per histogram name. Meant to find call sites which should
+   * be moved to handles, as the counting itself is not for free.
+   * @param[in] doCount If true fills by name are counted
+   */
+  void SetCountFillsByName(bool doCount = true) { fCountFillsByName = doCount; }
+
+  /**
+   * @brief Get the number of fills by name for a given histogram.
+   * @param[in] name Name of the histogram as used in the Fill function
+   * @return Number of fills by name since counting was switched on
+   */
+  unsigned long GetNumberOfFillsByName(const char *name) const;
+
+  /**
+   * @brief Print the number of fills by name for all histograms filled by name,
+   * sorted by the number of fills.
+   */
+  void PrintFillsByName() const;
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -719,8 +894,46 @@ private:
 	 */
 	TString histname(const TString &path) const;
 
+	/**
+	 * @brief Find histogram of a given type for a handle, fatal if not found
+	 * @param[in] name Name of the histogram (including parent groups)
+	 * @param[in] caller Name of the calling function used in the error message
+	 * @return Histogram of the requested type
+	 */
+	template<typename HistType>
+	HistType *FindHistogramForHandle(const char *name, const char *caller) const;
+
+	/**
+	 * @brief Weight of a 1D fill, replaced by the inverse bin width with option "w"
+	 * @param[in] hist Histogram to be filled
+	 * @param[in] x x-coordinate
+	 * @param[in] weight Weight given to the fill
+	 * @param[in] opt Filling arguments
+	 * @return Weight to be used
+	 */
+	double WeightTH1(const TH1 *hist, double x, double weight, Option_t *opt) const;
+
+	/**
+	 * @brief Weight of a 2D fill, divided by the bin widths with options "wx"/"wy"
+	 * @param[in] hist Histogram to be filled
+	 * @param[in] x x-coordinate
+	 * @param[in] y y-coordinate
+	 * @param[in] weight Weight given to the fill
+	 * @param[in] opt Filling arguments
+	 * @return Weight to be used
+	 */
+	double WeightTH2(const TH2 *hist, double x, double y, double weight, Option_t *opt) const;
+
+	/**
+	 * @brief Count fill by name, if enabled
+	 * @param[in] name Name of the histogram as used in the Fill function
+	 */
+	void CountFillByName(const char *name) { if(fCountFillsByName) fFillsByName[name]++; }
+
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
+	bool fCountFillsByName;               //!<! Count fills by name (debugging)
+	std::map<std::string, unsigned long> fFillsByName;    //!<! Number of fills by name per histogram
 
   /// \cond CLASSIMP
 	ClassDef(THistManager, 1);  // Container for histograms
@@ -762,6 +975,7 @@ namespace TestTHistManager {
  * - Build histrogram in groups
  * - Simple fill
  * - Fill histograms in groups
+ * - Fill histograms via handles
  */
 class THistManagerTestSuite {
 public:
@@ -845,6 +1059,22 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether histograms are filled correctly via handles, and whether
+   * fills by name are counted
+   * Relies on: TestBuildGroupedHistograms, TestFillGroupedHistograms
+   *
+   * Creating histograms of all types in groups, resolving handles and filling each histogram
+   * 100 times via handle. In addition the TH1 is filled 10 times by name with counting enabled.
+   *
+   * Test passed:
+   * - All handles are valid
+   * - All histograms have the expected value (110 for the TH1, 100 for the other histograms, 1 for profile)
+   * - 10 fills by name are counted for the TH1, 0 for the others
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandleHistograms();
 };
 
 /**
@@ -882,5 +1112,12 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandle();
+
 }
 #endif
@@ -25,6 +25,7 @@
 #include "AliUEHistograms.h"
 
 #include "AliCFContainer.h"
+#include "AliTHn.h"
 #include "AliBasicParticle.h"
 #include "AliVParticle.h"
 #include "AliAODTrack.h"
@@ -36,6 +37,11 @@
 #include "TH3F.h"
 #include "TMath.h"
 #include "TLorentzVector.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TArrayI.h"
+#include "TArrayS.h"
 
 ClassImp(AliUEHistograms)
 
@@ -86,7 +92,28 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
   fRunNumber(0),
-  fMergeCount(1)
+  fMergeCount(1),
+  fFillCorrEta(),
+  fFillCorrTriggerPt(),
+  fFillCorrTriggerPhi(),
+  fFillCorrTriggerCharge(),
+  fFillCorrAssocPt(),
+  fFillCorrAssocPhi(),
+  fFillCorrAssocCharge(),
+  fFillCorrAssocEfficiency(),
+  fFillCorrRadii(),
+  fFillCorrTriggerBendingMin(),
+  fFillCorrTriggerBendingMax(),
+  fFillCorrAssocBendingMin(),
+  fFillCorrAssocBendingMax(),
+  fFillCorrTriggerBendingScan(),
+  fFillCorrAssocBendingScan(),
+  fFillCorrTriggerBendingScanRow(),
+  fFillCorrAssocBendingScanRow(),
+  fFillCorrDEtaPair(),
+  fFillCorrScanPair(),
+  fFillCorrVars(),
+  fFillCorrWeights()
 {
   // Constructor
   //
@@ -267,7 +294,28 @@ AliUEHistograms::AliUEHistograms(const AliUEHistograms &c) :
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
   fRunNumber(0),
-  fMergeCount(1)
+  fMergeCount(1),
+  fFillCorrEta(),
+  fFillCorrTriggerPt(),
+  fFillCorrTriggerPhi(),
+  fFillCorrTriggerCharge(),
+  fFillCorrAssocPt(),
+  fFillCorrAssocPhi(),
+  fFillCorrAssocCharge(),
+  fFillCorrAssocEfficiency(),
+  fFillCorrRadii(),
+  fFillCorrTriggerBendingMin(),
+  fFillCorrTriggerBendingMax(),
+  fFillCorrAssocBendingMin(),
+  fFillCorrAssocBendingMax(),
+  fFillCorrTriggerBendingScan(),
+  fFillCorrAssocBendingScan(),
+  fFillCorrTriggerBendingScanRow(),
+  fFillCorrAssocBendingScanRow(),
+  fFillCorrDEtaPair(),
+  fFillCorrScanPair(),
+  fFillCorrVars(),
+  fFillCorrWeights()
 {
   //
   // AliUEHistograms copy constructor
@@ -565,6 +613,28 @@ void AliUEHistograms::Fill(AliVParticle* leadingMC, AliVParticle* leadingReco)
   }
 }
 
+//____________________________________________________________________
+const Double_t* AliUEHistograms::GetBendingTermsScan(TArrayD& table, TArrayI& rows, Int_t& nRows, Int_t index, Float_t pt, Float_t charge, const TArrayF& radii, Float_t bSign)
+{
+  // returns the bending terms (see GetBendingTerm) of particle <index> for all radii of the two-track cut scan
+  // they are computed on first use and kept in <table>, one row per particle. <rows> contains row+1 per particle (0 = not computed yet)
+
+  const Int_t nRadii = radii.GetSize();
+  if (rows[index] == 0)
+  {
+    if ((nRows + 1) * nRadii > table.GetSize())
+      table.Set(TMath::Max(2 * table.GetSize(), (nRows + 1) * nRadii));
+
+    Double_t* row = table.GetArray() + nRows * nRadii;
+    for (Int_t k=0; k<nRadii; k++)
+      row[k] = GetBendingTerm(pt, charge, radii[k], bSign);
+
+    rows[index] = ++nRows;
+  }
+
+  return table.GetArray() + (rows[index] - 1) * nRadii;
+}
+
 //____________________________________________________________________
 void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, Float_t weight, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency)
 {
@@ -593,7 +663,8 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 
   // Eta() is extremely time consuming, therefore cache it for the inner loop here:
   TObjArray* input = (mixed) ? mixed : particles;
-  TArrayF eta(input->GetEntriesFast());
+  GrowBuffer(fFillCorrEta, input->GetEntriesFast());
+  TArrayF& eta = fFillCorrEta;
   for (Int_t i=0; i<input->GetEntriesFast(); i++)
     eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
   
@@ -711,6 +782,110 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
     }
     
+    // the pair loop works on flat per-particle arrays (pT, phi, charge, efficiency) which are filled once per call,
+    // i.e. once per event or mixed event, instead of calling the virtual getters for each pair
+    // the arrays are members which only grow, i.e. they are not reallocated for each call
+    const Int_t nTriggers = particles->GetEntriesFast();
+    GrowBuffer(fFillCorrTriggerPt, nTriggers);
+    GrowBuffer(fFillCorrTriggerPhi, nTriggers);
+    GrowBuffer(fFillCorrTriggerCharge, nTriggers);
+    TArrayD& triggerPt = fFillCorrTriggerPt;
+    TArrayD& triggerPhi = fFillCorrTriggerPhi;
+    TArrayS& triggerCharge = fFillCorrTriggerCharge;
+    for (Int_t i=0; i<nTriggers; i++)
+    {
+      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+      triggerPt[i] = triggerParticle->Pt();
+      triggerPhi[i] = triggerParticle->Phi();
+      triggerCharge[i] = triggerParticle->Charge();
+    }
+
+    GrowBuffer(fFillCorrAssocPt, jMax);
+    GrowBuffer(fFillCorrAssocPhi, jMax);
+    GrowBuffer(fFillCorrAssocCharge, jMax);
+    GrowBuffer(fFillCorrAssocEfficiency, jMax);
+    TArrayD& assocPt = fFillCorrAssocPt;
+    TArrayD& assocPhi = fFillCorrAssocPhi;
+    TArrayS& assocCharge = fFillCorrAssocCharge;
+    TArrayD& assocEfficiency = fFillCorrAssocEfficiency;
+    for (Int_t j=0; j<jMax; j++)
+    {
+      AliVParticle* particle = (AliVParticle*) input->UncheckedAt(j);
+      assocPt[j] = particle->Pt();
+      assocPhi[j] = particle->Phi();
+      assocCharge[j] = particle->Charge();
+
+      // centrality and zVtx are the same for all pairs, i.e. the correction of the associated particle can be looked up once
+      assocEfficiency[j] = 1;
+      if (applyEfficiency && fEfficiencyCorrectionAssociated)
+      {
+        Int_t effVars[4];
+        effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
+        effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(assocPt[j]); //pt
+        effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(centrality); //centrality
+        effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(zVtx); //zVtx
+        assocEfficiency[j] = fEfficiencyCorrectionAssociated->GetBinContent(effVars);
+      }
+    }
+
+    // two-track cut: the bending term charge * bSign * asin(0.075 * r / pT) of GetDPhiStar depends only on one particle
+    // it is computed once per particle at the two boundary radii and, on first use, for all radii of the scan
+    TArrayF& radii = fFillCorrRadii;
+    TArrayD& triggerBendingMin = fFillCorrTriggerBendingMin;
+    TArrayD& triggerBendingMax = fFillCorrTriggerBendingMax;
+    TArrayD& assocBendingMin = fFillCorrAssocBendingMin;
+    TArrayD& assocBendingMax = fFillCorrAssocBendingMax;
+    TArrayD& triggerBendingScan = fFillCorrTriggerBendingScan;
+    TArrayD& assocBendingScan = fFillCorrAssocBendingScan;
+    TArrayI& triggerBendingScanRow = fFillCorrTriggerBendingScanRow;
+    TArrayI& assocBendingScanRow = fFillCorrAssocBendingScanRow;
+    Int_t nTriggerBendingScan = 0;
+    Int_t nAssocBendingScan = 0;
+    GrowBuffer(fFillCorrDEtaPair, jMax);
+    GrowBuffer(fFillCorrScanPair, jMax);
+    TArrayF& detaPair = fFillCorrDEtaPair;
+    TArrayC& scanPair = fFillCorrScanPair;
+    if (twoTrackEfficiencyCut)
+    {
+      // the size of radii is the number of radii of the scan, it only changes with fTwoTrackCutMinRadius
+      Int_t nRadii = 0;
+      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01)
+        nRadii++;
+      if (radii.GetSize() != nRadii)
+        radii.Set(nRadii);
+      nRadii = 0;
+      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01)
+        radii[nRadii++] = rad;
+
+      GrowBuffer(triggerBendingMin, nTriggers);
+      GrowBuffer(triggerBendingMax, nTriggers);
+      GrowBuffer(triggerBendingScanRow, nTriggers);
+      triggerBendingScanRow.Reset(); // no scan row computed yet for this call
+      for (Int_t i=0; i<nTriggers; i++)
+      {
+        triggerBendingMin[i] = GetBendingTerm(triggerPt[i], triggerCharge[i], fTwoTrackCutMinRadius, bSign);
+        triggerBendingMax[i] = GetBendingTerm(triggerPt[i], triggerCharge[i], 2.5, bSign);
+      }
+
+      GrowBuffer(assocBendingMin, jMax);
+      GrowBuffer(assocBendingMax, jMax);
+      GrowBuffer(assocBendingScanRow, jMax);
+      assocBendingScanRow.Reset();
+      for (Int_t j=0; j<jMax; j++)
+      {
+        assocBendingMin[j] = GetBendingTerm(assocPt[j], assocCharge[j], fTwoTrackCutMinRadius, bSign);
+        assocBendingMax[j] = GetBendingTerm(assocPt[j], assocCharge[j], 2.5, bSign);
+      }
+    }
+
+    // pairs are collected per trigger particle and filled in one go
+    AliCFContainer* trackHist = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward);
+    AliTHnBase* trackHistTHn = (trackHist->GetNVar() == 6) ? dynamic_cast<AliTHnBase*> (trackHist) : 0;
+    GrowBuffer(fFillCorrVars, jMax * 6);
+    GrowBuffer(fFillCorrWeights, jMax);
+    TArrayD& fillVars = fFillCorrVars;
+    TArrayD& fillWeights = fFillCorrWeights;
+
     for (Int_t i=0; i<particles->GetEntriesFast(); i++)
     {
       AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
@@ -738,6 +913,46 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  continue;
 	}
 	
+      // trigger particle factors of the pair weight
+      Double_t triggerEfficiency = 1;
+      if (applyEfficiency && fEfficiencyCorrectionTriggers)
+      {
+        Int_t effVars[4];
+        effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
+        effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(triggerPt[i]); //pt
+        effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(centrality); //centrality
+        effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(zVtx); //zVtx
+        triggerEfficiency = fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+      }
+
+      Double_t triggerWeight = 1;
+      if (fWeightPerEvent)
+        triggerWeight = triggerWeighting->GetBinContent(triggerWeighting->GetXaxis()->FindBin(triggerPt[i]));
+
+      // one pass over all associated particles: delta eta and the boundaries of the two-track cut
+      // (the scan for the minimum is only needed if dphistar is small at one boundary or changes sign between them)
+      if (twoTrackEfficiencyCut)
+      {
+        const Float_t phi1 = triggerPhi[i];
+        const Double_t bending1Min = triggerBendingMin[i];
+        const Double_t bending1Max = triggerBendingMax[i];
+        const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
+        const Double_t kDEtaLimit = twoTrackEfficiencyCutValue * 2.5 * 3;
+
+        for (Int_t j=0; j<jMax; j++)
+        {
+          Float_t deta = triggerEta - eta[j];
+          Float_t dphi = phi1 - (Float_t) assocPhi[j];
+
+          Float_t dphistar1 = GetDPhiStarFromBending(dphi, bending1Min, assocBendingMin[j]);
+          Float_t dphistar2 = GetDPhiStarFromBending(dphi, bending1Max, assocBendingMax[j]);
+
+          detaPair[j] = deta;
+          scanPair[j] = (TMath::Abs(deta) < kDEtaLimit && (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0));
+        }
+      }
+
+      Int_t nFill = 0;
       for (Int_t j=0; j<jMax; j++)
       {
         if (!mixed && i == j)
@@ -764,21 +979,21 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
           continue;
         
         if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
+	  if (assocPt[j] >= triggerPt[i])
 	    continue;
 	
 	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
+	  if (assocCharge[j] * fAssociatedSelectCharge < 0)
 	    continue;
 
         if (fSelectCharge > 0)
         {
           // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
+          if (fSelectCharge == 1 && assocCharge[j] * triggerCharge[i] > 0)
             continue;
             
           // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
+          if (fSelectCharge == 2 && assocCharge[j] * triggerCharge[i] < 0)
             continue;
         }
         
@@ -802,13 +1017,13 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 
 	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutConversionsV > 0 && assocCharge[j] * triggerCharge[i] < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.510e-3, 0.510e-3);
 	  
 	  if (mass < fCutConversionsV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	    mass = GetInvMassSquared(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.510e-3, 0.510e-3);
 	    
 	    fControlConvResoncances->Fill(0.0, mass);
 
@@ -818,15 +1033,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// K0s
-	if (fCutK0sV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutK0sV > 0 && assocCharge[j] * triggerCharge[i] < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.1396, 0.1396);
 	  
 	  const Float_t kK0smass = 0.4976;
 	  
 	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutK0sV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	    mass = GetInvMassSquared(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.1396, 0.1396);
 	    
 	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
 
@@ -836,16 +1051,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 
 	// Lambda
-	if (fCutLambdaV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutLambdaV > 0 && assocCharge[j] * triggerCharge[i] < 0)
 	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	  Float_t mass1 = GetInvMassSquaredCheap(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.1396, 0.9383);
+	  Float_t mass2 = GetInvMassSquaredCheap(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.9383, 0.1396);
 	  
 	  const Float_t kLambdaMass = 1.115;
 
 	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutLambdaV * 5)
 	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
+	    mass1 = GetInvMassSquared(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.1396, 0.9383);
 
 	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
 	    
@@ -854,7 +1069,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutLambdaV * 5)
 	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	    mass2 = GetInvMassSquared(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.9383, 0.1396);
 
 	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
 
@@ -864,15 +1079,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 
         // Phi
-	if (fCutPhiV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutPhiV > 0 && assocCharge[j] * triggerCharge[i] < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.4937, 0.4937);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.4937, 0.4937);
 	  
 	  const Float_t kPhimass = 1.019;
 	  
 	  if (TMath::Abs(mass - kPhimass*kPhimass) < fCutPhiV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.4937, 0.4937);
+	    mass = GetInvMassSquared(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.4937, 0.4937);
 	    
 	    fControlConvResoncances->Fill(3, mass - kPhimass*kPhimass);
 	    
@@ -882,15 +1097,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}	
 
         // Rho
-	if (fCutRhoV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutRhoV > 0 && assocCharge[j] * triggerCharge[i] < 0)
         {
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.1396, 0.1396);
 	  
 	  const Float_t kRhomass = 0.770;
 	  
 	  if (TMath::Abs(mass - kRhomass*kRhomass) < fCutRhoV * 5)
           {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	    mass = GetInvMassSquared(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], 0.1396, 0.1396);
 	    
 	    fControlConvResoncances->Fill(4, mass - kRhomass*kRhomass);
 	    
@@ -900,13 +1115,13 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 
         // User-defined cut
-	if (fCutCustomMass > 0 && fCutCustomFirst > 0 && fCutCustomSecond > 0 && fCutCustomV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutCustomMass > 0 && fCutCustomFirst > 0 && fCutCustomSecond > 0 && fCutCustomV > 0 && assocCharge[j] * triggerCharge[i] < 0)
         {
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), fCutCustomFirst, fCutCustomSecond);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], fCutCustomFirst, fCutCustomSecond);
 	  
 	  if (TMath::Abs(mass - fCutCustomMass*fCutCustomMass) < fCutCustomV * 5)
           {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), fCutCustomFirst, fCutCustomSecond);
+	    mass = GetInvMassSquared(triggerPt[i], triggerEta, triggerPhi[i], assocPt[j], eta[j], assocPhi[j], fCutCustomFirst, fCutCustomSecond);
 	    
 	    fControlConvResoncances->Fill(5, mass - fCutCustomMass*fCutCustomMass);
 	    
@@ -915,66 +1130,58 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	}
 
-	if (twoTrackEfficiencyCut)
+	if (twoTrackEfficiencyCut && scanPair[j])
 	{
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
+	  // the boundaries have been checked above, find the minimum
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
+	  Float_t phi1 = triggerPhi[i];
+	  Float_t pt1 = triggerPt[i];
+	  Float_t charge1 = triggerCharge[i];
 	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
-	      
-	  Float_t deta = triggerEta - eta[j];
+	  Float_t phi2 = assocPhi[j];
+	  Float_t pt2 = assocPt[j];
+	  Float_t charge2 = assocCharge[j];
 	      
-	  // optimization
-	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
+	  Float_t deta = detaPair[j];
+	  Float_t dphi = phi1 - phi2;
+
+	  const Double_t* bending1 = GetBendingTermsScan(triggerBendingScan, triggerBendingScanRow, nTriggerBendingScan, i, pt1, charge1, radii, bSign);
+	  const Double_t* bending2 = GetBendingTermsScan(assocBendingScan, assocBendingScanRow, nAssocBendingScan, j, pt2, charge2, radii, bSign);
+
+	  Float_t dphistarminabs = 1e5;
+	  Float_t dphistarmin = 1e5;
+	  for (Int_t k=0; k<radii.GetSize(); k++)
 	  {
-	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
-	    
-	    const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
+	    Float_t dphistar = GetDPhiStarFromBending(dphi, bending1[k], bending2[k]);
 
-	    Float_t dphistarminabs = 1e5;
-	    Float_t dphistarmin = 1e5;
-	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
+	    Float_t dphistarabs = TMath::Abs(dphistar);
+	    
+	    if (dphistarabs < dphistarminabs)
 	    {
-	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
-	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
-
-		Float_t dphistarabs = TMath::Abs(dphistar);
-		
-		if (dphistarabs < dphistarminabs)
-		{
-		  dphistarmin = dphistar;
-		  dphistarminabs = dphistarabs;
-		}
-	      }
-	      
-	      fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
-	      
-	      if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
-	      {
-// 		Printf("Removed track pair %d %d with %f %f %f %f %f %f %f %f %f", i, j, deta, dphistarminabs, phi1, pt1, charge1, phi2, pt2, charge2, bSign);
-		continue;
-	      }
-
-    	      fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+	      dphistarmin = dphistar;
+	      dphistarminabs = dphistarabs;
 	    }
 	  }
+	  
+	  fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+	  
+	  if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
+	  {
+// 	    Printf("Removed track pair %d %d with %f %f %f %f %f %f %f %f %f", i, j, deta, dphistarminabs, phi1, pt1, charge1, phi2, pt2, charge2, bSign);
+	    continue;
+	  }
+
+	  fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
 	}
         
-        Double_t vars[6];
+        Double_t* vars = fillVars.GetArray() + nFill * 6;
         vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
+        vars[1] = assocPt[j];
+        vars[2] = triggerPt[i];
         vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
+        vars[4] = triggerPhi[i] - assocPhi[j];
         if (vars[4] > 1.5 * TMath::Pi()) 
           vars[4] -= TMath::TwoPi();
         if (vars[4] < -0.5 * TMath::Pi())
@@ -982,48 +1189,25 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	vars[5] = zVtx;
 	
 	if (fillpT)
-	  weight = particle->Pt();
+	  weight = assocPt[j];
 	
+	// same order of operations as the per pair lookup (factors are 1 if not applied)
 	Double_t useWeight = weight;
-	if (applyEfficiency)
-	{
-	  if (fEfficiencyCorrectionAssociated)
-	  {
-	    Int_t effVars[4];
-	    // associated particle
-	    effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
-	    effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(vars[1]); //pt
-	    effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    
-	    // 	  Printf("%d %d %d %d %f", effVars[0], effVars[1], effVars[2], effVars[3], fEfficiencyCorrectionAssociated->GetBinContent(effVars));
-	  
-	    useWeight *= fEfficiencyCorrectionAssociated->GetBinContent(effVars);
-	  }
-	  if (fEfficiencyCorrectionTriggers)
-	  {
-	    Int_t effVars[4];
-
-	    effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
-	    effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[2]); //pt
-	    effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
-	  }
-	}
-
-	if (fWeightPerEvent)
-	{
-	  Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[2]);
-// 	  Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
-	  useWeight /= triggerWeighting->GetBinContent(weightBin);
-	}
-    
-        // fill all in toward region and do not use the other regions
-	fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
+	useWeight *= assocEfficiency[j];
+	useWeight *= triggerEfficiency;
+	useWeight /= triggerWeight;
+	
+	fillWeights[nFill++] = useWeight;
 
 // 	Printf("%.2f %.2f --> %.2f", triggerEta, eta[j], vars[0]);
       }
+      
+      // fill all in toward region and do not use the other regions
+      if (trackHistTHn)
+        trackHistTHn->FillN(nFill, fillVars.GetArray(), step, fillWeights.GetArray());
+      else
+        for (Int_t k=0; k<nFill; k++)
+          trackHist->Fill(fillVars.GetArray() + k * 6, step, fillWeights[k]);
  
       if (firstTime)
       {
@@ -12,6 +12,11 @@
 #include "AliUEHist.h"
 #include "TMath.h"
 #include "THn.h" // in cxx file causes .../THn.h:257: error: conflicting declaration ‘typedef class THnT<float> THnF’
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TArrayI.h"
+#include "TArrayS.h"
 
 class AliVParticle;
 
@@ -123,6 +128,10 @@ protected:
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign);
+  inline Double_t GetBendingTerm(Float_t pt, Float_t charge, Float_t radius, Float_t bSign);
+  inline Float_t GetDPhiStarFromBending(Float_t dphi, Double_t bending1, Double_t bending2);
+  const Double_t* GetBendingTermsScan(TArrayD& table, TArrayI& rows, Int_t& nRows, Int_t index, Float_t pt, Float_t charge, const TArrayF& radii, Float_t bSign);
+  void GrowBuffer(TArray& array, Int_t size) { if (array.GetSize() < size) array.Set(size); }
   
   static const Int_t fgkUEHists; // number of histograms
 
@@ -182,6 +191,29 @@ protected:
   
   Int_t fMergeCount;		// counts how many objects have been merged together
   
+  // buffers of FillCorrelations, only grown (GrowBuffer) to avoid allocations per event
+  TArrayF fFillCorrEta;                   //! eta of the associated particles
+  TArrayD fFillCorrTriggerPt;             //! pT of the trigger particles
+  TArrayD fFillCorrTriggerPhi;            //! phi of the trigger particles
+  TArrayS fFillCorrTriggerCharge;         //! charge of the trigger particles
+  TArrayD fFillCorrAssocPt;               //! pT of the associated particles
+  TArrayD fFillCorrAssocPhi;              //! phi of the associated particles
+  TArrayS fFillCorrAssocCharge;           //! charge of the associated particles
+  TArrayD fFillCorrAssocEfficiency;       //! efficiency correction of the associated particles
+  TArrayF fFillCorrRadii;                 //! radii of the two-track cut scan
+  TArrayD fFillCorrTriggerBendingMin;     //! bending term of the trigger particles at fTwoTrackCutMinRadius
+  TArrayD fFillCorrTriggerBendingMax;     //! bending term of the trigger particles at 2.5 m
+  TArrayD fFillCorrAssocBendingMin;       //! bending term of the associated particles at fTwoTrackCutMinRadius
+  TArrayD fFillCorrAssocBendingMax;       //! bending term of the associated particles at 2.5 m
+  TArrayD fFillCorrTriggerBendingScan;    //! bending terms for all radii, computed on first use (see GetBendingTermsScan)
+  TArrayD fFillCorrAssocBendingScan;      //! bending terms for all radii, computed on first use (see GetBendingTermsScan)
+  TArrayI fFillCorrTriggerBendingScanRow; //! row in fFillCorrTriggerBendingScan + 1 (0 = not computed)
+  TArrayI fFillCorrAssocBendingScanRow;   //! row in fFillCorrAssocBendingScan + 1 (0 = not computed)
+  TArrayF fFillCorrDEtaPair;              //! delta eta per associated particle for the current trigger
+  TArrayC fFillCorrScanPair;              //! pair needs the full two-track cut scan
+  TArrayD fFillCorrVars;                  //! fill variables of the pairs of the current trigger, 6 per pair
+  TArrayD fFillCorrWeights;               //! fill weights of the pairs of the current trigger
+  
   ClassDef(AliUEHistograms, 33)  // underlying event histogram container
 };
 
@@ -191,7 +223,25 @@ Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1,
   // calculates dphistar
   //
   
-  Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
+  return GetDPhiStarFromBending(phi1 - phi2, GetBendingTerm(pt1, charge1, radius, bSign), GetBendingTerm(pt2, charge2, radius, bSign));
+}
+
+Double_t AliUEHistograms::GetBendingTerm(Float_t pt, Float_t charge, Float_t radius, Float_t bSign)
+{
+  //
+  // bending of a track with <pt> and <charge> at <radius>, this is the part of dphistar which depends only on one particle
+  //
+  
+  return charge * bSign * TMath::ASin(0.075 * radius / pt);
+}
+
+Float_t AliUEHistograms::GetDPhiStarFromBending(Float_t dphi, Double_t bending1, Double_t bending2)
+{
+  //
+  // calculates dphistar from dphi = phi1 - phi2 and the bending terms of both particles (see GetBendingTerm)
+  //
+  
+  Float_t dphistar = dphi - bending1 + bending2;
   
   static const Double_t kPi = TMath::Pi();
   
@@ -0,0 +1,169 @@
+/*
+ * AliFemtoDreamCompactParticles.cxx
+ */
+#include "AliFemtoDreamCompactParticles.h"
+#include <cmath>
+#include <limits>
+#include "TMath.h"
+ClassImp(AliFemtoDreamCompactParticles)
+
+static const float piCompact = TMath::Pi();
+
+AliFemtoDreamCompactParticles::AliFemtoDreamCompactParticles()
+    : fSize(0),
+      fMass(0.),
+      fPx(),
+      fPy(),
+      fPz(),
+      fE(),
+      fPt(),
+      fCharge(),
+      fEta(),
+      fEtaDaug(),
+      fPhiStar(),
+      fNDaugEta(0),
+      fNDaugPhiStar(0),
+      fHasEta(true) {
+}
+
+AliFemtoDreamCompactParticles::~AliFemtoDreamCompactParticles() {
+}
+
+void AliFemtoDreamCompactParticles::Set(
+    std::vector<AliFemtoDreamBasePart> &Particles, double mass) {
+  fSize = Particles.size();
+  fMass = mass;
+  fPx.resize(fSize);
+  fPy.resize(fSize);
+  fPz.resize(fSize);
+  fE.resize(fSize);
+  fPt.resize(fSize);
+  fCharge.resize(fSize);
+  fEta.resize(fSize);
+  fHasEta = true;
+  fNDaugEta = std::numeric_limits<unsigned int>::max();
+  fNDaugPhiStar = std::numeric_limits<unsigned int>::max();
+  std::vector<std::vector<float>> etas(fSize);
+  std::vector<std::vector<std::vector<float>>> phiStars(fSize);
+  for (unsigned int i = 0; i < fSize; ++i) {
+    AliFemtoDreamBasePart &part = Particles[i];
+    TVector3 mom = part.GetMomentum();
+    fPx[i] = mom.X();
+    fPy[i] = mom.Y();
+    fPz[i] = mom.Z();
+    // as TLorentzVector::SetXYZM
+    fE[i] = std::sqrt(
+        fPx[i] * fPx[i] + fPy[i] * fPy[i] + fPz[i] * fPz[i] + mass * mass);
+    fPt[i] = mom.Pt();
+    std::vector<int> charge = part.GetCharge();
+    fCharge[i] = charge.size() ? charge[0] : 0;
+    etas[i] = part.GetEta();
+    fHasEta = fHasEta && etas[i].size();
+    fEta[i] = etas[i].size() ? etas[i][0] : 0.f;
+    unsigned int nDaugEta = etas[i].size() ? etas[i].size() - 1 : 0;
+    fNDaugEta = TMath::Min(fNDaugEta, nDaugEta);
+    phiStars[i] = part.GetPhiAtRaidius();
+    unsigned int nDaugPhiStar = 0;
+    while (nDaugPhiStar < phiStars[i].size()
+        && phiStars[i][nDaugPhiStar].size() == (size_t) kNRadii) {
+      ++nDaugPhiStar;
+    }
+    fNDaugPhiStar = TMath::Min(fNDaugPhiStar, nDaugPhiStar);
+  }
+  if (!fSize) {
+    fNDaugEta = 0;
+    fNDaugPhiStar = 0;
+  }
+  fEtaDaug.resize(fNDaugEta * fSize);
+  fPhiStar.resize(fNDaugPhiStar * kNRadii * fSize);
+  for (unsigned int i = 0; i < fSize; ++i) {
+    for (unsigned int iDaug = 0; iDaug < fNDaugEta; ++iDaug) {
+      fEtaDaug[iDaug * fSize + i] = etas[i][iDaug + 1];
+    }
+    for (unsigned int iDaug = 0; iDaug < fNDaugPhiStar; ++iDaug) {
+      for (int iRad = 0; iRad < kNRadii; ++iRad) {
+        fPhiStar[(iDaug * kNRadii + iRad) * fSize + i] =
+            phiStars[i][iDaug][iRad];
+      }
+    }
+  }
+}
+
+bool AliFemtoDreamCompactParticles::HasDaughterInfo(unsigned int nDaug) const {
+  if (!fSize || nDaug == 0) {
+    return true;
+  }
+  if (nDaug > fNDaugPhiStar) {
+    return false;
+  }
+  return (nDaug == 1) ? fHasEta : (nDaug <= fNDaugEta);
+}
+
+void AliFemtoDreamCompactParticles::PairKinematics(
+    int i, const AliFemtoDreamCompactParticles &other, int jFirst,
+    float *relK, float *kT, float *mT) const {
+  // k* is the momentum of the particles in the pair rest frame, obtained from
+  // the invariant mass of the pair instead of boosting both particles
+  const double px1 = fPx[i];
+  const double py1 = fPy[i];
+  const double pz1 = fPz[i];
+  const double e1 = fE[i];
+  const double mSum = fMass + other.fMass;
+  const double mDiff = fMass - other.fMass;
+  const float averageMass = 0.5 * (fMass + other.fMass);
+  const double averageMassSq = (double) averageMass * averageMass;
+  const double *px2 = other.fPx.data();
+  const double *py2 = other.fPy.data();
+  const double *pz2 = other.fPz.data();
+  const double *e2 = other.fE.data();
+  const int n = other.fSize;
+  for (int j = jFirst; j < n; ++j) {
+    const double px = px1 + px2[j];
+    const double py = py1 + py2[j];
+    const double pz = pz1 + pz2[j];
+    const double e = e1 + e2[j];
+    const double s = e * e - px * px - py * py - pz * pz;
+    const double kStarSq = (s - mSum * mSum) * (s - mDiff * mDiff) / s;
+    relK[j] = (kStarSq > 0) ? 0.5 * std::sqrt(kStarSq) : 0.;
+    const float pairKT = 0.5 * std::sqrt(px * px + py * py);
+    kT[j] = pairKT;
+    mT[j] = std::sqrt((double) pairKT * pairKT + averageMassSq);
+  }
+}
+
+void AliFemtoDreamCompactParticles::ClosePairRejection(
+    int i, const AliFemtoDreamCompactParticles &other, int jFirst,
+    unsigned int nDaug1, unsigned int nDaug2, float deltaPhiSqMax,
+    float deltaEtaSqMax, char *pass) const {
+  const int n = other.fSize;
+  for (unsigned int iDaug1 = 0; iDaug1 < nDaug1; ++iDaug1) {
+    const float eta1 = Eta(nDaug1, iDaug1, i);
+    for (unsigned int iDaug2 = 0; iDaug2 < nDaug2; ++iDaug2) {
+      const float *eta2 =
+          (nDaug2 == 1) ?
+              other.fEta.data() : other.fEtaDaug.data() + iDaug2 * n;
+      for (int j = jFirst; j < n; ++j) {
+        const float deta = eta1 - eta2[j];
+        float dphiAvg = 0;
+        for (int iRad = 0; iRad < kNRadii; ++iRad) {
+          float dphi = fPhiStar[(iDaug1 * kNRadii + iRad) * fSize + i]
+              - other.fPhiStar[(iDaug2 * kNRadii + iRad) * n + j];
+          // same wrapping as DeltaEtaDeltaPhi: first with the float pi, then
+          // with TVector2::Phi_mpi_pi; phi* is within (-1.5pi, 2.5pi), the
+          // difference within (-4pi, 4pi), so one step of each is enough
+          dphi = (dphi > piCompact) ? dphi - piCompact * 2 :
+                 (dphi < -piCompact) ? dphi + piCompact * 2 : dphi;
+          double dphiD = dphi;
+          dphiD = (dphiD >= TMath::Pi()) ? dphiD - TMath::TwoPi() :
+                  (dphiD < -TMath::Pi()) ? dphiD + TMath::TwoPi() : dphiD;
+          dphiAvg += (float) dphiD;
+        }
+        const float dphiMean = dphiAvg / (float) kNRadii;
+        if (dphiMean * dphiMean / deltaPhiSqMax
+            + deta * deta / deltaEtaSqMax < 1.) {
+          pass[j] = false;
+        }
+      }
+    }
+  }
+}
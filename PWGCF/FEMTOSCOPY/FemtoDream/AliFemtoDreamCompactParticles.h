@@ -0,0 +1,70 @@
+/*
+ * AliFemtoDreamCompactParticles.h
+ *
+ * Compact structure-of-arrays copy of the particles of one species in one
+ * event: momentum, energy, pT, charge, eta and phi* at the TPC radii of the
+ * daughters. Used by the pair kernels, which compute the relative momentum
+ * and the close pair rejection of one particle with all particles of
+ * another block in contiguous loops.
+ */
+
+#ifndef ALIFEMTODREAMCOMPACTPARTICLES_H_
+#define ALIFEMTODREAMCOMPACTPARTICLES_H_
+#include <vector>
+#include "Rtypes.h"
+
+#include "AliFemtoDreamBasePart.h"
+
+class AliFemtoDreamCompactParticles {
+ public:
+  AliFemtoDreamCompactParticles();
+  virtual ~AliFemtoDreamCompactParticles();
+  void Set(std::vector<AliFemtoDreamBasePart> &Particles, double mass);
+  unsigned int GetSize() const {
+    return fSize;
+  }
+  double GetMass() const {
+    return fMass;
+  }
+  float GetPt(int i) const {
+    return fPt[i];
+  }
+  int GetCharge(int i) const {
+    return fCharge[i];
+  }
+  // true if the phi* and eta needed by the close pair rejection with nDaug
+  // daughters are available for all particles
+  bool HasDaughterInfo(unsigned int nDaug) const;
+  // k*, kT and mT of particle i with the particles [jFirst, other.GetSize())
+  // of other, stored at the index of the partner
+  void PairKinematics(int i, const AliFemtoDreamCompactParticles &other,
+                      int jFirst, float *relK, float *kT, float *mT) const;
+  // close pair rejection as in AliFemtoDreamHigherPairMath::DeltaEtaDeltaPhi
+  // without the QA histograms; pass[j] is set to false for rejected pairs
+  void ClosePairRejection(int i, const AliFemtoDreamCompactParticles &other,
+                          int jFirst, unsigned int nDaug1,
+                          unsigned int nDaug2, float deltaPhiSqMax,
+                          float deltaEtaSqMax, char *pass) const;
+  static const int kNRadii = 9;
+ private:
+  float Eta(unsigned int nDaug, unsigned int iDaug, int i) const {
+    return (nDaug == 1) ? fEta[i] : fEtaDaug[iDaug * fSize + i];
+  }
+  unsigned int fSize;
+  double fMass;
+  std::vector<double> fPx;
+  std::vector<double> fPy;
+  std::vector<double> fPz;
+  std::vector<double> fE;
+  std::vector<float> fPt;
+  std::vector<int> fCharge;
+  std::vector<float> fEta;         // eta of the particle itself
+  std::vector<float> fEtaDaug;     // eta of the daughters, [iDaug][i]
+  std::vector<float> fPhiStar;     // phi* at the TPC radii, [iDaug][iRad][i]
+  unsigned int fNDaugEta;          // daughters with eta for all particles
+  unsigned int fNDaugPhiStar;      // daughters with kNRadii phi* for all particles
+  bool fHasEta;                    // all particles have an eta
+  ClassDef(AliFemtoDreamCompactParticles, 1)
+};
+
+#endif /* ALIFEMTODREAMCOMPACTPARTICLES_H_ */
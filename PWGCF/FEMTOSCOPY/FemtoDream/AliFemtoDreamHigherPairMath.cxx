@@ -83,6 +83,26 @@ bool AliFemtoDreamHigherPairMath::PassesPairSelection(
   return pass;
 }
 
+AliFemtoDreamHigherPairMath::PairSelectionMode AliFemtoDreamHigherPairMath::GetPairSelectionMode(
+    int iHC, const AliFemtoDreamCompactParticles &part1,
+    const AliFemtoDreamCompactParticles &part2) {
+  //Same conditions as PassesPairSelection/DeltaEtaDeltaPhi
+  bool CPR = fRejPairs.at(iHC);
+  if (fHists->GetEtaPhiPlots()) {
+    return kPairObject;
+  }
+  if (!(CPR && fDoDeltaEtaDeltaPhiCut)) {
+    return kPairPass;
+  }
+  unsigned int nDaug1 = fWhichPairs.at(iHC) / 10;
+  unsigned int nDaug2 = fWhichPairs.at(iHC) % 10;
+  if (nDaug1 > 9 || !part1.HasDaughterInfo(nDaug1)
+      || !part2.HasDaughterInfo(nDaug2)) {
+    return kPairObject;
+  }
+  return kPairCompact;
+}
+
 bool AliFemtoDreamHigherPairMath::CommonAncestors(AliFemtoDreamBasePart& part1, AliFemtoDreamBasePart& part2) {
     bool IsCommon = false;
     if(part1.GetMotherID() == part2.GetMotherID()){
@@ -141,7 +161,6 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
   if (PDGPart1 == 0 || PDGPart2 == 0) {
     AliError("Invalid PDG Code");
   }
-  bool fillHists = fWhichPairs.at(iHC);
   TLorentzVector PartOne, PartTwo;
   TVector3 Part1Momentum = part1.GetMomentum();
   TVector3 Part2Momentum = part2.GetMomentum();
@@ -154,6 +173,20 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
                   TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
 
   float RelativeK = RelativePairMomentum(PartOne, PartTwo);
+  FillSameEvent(iHC, Mult, cent, part1, part2, RelativeK,
+                RelativePairkT(PartOne, PartTwo),
+                RelativePairmT(PartOne, PartTwo), Part1Momentum.Pt(),
+                Part2Momentum.Pt());
+  return RelativeK;
+}
+
+void AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
+                                                AliFemtoDreamBasePart &part1,
+                                                AliFemtoDreamBasePart &part2,
+                                                float RelativeK, float kT,
+                                                float mT, float pt1,
+                                                float pt2) {
+  bool fillHists = fWhichPairs.at(iHC);
   fHists->FillSameEventDist(iHC, RelativeK);
   if (fHists->GetDoMultBinning()) {
     fHists->FillSameEventMultDist(iHC, Mult + 1, RelativeK);
@@ -162,26 +195,21 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
     fHists->FillSameEventCentDist(iHC, cent, RelativeK);
   }
   if (fillHists && fHists->GetDokTBinning()) {
-    fHists->FillSameEventkTDist(iHC, RelativePairkT(PartOne, PartTwo),
-                                RelativeK, cent);
+    fHists->FillSameEventkTDist(iHC, kT, RelativeK, cent);
   }
   if (fillHists && fHists->GetDomTBinning()) {
-    fHists->FillSameEventmTDist(iHC, RelativePairmT(PartOne, PartTwo),
-                                RelativeK);
+    fHists->FillSameEventmTDist(iHC, mT, RelativeK);
   }
   if (fillHists && fHists->GetDokTandMultBinning()) {
-    fHists->FillSameEventkTandMultDist(iHC, RelativePairkT(PartOne, PartTwo),
-                                       RelativeK, Mult + 1);
+    fHists->FillSameEventkTandMultDist(iHC, kT, RelativeK, Mult + 1);
   }
   if (fillHists && fHists->GetDomTMultPlots()) {
-    fHists->FillSameEventmTMultDist(iHC, RelativePairmT(PartOne, PartTwo), Mult + 1, 
-				   RelativeK); 
-  }   
+    fHists->FillSameEventmTMultDist(iHC, mT, Mult + 1, RelativeK);
+  }
   if (fillHists && fHists->GetDoPtQA()) {
-    fHists->FillPtQADist(iHC, RelativeK, Part1Momentum.Pt(),
-                         Part2Momentum.Pt());
-    fHists->FillPtSEOneQADist(iHC, Part1Momentum.Pt(), Mult + 1);
-    fHists->FillPtSETwoQADist(iHC, Part2Momentum.Pt(), Mult + 1);
+    fHists->FillPtQADist(iHC, RelativeK, pt1, pt2);
+    fHists->FillPtSEOneQADist(iHC, pt1, Mult + 1);
+    fHists->FillPtSETwoQADist(iHC, pt2, Mult + 1);
   }
   if (fillHists && fHists->GetDoAncestorsPlots()) {
     bool isAlabama = CommonAncestors(part1,part2);
@@ -191,7 +219,7 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
 	fHists->FillSameEventMultDistCommon(iHC, Mult + 1, RelativeK);
       }
       if (fHists->GetDomTBinning()) {
-	fHists->FillSameEventmTDistCommon(iHC, RelativePairmT(PartOne, PartTwo), RelativeK);
+	fHists->FillSameEventmTDistCommon(iHC, mT, RelativeK);
       }
     } else {
       fHists->FillSameEventDistNonCommon(iHC, RelativeK);
@@ -199,11 +227,10 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
 	fHists->FillSameEventMultDistNonCommon(iHC, Mult + 1, RelativeK);
       }
       if (fHists->GetDomTBinning()) {
-	fHists->FillSameEventmTDistNonCommon(iHC, RelativePairmT(PartOne, PartTwo), RelativeK);
+	fHists->FillSameEventmTDistNonCommon(iHC, mT, RelativeK);
       }
     }
   }
-  return RelativeK;
 }
 
 void AliFemtoDreamHigherPairMath::MassQA(int iHC, float RelK,
@@ -222,7 +249,6 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
   if (PDGPart1 == 0 || PDGPart2 == 0) {
     AliError("Invalid PDG Code");
   }
-  bool fillHists = fWhichPairs.at(iHC);
   TLorentzVector PartOne, PartTwo;
   TVector3 Part1Momentum = part1.GetMomentum();
   TVector3 Part2Momentum = part2.GetMomentum();
@@ -245,6 +271,17 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
     PartTwo.SetPhi(PartTwo.Phi() + fRandom.Uniform(2 * fPi));
   }
   float RelativeK = RelativePairMomentum(PartOne, PartTwo);
+  FillMixedEvent(iHC, Mult, cent, RelativeK, RelativePairkT(PartOne, PartTwo),
+                 RelativePairmT(PartOne, PartTwo), Part1Momentum.Pt(),
+                 Part2Momentum.Pt());
+  return RelativeK;
+}
+
+void AliFemtoDreamHigherPairMath::FillMixedEvent(int iHC, int Mult, float cent,
+                                                 float RelativeK, float kT,
+                                                 float mT, float pt1,
+                                                 float pt2) {
+  bool fillHists = fWhichPairs.at(iHC);
   fHists->FillMixedEventDist(iHC, RelativeK);
   if (fHists->GetDoMultBinning()) {
     fHists->FillMixedEventMultDist(iHC, Mult + 1, RelativeK);
@@ -253,26 +290,21 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
     fHists->FillMixedEventCentDist(iHC, cent, RelativeK);
   }
   if (fillHists && fHists->GetDokTBinning()) {
-    fHists->FillMixedEventkTDist(iHC, RelativePairkT(PartOne, PartTwo),
-                                 RelativeK, cent);
+    fHists->FillMixedEventkTDist(iHC, kT, RelativeK, cent);
   }
   if (fillHists && fHists->GetDomTBinning()) {
-    fHists->FillMixedEventmTDist(iHC, RelativePairmT(PartOne, PartTwo),
-                                 RelativeK);
+    fHists->FillMixedEventmTDist(iHC, mT, RelativeK);
   }
   if (fillHists && fHists->GetDokTandMultBinning()) {
-    fHists->FillMixedEventkTandMultDist(iHC, RelativePairkT(PartOne, PartTwo),
-                                        RelativeK, Mult + 1);
+    fHists->FillMixedEventkTandMultDist(iHC, kT, RelativeK, Mult + 1);
   }
   if (fillHists && fHists->GetDomTMultPlots()) {
-    fHists->FillMixedEventmTMultDist(iHC, RelativePairmT(PartOne, PartTwo), Mult + 1, 
-				   RelativeK); 
-  }   
+    fHists->FillMixedEventmTMultDist(iHC, mT, Mult + 1, RelativeK);
+  }
   if (fillHists && fHists->GetDoPtQA()) {
-    fHists->FillPtMEOneQADist(iHC, Part1Momentum.Pt(), Mult + 1);
-    fHists->FillPtMETwoQADist(iHC, Part2Momentum.Pt(), Mult + 1);
+    fHists->FillPtMEOneQADist(iHC, pt1, Mult + 1);
+    fHists->FillPtMETwoQADist(iHC, pt2, Mult + 1);
   }
-  return RelativeK;
 }
 
 void AliFemtoDreamHigherPairMath::SEDetaDPhiPlots(int iHC,
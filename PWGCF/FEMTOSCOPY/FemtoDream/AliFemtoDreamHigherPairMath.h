@@ -11,6 +11,7 @@
 #include "AliLog.h"
 #include "TRandom3.h"
 #include "AliFemtoDreamBasePart.h"
+#include "AliFemtoDreamCompactParticles.h"
 #include "AliFemtoDreamCollConfig.h"
 #include "AliFemtoDreamCorrHists.h"
 #include <vector>
@@ -34,10 +35,32 @@ class AliFemtoDreamHigherPairMath {
   bool PassesPairSelection(int iHC, AliFemtoDreamBasePart& part1,
                            AliFemtoDreamBasePart& part2, float RelativeK,
                            bool SEorME, bool Recalculate);
+  // How the pair selection of PassesPairSelection can be done for two blocks
+  // of particles: nothing to check, with the compact copies, or only with the
+  // particle objects (QA histograms at the radii, missing daughter info)
+  enum PairSelectionMode {
+    kPairPass = 0,
+    kPairCompact = 1,
+    kPairObject = 2
+  };
+  PairSelectionMode GetPairSelectionMode(
+      int iHC, const AliFemtoDreamCompactParticles &part1,
+      const AliFemtoDreamCompactParticles &part2);
+  void ClosePairRejection(int iHC, const AliFemtoDreamCompactParticles &part1,
+                          int i, const AliFemtoDreamCompactParticles &part2,
+                          int jFirst, char *pass) {
+    part1.ClosePairRejection(i, part2, jFirst, fWhichPairs[iHC] / 10,
+                             fWhichPairs[iHC] % 10, fDeltaPhiSqMax,
+                             fDeltaEtaSqMax, pass);
+  }
   bool CommonAncestors(AliFemtoDreamBasePart& part1, AliFemtoDreamBasePart& part2);
   void RecalculatePhiStar(AliFemtoDreamBasePart &part);
   float FillSameEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
                       int PDGPart1, AliFemtoDreamBasePart& part2, int PDGPart2);
+  // same as above, with the pair kinematics already computed
+  void FillSameEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
+                     AliFemtoDreamBasePart& part2, float RelativeK, float kT,
+                     float mT, float pt1, float pt2);
   void MassQA(int iHC, float RelK, AliFemtoDreamBasePart &part1,
               AliFemtoDreamBasePart &part2);
   void SEMomentumResolution(int iHC, AliFemtoDreamBasePart* part1, int PDGPart1,
@@ -53,6 +76,10 @@ class AliFemtoDreamHigherPairMath {
   float FillMixedEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
                        int PDGPart1, AliFemtoDreamBasePart& part2, int PDGPart2,
                        AliFemtoDreamCollConfig::UncorrelatedMode mode);
+  // same as above for AliFemtoDreamCollConfig::kNone, with the pair
+  // kinematics already computed
+  void FillMixedEvent(int iHC, int Mult, float cent, float RelativeK, float kT,
+                      float mT, float pt1, float pt2);
   void MEMomentumResolution(int iHC, AliFemtoDreamBasePart* part1, int PDGPart1,
                             AliFemtoDreamBasePart* part2, int PDGPart2,
                             float RelativeK);
@@ -12,12 +12,14 @@
 ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamPartContainer::AliFemtoDreamPartContainer()
     : fPartBuffer(),
+      fCompactBuffer(),
       fMixingDepth(0) {
 
 }
 
 AliFemtoDreamPartContainer::AliFemtoDreamPartContainer(int MixingDepth)
     : fPartBuffer(),
+      fCompactBuffer(),
       fMixingDepth(MixingDepth) {
 
 }
@@ -36,6 +38,7 @@ AliFemtoDreamPartContainer& AliFemtoDreamPartContainer::operator=(
 //  }
   this->fMixingDepth = obj.fMixingDepth;
   this->fPartBuffer = obj.fPartBuffer;
+  this->fCompactBuffer = obj.fCompactBuffer;
   return (*this);
 }
 
@@ -49,11 +52,32 @@ void AliFemtoDreamPartContainer::SetEvent(
     fPartBuffer.pop_front();
   }
   fPartBuffer.push_back(Particles);
+  //Events without compact copy invalidate the compact buffer
+  fCompactBuffer.clear();
 //  std::cout << "PartBuffer Size: "<<fPartBuffer.size()<<'\t'<<"Input Size: "
 //      << Particles.size() << '\n';
   return;
 }
 
+void AliFemtoDreamPartContainer::SetEvent(
+    std::vector<AliFemtoDreamBasePart> &Particles,
+    const AliFemtoDreamCompactParticles &Compact) {
+  if (fCompactBuffer.size() != fPartBuffer.size()) {
+    fCompactBuffer.clear();
+  }
+  if (!(fPartBuffer.size() < fMixingDepth)) {
+    fPartBuffer.pop_front();
+    if (fCompactBuffer.size()) {
+      fCompactBuffer.pop_front();
+    }
+  }
+  fPartBuffer.push_back(Particles);
+  if (fCompactBuffer.size() + 1 == fPartBuffer.size()) {
+    fCompactBuffer.push_back(Compact);
+  }
+  return;
+}
+
 void AliFemtoDreamPartContainer::PrintLastEvent() {
   for (std::deque<std::vector<AliFemtoDreamBasePart>>::iterator itEvt =
       fPartBuffer.begin(); itEvt != fPartBuffer.end(); ++itEvt) {
@@ -72,3 +96,11 @@ std::vector<AliFemtoDreamBasePart> &AliFemtoDreamPartContainer::GetEvent(
       .begin() + Depth;
   return *itEvt;
 }
+
+const AliFemtoDreamCompactParticles *AliFemtoDreamPartContainer::GetCompactEvent(
+    int Depth) const {
+  if (fCompactBuffer.size() != fPartBuffer.size()) {
+    return 0;
+  }
+  return &fCompactBuffer[Depth];
+}
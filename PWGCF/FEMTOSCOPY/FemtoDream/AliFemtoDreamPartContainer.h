@@ -12,6 +12,7 @@
 #include "Rtypes.h"
 
 #include "AliFemtoDreamBasePart.h"
+#include "AliFemtoDreamCompactParticles.h"
 
 //Class Containing the Particles from previous Events up to a certain mixing
 //depth for one Particle Species and Mult/ZVtx Bin
@@ -24,18 +25,24 @@ class AliFemtoDreamPartContainer {
   virtual ~AliFemtoDreamPartContainer();
   void PrintLastEvent();
   void SetEvent(std::vector<AliFemtoDreamBasePart> &Particles);
+  // also keeps the compact copy of the particles used by the pair kernels
+  void SetEvent(std::vector<AliFemtoDreamBasePart> &Particles,
+                const AliFemtoDreamCompactParticles &Compact);
   std::deque<std::vector<AliFemtoDreamBasePart>> GetEventBuffer() const {
     return fPartBuffer;
   }
   ;
   std::vector<AliFemtoDreamBasePart> &GetEvent(int Depth);
+  // compact copy of the event at Depth, 0 if not available for all events
+  const AliFemtoDreamCompactParticles *GetCompactEvent(int Depth) const;
   unsigned int GetMixingDepth() const {
     return fPartBuffer.size();
   }
   ;
  private:
   std::deque<std::vector<AliFemtoDreamBasePart>> fPartBuffer;
-  unsigned int fMixingDepth;ClassDef(AliFemtoDreamPartContainer,2)
+  std::deque<AliFemtoDreamCompactParticles> fCompactBuffer; //! compact copies of fPartBuffer (empty if out of sync)
+  unsigned int fMixingDepth;ClassDef(AliFemtoDreamPartContainer,3)
   ;
 };
 
@@ -5,6 +5,7 @@
  *      Author: gu74req
  */
 //#include "AliLog.h"
+#include <algorithm>
 #include <iostream>
 #include "AliFemtoDreamZVtxMultContainer.h"
 #include "TLorentzVector.h"
@@ -15,7 +16,13 @@ ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer()
     : fPartContainer(0),
       fPDGParticleSpecies(0),
-      fWhichPairs(){
+      fWhichPairs(),
+      fMasses(),
+      fCompact(),
+      fRelK(),
+      fkT(),
+      fmT(),
+      fPass() {
 }
 
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
@@ -23,7 +30,13 @@ AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
     : fPartContainer(conf->GetNParticles(),
                      AliFemtoDreamPartContainer(conf->GetMixingDepth())),
       fPDGParticleSpecies(conf->GetPDGCodes()),
-      fWhichPairs(conf->GetWhichPairs()){
+      fWhichPairs(conf->GetWhichPairs()),
+      fMasses(),
+      fCompact(),
+      fRelK(),
+      fkT(),
+      fmT(),
+      fPass() {
   TDatabasePDG::Instance()->AddParticle("deuteron", "deuteron", 1.8756134,
                                         kTRUE, 0.0, 1, "Nucleus", 1000010020);
   TDatabasePDG::Instance()->AddAntiParticle("anti-deuteron", -1000010020);
@@ -47,18 +60,48 @@ void AliFemtoDreamZVtxMultContainer::SetEvent(
       .begin();
   std::vector<AliFemtoDreamPartContainer>::iterator itContainer = fPartContainer
       .begin();
+  //The compact copies were filled by the pairing of the same event
+  if (fCompact.size() != Particles.size()) {
+    SetCompactParticles(Particles);
+  }
+  auto itCompact = fCompact.begin();
   while (itContainer != fPartContainer.end()) {
     if (itInput->size() > 0) {
-      itContainer->SetEvent(*itInput);
+      itContainer->SetEvent(*itInput, *itCompact);
     }
     ++itInput;
     ++itContainer;
+    ++itCompact;
   }
+  fCompact.clear();
   //  }
 }
+
+void AliFemtoDreamZVtxMultContainer::SetCompactParticles(
+    std::vector<std::vector<AliFemtoDreamBasePart>> &Particles) {
+  if (fMasses.size() != fPDGParticleSpecies.size()) {
+    fMasses.clear();
+    for (auto itPDG : fPDGParticleSpecies) {
+      TParticlePDG *pdg = TDatabasePDG::Instance()->GetParticle(itPDG);
+      if (!pdg) {
+        std::cout << "AliFemtoDreamZVtxMultContainer: unknown PDG code "
+                  << itPDG << '\n';
+      }
+      fMasses.push_back(pdg ? pdg->Mass() : 0.);
+    }
+  }
+  fCompact.resize(Particles.size());
+  for (unsigned int iSpec = 0; iSpec < Particles.size(); ++iSpec) {
+    fCompact[iSpec].Set(Particles[iSpec], fMasses.at(iSpec));
+  }
+}
 void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
     AliFemtoDreamHigherPairMath *HigherMath, int iMult, float cent) {
+  //The pair kinematics and the close pair rejection of one particle with all
+  //its partners are computed at once on the compact copies of the particles,
+  //the histograms are then filled pair by pair
+  SetCompactParticles(Particles);
   int HistCounter = 0;
   //First loop over all the different Species
   auto itPDGPar1 = fPDGParticleSpecies.begin();
@@ -66,47 +109,54 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
       ++itSpec1) {
     auto itPDGPar2 = fPDGParticleSpecies.begin();
     itPDGPar2 += itSpec1 - Particles.begin();
+    const AliFemtoDreamCompactParticles &Compact1 = fCompact[itSpec1
+        - Particles.begin()];
     for (auto itSpec2 = itSpec1; itSpec2 != Particles.end(); ++itSpec2) {
       HigherMath->FillPairCounterSE(HistCounter, itSpec1->size(),
                                     itSpec2->size());
+      const AliFemtoDreamCompactParticles &Compact2 = fCompact[itSpec2
+          - Particles.begin()];
+      AliFemtoDreamHigherPairMath::PairSelectionMode mode = HigherMath
+          ->GetPairSelectionMode(HistCounter, Compact1, Compact2);
+      int nPart2 = itSpec2->size();
+      fRelK.resize(nPart2);
+      fkT.resize(nPart2);
+      fmT.resize(nPart2);
+      fPass.resize(nPart2);
       //Now loop over the actual Particles and correlate them
-      for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
-          ++itPart1) {
-        AliFemtoDreamBasePart part1 = *itPart1;
-        std::vector<AliFemtoDreamBasePart>::iterator itPart2;
-        if (itSpec1 == itSpec2) {
-          itPart2 = itPart1 + 1;
-        } else {
-          itPart2 = itSpec2->begin();
+      for (int iPart1 = 0; iPart1 < (int) itSpec1->size(); ++iPart1) {
+        AliFemtoDreamBasePart &part1 = (*itSpec1)[iPart1];
+        int iPart2First = (itSpec1 == itSpec2) ? iPart1 + 1 : 0;
+        if (iPart2First >= nPart2) {
+          continue;
         }
-        while (itPart2 != itSpec2->end()) {
-          AliFemtoDreamBasePart part2 = *itPart2;
-          TLorentzVector PartOne, PartTwo;
-          PartOne.SetXYZM(
-              itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-              itPart1->GetMomentum().Z(),
-              TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
-          PartTwo.SetXYZM(
-              itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-              itPart2->GetMomentum().Z(),
-              TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
-          float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
-          if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
-                                               RelativeK, true, false)) {
-            ++itPart2;
+        Compact1.PairKinematics(iPart1, Compact2, iPart2First, fRelK.data(),
+                                fkT.data(), fmT.data());
+        std::fill(fPass.begin() + iPart2First, fPass.end(), true);
+        if (mode == AliFemtoDreamHigherPairMath::kPairCompact) {
+          HigherMath->ClosePairRejection(HistCounter, Compact1, iPart1,
+                                         Compact2, iPart2First, fPass.data());
+        }
+        for (int iPart2 = iPart2First; iPart2 < nPart2; ++iPart2) {
+          AliFemtoDreamBasePart &part2 = (*itSpec2)[iPart2];
+          float RelativeK = fRelK[iPart2];
+          if (mode == AliFemtoDreamHigherPairMath::kPairObject) {
+            fPass[iPart2] = HigherMath->PassesPairSelection(HistCounter, part1,
+                                                            part2, RelativeK,
+                                                            true, false);
+          }
+          if (!fPass[iPart2]) {
             continue;
           }
-          RelativeK = HigherMath->FillSameEvent(HistCounter, iMult, cent,
-                                                part1,
-                                                *itPDGPar1,
-                                                part2,
-                                                *itPDGPar2);
-          HigherMath->MassQA(HistCounter, RelativeK, *itPart1, *itPart2);
-          HigherMath->SEDetaDPhiPlots(HistCounter, *itPart1, *itPDGPar1,
-                                      *itPart2, *itPDGPar2, RelativeK, false);
-          HigherMath->SEMomentumResolution(HistCounter, &(*itPart1), *itPDGPar1,
-                                           &(*itPart2), *itPDGPar2, RelativeK);
-          ++itPart2;
+          HigherMath->FillSameEvent(HistCounter, iMult, cent, part1, part2,
+                                    RelativeK, fkT[iPart2], fmT[iPart2],
+                                    Compact1.GetPt(iPart1),
+                                    Compact2.GetPt(iPart2));
+          HigherMath->MassQA(HistCounter, RelativeK, part1, part2);
+          HigherMath->SEDetaDPhiPlots(HistCounter, part1, *itPDGPar1, part2,
+                                      *itPDGPar2, RelativeK, false);
+          HigherMath->SEMomentumResolution(HistCounter, &part1, *itPDGPar1,
+                                           &part2, *itPDGPar2, RelativeK);
         }
       }
       ++HistCounter;
@@ -119,6 +169,9 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
 void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
     AliFemtoDreamHigherPairMath *HigherMath, int iMult, float cent) {
+  if (fCompact.size() != Particles.size()) {
+    SetCompactParticles(Particles);
+  }
   int HistCounter = 0;
   auto itPDGPar1 = fPDGParticleSpecies.begin();
   //First loop over all the different Species
@@ -128,6 +181,7 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     //Particle1 + Particle2 == Particle2 + Particle 1
     int SkipPart = itSpec1 - Particles.begin();
     auto itPDGPar2 = fPDGParticleSpecies.begin() + SkipPart;
+    const AliFemtoDreamCompactParticles &Compact1 = fCompact[SkipPart];
     for (auto itSpec2 = fPartContainer.begin() + SkipPart;
         itSpec2 != fPartContainer.end(); ++itSpec2) {
       if (itSpec1->size() > 0) {
@@ -135,39 +189,55 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
                                              (int) itSpec2->GetMixingDepth());
       }
       for (int iDepth = 0; iDepth < (int) itSpec2->GetMixingDepth(); ++iDepth) {
-        std::vector<AliFemtoDreamBasePart> ParticlesOfEvent = itSpec2->GetEvent(
-            iDepth);
+        std::vector<AliFemtoDreamBasePart> &ParticlesOfEvent = itSpec2
+            ->GetEvent(iDepth);
         HigherMath->FillPairCounterME(HistCounter, itSpec1->size(),
                                       ParticlesOfEvent.size());
-        for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
-            ++itPart1) {
-          for (auto itPart2 = ParticlesOfEvent.begin();
-              itPart2 != ParticlesOfEvent.end(); ++itPart2) {
-
-            TLorentzVector PartOne, PartTwo;
-            PartOne.SetXYZM(
-                itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-                itPart1->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
-            PartTwo.SetXYZM(
-                itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-                itPart2->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
-            float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
-            if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
-                                                 RelativeK, false, false)) {
+        const AliFemtoDreamCompactParticles *Compact2 = itSpec2
+            ->GetCompactEvent(iDepth);
+        AliFemtoDreamCompactParticles CompactOfEvent;
+        if (!Compact2) {
+          //Buffer filled without compact copies, e.g. read from file
+          CompactOfEvent.Set(ParticlesOfEvent,
+                             fMasses.at(itPDGPar2 - fPDGParticleSpecies.begin()));
+          Compact2 = &CompactOfEvent;
+        }
+        AliFemtoDreamHigherPairMath::PairSelectionMode mode = HigherMath
+            ->GetPairSelectionMode(HistCounter, Compact1, *Compact2);
+        int nPart2 = ParticlesOfEvent.size();
+        fRelK.resize(nPart2);
+        fkT.resize(nPart2);
+        fmT.resize(nPart2);
+        fPass.resize(nPart2);
+        for (int iPart1 = 0; iPart1 < (int) itSpec1->size(); ++iPart1) {
+          AliFemtoDreamBasePart &part1 = (*itSpec1)[iPart1];
+          Compact1.PairKinematics(iPart1, *Compact2, 0, fRelK.data(),
+                                  fkT.data(), fmT.data());
+          std::fill(fPass.begin(), fPass.end(), true);
+          if (mode == AliFemtoDreamHigherPairMath::kPairCompact) {
+            HigherMath->ClosePairRejection(HistCounter, Compact1, iPart1,
+                                           *Compact2, 0, fPass.data());
+          }
+          for (int iPart2 = 0; iPart2 < nPart2; ++iPart2) {
+            AliFemtoDreamBasePart &part2 = ParticlesOfEvent[iPart2];
+            float RelativeK = fRelK[iPart2];
+            if (mode == AliFemtoDreamHigherPairMath::kPairObject) {
+              fPass[iPart2] = HigherMath->PassesPairSelection(HistCounter,
+                                                              part1, part2,
+                                                              RelativeK, false,
+                                                              false);
+            }
+            if (!fPass[iPart2]) {
               continue;
             }
-            RelativeK = HigherMath->FillMixedEvent(
-                HistCounter, iMult, cent, *itPart1, *itPDGPar1,
-                *itPart2, *itPDGPar2,
-                AliFemtoDreamCollConfig::kNone);
-
-            HigherMath->MEDetaDPhiPlots(HistCounter, *itPart1, *itPDGPar1,
-                                        *itPart2, *itPDGPar2, RelativeK, false);
-            HigherMath->MEMomentumResolution(HistCounter, &(*itPart1),
-                                             *itPDGPar1, &(*itPart2),
-                                             *itPDGPar2, RelativeK);
+            HigherMath->FillMixedEvent(HistCounter, iMult, cent, RelativeK,
+                                       fkT[iPart2], fmT[iPart2],
+                                       Compact1.GetPt(iPart1),
+                                       Compact2->GetPt(iPart2));
+            HigherMath->MEDetaDPhiPlots(HistCounter, part1, *itPDGPar1, part2,
+                                        *itPDGPar2, RelativeK, false);
+            HigherMath->MEMomentumResolution(HistCounter, &part1, *itPDGPar1,
+                                             &part2, *itPDGPar2, RelativeK);
           }
         }
       }
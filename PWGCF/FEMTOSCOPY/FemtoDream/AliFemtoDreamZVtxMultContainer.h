@@ -41,6 +41,8 @@ class AliFemtoDreamZVtxMultContainer {
   }
   ;
  private:
+  void SetCompactParticles(
+      std::vector<std::vector<AliFemtoDreamBasePart>> &Particles);
   std::vector<AliFemtoDreamPartContainer> fPartContainer;
   std::vector<int> fPDGParticleSpecies;
   std::vector<unsigned int> fWhichPairs;
@@ -49,8 +51,14 @@ class AliFemtoDreamZVtxMultContainer {
 //  float fDeltaEtaMax;
 //  float fDeltaPhiMax;
 //  float fDeltaPhiEtaMax;
+  std::vector<double> fMasses;  //! masses of the particle species
+  std::vector<AliFemtoDreamCompactParticles> fCompact;  //! compact copies of the current event
+  std::vector<float> fRelK;  //! k* of one particle with a block of partners
+  std::vector<float> fkT;    //! kT of one particle with a block of partners
+  std::vector<float> fmT;    //! mT of one particle with a block of partners
+  std::vector<char> fPass;   //! pair selection of one particle with a block of partners
 
-ClassDef(AliFemtoDreamZVtxMultContainer, 4)
+ClassDef(AliFemtoDreamZVtxMultContainer, 5)
   ;
 };
 
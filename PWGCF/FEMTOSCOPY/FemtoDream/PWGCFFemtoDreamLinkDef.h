@@ -24,6 +24,7 @@
 #pragma link C++ class AliFemtoDreamPairCleaner+;
 #pragma link C++ class AliFemtoDreamCollConfig+;
 #pragma link C++ class AliFemtoDreamCorrHists+;
+#pragma link C++ class AliFemtoDreamCompactParticles+;
 #pragma link C++ class AliFemtoDreamPartContainer+;
 #pragma link C++ class AliFemtoDreamZVtxMultContainer+;
 #pragma link C++ class AliFemtoDreamPartCollection+;
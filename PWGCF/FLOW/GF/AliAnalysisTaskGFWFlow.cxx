@@ -606,12 +606,13 @@ Bool_t AliAnalysisTaskGFWFlow::FillFCs(TString head, TString hn, Double_t cent,
   };
   return kTRUE;
 };
-Bool_t AliAnalysisTaskGFWFlow::FillFCs(AliGFW::CorrConfig corconf, Double_t cent, Double_t rndmn, Bool_t DisableOverlap) {
+Bool_t AliAnalysisTaskGFWFlow::FillFCs(const AliGFW::CorrConfig &corconf, Double_t cent, Double_t rndmn, Bool_t DisableOverlap) {
   Double_t dnx, val;
-  dnx = fGFW->Calculate(corconf,0,kTRUE).Re();
+  //Configurations are compiled in GetCorrelatorConfig, so evaluate them through the plan ID
+  dnx = fGFW->Calculate(corconf.ID,0,kTRUE).Re();
   if(dnx==0) return kFALSE;
   if(!corconf.pTDif) {
-    val = fGFW->Calculate(corconf,0,kFALSE).Re()/dnx;
+    val = fGFW->Calculate(corconf.ID,0,kFALSE).Re()/dnx;
     if(TMath::Abs(val)<1)
       fFC->FillProfile(corconf.Head.Data(),cent,val,dnx,rndmn);
     return kTRUE;
@@ -622,9 +623,9 @@ Bool_t AliAnalysisTaskGFWFlow::FillFCs(AliGFW::CorrConfig corconf, Double_t cent
   Bool_t NeedToDisable=kFALSE;
   for(Int_t i=1;i<=fPtAxis->GetNbins();i++) {
     //if(DisableOverlap) NeedToDisable=(i>=binDisableOLFrom);
-    dnx = fGFW->Calculate(corconf,i-1,kTRUE,NeedToDisable).Re();
+    dnx = fGFW->Calculate(corconf.ID,i-1,kTRUE,NeedToDisable).Re();
     if(dnx==0) continue;
-    val = fGFW->Calculate(corconf,i-1,kFALSE,NeedToDisable).Re()/dnx;
+    val = fGFW->Calculate(corconf.ID,i-1,kFALSE,NeedToDisable).Re()/dnx;
     if(TMath::Abs(val)<1)
       fFC->FillProfile(Form("%s_pt_%i",corconf.Head.Data(),i),cent,val,dnx,rndmn);
   };
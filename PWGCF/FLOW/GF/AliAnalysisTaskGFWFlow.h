@@ -94,7 +94,7 @@ class AliAnalysisTaskGFWFlow : public AliAnalysisTaskSE {
   Bool_t AcceptParticle(AliVParticle *mPa);
   Bool_t InitRun();
   Bool_t LoadWeights(Int_t runno);
-  Bool_t FillFCs(AliGFW::CorrConfig corconf, Double_t cent, Double_t rndm, Bool_t DisableOverlap=kFALSE);
+  Bool_t FillFCs(const AliGFW::CorrConfig &corconf, Double_t cent, Double_t rndm, Bool_t DisableOverlap=kFALSE);
   Bool_t FillFCs(TString head, TString hn, Double_t cent, Bool_t diff, Double_t rndmn);
  // TStopwatch mywatch;
  // TStopwatch mywatchFill;
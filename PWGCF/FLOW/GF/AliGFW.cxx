@@ -3,7 +3,9 @@
 need to add flags to have control over what is added, e.g. what happens, when I have several overlapping regions of different types: reference, pT-diff unID and pT-diff. ID?
 */
 AliGFW::AliGFW():
-  fInitialized(kFALSE)
+  fInitialized(kFALSE),
+  fEventStamp(1),
+  fMemoOutdated(kTRUE)
 {
 };
 
@@ -74,13 +76,13 @@ Int_t AliGFW::CreateRegions() {
   //for(auto pitr = fRegions.begin(); pitr!=fRegions.end(); pitr++) pitr->PrintStructure();
   Int_t nRegions=0;
   for(auto pItr=fRegions.begin(); pItr!=fRegions.end(); pItr++) {
-    AliGFWCumulant *lCumulant = new AliGFWCumulant();
+    fCumulants.push_back(AliGFWCumulant());
+    AliGFWCumulant *lCumulant = &fCumulants.back();
     if(pItr->NparVec.size()) {
       lCumulant->CreateComplexVectorArrayVarPower(pItr->Nhar, pItr->NparVec, pItr->NpT);
     } else {
       lCumulant->CreateComplexVectorArray(pItr->Nhar, pItr->Npar, pItr->NpT);
     };
-    fCumulants.push_back(*lCumulant);
     ++nRegions;
   };
   if(nRegions) fInitialized=kTRUE;
@@ -89,6 +91,7 @@ Int_t AliGFW::CreateRegions() {
 void AliGFW::Fill(Double_t eta, Int_t ptin, Double_t phi, Double_t weight, Int_t mask) {
   if(!fInitialized) CreateRegions();
   if(!fInitialized) return;
+  fMemoOutdated=kTRUE;
   for(Int_t i=0;i<(Int_t)fRegions.size();++i) {
     if(fRegions.at(i).EtaMin<eta && fRegions.at(i).EtaMax>eta && (fRegions.at(i).BitMask&mask))
       fCumulants.at(i).FillArray(eta,ptin,phi,weight);
@@ -126,40 +129,50 @@ TComplex AliGFW::RecursiveCorr(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGF
 };
 void AliGFW::Clear() {
   for(auto ptr = fCumulants.begin(); ptr!=fCumulants.end(); ++ptr) ptr->ResetQs();
-  fCalculatedNames.clear();
-  fCalculatedQs.clear();
+  fMemoOutdated=kTRUE;
 };
 TComplex AliGFW::Calculate(TString config, Bool_t SetHarmsToZero) {
   if(config.EqualTo("")) {
     printf("Configuration empty!\n");
     return TComplex(0,0);
   };
+  //Strings are only parsed the first time they are seen
+  auto itr = fStringPlans.find(config);
+  Int_t planID = (itr==fStringPlans.end())?CompileString(config):itr->second;
+  return Calculate(planID,0,SetHarmsToZero);
+};
+Int_t AliGFW::CompileString(TString config) {
+  CorrPlan plan;
+  plan.FromString=kTRUE;
+  plan.Head=config;
   TString tmp;
   Ssiz_t sz1=0;
-  TComplex ret(1,0);
   while(config.Tokenize(tmp,sz1,"}")) {
-    if(SetHarmsToZero) SetHarmonicsToZero(tmp);
-    /*Int_t ind=FindCalculated(tmp);
-    if(ind>=0) {
-      ret*=fCalculatedQs.at(ind);
-      continue;
-    };*/
-    TComplex val=CalculateSingle(tmp);
-    ret*=val;
-    fCalculatedQs.push_back(val);
-    fCalculatedNames.push_back(tmp);
+    TString tmpZero(tmp);
+    SetHarmonicsToZero(tmpZero);
+    vector<Int_t> regs, hars, regsZero, harsZero;
+    Int_t ptbin=0, ptbinZero=0;
+    CorrTerm term;
+    if(ParseSingle(tmp,regs,hars,ptbin) && ParseSingle(tmpZero,regsZero,harsZero,ptbinZero) && regs.size()) {
+      if(regs.size()==1) CompileTerm(term,regs.at(0),regs.at(0),0,hars,harsZero);
+      else CompileTerm(term,regs.at(0),regs.at(1),ptbin,hars,harsZero);
+    };
+    plan.Terms.push_back(term);
   };
-  return ret;
+  plan.ID = (Int_t)fPlans.size();
+  plan.Memo[0] = RegisterMemo(plan,kFALSE);
+  plan.Memo[1] = RegisterMemo(plan,kTRUE);
+  fPlans.push_back(plan);
+  fStringPlans[config] = plan.ID;
+  return plan.ID;
 };
-TComplex AliGFW::CalculateSingle(TString config) {
+Bool_t AliGFW::ParseSingle(TString config, vector<Int_t> &regs, vector<Int_t> &hars, Int_t &ptbin) {
   //First remove all ; and ,:
   config.ReplaceAll(","," ");
   config.ReplaceAll(";"," ");
   //Then make sure we don't have any double-spaces:
   while(config.Index("  ")>-1) config.ReplaceAll("  "," ");
-  vector<Int_t> regs;
-  vector<Int_t> hars;
-  Int_t ptbin=0;
+  ptbin=0;
   Ssiz_t sz1=0;
   Ssiz_t szend=0;
   TString ts, ts2;
@@ -172,7 +185,7 @@ TComplex AliGFW::CalculateSingle(TString config) {
   if(sz1<0) sz1=0;
   if(!config.Tokenize(ts,szend,"{")) {
     printf("Could not find harmonics!\n");
-    return TComplex(0,0);
+    return kFALSE;
   };
   //Fetch regions
   while(ts.Tokenize(ts2,sz1," ")) {
@@ -187,8 +200,7 @@ TComplex AliGFW::CalculateSingle(TString config) {
   };
   //Fetch harmonics
   while(config.Tokenize(ts,szend," ")) hars.push_back(ts.Atoi());
-  if(regs.size()==1) return Calculate(regs.at(0),hars);
-  return Calculate(regs.at(0),regs.at(1),hars,ptbin);
+  return kTRUE;
 };
 AliGFW::CorrConfig AliGFW::GetCorrelatorConfig(TString config, TString head, Bool_t ptdif) {
   //First remove all ; and ,:
@@ -245,8 +257,199 @@ AliGFW::CorrConfig AliGFW::GetCorrelatorConfig(TString config, TString head, Boo
   };
   ReturnConfig.Head = head;
   ReturnConfig.pTDif = ptdif;
+  ReturnConfig.ID = CompileCorrConfig(ReturnConfig);
   return ReturnConfig;
 };
+Int_t AliGFW::CompileCorrConfig(const CorrConfig &corconf) {
+  CorrPlan plan;
+  plan.Head = corconf.Head;
+  plan.pTDif = corconf.pTDif;
+  if(corconf.Regs.size()) {
+    Int_t poi = corconf.Regs.at(0);
+    Int_t ref = (corconf.Regs.size()>1)?corconf.Regs.at(1):corconf.Regs.at(0);
+    plan.NpT = fRegions.at(poi).NpT;
+    CorrTerm term;
+    CompileTerm(term,poi,ref,-1,corconf.Hars,vector<Int_t>(corconf.Hars.size(),0));
+    plan.Terms.push_back(term);
+    if(corconf.Regs2.size()) {
+      poi = corconf.Regs2.at(0);
+      ref = (corconf.Regs2.size()>1)?corconf.Regs2.at(1):corconf.Regs2.at(0);
+      CorrTerm term2;
+      CompileTerm(term2,poi,ref,0,corconf.Hars2,vector<Int_t>(corconf.Hars2.size(),0));
+      plan.Terms.push_back(term2);
+    };
+  };
+  plan.ID = (Int_t)fPlans.size();
+  plan.Memo[0] = RegisterMemo(plan,kFALSE);
+  plan.Memo[1] = RegisterMemo(plan,kTRUE);
+  fPlans.push_back(plan);
+  return plan.ID;
+};
+void AliGFW::CompileTerm(CorrTerm &term, Int_t poi, Int_t ref, Int_t ptbin, const vector<Int_t> &hars, const vector<Int_t> &harsZero) {
+  term.Poi = poi;
+  term.Ref = ref;
+  term.PtBin = ptbin;
+  term.Hars = hars;
+  term.HarsZero = harsZero;
+  std::map<vector<Int_t>,Int_t> nodeIDs;
+  CompileRecursion(term.Prog,nodeIDs,hars,vector<Int_t>());
+  nodeIDs.clear();
+  CompileRecursion(term.ProgZero,nodeIDs,harsZero,vector<Int_t>());
+};
+Int_t AliGFW::CompileRecursion(CorrProgram &prog, std::map<vector<Int_t>,Int_t> &nodeIDs, vector<Int_t> hars, vector<Int_t> pows) {
+  //Same structure as RecursiveCorr, but each distinct (harmonics, powers) combination becomes one node
+  if(hars.size()==0) return -1;
+  if(pows.size()==0) //if powers are not initialized, initialize them to 1
+    for(Int_t i=0; i<(Int_t)hars.size(); i++)
+      pows.push_back(1);
+  vector<Int_t> key(hars);
+  key.insert(key.end(),pows.begin(),pows.end());
+  auto itr = nodeIDs.find(key);
+  if(itr!=nodeIDs.end()) return itr->second;
+  CorrNode node;
+  node.H1=hars.at(0); node.P1=pows.at(0);
+  node.H2=0; node.P2=0;
+  node.Child=-1;
+  node.SubBegin=0; node.SubEnd=0;
+  if(hars.size()<2) node.Type=kSingle;
+  else if(hars.size()<3) {
+    node.Type=kTwo;
+    node.H2=hars.at(1); node.P2=pows.at(1);
+  } else {
+    node.Type=kRec;
+    node.H2=hars.at(hars.size()-1);
+    node.P2=pows.at(pows.size()-1);
+    hars.erase(hars.end()-1);
+    pows.erase(pows.end()-1);
+    node.Child = CompileRecursion(prog,nodeIDs,hars,pows);
+    vector<Int_t> subs;
+    for(Int_t i=0;i<(Int_t)hars.size();i++) {
+      vector<Int_t> lhars = hars;
+      vector<Int_t> lpows = pows;
+      lhars.at(i)+=node.H2;
+      lpows.at(i)+=node.P2;
+      subs.push_back(CompileRecursion(prog,nodeIDs,lhars,lpows));
+    };
+    node.SubBegin=(Int_t)prog.Subtract.size();
+    prog.Subtract.insert(prog.Subtract.end(),subs.begin(),subs.end());
+    node.SubEnd=(Int_t)prog.Subtract.size();
+  };
+  prog.Nodes.push_back(node);
+  nodeIDs[key] = (Int_t)prog.Nodes.size()-1;
+  return nodeIDs[key];
+};
+Int_t AliGFW::RegisterMemo(const CorrPlan &plan, Bool_t zero) {
+  //Plans giving the same result (e.g. weights of correlators differing only in harmonics) share the same slots
+  vector<Int_t> key;
+  key.push_back(plan.FromString);
+  key.push_back(plan.NpT);
+  for(Int_t i=0;i<(Int_t)plan.Terms.size();i++) {
+    const CorrTerm &term = plan.Terms.at(i);
+    const vector<Int_t> &hars = zero?term.HarsZero:term.Hars;
+    key.push_back(term.Poi);
+    key.push_back(term.Ref);
+    key.push_back(term.PtBin);
+    key.push_back((Int_t)hars.size());
+    key.insert(key.end(),hars.begin(),hars.end());
+  };
+  auto itr = fMemoKeys.find(key);
+  if(itr!=fMemoKeys.end()) return itr->second;
+  Int_t offset = (Int_t)fMemo.size();
+  MemoEntry empty = {0,0.,0.};
+  fMemo.resize(offset + (plan.FromString?1:2*plan.NpT),empty);
+  fMemoKeys[key] = offset;
+  return offset;
+};
+TComplex AliGFW::Calculate(Int_t planID, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap) {
+  if(planID<0 || planID>=(Int_t)fPlans.size()) return TComplex(0,0);
+  if(fMemoOutdated) {
+    ++fEventStamp;
+    if(!fEventStamp) { //wrapped around, invalidate everything explicitly
+      for(Int_t i=0;i<(Int_t)fMemo.size();i++) fMemo[i].Stamp=0;
+      fEventStamp=1;
+    };
+    fMemoOutdated=kFALSE;
+  };
+  const CorrPlan &plan = fPlans[planID];
+  Int_t memoInd = -1;
+  if(plan.FromString) memoInd = plan.Memo[SetHarmsToZero?1:0];
+  else if(ptbin>=0 && ptbin<plan.NpT) memoInd = plan.Memo[SetHarmsToZero?1:0] + 2*ptbin + (DisableOverlap?1:0);
+  if(memoInd>=0 && fMemo[memoInd].Stamp==fEventStamp) return TComplex(fMemo[memoInd].Re,fMemo[memoInd].Im);
+  TComplex retval = EvaluatePlan(plan,ptbin,SetHarmsToZero,DisableOverlap);
+  if(memoInd>=0) {
+    fMemo[memoInd].Stamp = fEventStamp;
+    fMemo[memoInd].Re = retval.Re();
+    fMemo[memoInd].Im = retval.Im();
+  };
+  return retval;
+};
+TComplex AliGFW::EvaluatePlan(const CorrPlan &plan, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap) {
+  //Follows Calculate(TString) and Calculate(CorrConfig), respectively
+  if(!fInitialized) return TComplex(0,0);
+  if(plan.FromString) {
+    TComplex ret(1,0);
+    for(Int_t i=0;i<(Int_t)plan.Terms.size();i++) {
+      const CorrTerm &term = plan.Terms[i];
+      if(term.Poi<0) { ret*=TComplex(0,0); continue; };
+      AliGFWCumulant *qpoi = &fCumulants.at(term.Poi);
+      ret*=EvaluateProgram(SetHarmsToZero?term.ProgZero:term.Prog, qpoi, &fCumulants.at(term.Ref), qpoi, term.PtBin);
+    };
+    return ret;
+  };
+  if(plan.Terms.size()==0) return TComplex(0,0);
+  const CorrTerm &term = plan.Terms[0];
+  AliGFWCumulant *qpoi = &fCumulants.at(term.Poi);
+  if(!qpoi->IsPtBinFilled(ptbin)) return TComplex(0,0);
+  AliGFWCumulant *qovl = DisableOverlap?0:qpoi;
+  TComplex retval = EvaluateProgram(SetHarmsToZero?term.ProgZero:term.Prog, qpoi, &fCumulants.at(term.Ref), qovl, ptbin);
+  if(plan.Terms.size()<2) return retval;
+  const CorrTerm &term2 = plan.Terms[1];
+  qpoi = &fCumulants.at(term2.Poi);
+  retval*=EvaluateProgram(SetHarmsToZero?term2.ProgZero:term2.Prog, qpoi, &fCumulants.at(term2.Ref), qpoi, term2.PtBin);
+  return retval;
+};
+TComplex AliGFW::EvaluateProgram(const CorrProgram &prog, AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGFWCumulant *qol, Int_t ptbin) {
+  //Arithmetic in the same order as TwoRec and RecursiveCorr, so that the results are identical
+  Int_t nNodes = (Int_t)prog.Nodes.size();
+  if(!nNodes) return TComplex(0,0);
+  if((Int_t)fNodeRe.size()<nNodes) {
+    fNodeRe.resize(nNodes);
+    fNodeIm.resize(nNodes);
+  };
+  Double_t are, aim, bre, bim, cre, cim;
+  for(Int_t i=0;i<nNodes;i++) {
+    const CorrNode &node = prog.Nodes[i];
+    if(node.Type==kSingle) {
+      qpoi->GetVec(node.H1,node.P1,ptbin,fNodeRe[i],fNodeIm[i]);
+      continue;
+    };
+    if(node.Type==kTwo) {
+      qpoi->GetVec(node.H1,node.P1,ptbin,are,aim);
+      qref->GetVec(node.H2,node.P2,ptbin,bre,bim);
+      cre=0; cim=0;
+      if(qol) qol->GetVec(node.H1+node.H2,node.P1+node.P2,ptbin,cre,cim);
+    } else {
+      are=fNodeRe[node.Child];
+      aim=fNodeIm[node.Child];
+      qref->GetVec(node.H2,node.P2,0,bre,bim); //pT bin 0, as in RecursiveCorr
+      cre=0; cim=0;
+    };
+    Double_t re = are*bre-aim*bim;
+    Double_t im = are*bim+aim*bre;
+    if(node.Type==kTwo) {
+      re-=cre;
+      im-=cim;
+    } else {
+      for(Int_t j=node.SubBegin;j<node.SubEnd;j++) {
+        re-=fNodeRe[prog.Subtract[j]];
+        im-=fNodeIm[prog.Subtract[j]];
+      };
+    };
+    fNodeRe[i]=re;
+    fNodeIm[i]=im;
+  };
+  return TComplex(fNodeRe[nNodes-1],fNodeIm[nNodes-1]);
+};
 
 TComplex AliGFW::Calculate(Int_t poi, Int_t ref, vector<Int_t> hars, Int_t ptbin) {
   AliGFWCumulant *qref = &fCumulants.at(ref);
@@ -284,13 +487,6 @@ Int_t AliGFW::FindRegionByName(TString refName) {
   for(Int_t i=0;i<(Int_t)fRegions.size();i++) if(fRegions.at(i).rName.EqualTo(refName)) return i;
   return -1;
 };
-Int_t AliGFW::FindCalculated(TString identifier) {
-  if(fCalculatedNames.size()==0) return -1;
-  for(Int_t i=0;i<(Int_t)fCalculatedNames.size();i++) {
-    if(fCalculatedNames.at(i).EqualTo(identifier)) return i;
-  };
-  return -1;
-};
 Bool_t AliGFW::SetHarmonicsToZero(TString &instr) {
   TString tmp;
   Ssiz_t sz1=0, sz2;
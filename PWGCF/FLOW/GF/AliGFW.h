@@ -2,6 +2,7 @@
 #define AliGFW__H
 #include "AliGFWCumulant.h"
 #include <vector>
+#include <map>
 #include <utility>
 #include <algorithm>
 #include "TString.h"
@@ -40,6 +41,36 @@ class AliGFW {
     vector<Int_t> Hars2 {};
     Bool_t pTDif=kFALSE;
     TString Head="";
+    Int_t ID=-1; //ID of the compiled plan, see CompileCorrConfig()
+  };
+  //One node of a compiled recursion (see RecursiveCorr). Nodes are stored so that inputs always come before the node itself
+  struct CorrNode {
+    Int_t Type; //kSingle: poi(H1,P1); kTwo: poi(H1,P1)*ref(H2,P2)-ovl(H1+H2,P1+P2); kRec: Child*ref(H2,P2) - Sub
+    Int_t H1, P1, H2, P2;
+    Int_t Child;
+    Int_t SubBegin, SubEnd; //range in CorrProgram::Subtract
+  };
+  enum CorrNodeType_t {kSingle=0, kTwo=1, kRec=2};
+  struct CorrProgram {
+    vector<CorrNode> Nodes {};
+    vector<Int_t> Subtract {};
+  };
+  //One product term of a correlator: a recursion over regions poi/ref, for original harmonics and for harmonics set to zero
+  struct CorrTerm {
+    Int_t Poi=-1, Ref=-1;
+    Int_t PtBin=-1; //fixed pT bin; -1 if taken from the call
+    vector<Int_t> Hars {}, HarsZero {};
+    CorrProgram Prog, ProgZero;
+  };
+  //Immutable plan, compiled once from a CorrConfig or a configuration string
+  struct CorrPlan {
+    Int_t ID=-1;
+    TString Head="";
+    Bool_t pTDif=kFALSE;
+    Bool_t FromString=kFALSE;
+    vector<CorrTerm> Terms {};
+    Int_t NpT=1; //number of pT bins memoised
+    Int_t Memo[2] {-1,-1}; //offsets in memoisation table (harmonics, harmonics set to zero)
   };
   AliGFW();
   ~AliGFW();
@@ -55,6 +86,11 @@ class AliGFW {
   TComplex Calculate(TString config, Bool_t SetHarmsToZero=kFALSE);
   CorrConfig GetCorrelatorConfig(TString config, TString head = "", Bool_t ptdif=kFALSE);
   TComplex Calculate(CorrConfig corconf, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap=kFALSE);
+  //Compiled correlators: parse once, then evaluate by plan ID. Results are memoised per event (until Clear())
+  Int_t CompileCorrConfig(const CorrConfig &corconf);
+  TComplex Calculate(Int_t planID, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap=kFALSE);
+  Int_t GetNPlans() { return (Int_t)fPlans.size(); };
+  const CorrPlan &GetPlan(Int_t planID) { return fPlans.at(planID); };
  private:
   Bool_t fInitialized;
   void SplitRegions();
@@ -65,14 +101,26 @@ class AliGFW {
   void AddRegion(Region inreg) { fRegions.push_back(inreg); };
   Region GetRegion(Int_t index) { return fRegions.at(index); };
   Int_t FindRegionByName(TString refName);
-  vector<TString> fCalculatedNames;
-  vector<TComplex> fCalculatedQs;
-  Int_t FindCalculated(TString identifier);
+  //Compiled plans and per-event memoisation:
+  vector<CorrPlan> fPlans; //! compiled plans
+  std::map<TString,Int_t> fStringPlans; //! configuration string -> plan ID
+  std::map<vector<Int_t>,Int_t> fMemoKeys; //! plan content -> offset in memoisation table, so that equal plans share results
+  struct MemoEntry { UInt_t Stamp; Double_t Re, Im; };
+  vector<MemoEntry> fMemo; //! memoised results
+  UInt_t fEventStamp; //! memoised values with another stamp are outdated
+  Bool_t fMemoOutdated; //! Q-vectors changed since last calculation
+  vector<Double_t> fNodeRe, fNodeIm; //! scratch for evaluation of programs
+  Int_t CompileString(TString config);
+  void CompileTerm(CorrTerm &term, Int_t poi, Int_t ref, Int_t ptbin, const vector<Int_t> &hars, const vector<Int_t> &harsZero);
+  Int_t CompileRecursion(CorrProgram &prog, std::map<vector<Int_t>,Int_t> &nodeIDs, vector<Int_t> hars, vector<Int_t> pows);
+  Int_t RegisterMemo(const CorrPlan &plan, Bool_t zero);
+  TComplex EvaluateProgram(const CorrProgram &prog, AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGFWCumulant *qol, Int_t ptbin);
+  TComplex EvaluatePlan(const CorrPlan &plan, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap);
   //Calculateing functions:
   TComplex Calculate(Int_t poi, Int_t ref, vector<Int_t> hars, Int_t ptbin=0); //For differential, need POI and reference
   TComplex Calculate(Int_t poi, vector<Int_t> hars); //For integrated case
   //Process one string (= one region)
-  TComplex CalculateSingle(TString config);
+  Bool_t ParseSingle(TString config, vector<Int_t> &regs, vector<Int_t> &hars, Int_t &ptbin);
 
   Bool_t SetHarmonicsToZero(TString &instr);
 
@@ -1,21 +1,25 @@
 #include "AliGFWCumulant.h"
+#include <algorithm>
 
 AliGFWCumulant::AliGFWCumulant():
-  fQvector(0),
+  fQRe(),
+  fQIm(),
+  fPowOffset(),
+  fNQ(0),
   fUsed(kBlank),
   fNEntries(-1),
   fN(1),
   fPow(1),
   fPt(1),
-  fFilledPts(0),
+  fFilledPts(),
+  fWeightPow(),
   fInitialized(kFALSE)
 {
 };
 
 AliGFWCumulant::~AliGFWCumulant()
 {
-  //printf("Destructor (?) for some reason called?\n");
-  //DestroyComplexVectorArray();
+  //Storage is held in vectors and released automatically
 };
 void AliGFWCumulant::FillArray(Double_t eta, Int_t ptin, Double_t phi, Double_t weight) {
   if(!fInitialized)
@@ -23,42 +27,37 @@ void AliGFWCumulant::FillArray(Double_t eta, Int_t ptin, Double_t phi, Double_t
   if(fPt==1) ptin=0; //If one bin, then just fill it straight; otherwise, if ptin is out-of-range, do not fill
   else if(ptin<0 || ptin>=fPt) return;
   fFilledPts[ptin] = kTRUE;
+  //Powers of weight are the same for all harmonics, so calculate them only once per particle
+  for(Int_t lPow=0; lPow<(Int_t)fWeightPow.size(); lPow++)
+    fWeightPow[lPow] = TMath::Power(weight, lPow);
+  Double_t *qre = &fQRe[ptin*fNQ];
+  Double_t *qim = &fQIm[ptin*fNQ];
   for(Int_t lN = 0; lN<fN; lN++) {
     Double_t lSin = TMath::Sin(lN*phi); //No need to recalculate for each power
     Double_t lCos = TMath::Cos(lN*phi); //No need to recalculate for each power
-    for(Int_t lPow=0; lPow<PW(lN); lPow++) {
-      Double_t lPrefactor = TMath::Power(weight, lPow); //Dont calculate it twice; multiplication is cheaper that power
-      Double_t qsin = lPrefactor * lSin;
-      Double_t qcos = lPrefactor * lCos;
-      fQvector[ptin][lN][lPow](fQvector[ptin][lN][lPow].Re()+qcos,fQvector[ptin][lN][lPow].Im()+qsin);//+=TComplex(qcos,qsin);
+    Int_t lOff = fPowOffset[lN];
+    for(Int_t lPow=0; lPow<fPowVec[lN]; lPow++) {
+      qre[lOff+lPow] += fWeightPow[lPow] * lCos;
+      qim[lOff+lPow] += fWeightPow[lPow] * lSin;
     };
   };
   Inc();
 };
 void AliGFWCumulant::ResetQs() {
   if(!fNEntries) return; //If 0 entries, then no need to reset. Otherwise, if -1, then just initialized and need to set to 0.
-  for(Int_t i=0; i<fPt; i++) {
-    fFilledPts[i] = kFALSE;
-    for(Int_t lN=0;lN<fN;lN++) {
-      for(Int_t lPow=0;lPow<PW(lN);lPow++) {
-  	       fQvector[i][lN][lPow](0.,0.);
-      };
-    };
-  };
+  std::fill(fFilledPts.begin(), fFilledPts.end(), kFALSE);
+  std::fill(fQRe.begin(), fQRe.end(), 0.);
+  std::fill(fQIm.begin(), fQIm.end(), 0.);
   fNEntries=0;
 };
 void AliGFWCumulant::DestroyComplexVectorArray() {
   if(!fInitialized) return;
-  for(Int_t l_n = 0; l_n<fN; l_n++) {
-    for(Int_t i=0;i<fPt;i++) {
-      delete [] fQvector[i][l_n];
-    };
-  };
-  for(Int_t i=0;i<fPt;i++) {
-    delete [] fQvector[i];
-  };
-  delete [] fQvector;
-  delete [] fFilledPts;
+  fQRe.clear();
+  fQIm.clear();
+  fPowOffset.clear();
+  fFilledPts.clear();
+  fWeightPow.clear();
+  fNQ=0;
   fInitialized=kFALSE;
   fNEntries=-1;
 };
@@ -74,23 +73,26 @@ void AliGFWCumulant::CreateComplexVectorArrayVarPower(Int_t N, vector<Int_t> Pow
   fN=N;
   fPow=0;
   fPt=Pt;
-  fFilledPts = new Bool_t[Pt];
   fPowVec = PowVec;
-  fQvector = new TComplex**[fPt];
-  for(Int_t i=0;i<fPt;i++) {
-    fQvector[i] = new TComplex*[fN];
-  };
+  fPowOffset.assign(fN,0);
+  fNQ=0;
+  Int_t maxPow=0;
   for(Int_t l_n=0;l_n<fN;l_n++) {
-    for(Int_t i=0;i<fPt;i++) {
-      fQvector[i][l_n] = new TComplex[PW(l_n)];
-    };
+    fPowOffset[l_n]=fNQ;
+    fNQ+=PW(l_n);
+    if(PW(l_n)>maxPow) maxPow=PW(l_n);
   };
+  fQRe.assign(fPt*fNQ,0.);
+  fQIm.assign(fPt*fNQ,0.);
+  fFilledPts.assign(fPt,kFALSE);
+  fWeightPow.assign(maxPow,0.);
+  fNEntries=-1;
   ResetQs();
   fInitialized=kTRUE;
 };
 TComplex AliGFWCumulant::Vec(Int_t n, Int_t p, Int_t ptbin) {
   if(!fInitialized) return 0;
-  if(ptbin>=fPt || ptbin<0) ptbin=0;
-  if(n>=0) return fQvector[ptbin][n][p];
-  return TComplex::Conjugate(fQvector[ptbin][-n][p]);
+  Double_t re, im;
+  GetVec(n,p,ptbin,re,im);
+  return TComplex(re,im);
 };
@@ -4,6 +4,7 @@
 #include "TNamed.h"
 #include "TMath.h"
 #include "TAxis.h"
+#include <vector>
 using std::vector;
 class AliGFWCumulant {
  public:
@@ -16,22 +17,36 @@ class AliGFWCumulant {
   void Inc() { fNEntries++; };
   Int_t GetN() { return fNEntries; };
   // protected:
-  TComplex ***fQvector;
+  //Q-vectors are stored contiguously as separate real and imaginary parts, index = ptbin*fNQ + fPowOffset[harmonic] + power
+  vector<Double_t> fQRe; //! Real parts of Q-vectors
+  vector<Double_t> fQIm; //! Imaginary parts of Q-vectors
+  vector<Int_t> fPowOffset; //! Offset of each harmonic within one pt bin
+  Int_t fNQ; //! Number of (harmonic, power) combinations per pt bin
   UInt_t fUsed;
   Int_t fNEntries;
   //Q-vectors. Could be done recursively, but maybe defining each one of them explicitly is easier to read
   TComplex Vec(Int_t, Int_t, Int_t ptbin=0); //envelope class to summarize pt-dif. Q-vec getter
+  //Same as Vec(), but without constructing TComplex
+  void GetVec(Int_t n, Int_t p, Int_t ptbin, Double_t &re, Double_t &im) const {
+    if(!fInitialized) { re=0; im=0; return; };
+    if(ptbin>=fPt || ptbin<0) ptbin=0;
+    if(n>=0) { Int_t ind = ptbin*fNQ+fPowOffset[n]+p; re = fQRe[ind]; im = fQIm[ind]; return; };
+    Int_t ind = ptbin*fNQ+fPowOffset[-n]+p;
+    re = fQRe[ind];
+    im = -fQIm[ind];
+  };
   Int_t fN; //! Harmonics
   Int_t fPow; //! Power
   vector<Int_t> fPowVec; //! Powers array
   Int_t fPt; //!fPt bins
-  Bool_t *fFilledPts;
+  vector<Bool_t> fFilledPts; //! pt bins with at least one entry
+  vector<Double_t> fWeightPow; //! weight^power, recalculated for each particle
   Bool_t fInitialized; //Arrays are initialized
   void CreateComplexVectorArray(Int_t N=1, Int_t P=1, Int_t Pt=1);
   void CreateComplexVectorArrayVarPower(Int_t N=1, vector<Int_t> Pvec={1}, Int_t Pt=1);
   Int_t PW(Int_t ind) { return fPowVec.at(ind); }; //No checks to speed up, be carefull!!!
   void DestroyComplexVectorArray();
-  Bool_t IsPtBinFilled(Int_t ptb) { if(!fFilledPts) return kFALSE; return fFilledPts[ptb]; };
+  Bool_t IsPtBinFilled(Int_t ptb) { if(!fInitialized) return kFALSE; if(ptb>=fPt || ptb<0) ptb=0; return fFilledPts[ptb]; }; //out-of-range bins as in Vec()
 };
 
 #endif
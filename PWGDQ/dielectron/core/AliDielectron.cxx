@@ -134,6 +134,7 @@ AliDielectron::AliDielectron() :
   fHistoArray(0x0),
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fVarContext(new AliDielectronVarManager::Context),
   fPairCandidates(new TObjArray(11)),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
@@ -221,6 +222,7 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fHistoArray(0x0),
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fVarContext(new AliDielectronVarManager::Context),
   fPairCandidates(new TObjArray(11)),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
@@ -287,6 +289,7 @@ AliDielectron::~AliDielectron()
   if (fPairEffMap) delete fPairEffMap;
   if (fHistos) delete fHistos;
   if (fUsedVars) delete fUsedVars;
+  if (fVarContext) delete fVarContext;
   if (fPairCandidates && fEventProcess) delete fPairCandidates;
   if (fDebugTree) delete fDebugTree;
   if (fMixing) delete fMixing;
@@ -373,6 +376,9 @@ void AliDielectron::Init()
       fEvtVsTrkHist->SetHistogramList(fHistos);
     }
   }
+
+  // add the variables needed to compute the requested ones
+  AliDielectronVarManager::ResolveDependencies(fUsedVars, fLegEffMap, fPairEffMap);
 }
 
 //________________________________________________________________
@@ -454,19 +460,24 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
 
 	AliDielectronPID::SetPIDCalibinPU(fPIDCalibinPU);
 
-  // set event
-  AliDielectronVarManager::SetFillMap(fUsedVars);
-  AliDielectronVarManager::SetEvent(ev1);
+  // set event, the pid response is the one registered by the task
+  fVarContext->SetFillMap(fUsedVars);
+  fVarContext->SetPIDResponse(AliDielectronVarManager::GetPIDResponse());
+  fVarContext->SetEvent(ev1);
 
   if (fMixing){
     //set mixing bin to event data
-    Int_t bin=fMixing->FindBin(AliDielectronVarManager::GetData());
-    AliDielectronVarManager::SetValue(AliDielectronVarManager::kMixingBin,bin);
+    Int_t bin=fMixing->FindBin(fVarContext->GetData());
+    fVarContext->SetValue(AliDielectronVarManager::kMixingBin,bin);
   }
 
   // set efficiency maps
-  AliDielectronVarManager::SetLegEffMap(fLegEffMap);
-  AliDielectronVarManager::SetPairEffMap(fPairEffMap);
+  fVarContext->SetLegEffMap(fLegEffMap);
+  fVarContext->SetPairEffMap(fPairEffMap);
+
+  // cuts, CF/HF managers and the debug tree do not take a context yet and
+  // fill through the default one, hand them the state of this instance
+  AliDielectronVarManager::SetDefaultContext(*fVarContext);
 
   //in case we have MC load the MC event and process the MC particles
   // why do not apply the event cuts first ????
@@ -492,7 +503,7 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
       (ev2&&fEventFilter.IsSelected(ev2)!=selectedMask)) return 0;
 
   if(fEvtVsTrkHist){
-    fEvtVsTrkHist->SetPIDResponse(AliDielectronVarManager::GetPIDResponse());
+    fEvtVsTrkHist->SetPIDResponse(fVarContext->GetPIDResponse());
     fEvtVsTrkHist->FillHistograms(ev1);
   }
 
@@ -566,15 +577,15 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
   // fill candidate variables
   Double_t ntracks = fTracks[0].GetEntriesFast() + fTracks[1].GetEntriesFast();
   Double_t npairs  = PairArray(AliDielectron::kEv1PM)->GetEntriesFast();
-  AliDielectronVarManager::SetValue(AliDielectronVarManager::kTracks, ntracks);
-  AliDielectronVarManager::SetValue(AliDielectronVarManager::kPairs,  npairs);
+  fVarContext->SetValue(AliDielectronVarManager::kTracks, ntracks);
+  fVarContext->SetValue(AliDielectronVarManager::kPairs,  npairs);
 
   //in case there is a histogram manager, fill the QA histograms
   if (fHistos && fSignalsMC) FillMCHistograms(ev1);
   if (fHistos) FillHistograms(ev1);
   // fill histo array with event information only
   if (fHistoArray && fHistoArray->IsEventArray())
-    fHistoArray->Fill(0,const_cast<Double_t *>(AliDielectronVarManager::GetData()),0x0,0x0);
+    fHistoArray->Fill(0,const_cast<Double_t *>(fVarContext->GetData()),0x0,0x0);
 
   // clear arrays
   if (!fDontClearArrays) ClearArrays();
@@ -734,7 +745,7 @@ void AliDielectron::FillHistogramsTracks(TObjArray **tracks)
 
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues];
-  AliDielectronVarManager::SetFillMap(fUsedVars);
+  fVarContext->SetFillMap(fUsedVars);
 
   //Fill track information, separately for the track array candidates
   for (Int_t i=0; i<2; ++i){
@@ -742,7 +753,7 @@ void AliDielectron::FillHistogramsTracks(TObjArray **tracks)
     if (!fHistos->GetHistogramList()->FindObject(className.Data())) continue;
     Int_t ntracks=tracks[i]->GetEntriesFast();
     for (Int_t itrack=0; itrack<ntracks; ++itrack){
-      AliDielectronVarManager::Fill(tracks[i]->UncheckedAt(itrack), values);
+      AliDielectronVarManager::Fill(tracks[i]->UncheckedAt(itrack), values, *fVarContext);
       fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
     }
   }
@@ -757,11 +768,11 @@ void AliDielectron::FillHistogramsMC(const AliMCEvent *ev, AliVEvent *ev1)
   //
 
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
-  AliDielectronVarManager::SetFillMap(fUsedVars);
+  fVarContext->SetFillMap(fUsedVars);
 
   // Fill event information
-  AliDielectronVarManager::Fill(ev1, values);    // ESD/AOD information
-  AliDielectronVarManager::Fill(ev, values);     // MC truth info
+  AliDielectronVarManager::Fill(ev1, values, *fVarContext);    // ESD/AOD information
+  AliDielectronVarManager::Fill(ev, values, *fVarContext);     // MC truth info
   if (fHistos->GetHistogramList()->FindObject("MCEvent"))
     fHistos->FillClass("MCEvent", AliDielectronVarManager::kNMaxValues, values);
 }
@@ -776,12 +787,12 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
 
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
-  AliDielectronVarManager::SetFillMap(fUsedVars);
+  fVarContext->SetFillMap(fUsedVars);
 
   //Fill event information
   if (ev){
     if (fHistos->GetHistogramList()->FindObject("Event")) {
-      fHistos->FillClass("Event", AliDielectronVarManager::kNMaxValues, AliDielectronVarManager::GetData());
+      fHistos->FillClass("Event", AliDielectronVarManager::kNMaxValues, fVarContext->GetData());
     }
   }
 
@@ -795,7 +806,7 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
       if (!trkClass && !mergedtrkClass) continue;
       Int_t ntracks=fTracks[i].GetEntriesFast();
       for (Int_t itrack=0; itrack<ntracks; ++itrack){
-        AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values);
+        AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values, *fVarContext);
         if(trkClass)
           fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
         if(mergedtrkClass && i<2)
@@ -818,7 +829,7 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
 
       //fill pair information
       if (pairClass){
-        AliDielectronVarManager::Fill(pair, values);
+        AliDielectronVarManager::Fill(pair, values, *fVarContext);
         fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
       }
 
@@ -827,12 +838,12 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
         AliVParticle *d1=pair->GetFirstDaughterP();
         AliVParticle *d2=pair->GetSecondDaughterP();
         if (!arrLegs.FindObject(d1)){
-          AliDielectronVarManager::Fill(d1, values);
+          AliDielectronVarManager::Fill(d1, values, *fVarContext);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d1);
         }
         if (!arrLegs.FindObject(d2)){
-          AliDielectronVarManager::Fill(d2, values);
+          AliDielectronVarManager::Fill(d2, values, *fVarContext);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d2);
         }
@@ -854,7 +865,7 @@ void AliDielectron::FillHistogramsPair(AliDielectronPair *pair,Bool_t fromPreFil
   //
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues];
-  AliDielectronVarManager::SetFillMap(fUsedVars);
+  fVarContext->SetFillMap(fUsedVars);
 
   //Fill Pair information, separately for all pair candidate arrays and the legs
   TObjArray arrLegs(100);
@@ -872,17 +883,17 @@ void AliDielectron::FillHistogramsPair(AliDielectronPair *pair,Bool_t fromPreFil
 
   //fill pair information
   if (pairClass){
-    AliDielectronVarManager::Fill(pair, values);
+    AliDielectronVarManager::Fill(pair, values, *fVarContext);
     fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
   }
 
   if (legClass){
     AliVParticle *d1=pair->GetFirstDaughterP();
-    AliDielectronVarManager::Fill(d1, values);
+    AliDielectronVarManager::Fill(d1, values, *fVarContext);
     fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
 
     AliVParticle *d2=pair->GetSecondDaughterP();
-    AliDielectronVarManager::Fill(d2, values);
+    AliDielectronVarManager::Fill(d2, values, *fVarContext);
     fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
   }
 }
@@ -1617,24 +1628,24 @@ void AliDielectron::FillMCHistograms(Int_t label1, Int_t label2, Int_t nSignal)
 
   // fill event values
   Double_t values[AliDielectronVarManager::kNMaxValues];
-  AliDielectronVarManager::SetFillMap(fUsedVars);
-  AliDielectronVarManager::Fill(dieMC->GetMCEvent(), values); // get event informations
+  fVarContext->SetFillMap(fUsedVars);
+  AliDielectronVarManager::Fill(dieMC->GetMCEvent(), values, *fVarContext); // get event informations
   // @TODO: check if this Fill() is even needed. It might modify the fill map (fUsedVars).
 
   // fill the leg variables
   //  printf("leg:%d trk:%d part1:%p part2:%p \n",legClass,trkClass,part1,part2);
   if (legClass || trkClass) {
-    if(part1) AliDielectronVarManager::Fill(part1,values);
+    if(part1) AliDielectronVarManager::Fill(part1,values, *fVarContext);
     if(part1 && trkClass)          fHistos->FillClass(className3, AliDielectronVarManager::kNMaxValues, values);
     if(part1 && part2 && legClass) fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
-    if(part2) AliDielectronVarManager::Fill(part2,values);
+    if(part2) AliDielectronVarManager::Fill(part2,values, *fVarContext);
     if(part2 && trkClass)          fHistos->FillClass(className3, AliDielectronVarManager::kNMaxValues, values);
     if(part1 && part2 && legClass) fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
   }
 
   //fill pair information
   if (pairClass && part1 && part2) {
-    AliDielectronVarManager::FillVarMCParticle2(part1,part2,values);
+    AliDielectronVarManager::FillVarMCParticle2(part1,part2,values, *fVarContext);
     fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
   }
 
@@ -1648,7 +1659,7 @@ void AliDielectron::FillMCHistograms(const AliVEvent *ev) {
   if (!fSignalsMC) return;
   TString className,className2,className3;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
-  AliDielectronVarManager::SetFillMap(fUsedVars);
+  fVarContext->SetFillMap(fUsedVars);
   // AliDielectronVarManager::Fill(ev, values);
   // not needed to get event information here, because done in FillVarVParticle() [and FillVarDielectronPair()].
 
@@ -1674,14 +1685,14 @@ void AliDielectron::FillMCHistograms(const AliVEvent *ev) {
           if(isMCtruth) {
             //fill pair information
             if (pairClass){
-              AliDielectronVarManager::Fill(pair, values);
+              AliDielectronVarManager::Fill(pair, values, *fVarContext);
               fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
             }
             //fill leg information, both + and - in the same histo
             if (legClass){
-              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(),values, *fVarContext);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
-              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(),values, *fVarContext);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
             }
           } //is signal
@@ -1695,14 +1706,14 @@ void AliDielectron::FillMCHistograms(const AliVEvent *ev) {
           if(isMCtruth){
             //fill pair information
             if (pairClass){
-              AliDielectronVarManager::Fill(pair, values);
+              AliDielectronVarManager::Fill(pair, values, *fVarContext);
               fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
             }
             //fill leg information, both + and - in the same histo
             if (legClass){
-              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(),values, *fVarContext);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
-              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(),values, *fVarContext);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
             }
           } //is signal
@@ -1716,14 +1727,14 @@ void AliDielectron::FillMCHistograms(const AliVEvent *ev) {
           if(isMCtruth){
             //fill pair information
             if (pairClass){
-              AliDielectronVarManager::Fill(pair, values);
+              AliDielectronVarManager::Fill(pair, values, *fVarContext);
               fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
             }
             //fill leg information, both + and - in the same histo
             if (legClass){
-              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetFirstDaughterP(),values, *fVarContext);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
-              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(),values);
+              AliDielectronVarManager::Fill(pair->GetSecondDaughterP(),values, *fVarContext);
               fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
             }
           } //is signal
@@ -1742,7 +1753,7 @@ void AliDielectron::FillMCHistograms(const AliVEvent *ev) {
         Bool_t isMCtruth2 = AliDielectronMC::Instance()->IsMCTruth(label, (AliDielectronSignalMC*)fSignalsMC->At(isig), 2);
         // skip if track does not correspond to the signal
         if(!isMCtruth1 && !isMCtruth2) continue;
-        AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values);
+        AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values, *fVarContext);
         fHistos->FillClass(className3, AliDielectronVarManager::kNMaxValues, values);
       } //loop: tracks
     } //loop: arrays
@@ -2197,6 +2208,26 @@ void AliDielectron::SetWidthCorrFunctionPU(UInt_t detID, UInt_t parID, THnBase *
   }
 }
 //______________________________________________
+void AliDielectron::InitLegEffMap(TString filename, TString generatedname, TString foundname)
+{
+  //
+  // Set the single electron efficiency map, the variables it needs are
+  // added to the fill map also if Init() was already called
+  //
+  fLegEffMap=InitEffMap(filename,generatedname,foundname);
+  AliDielectronVarManager::ResolveDependencies(fUsedVars, fLegEffMap, fPairEffMap);
+}
+//______________________________________________
+void AliDielectron::InitPairEffMap(TString filename, TString generatedname, TString foundname)
+{
+  //
+  // Set the pair efficiency map, the variables it needs are
+  // added to the fill map also if Init() was already called
+  //
+  fPairEffMap=InitEffMap(filename,generatedname,foundname);
+  AliDielectronVarManager::ResolveDependencies(fUsedVars, fLegEffMap, fPairEffMap);
+}
+//______________________________________________
 TObject* AliDielectron::InitEffMap(TString filename, TString generatedname, TString foundname)
 {
   // init an efficiency object for on-the-fly correction calculations
@@ -2230,14 +2261,14 @@ void AliDielectron::FillHistogramsFromPairArray(Bool_t pairInfoOnly/*=kFALSE*/)
 
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
-  AliDielectronVarManager::SetFillMap(fUsedVars);
-  AliDielectronVarManager::SetLegEffMap(fLegEffMap);
-  AliDielectronVarManager::SetPairEffMap(fPairEffMap);
+  fVarContext->SetFillMap(fUsedVars);
+  fVarContext->SetLegEffMap(fLegEffMap);
+  fVarContext->SetPairEffMap(fPairEffMap);
 
   //Fill event information
   if(!pairInfoOnly) {
     if(fHistos->GetHistogramList()->FindObject("Event")) {
-      fHistos->FillClass("Event", AliDielectronVarManager::kNMaxValues, AliDielectronVarManager::GetData());
+      fHistos->FillClass("Event", AliDielectronVarManager::kNMaxValues, fVarContext->GetData());
     }
   }
 
@@ -2277,11 +2308,11 @@ void AliDielectron::FillHistogramsFromPairArray(Bool_t pairInfoOnly/*=kFALSE*/)
       if (fHistoArray) fHistoArray->Fill(i,pair);
 
       // fill map
-      AliDielectronVarManager::SetFillMap(fUsedVars);
+      fVarContext->SetFillMap(fUsedVars);
 
       //fill pair information
       if (pairClass){
-        AliDielectronVarManager::Fill(pair, values);
+        AliDielectronVarManager::Fill(pair, values, *fVarContext);
         fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
       }
 
@@ -2290,12 +2321,12 @@ void AliDielectron::FillHistogramsFromPairArray(Bool_t pairInfoOnly/*=kFALSE*/)
         AliVParticle *d1=pair->GetFirstDaughterP();
         AliVParticle *d2=pair->GetSecondDaughterP();
         if (!arrLegs.FindObject(d1)){
-          AliDielectronVarManager::Fill(d1, values);
+          AliDielectronVarManager::Fill(d1, values, *fVarContext);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d1);
         }
         if (!arrLegs.FindObject(d2)){
-          AliDielectronVarManager::Fill(d2, values);
+          AliDielectronVarManager::Fill(d2, values, *fVarContext);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d2);
         }
@@ -28,6 +28,7 @@
 #include "AliDielectronHF.h"
 #include "AliDielectronCutQA.h"
 #include "AliDielectronEvtVsTrkHist.h"
+#include "AliDielectronVarManager.h"
 
 class AliEventplane;
 class AliVEvent;
@@ -162,8 +163,8 @@ public:
   void SetVZEROCalibrationFilename(const Char_t* filename) {fVZEROCalibrationFilename = filename;}
   void SetVZERORecenteringFilename(const Char_t* filename) {fVZERORecenteringFilename = filename;}
   void SetZDCRecenteringFilename(const Char_t* filename) {fZDCRecenteringFilename = filename;}
-  void InitLegEffMap(TString filename, TString generatedname="hGenerated", TString foundname="hFound")  { fLegEffMap=InitEffMap(filename,generatedname,foundname)  ;}
-  void InitPairEffMap(TString filename, TString generatedname="hGenerated", TString foundname="hFound") { fPairEffMap=InitEffMap(filename,generatedname,foundname) ;}
+  void InitLegEffMap(TString filename, TString generatedname="hGenerated", TString foundname="hFound");
+  void InitPairEffMap(TString filename, TString generatedname="hGenerated", TString foundname="hFound");
 
   void SetCentroidCorrArr(TObjArray *arrFun, Bool_t bHisto, UInt_t varx, UInt_t vary=0, UInt_t varz=0);
   void SetWidthCorrArr(TObjArray *arrFun, Bool_t bHisto, UInt_t varx, UInt_t vary=0, UInt_t varz=0);
@@ -244,6 +245,7 @@ private:
                                   //  Streaming and merging should be handled
                                   //  by the analysis framework
   TBits *fUsedVars;               // used variables
+  AliDielectronVarManager::Context *fVarContext; //! filling state of this instance
 
   TObjArray fTracks[4];           //! Selected track candidates
                                   //  0: Event1, positive particles
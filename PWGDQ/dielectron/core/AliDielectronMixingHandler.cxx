@@ -160,11 +160,14 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
   //check if there are tracks available
   if (diele->GetTrackArray(0)->GetEntriesFast()==0 && diele->GetTrackArray(1)->GetEntriesFast()==0) return;
 
+  // event data of this dielectron instance
+  AliDielectronVarManager::Context *ctx=diele->fVarContext;
+
   TString dim;
-  Int_t bin=FindBin(AliDielectronVarManager::GetData(),&dim);
+  Int_t bin=FindBin(ctx->GetData(),&dim);
 
   //add mixing bin to event data
-  AliDielectronVarManager::SetValue(AliDielectronVarManager::kMixingBin,bin);
+  ctx->SetValue(AliDielectronVarManager::kMixingBin,bin);
 
   if (bin<0){
     AliDebug(5,Form("Bin outside range: %s",dim.Data()));
@@ -228,7 +231,7 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
   }
   
   event->SetTracks(*diele->GetTrackArray(0), *diele->GetTrackArray(1), *diele->GetPairArray(1));
-  event->SetEventData(AliDielectronVarManager::GetData());
+  event->SetEventData(ctx->GetData());
 
   //set current event position in ring buffer
   pool.SetUniqueID(index1);
@@ -256,10 +259,11 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
   TObjArray arrTrDummy[4];
   for (Int_t i=0; i<4; ++i) arrTrDummy[i]=diele->fTracks[i];
 
-  //buffer also global event data
+  //buffer also the event data
+  AliDielectronVarManager::Context *ctx=diele->fVarContext;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0};
   for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=AliDielectronVarManager::GetValue((AliDielectronVarManager::ValueTypes)i);
+    values[i]=ctx->GetValue((AliDielectronVarManager::ValueTypes)i);
 
 
   // The event data should alread be filled, since
@@ -371,8 +375,8 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
     diele->fTracks[i]=arrTrDummy[i];
   }
 
-  //set back global event values
-  AliDielectronVarManager::SetEventData(values);
+  //set back event values
+  ctx->SetEventData(values);
 }
 
 //______________________________________________
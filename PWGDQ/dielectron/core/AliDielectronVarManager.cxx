@@ -719,15 +719,8 @@ const char* AliDielectronVarManager::fgkParticleNames[AliDielectronVarManager::k
   {"LegSource",              "Leg source",                                         ""}
 };
 
-AliPIDResponse* AliDielectronVarManager::fgPIDResponse      = 0x0;
-AliVEvent*      AliDielectronVarManager::fgEvent            = 0x0;
-AliEventplane*  AliDielectronVarManager::fgTPCEventPlane    = 0x0;
-AliKFVertex*    AliDielectronVarManager::fgKFVertex         = 0x0;
 TProfile*       AliDielectronVarManager::fgMultEstimatorAvg[7][9] = {{0x0}};
 TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
-TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
-TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
-TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
@@ -739,7 +732,40 @@ AliDielectronQnEPcorrection* AliDielectronVarManager::fgQnEPacRemoval = 0x0;
 Bool_t          AliDielectronVarManager::fgEventPlaneACremoval = kFALSE;
 TString         AliDielectronVarManager::fgQnVectorNorm = "";
 Int_t           AliDielectronVarManager::fgCurrentRun = -1;
-Double_t        AliDielectronVarManager::fgData[AliDielectronVarManager::kNMaxValues] = {0.};
+AliDielectronVarManager::Context AliDielectronVarManager::fgContext;
+
+// variables which are needed to compute another variable: {variable, needed variable}
+static const Int_t gkDielectronVarDependencies[][2] = {
+  {AliDielectronVarManager::kOneOverLegEff,           AliDielectronVarManager::kLegEff},
+  {AliDielectronVarManager::kOneOverPairEff,          AliDielectronVarManager::kPairEff},
+  {AliDielectronVarManager::kOneOverPairEffSq,        AliDielectronVarManager::kPairEff},
+  {AliDielectronVarManager::kPairEff,                 AliDielectronVarManager::kLegEff},
+  {AliDielectronVarManager::kNFclsTPCfCross,          AliDielectronVarManager::kNFclsTPC},
+  {AliDielectronVarManager::kNFclsTPCfCross,          AliDielectronVarManager::kNFclsTPCr},
+  {AliDielectronVarManager::kTPCGeomLength,           AliDielectronVarManager::kTPCActiveLength},
+  {AliDielectronVarManager::kInTRDacceptance,         AliDielectronVarManager::kTRDeta},
+  {AliDielectronVarManager::kTRDpidEffLeg,            AliDielectronVarManager::kTRDphi},
+  {AliDielectronVarManager::kTRDpidEffLeg,            AliDielectronVarManager::kPOut},
+  {AliDielectronVarManager::kOpeningAngleCorr,        AliDielectronVarManager::kOpeningAngle},
+  {AliDielectronVarManager::kOpeningAngleCorr,        AliDielectronVarManager::kPairDCAabsXY},
+  {AliDielectronVarManager::kMCorr,                   AliDielectronVarManager::kPairDCAabsXY},
+  {AliDielectronVarManager::kDistPrimToSecVtxXYMC,    AliDielectronVarManager::kXvPrimMCtruth},
+  {AliDielectronVarManager::kDistPrimToSecVtxXYMC,    AliDielectronVarManager::kYvPrimMCtruth},
+  {AliDielectronVarManager::kDistPrimToSecVtxZMC,     AliDielectronVarManager::kZvPrimMCtruth},
+  {AliDielectronVarManager::kQnDeltaPhiTrackTPCrpH2,  AliDielectronVarManager::kQnTPCrpH2},
+  {AliDielectronVarManager::kQnDeltaPhiTrackV0CrpH2,  AliDielectronVarManager::kQnV0CrpH2},
+  {AliDielectronVarManager::kQnDeltaPhiTPCrpH2,       AliDielectronVarManager::kQnTPCrpH2},
+  {AliDielectronVarManager::kQnDeltaPhiV0ArpH2,       AliDielectronVarManager::kQnV0ArpH2},
+  {AliDielectronVarManager::kQnDeltaPhiV0CrpH2,       AliDielectronVarManager::kQnV0CrpH2},
+  {AliDielectronVarManager::kQnDeltaPhiV0rpH2,        AliDielectronVarManager::kQnV0rpH2},
+  {AliDielectronVarManager::kQnDeltaPhiSPDrpH2,       AliDielectronVarManager::kQnSPDrpH2},
+  {AliDielectronVarManager::kQnTPCrpH2FlowV2,         AliDielectronVarManager::kQnDeltaPhiTPCrpH2},
+  {AliDielectronVarManager::kQnV0ArpH2FlowV2,         AliDielectronVarManager::kQnDeltaPhiV0ArpH2},
+  {AliDielectronVarManager::kQnV0CrpH2FlowV2,         AliDielectronVarManager::kQnDeltaPhiV0CrpH2},
+  {AliDielectronVarManager::kQnV0rpH2FlowV2,          AliDielectronVarManager::kQnDeltaPhiV0rpH2},
+  {AliDielectronVarManager::kQnSPDrpH2FlowV2,         AliDielectronVarManager::kQnDeltaPhiSPDrpH2}
+};
+
 //________________________________________________________________
 AliDielectronVarManager::AliDielectronVarManager() :
   TNamed("AliDielectronVarManager","AliDielectronVarManager")
@@ -810,6 +836,119 @@ AliDielectronVarManager::~AliDielectronVarManager()
 
 }
 
+//________________________________________________________________
+AliDielectronVarManager::Context::Context() :
+  fFillMap(0x0),
+  fPIDResponse(0x0),
+  fEvent(0x0),
+  fTPCEventPlane(0x0),
+  fKFVertex(0x0),
+  fLegEffMap(0x0),
+  fPairEffMap(0x0)
+{
+  //
+  // Default constructor
+  //
+  for (Int_t i=0; i<kNMaxValues; ++i) fData[i]=0.;
+}
+
+//________________________________________________________________
+AliDielectronVarManager::Context::Context(const Context &c) :
+  fFillMap(0x0),
+  fPIDResponse(0x0),
+  fEvent(0x0),
+  fTPCEventPlane(0x0),
+  fKFVertex(0x0),
+  fLegEffMap(0x0),
+  fPairEffMap(0x0)
+{
+  //
+  // Copy constructor
+  //
+  *this=c;
+}
+
+//________________________________________________________________
+AliDielectronVarManager::Context &AliDielectronVarManager::Context::operator=(const Context &c)
+{
+  //
+  // Assignment, the kf vertex is copied
+  //
+  if (this==&c) return *this;
+  fFillMap=c.fFillMap;
+  fPIDResponse=c.fPIDResponse;
+  fEvent=c.fEvent;
+  fTPCEventPlane=c.fTPCEventPlane;
+  fLegEffMap=c.fLegEffMap;
+  fPairEffMap=c.fPairEffMap;
+  delete fKFVertex;
+  fKFVertex=(c.fKFVertex ? new AliKFVertex(*c.fKFVertex) : 0x0);
+  for (Int_t i=0; i<kNMaxValues; ++i) fData[i]=c.fData[i];
+  return *this;
+}
+
+//________________________________________________________________
+AliDielectronVarManager::Context::~Context()
+{
+  //
+  // Default destructor
+  //
+  delete fKFVertex;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::ResolveDependencies(TBits *map, const TObject *legEffMap, const TObject *pairEffMap)
+{
+  //
+  // Add to map the variables needed to compute the requested ones,
+  // such that only the requested variables need to be filled
+  //
+  if (!map) return;
+  const Int_t nDep=sizeof(gkDielectronVarDependencies)/sizeof(gkDielectronVarDependencies[0]);
+  Bool_t changed=kTRUE;
+  while (changed) {
+    changed=kFALSE;
+    for (Int_t i=0; i<nDep; ++i) {
+      if (!map->TestBitNumber(gkDielectronVarDependencies[i][0])) continue;
+      if (map->TestBitNumber(gkDielectronVarDependencies[i][1])) continue;
+      map->SetBitNumber(gkDielectronVarDependencies[i][1], kTRUE);
+      changed=kTRUE;
+    }
+    // the axes of the efficiency maps are looked up by name
+    if (map->TestBitNumber(kLegEff)  && AddEffMapAxes(map, legEffMap))  changed=kTRUE;
+    if (map->TestBitNumber(kPairEff) && AddEffMapAxes(map, pairEffMap)) changed=kTRUE;
+  }
+}
+
+//________________________________________________________________
+Bool_t AliDielectronVarManager::AddEffMapAxes(TBits *map, const TObject *effMap)
+{
+  //
+  // Add the variables of the axes of an efficiency map, return if map changed
+  //
+  if (!effMap) return kFALSE;
+  Bool_t changed=kFALSE;
+  if (effMap->InheritsFrom(THnBase::Class())) {
+    const THnBase *eff=static_cast<const THnBase*>(effMap);
+    for (Int_t idim=0; idim<eff->GetNdimensions(); ++idim) {
+      UInt_t var=GetValueType(eff->GetAxis(idim)->GetName());
+      if (var>=kNMaxValues || map->TestBitNumber(var)) continue;
+      map->SetBitNumber(var, kTRUE);
+      changed=kTRUE;
+    }
+  }
+  else if (effMap->IsA()==TSpline3::Class()) {
+    TSpline3 *eff=(TSpline3*)effMap;
+    if (!eff->GetHistogram()) return kFALSE;
+    UInt_t var=GetValueType(eff->GetHistogram()->GetXaxis()->GetName());
+    if (var<kNMaxValues && !map->TestBitNumber(var)) {
+      map->SetBitNumber(var, kTRUE);
+      changed=kTRUE;
+    }
+  }
+  return changed;
+}
+
 //________________________________________________________________
 UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   //
@@ -761,31 +761,83 @@ public:
   };
 
 
+  // Filling state of one owner: the map of requested variables, the
+  // efficiency maps, the current event and its event-wise values.
+  // Each AliDielectron keeps its own context and hands it to the Fill
+  // kernels, so instances with different variables or efficiency maps do
+  // not overwrite each other. The static interface without a context
+  // works on a process-wide default context (fgContext).
+  class Context {
+  public:
+    Context();
+    Context(const Context &c);
+    Context &operator=(const Context &c);
+    ~Context();
+
+    void SetFillMap(   TBits   *map) { fFillMap=map; }
+    void SetLegEffMap( TObject *map) { fLegEffMap=map; }
+    void SetPairEffMap(TObject *map) { fPairEffMap=map; }
+    void SetPIDResponse(AliPIDResponse *pidResponse) { fPIDResponse=pidResponse; }
+    void SetEvent(AliVEvent * const ev);
+    void SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues]);
+    void SetTPCEventPlane(AliEventplane *const evplane);
+    void SetValue(ValueTypes var, Double_t val) { fData[var]=val; }
+
+    TBits*             GetFillMap()      const { return fFillMap; }
+    AliPIDResponse*    GetPIDResponse()  const { return fPIDResponse; }
+    AliVEvent*         GetCurrentEvent() const { return fEvent; }
+    const AliKFVertex* GetKFVertex()     const { return fKFVertex; }
+    const Double_t*    GetData()         const { return fData; }
+    Double_t GetValue(ValueTypes var)    const { return fData[var]; }
+
+  private:
+    friend class AliDielectronVarManager;
+
+    Bool_t Req(ValueTypes var) const { if(!fFillMap) return kTRUE;
+      if(fFillMap->GetNbits()>kNMaxValues) return kFALSE; // needed for unknown crashes (TBits with high number of bits after calling GetPrimaryVertex in FillVarESDEvent)
+      return fFillMap->TestBitNumber(var); }
+
+    TBits          *fFillMap;             // map for requested variable filling
+    AliPIDResponse *fPIDResponse;         // PID response object
+    AliVEvent      *fEvent;               // current event pointer
+    AliEventplane  *fTPCEventPlane;       // current event tpc plane pointer
+    AliKFVertex    *fKFVertex;            // kf vertex (owned)
+    TObject        *fLegEffMap;           // single electron efficiencies
+    TObject        *fPairEffMap;          // pair efficiencies
+    Double_t        fData[AliDielectronVarManager::kNMaxValues]; // event data
+  };
+
   AliDielectronVarManager();
   AliDielectronVarManager(const char* name, const char* title);
   virtual ~AliDielectronVarManager();
-  static void Fill(const TObject* particle, Double_t * const values);
-  static void FillVarMCParticle2(const AliVParticle *p1, const AliVParticle *p2, Double_t * const values);
-  static void FillVarVParticle(const AliVParticle *particle,         Double_t * const values);
+  static void Fill(const TObject* particle, Double_t * const values, const Context &ctx);
+  static void FillVarMCParticle2(const AliVParticle *p1, const AliVParticle *p2, Double_t * const values, const Context &ctx);
+  static void FillVarVParticle(const AliVParticle *particle,         Double_t * const values, const Context &ctx);
+  static void Fill(const TObject* particle, Double_t * const values) { Fill(particle, values, fgContext); }
+  static void FillVarMCParticle2(const AliVParticle *p1, const AliVParticle *p2, Double_t * const values) { FillVarMCParticle2(p1, p2, values, fgContext); }
+  static void FillVarVParticle(const AliVParticle *particle,         Double_t * const values) { FillVarVParticle(particle, values, fgContext); }
 
   static void InitESDpid(Int_t type=0);
   static void InitAODpidUtil(Int_t type=0);
   static void InitEstimatorAvg(const Char_t* filename);
   static void InitEstimatorObjArrayAvg(const TObjArray* array);
   static void InitTRDpidEffHistograms(const Char_t* filename);
-  static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
-  static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
-  static void SetFillMap(   TBits   *map) { fgFillMap=map; }
+  static void SetLegEffMap( TObject *map) { fgContext.SetLegEffMap(map); }
+  static void SetPairEffMap(TObject *map) { fgContext.SetPairEffMap(map); }
+  static void SetFillMap(   TBits   *map) { fgContext.SetFillMap(map); }
+  static void ResolveDependencies(TBits *map, const TObject *legEffMap=0x0, const TObject *pairEffMap=0x0);
   static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
 
   static void SetVZERORecenteringFile(const Char_t* filename) {fgVZERORecenteringFile = filename;}
   static void SetZDCRecenteringFile(const Char_t* filename) {fgZDCRecenteringFile = filename;}
-  static void SetPIDResponse(AliPIDResponse *pidResponse) {fgPIDResponse=pidResponse;}
-  static AliPIDResponse* GetPIDResponse() { return fgPIDResponse; }
-  static void SetEvent(AliVEvent * const ev);
-  static void SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues]);
-  static Bool_t GetDCA(const AliAODTrack *track, Double_t* d0z0, Double_t* covd0z0=0);
-  static void SetTPCEventPlane(AliEventplane *const evplane);
+  static void SetPIDResponse(AliPIDResponse *pidResponse) {fgContext.SetPIDResponse(pidResponse);}
+  static AliPIDResponse* GetPIDResponse() { return fgContext.GetPIDResponse(); }
+  static void SetEvent(AliVEvent * const ev) { fgContext.SetEvent(ev); }
+  static void SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues]) { fgContext.SetEventData(data); }
+  static void SetDefaultContext(const Context &ctx) { fgContext=ctx; }
+  static Bool_t GetDCA(const AliAODTrack *track, Double_t* d0z0, Double_t* covd0z0, const Context &ctx);
+  static Bool_t GetDCA(const AliAODTrack *track, Double_t* d0z0, Double_t* covd0z0=0) { return GetDCA(track, d0z0, covd0z0, fgContext); }
+  static void SetTPCEventPlane(AliEventplane *const evplane) { fgContext.SetTPCEventPlane(evplane); }
   static void SetTPCEventPlaneACremoval(AliDielectronQnEPcorrection *acCuts) {fgQnEPacRemoval = acCuts; fgEventPlaneACremoval = kTRUE;}
   static void SetQnVectorNormalisation(TString qnNorm) {fgQnVectorNorm = qnNorm;}
   static void GetVzeroRP(const AliVEvent* event, Double_t* qvec, Int_t sideOption);      // 0- V0A; 1- V0C; 2- V0A+V0C
@@ -793,40 +845,41 @@ public:
   static AliAODVertex* GetVertex(const AliAODEvent *event, AliAODVertex::AODVtx_t vtype);
   static TProfile* GetEstimatorHistogram(Int_t period, Int_t type) {return fgMultEstimatorAvg[period][type];}
   static Double_t GetTRDpidEfficiency(Int_t runNo, Double_t centrality, Double_t eta, Double_t trdPhi, Double_t pout, Double_t& effErr);
-  static Double_t GetSingleLegEff(Double_t * const values);
-  static Double_t GetPairEff(Double_t * const values);
+  static Double_t GetSingleLegEff(Double_t * const values, const Context &ctx);
+  static Double_t GetPairEff(Double_t * const values, const Context &ctx);
+  static Double_t GetSingleLegEff(Double_t * const values) { return GetSingleLegEff(values, fgContext); }
+  static Double_t GetPairEff(Double_t * const values) { return GetPairEff(values, fgContext); }
 
-  static const AliKFVertex* GetKFVertex() {return fgKFVertex;}
+  static const AliKFVertex* GetKFVertex() {return fgContext.GetKFVertex();}
 
   static const char* GetValueName(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][0]:""; }
   static const char* GetValueLabel(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][1]:""; }
   static const char* GetValueUnit(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][2]:""; }
   static UInt_t GetValueType(const char* valname);
-  static const Double_t* GetData() {return fgData;}
-  static AliVEvent* GetCurrentEvent() {return fgEvent;}
+  static const Double_t* GetData() {return fgContext.GetData();}
+  static AliVEvent* GetCurrentEvent() {return fgContext.GetCurrentEvent();}
 
-  static Double_t GetValue(ValueTypes var) {return fgData[var];}
-  static void SetValue(ValueTypes var, Double_t val) { fgData[var]=val; }
+  static Double_t GetValue(ValueTypes var) {return fgContext.GetValue(var);}
+  static void SetValue(ValueTypes var, Double_t val) { fgContext.SetValue(var,val); }
 
 
 private:
 
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
-  static Bool_t Req(ValueTypes var) { if(fgFillMap->GetNbits()>kNMaxValues) return kFALSE; // needed for unknown crashes (TBits with high number of bits after calling GetPrimaryVertex in FillVarESDEvent)
-    return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
-  static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
-  static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
-  static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
-  static void FillVarMCParticle(const AliMCParticle *particle,       Double_t * const values);
-  static void FillVarAODMCParticle(const AliAODMCParticle *particle, Double_t * const values);
-  static void FillVarDielectronPair(const AliDielectronPair *pair,   Double_t * const values);
-  static void FillVarKFParticle(const AliKFParticle *pair,           Double_t * const values);
-
-  static void FillVarVEvent(const AliVEvent *event,                  Double_t * const values);
-  static void FillVarESDEvent(const AliESDEvent *event,              Double_t * const values);
-  static void FillVarAODEvent(const AliAODEvent *event,              Double_t * const values);
-  static void FillVarMCEvent(const AliMCEvent *event,                Double_t * const values);
+  static Bool_t AddEffMapAxes(TBits *map, const TObject *effMap);
+  static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values, const Context &ctx);
+  static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values, const Context &ctx);
+  static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values, const Context &ctx);
+  static void FillVarMCParticle(const AliMCParticle *particle,       Double_t * const values, const Context &ctx);
+  static void FillVarAODMCParticle(const AliAODMCParticle *particle, Double_t * const values, const Context &ctx);
+  static void FillVarDielectronPair(const AliDielectronPair *pair,   Double_t * const values, const Context &ctx);
+  static void FillVarKFParticle(const AliKFParticle *pair,           Double_t * const values, const Context &ctx);
+
+  static void FillVarVEvent(const AliVEvent *event,                  Double_t * const values, const Context &ctx);
+  static void FillVarESDEvent(const AliESDEvent *event,              Double_t * const values, const Context &ctx);
+  static void FillVarAODEvent(const AliAODEvent *event,              Double_t * const values, const Context &ctx);
+  static void FillVarMCEvent(const AliMCEvent *event,                Double_t * const values, const Context &ctx);
   static void FillVarTPCEventPlane(const AliEventplane *evplane,     Double_t * const values);
   static void FillQnEventplanes(TList *qnlist,                       Double_t * const values);
   static void FillZDCEventPlane(Double_t * const values);
@@ -835,16 +888,10 @@ private:
   static void InitVZERORecenteringHistograms(Int_t runNo);
   static void InitZDCRecenteringHistograms(Int_t runNo);
 
-  static AliPIDResponse  *fgPIDResponse;        // PID response object
-  static AliVEvent       *fgEvent;              // current event pointer
-  static AliEventplane   *fgTPCEventPlane;      // current event tpc plane pointer
-  static AliKFVertex     *fgKFVertex;           // kf vertex
+  static Context          fgContext;            //! default context of the static interface
   static TProfile        *fgMultEstimatorAvg[7][9];  // multiplicity estimator averages (7 periods x 18 estimators)
   static Double_t         fgTRDpidEffCentRanges[10][4];   // centrality ranges for the TRD pid efficiency histograms
   static TH3D            *fgTRDpidEff[10][4];   // TRD pid efficiencies from conversion electrons
-  static TObject         *fgLegEffMap;             // single electron efficiencies
-  static TObject         *fgPairEffMap;             // pair efficiencies
-  static TBits           *fgFillMap;             // map for requested variable filling
   static TString          fgVZEROCalibrationFile;  // file with VZERO channel-by-channel calibrations
   static TString          fgVZERORecenteringFile;  // file with VZERO Q-vector averages needed for event plane recentering
   static TProfile2D      *fgVZEROCalib[64];           // 1 histogram per VZERO channel
@@ -861,9 +908,6 @@ private:
 
   static Double_t CalculateEPDiff(Double_t detArp, Double_t detBrp);
 
-
-  static Double_t fgData[kNMaxValues];        //! data
-
   AliDielectronVarManager(const AliDielectronVarManager &c);
   AliDielectronVarManager &operator=(const AliDielectronVarManager &c);
 
@@ -872,29 +916,29 @@ private:
 
 
 //Inline functions
-inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * const values)
+inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * const values, const Context &ctx)
 {
   //
   // Main function to fill all available variables according to the type of particle
   //
   if (!object) return;
-  if      (object->IsA() == AliESDtrack::Class())       FillVarESDtrack(static_cast<const AliESDtrack*>(object), values);
-  else if (object->IsA() == AliAODTrack::Class())       FillVarAODTrack(static_cast<const AliAODTrack*>(object), values);
-  else if (object->IsA() == AliMCParticle::Class())     FillVarMCParticle(static_cast<const AliMCParticle*>(object), values);
-  else if (object->IsA() == AliAODMCParticle::Class())  FillVarAODMCParticle(static_cast<const AliAODMCParticle*>(object), values);
-  else if (object->IsA() == AliDielectronPair::Class()) FillVarDielectronPair(static_cast<const AliDielectronPair*>(object), values);
-  else if (object->IsA() == AliKFParticle::Class())     FillVarKFParticle(static_cast<const AliKFParticle*>(object),values);
+  if      (object->IsA() == AliESDtrack::Class())       FillVarESDtrack(static_cast<const AliESDtrack*>(object), values, ctx);
+  else if (object->IsA() == AliAODTrack::Class())       FillVarAODTrack(static_cast<const AliAODTrack*>(object), values, ctx);
+  else if (object->IsA() == AliMCParticle::Class())     FillVarMCParticle(static_cast<const AliMCParticle*>(object), values, ctx);
+  else if (object->IsA() == AliAODMCParticle::Class())  FillVarAODMCParticle(static_cast<const AliAODMCParticle*>(object), values, ctx);
+  else if (object->IsA() == AliDielectronPair::Class()) FillVarDielectronPair(static_cast<const AliDielectronPair*>(object), values, ctx);
+  else if (object->IsA() == AliKFParticle::Class())     FillVarKFParticle(static_cast<const AliKFParticle*>(object),values, ctx);
   // Main function to fill all available variables according to the type of event
 
-  else if (object->IsA() == AliVEvent::Class())         FillVarVEvent(static_cast<const AliVEvent*>(object), values);
-  else if (object->IsA() == AliESDEvent::Class())       FillVarESDEvent(static_cast<const AliESDEvent*>(object), values);
-  else if (object->IsA() == AliAODEvent::Class())       FillVarAODEvent(static_cast<const AliAODEvent*>(object), values);
-  else if (object->IsA() == AliMCEvent::Class())        FillVarMCEvent(static_cast<const AliMCEvent*>(object), values);
+  else if (object->IsA() == AliVEvent::Class())         FillVarVEvent(static_cast<const AliVEvent*>(object), values, ctx);
+  else if (object->IsA() == AliESDEvent::Class())       FillVarESDEvent(static_cast<const AliESDEvent*>(object), values, ctx);
+  else if (object->IsA() == AliAODEvent::Class())       FillVarAODEvent(static_cast<const AliAODEvent*>(object), values, ctx);
+  else if (object->IsA() == AliMCEvent::Class())        FillVarMCEvent(static_cast<const AliMCEvent*>(object), values, ctx);
   else if (object->IsA() == AliEventplane::Class())     FillVarTPCEventPlane(static_cast<const AliEventplane*>(object), values);
 //   else printf(Form("AliDielectronVarManager::Fill: Type %s is not supported by AliDielectronVarManager!", object->ClassName())); //TODO: implement without object needed
 }
 
-inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *particle, Double_t * const values)
+inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *particle, Double_t * const values, const Context &ctx)
 {
   ///
   /// Fill track information available in AliVParticle into an array
@@ -929,7 +973,7 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
   if(track->IsA() != AliDielectronPair::Class()) // otherwise crashing with ROOT5
     values[AliDielectronVarManager::kPIn]= track->GetTPCmomentum();//used for PID calib
 
-  if(Req(kPtMC)||Req(kPMC)||Req(kPhiMC)||Req(kEtaMC)){
+  if(ctx.Req(kPtMC)||ctx.Req(kPMC)||ctx.Req(kPhiMC)||ctx.Req(kEtaMC)){
     values[AliDielectronVarManager::kPtMC]      = -999.;
     values[AliDielectronVarManager::kPMC]       = -999.;
     values[AliDielectronVarManager::kPhiMC]     = -999.;
@@ -947,17 +991,17 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
 
 //   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
   for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+    values[i]=ctx.fData[i];
 }
 
-inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle, Double_t * const values)
+inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle, Double_t * const values, const Context &ctx)
 {
   //
   // Fill track information available for histogramming into an array
   //
 
   // Fill common AliVParticle interface information
-  FillVarVParticle(particle, values);
+  FillVarVParticle(particle, values, ctx);
 
   AliESDtrack *esdTrack=0x0;
   Double_t origdEdx=particle->GetTPCsignal();
@@ -1057,28 +1101,28 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   // Not clear if this is valid for ESDtracks: switch computation off since it takes 70% of the CPU time for filling all AODtrack variables
   // TODO: find a solution when this is needed (maybe at fill time in histos, CFcontainer and cut selection)
   // 1D TRD PID
-  if( Req(kTRDprobEle) || Req(kTRDprobPio) ){
-    fgPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob);
+  if( ctx.Req(kTRDprobEle) || ctx.Req(kTRDprobPio) ){
+    ctx.fPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob);
     values[AliDielectronVarManager::kTRDprobEle]      = prob[AliPID::kElectron];
     values[AliDielectronVarManager::kTRDprobPio]      = prob[AliPID::kPion];
   }
   // 2D TRD PID
-  if( Req(kTRDprob2DEle) || Req(kTRDprob2DPio) || Req(kTRDprob2DPro) ){
-    fgPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob, AliTRDPIDResponse::kLQ2D);
+  if( ctx.Req(kTRDprob2DEle) || ctx.Req(kTRDprob2DPio) || ctx.Req(kTRDprob2DPro) ){
+    ctx.fPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob, AliTRDPIDResponse::kLQ2D);
     values[AliDielectronVarManager::kTRDprob2DEle]    = prob[AliPID::kElectron];
     values[AliDielectronVarManager::kTRDprob2DPio]    = prob[AliPID::kPion];
     values[AliDielectronVarManager::kTRDprob2DPro]    = prob[AliPID::kProton];
   }
   // 3D TRD PID
-   if( Req(kTRDprob3DEle) || Req(kTRDprob3DPio) || Req(kTRDprob3DPro) ){
-     fgPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ3D);
+   if( ctx.Req(kTRDprob3DEle) || ctx.Req(kTRDprob3DPio) || ctx.Req(kTRDprob3DPro) ){
+     ctx.fPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ3D);
      values[AliDielectronVarManager::kTRDprob3DEle]    = prob[AliPID::kElectron];
      values[AliDielectronVarManager::kTRDprob3DPio]    = prob[AliPID::kPion];
      values[AliDielectronVarManager::kTRDprob3DPro]    = prob[AliPID::kProton];
    }
   // 7D TRD PID
-   if( Req(kTRDprob7DEle) || Req(kTRDprob7DPio) || Req(kTRDprob7DPro) ){
-     fgPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob, AliTRDPIDResponse::kLQ7D);
+   if( ctx.Req(kTRDprob7DEle) || ctx.Req(kTRDprob7DPio) || ctx.Req(kTRDprob7DPro) ){
+     ctx.fPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob, AliTRDPIDResponse::kLQ7D);
      values[AliDielectronVarManager::kTRDprob7DEle]    = prob[AliPID::kElectron];
      values[AliDielectronVarManager::kTRDprob7DPio]    = prob[AliPID::kPion];
      values[AliDielectronVarManager::kTRDprob7DPro]    = prob[AliPID::kProton];
@@ -1120,7 +1164,7 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
     if (mc->GetMCTrack(particle)) {
       Int_t trkLbl = TMath::Abs(particle->GetLabel());
 
-      if (Req(kMCLegSource)){
+      if (ctx.Req(kMCLegSource)){
         values[AliDielectronVarManager::kMCLegSource] = 0;
         if (mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kPrimary)) values[AliDielectronVarManager::kMCLegSource] += 1;
         if (mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kFinalState)) values[AliDielectronVarManager::kMCLegSource] += 2;
@@ -1130,16 +1174,16 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
         if (mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kSecondaryFromMaterial)) values[AliDielectronVarManager::kMCLegSource] +=32;
       }
 
-      if (Req(kPdgCode))           values[AliDielectronVarManager::kPdgCode]           =mc->GetMCTrack(particle)->PdgCode();
-      if (Req(kHasCocktailMother)) values[AliDielectronVarManager::kHasCocktailMother] =mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kDirect);
-      if (Req(kPdgCodeMother))     values[AliDielectronVarManager::kPdgCodeMother]     =mc->GetMotherPDG(particle);
-      if (Req(kPdgCodeGrandMother)){
+      if (ctx.Req(kPdgCode))           values[AliDielectronVarManager::kPdgCode]           =mc->GetMCTrack(particle)->PdgCode();
+      if (ctx.Req(kHasCocktailMother)) values[AliDielectronVarManager::kHasCocktailMother] =mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kDirect);
+      if (ctx.Req(kPdgCodeMother))     values[AliDielectronVarManager::kPdgCodeMother]     =mc->GetMotherPDG(particle);
+      if (ctx.Req(kPdgCodeGrandMother)){
         AliMCParticle *motherMC=mc->GetMCTrackMother(particle); //mother
         if(motherMC) values[AliDielectronVarManager::kPdgCodeGrandMother]=mc->GetMotherPDG(motherMC);
       }
       // Fill distance of primary vertex to secondary vertex (as an alternative to the IP)
       // Pure MC variable by intention, no reconstucted value filled.
-      if (Req(kDistPrimToSecVtxXYMC) || Req(kDistPrimToSecVtxZMC)) {
+      if (ctx.Req(kDistPrimToSecVtxXYMC) || ctx.Req(kDistPrimToSecVtxZMC)) {
         AliMCParticle *MCpart = mc->GetMCTrack(particle);
         values[AliDielectronVarManager::kDistPrimToSecVtxXYMC] = TMath::Sqrt(  TMath::Power(MCpart->Xv() - values[AliDielectronVarManager::kXvPrimMCtruth],2) + TMath::Power(MCpart->Yv() - values[AliDielectronVarManager::kYvPrimMCtruth],2));
         values[AliDielectronVarManager::kDistPrimToSecVtxZMC] = TMath::Abs(MCpart->Zv() - values[AliDielectronVarManager::kZvPrimMCtruth]);
@@ -1182,15 +1226,15 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   const AliExternalTrackParam *out=particle->GetOuterParam();
   if(out) values[AliDielectronVarManager::kPOut] = out->GetP();
   else values[AliDielectronVarManager::kPOut] = mom;
-  if(out && fgEvent) {
+  if(out && ctx.fEvent) {
     Double_t localCoord[3]={0.0};
-    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)fgEvent)->GetMagneticField(), localCoord);
+    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)ctx.fEvent)->GetMagneticField(), localCoord);
     values[AliDielectronVarManager::kTRDphi] = (localCoordGood && TMath::Abs(localCoord[0])>1.0e-6 && TMath::Abs(localCoord[1])>1.0e-6 ? TMath::ATan2(localCoord[1], localCoord[0]) : -999.);
   }
   if(mc->HasMC() && fgTRDpidEff[0][0]) {
-    Int_t runNo = (fgEvent ? fgEvent->GetRunNumber() : -1);
+    Int_t runNo = (ctx.fEvent ? ctx.fEvent->GetRunNumber() : -1);
     Float_t centrality=-1.0;
-    AliCentrality *esdCentrality = (fgEvent ? fgEvent->GetCentrality() : 0x0);
+    AliCentrality *esdCentrality = (ctx.fEvent ? ctx.fEvent->GetCentrality() : 0x0);
     if(esdCentrality) centrality = esdCentrality->GetCentralityPercentile("V0M");
     Double_t effErr=0.0;
     values[kTRDpidEffLeg] = GetTRDpidEfficiency(runNo, centrality, values[AliDielectronVarManager::kEta],
@@ -1208,7 +1252,7 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
 
   Double_t l = particle->GetIntegratedLength();  // cm
   Double_t t = particle->GetTOFsignal();
-  Double_t t0 = fgPIDResponse->GetTOFResponse().GetTimeZero(); // ps
+  Double_t t0 = ctx.fPIDResponse->GetTOFResponse().GetTimeZero(); // ps
 
   if( (l < 360. || l > 800.) || (t <= 0.) || (t0 >999990.0) ) {
 	values[AliDielectronVarManager::kTOFbeta]=0.0;
@@ -1224,40 +1268,40 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   }
   values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
 
-  values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+  values[AliDielectronVarManager::kTOFmismProb] = ctx.fPIDResponse->GetTOFMismatchProbability(particle);
 
   // nsigma to Electron band
   // TODO: for the moment we set the bethe bloch parameters manually
   //       this should be changed in future!
-  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorr(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kTPCnSigmaEle]   =(ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorr(particle,AliPID::kElectron);
 
-  values[AliDielectronVarManager::kTPCnSigmaPio] = (fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kPion  )) /  AliDielectronPID::GetWdthCorr(particle,AliPID::kPion  );
-  values[AliDielectronVarManager::kTPCnSigmaMuo] = (fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kMuon  )) /  AliDielectronPID::GetWdthCorr(particle,AliPID::kMuon  );
-  values[AliDielectronVarManager::kTPCnSigmaKao] = (fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kKaon  )) /  AliDielectronPID::GetWdthCorr(particle,AliPID::kKaon  );
-  values[AliDielectronVarManager::kTPCnSigmaPro] = (fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kProton)) /  AliDielectronPID::GetWdthCorr(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kTPCnSigmaPio] = (ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kPion  )) /  AliDielectronPID::GetWdthCorr(particle,AliPID::kPion  );
+  values[AliDielectronVarManager::kTPCnSigmaMuo] = (ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kMuon  )) /  AliDielectronPID::GetWdthCorr(particle,AliPID::kMuon  );
+  values[AliDielectronVarManager::kTPCnSigmaKao] = (ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kKaon  )) /  AliDielectronPID::GetWdthCorr(particle,AliPID::kKaon  );
+  values[AliDielectronVarManager::kTPCnSigmaPro] = (ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kProton)) /  AliDielectronPID::GetWdthCorr(particle,AliPID::kProton);
 
-  values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kITSnSigmaEleRaw]= ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kITSnSigmaEle]   =(ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kElectron);
 
-  values[AliDielectronVarManager::kITSnSigmaPio] = (fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kPion  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kPion  );
-  values[AliDielectronVarManager::kITSnSigmaMuo] = (fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kMuon  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kMuon  );
-  values[AliDielectronVarManager::kITSnSigmaKao] = (fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kKaon  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kKaon  );
-  values[AliDielectronVarManager::kITSnSigmaPro] = (fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton) - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kProton)) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kITSnSigmaPio] = (ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kPion  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kPion  );
+  values[AliDielectronVarManager::kITSnSigmaMuo] = (ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kMuon  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kMuon  );
+  values[AliDielectronVarManager::kITSnSigmaKao] = (ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kKaon  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kKaon  );
+  values[AliDielectronVarManager::kITSnSigmaPro] = (ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton) - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kProton)) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kProton);
 
-  values[AliDielectronVarManager::kTOFnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kTOFnSigmaEleRaw]= ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kTOFnSigmaEle]   =(ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kElectron);
 
-  values[AliDielectronVarManager::kTOFnSigmaPio] = (fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kPion  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kPion  );
-  values[AliDielectronVarManager::kTOFnSigmaMuo] = (fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kMuon  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kMuon  );
-  values[AliDielectronVarManager::kTOFnSigmaKao] = (fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kKaon  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kKaon  );
-  values[AliDielectronVarManager::kTOFnSigmaPro] = (fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton) - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kProton)) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kTOFnSigmaPio] = (ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kPion  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kPion  );
+  values[AliDielectronVarManager::kTOFnSigmaMuo] = (ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kMuon  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kMuon  );
+  values[AliDielectronVarManager::kTOFnSigmaKao] = (ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kKaon  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kKaon  );
+  values[AliDielectronVarManager::kTOFnSigmaPro] = (ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton) - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kProton)) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kProton);
 
   //EMCAL PID information
   Double_t eop=0;
   Double_t showershape[4]={0.,0.,0.,0.};
 //   values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
+  values[AliDielectronVarManager::kEMCALnSigmaEle]  = ctx.fPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
   values[AliDielectronVarManager::kEMCALEoverP]     = eop;
   values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
   values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
@@ -1265,72 +1309,72 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   values[AliDielectronVarManager::kEMCALM20]        = showershape[2];
   values[AliDielectronVarManager::kEMCALDispersion] = showershape[3];
 
-  values[AliDielectronVarManager::kLegEff]        = GetSingleLegEff(values);
+  values[AliDielectronVarManager::kLegEff]        = GetSingleLegEff(values, ctx);
   values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
   //restore TPC signal if it was changed
   if (esdTrack) esdTrack->SetTPCsignal(origdEdx,esdTrack->GetTPCsignalSigma(),esdTrack->GetTPCsignalN());
 
   //fill info from AliVTrdTrack
-  if(Req(kTRDonlineA)||Req(kTRDonlineLayerMask)||Req(kTRDonlinePID)||Req(kTRDonlinePt)||Req(kTRDonlineStack)||Req(kTRDonlineTrackInTime)||Req(kTRDonlineSector)||Req(kTRDonlineFlagsTiming)||Req(kTRDonlineLabel)||Req(kTRDonlineNTracklets)||Req(kTRDonlineFirstLayer))
-    FillVarVTrdTrack(particle,values);
+  if(ctx.Req(kTRDonlineA)||ctx.Req(kTRDonlineLayerMask)||ctx.Req(kTRDonlinePID)||ctx.Req(kTRDonlinePt)||ctx.Req(kTRDonlineStack)||ctx.Req(kTRDonlineTrackInTime)||ctx.Req(kTRDonlineSector)||ctx.Req(kTRDonlineFlagsTiming)||ctx.Req(kTRDonlineLabel)||ctx.Req(kTRDonlineNTracklets)||ctx.Req(kTRDonlineFirstLayer))
+    FillVarVTrdTrack(particle,values, ctx);
 
-  if( fgEvent && fgEvent->GetMagneticField() ){
+  if( ctx.fEvent && ctx.fEvent->GetMagneticField() ){
     if(out){
       AliExternalTrackParam out_tmp(*out);
-      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), ctx.fEvent->GetMagneticField());
       values[AliDielectronVarManager::kTRDeta] = out_tmp.Eta();
     }
     else{
       AliESDtrack particle_tmp(*particle);
-      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), ctx.fEvent->GetMagneticField());
       values[AliDielectronVarManager::kTRDeta] = particle_tmp.Eta();
     }
     int mode = particle->GetInnerParam() ? 1:0;
-    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., fgEvent->GetMagneticField());
+    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., ctx.fEvent->GetMagneticField());
     values[kTPCGeomLength] = values[kTPCActiveLength] / ( 130 - TMath::Power( TMath::Abs( particle->GetSigned1Pt() ),1.5 ) );
     values[AliDielectronVarManager::kInTRDacceptance] = TMath::Abs( values[AliDielectronVarManager::kTRDeta] )<0.85 && (  (values[AliDielectronVarManager::kCharge]<0&&(  values[AliDielectronVarManager::kPhi]<1.32 || (values[AliDielectronVarManager::kPhi]>1.98 && values[AliDielectronVarManager::kPhi]<4.10)||  ( values[AliDielectronVarManager::kPhi]>5.12  && values[AliDielectronVarManager::kPhi]<5.48  && TMath::Abs( values[AliDielectronVarManager::kTRDeta] )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.48 )) ||   (values[AliDielectronVarManager::kCharge]>0&&(  values[AliDielectronVarManager::kPhi]<1.52 || (values[AliDielectronVarManager::kPhi]>2.20 && values[AliDielectronVarManager::kPhi]<4.32)||  ( values[AliDielectronVarManager::kPhi]>5.32  && values[AliDielectronVarManager::kPhi]<5.68  && TMath::Abs( values[AliDielectronVarManager::kTRDeta]  )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.68 )) )  ? 1: 0;
   }
 
 }
 
-inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle, Double_t * const values)
+inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle, Double_t * const values, const Context &ctx)
 {
   //
   // Fill track information available for histogramming into an array
   //
 
   // Fill common AliVParticle interface information
-  FillVarVParticle(particle, values);
+  FillVarVParticle(particle, values, ctx);
   Double_t tpcNcls=particle->GetTPCNcls();
 
-  if(Req(kQnDeltaPhiTrackTPCrpH2))   values[AliDielectronVarManager::kQnDeltaPhiTrackTPCrpH2]  = TVector2::Phi_mpi_pi(values[AliDielectronVarManager::kPhi] - values[AliDielectronVarManager::kQnTPCrpH2]);
-  if(Req(kQnDeltaPhiTrackV0CrpH2))   values[AliDielectronVarManager::kQnDeltaPhiTrackV0CrpH2]  = TVector2::Phi_mpi_pi(values[AliDielectronVarManager::kPhi] - values[AliDielectronVarManager::kQnV0CrpH2]);
+  if(ctx.Req(kQnDeltaPhiTrackTPCrpH2))   values[AliDielectronVarManager::kQnDeltaPhiTrackTPCrpH2]  = TVector2::Phi_mpi_pi(values[AliDielectronVarManager::kPhi] - values[AliDielectronVarManager::kQnTPCrpH2]);
+  if(ctx.Req(kQnDeltaPhiTrackV0CrpH2))   values[AliDielectronVarManager::kQnDeltaPhiTrackV0CrpH2]  = TVector2::Phi_mpi_pi(values[AliDielectronVarManager::kPhi] - values[AliDielectronVarManager::kQnV0CrpH2]);
 
   Double_t tpcNclsS = -99.;
-  if(Req(kNclsSTPC) || Req(kNclsSFracTPC)) tpcNclsS = particle->GetTPCnclsS();
+  if(ctx.Req(kNclsSTPC) || ctx.Req(kNclsSFracTPC)) tpcNclsS = particle->GetTPCnclsS();
 
   // Reset AliESDtrack interface specific information
-  if(Req(kNclsITS) || Req(kNclsSFracITS))      values[AliDielectronVarManager::kNclsITS]       = particle->GetITSNcls();
-  if(Req(kITSchi2))    values[AliDielectronVarManager::kITSchi2]     = particle->GetITSchi2();
-  if(Req(kITSchi2Cl))    values[AliDielectronVarManager::kITSchi2Cl]     = (particle->GetITSNcls()>0)? particle->GetITSchi2() / particle->GetITSNcls() : 0;
-  if(Req(kNclsTPC))      values[AliDielectronVarManager::kNclsTPC]       = tpcNcls;
-  if(Req(kNclsSTPC) || Req(kNclsSFracTPC))     values[AliDielectronVarManager::kNclsSTPC]      = tpcNclsS;
-  if(Req(kNclsSFracTPC)) values[AliDielectronVarManager::kNclsSFracTPC]  = tpcNcls>0?tpcNclsS/tpcNcls:0;
-  if(Req(kNclsTPCiter1)) values[AliDielectronVarManager::kNclsTPCiter1]  = tpcNcls; // not really available in AOD
-  if(Req(kNFclsTPC)  || Req(kNFclsTPCfCross))  values[AliDielectronVarManager::kNFclsTPC]      = particle->GetTPCNclsF();
-  if(Req(kNFclsTPCr) || Req(kNFclsTPCfCross))  values[AliDielectronVarManager::kNFclsTPCr]     = particle->GetTPCClusterInfo(2,1);
-  if(Req(kNclsCrTPC))      values[AliDielectronVarManager::kNclsCrTPC]      = particle->GetTPCCrossedRows();
-  if(Req(kNFclsTPCrFrac))  values[AliDielectronVarManager::kNFclsTPCrFrac] = particle->GetTPCClusterInfo(2);
-  if(Req(kNFclsTPCfCross)) values[AliDielectronVarManager::kNFclsTPCfCross]= (values[kNFclsTPC]>0)?(values[kNFclsTPCr]/values[kNFclsTPC]):0;
-  if(Req(kChi2TPCConstrainedVsGlobal)) values[AliDielectronVarManager::kChi2TPCConstrainedVsGlobal] = particle->GetChi2TPCConstrainedVsGlobal();
-  if(Req(kNclsTRD))        values[AliDielectronVarManager::kNclsTRD]       = particle->GetNcls(2);
-  if(Req(kTRDntracklets))  values[AliDielectronVarManager::kTRDntracklets] = 0;
-  if(Req(kTRDpidQuality))  values[AliDielectronVarManager::kTRDpidQuality] = particle->GetTRDntrackletsPID();
-  if(Req(kTRDchi2))        values[AliDielectronVarManager::kTRDchi2]       = (particle->GetTRDntrackletsPID()!=0.?particle->GetTRDchi2():-1);
-  if(Req(kTRDchi2Trklt))   values[AliDielectronVarManager::kTRDchi2Trklt]  = (particle->GetTRDntrackletsPID()>0 ? particle->GetTRDchi2() / particle->GetTRDntrackletsPID() : -1.);
-  if(Req(kTRDsignal))      values[AliDielectronVarManager::kTRDsignal]     = particle->GetTRDsignal();
-
-  if(Req(kNclsSITS) || Req(kNclsSFracITS) || Req(kNclsSMapITS) || Req(kClsS1ITS) || Req(kClsS2ITS) || Req(kClsS3ITS) || Req(kClsS4ITS) || Req(kClsS5ITS) || Req(kClsS6ITS)){
+  if(ctx.Req(kNclsITS) || ctx.Req(kNclsSFracITS))      values[AliDielectronVarManager::kNclsITS]       = particle->GetITSNcls();
+  if(ctx.Req(kITSchi2))    values[AliDielectronVarManager::kITSchi2]     = particle->GetITSchi2();
+  if(ctx.Req(kITSchi2Cl))    values[AliDielectronVarManager::kITSchi2Cl]     = (particle->GetITSNcls()>0)? particle->GetITSchi2() / particle->GetITSNcls() : 0;
+  if(ctx.Req(kNclsTPC))      values[AliDielectronVarManager::kNclsTPC]       = tpcNcls;
+  if(ctx.Req(kNclsSTPC) || ctx.Req(kNclsSFracTPC))     values[AliDielectronVarManager::kNclsSTPC]      = tpcNclsS;
+  if(ctx.Req(kNclsSFracTPC)) values[AliDielectronVarManager::kNclsSFracTPC]  = tpcNcls>0?tpcNclsS/tpcNcls:0;
+  if(ctx.Req(kNclsTPCiter1)) values[AliDielectronVarManager::kNclsTPCiter1]  = tpcNcls; // not really available in AOD
+  if(ctx.Req(kNFclsTPC)  || ctx.Req(kNFclsTPCfCross))  values[AliDielectronVarManager::kNFclsTPC]      = particle->GetTPCNclsF();
+  if(ctx.Req(kNFclsTPCr) || ctx.Req(kNFclsTPCfCross))  values[AliDielectronVarManager::kNFclsTPCr]     = particle->GetTPCClusterInfo(2,1);
+  if(ctx.Req(kNclsCrTPC))      values[AliDielectronVarManager::kNclsCrTPC]      = particle->GetTPCCrossedRows();
+  if(ctx.Req(kNFclsTPCrFrac))  values[AliDielectronVarManager::kNFclsTPCrFrac] = particle->GetTPCClusterInfo(2);
+  if(ctx.Req(kNFclsTPCfCross)) values[AliDielectronVarManager::kNFclsTPCfCross]= (values[kNFclsTPC]>0)?(values[kNFclsTPCr]/values[kNFclsTPC]):0;
+  if(ctx.Req(kChi2TPCConstrainedVsGlobal)) values[AliDielectronVarManager::kChi2TPCConstrainedVsGlobal] = particle->GetChi2TPCConstrainedVsGlobal();
+  if(ctx.Req(kNclsTRD))        values[AliDielectronVarManager::kNclsTRD]       = particle->GetNcls(2);
+  if(ctx.Req(kTRDntracklets))  values[AliDielectronVarManager::kTRDntracklets] = 0;
+  if(ctx.Req(kTRDpidQuality))  values[AliDielectronVarManager::kTRDpidQuality] = particle->GetTRDntrackletsPID();
+  if(ctx.Req(kTRDchi2))        values[AliDielectronVarManager::kTRDchi2]       = (particle->GetTRDntrackletsPID()!=0.?particle->GetTRDchi2():-1);
+  if(ctx.Req(kTRDchi2Trklt))   values[AliDielectronVarManager::kTRDchi2Trklt]  = (particle->GetTRDntrackletsPID()>0 ? particle->GetTRDchi2() / particle->GetTRDntrackletsPID() : -1.);
+  if(ctx.Req(kTRDsignal))      values[AliDielectronVarManager::kTRDsignal]     = particle->GetTRDsignal();
+
+  if(ctx.Req(kNclsSITS) || ctx.Req(kNclsSFracITS) || ctx.Req(kNclsSMapITS) || ctx.Req(kClsS1ITS) || ctx.Req(kClsS2ITS) || ctx.Req(kClsS3ITS) || ctx.Req(kClsS4ITS) || ctx.Req(kClsS5ITS) || ctx.Req(kClsS6ITS)){
     Double_t itsNclsS = 0.;
     values[AliDielectronVarManager::kClsS1ITS]=0;
     values[AliDielectronVarManager::kClsS2ITS]=0;
@@ -1351,11 +1395,11 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
     }
 
     values[AliDielectronVarManager::kNclsSITS]     = itsNclsS;
-    if(Req(kNclsSMapITS))  values[AliDielectronVarManager::kNclsSMapITS]  = particle->GetITSSharedClusterMap();  //not implemented in AODs
-    if(Req(kNclsSFracITS)) values[AliDielectronVarManager::kNclsSFracITS] = itsNclsS > 0. ? itsNclsS / particle->GetITSNcls() : 0.;
+    if(ctx.Req(kNclsSMapITS))  values[AliDielectronVarManager::kNclsSMapITS]  = particle->GetITSSharedClusterMap();  //not implemented in AODs
+    if(ctx.Req(kNclsSFracITS)) values[AliDielectronVarManager::kNclsSFracITS] = itsNclsS > 0. ? itsNclsS / particle->GetITSNcls() : 0.;
   }
 
-  if(Req(kITSsignalSSD1) || Req(kITSsignalSSD2) || Req(kITSsignalSDD1) || Req(kITSsignalSDD2) ){
+  if(ctx.Req(kITSsignalSSD1) || ctx.Req(kITSsignalSSD2) || ctx.Req(kITSsignalSDD1) || ctx.Req(kITSsignalSDD2) ){
     Double_t itsdEdx[4];
     particle->GetITSdEdxSamples(itsdEdx);
     values[AliDielectronVarManager::kITSsignalSSD1]   =   itsdEdx[0];
@@ -1370,7 +1414,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   UChar_t threshold = 5;
 
   values[AliDielectronVarManager::kTPCclsSegments] = 0.0;
-  if(Req(kTPCclsSegments)) {
+  if(ctx.Req(kTPCclsSegments)) {
     for(UChar_t i=0; i<8; ++i) {
       n=0;
       for(j=i*20; j<(i+1)*20 && j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
@@ -1379,7 +1423,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   }
 
   values[AliDielectronVarManager::kTPCclsIRO]=0.;
-  if(Req(kTPCclsIRO)) {
+  if(ctx.Req(kTPCclsIRO)) {
     n=0;
     threshold=0;
     for(j=0; j<63; ++j) n+=tpcClusterMap.TestBitNumber(j);
@@ -1387,19 +1431,19 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   }
 
   values[AliDielectronVarManager::kTPCclsORO]=0.;
-  if(Req(kTPCclsORO)) {
+  if(ctx.Req(kTPCclsORO)) {
     n=0;
     threshold=0;
     for(j=63; j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
     if(n>=threshold) values[AliDielectronVarManager::kTPCclsORO] = n;
   }
 
-  if(Req(kChi2GlobalNDF))   values[AliDielectronVarManager::kChi2GlobalNDF]     = particle->Chi2perNDF();
+  if(ctx.Req(kChi2GlobalNDF))   values[AliDielectronVarManager::kChi2GlobalNDF]     = particle->Chi2perNDF();
 
   // it is stored as normalized to tpcNcls-5 (see AliAnalysisTaskESDfilter)
-  if(Req(kTPCchi2Cl))   values[AliDielectronVarManager::kTPCchi2Cl]     = (tpcNcls>0)?particle->Chi2perNDF()*(tpcNcls-5)/tpcNcls:-1.;
-  if(Req(kTrackStatus)) values[AliDielectronVarManager::kTrackStatus]   = (Double_t)particle->GetStatus();
-  if(Req(kFilterBit))   values[AliDielectronVarManager::kFilterBit]     = (Double_t)particle->GetFilterMap();
+  if(ctx.Req(kTPCchi2Cl))   values[AliDielectronVarManager::kTPCchi2Cl]     = (tpcNcls>0)?particle->Chi2perNDF()*(tpcNcls-5)/tpcNcls:-1.;
+  if(ctx.Req(kTrackStatus)) values[AliDielectronVarManager::kTrackStatus]   = (Double_t)particle->GetStatus();
+  if(ctx.Req(kFilterBit))   values[AliDielectronVarManager::kFilterBit]     = (Double_t)particle->GetFilterMap();
 
   //TRD pidProbs
   values[AliDielectronVarManager::kTRDprobEle]    = 0;
@@ -1412,7 +1456,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   //
   Int_t v0Index=-1;
   Int_t kinkIndex=-1;
-  if( (Req(kV0Index0) || Req(kKinkIndex0)) && particle->GetProdVertex()) {
+  if( (ctx.Req(kV0Index0) || ctx.Req(kKinkIndex0)) && particle->GetProdVertex()) {
     v0Index   = particle->GetProdVertex()->GetType()==AliAODVertex::kV0   ? 1 : 0;
     kinkIndex = particle->GetProdVertex()->GetType()==AliAODVertex::kKink ? 1 : 0;
   }
@@ -1421,7 +1465,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
 
   Double_t d0z0[2]={-999.0,-999.0};
   Double_t dcaRes[3] = {-999.,-999.,-999.};
-  if(Req(kImpactParXY) || Req(kImpactParZ) || Req(kImpactParXYsigma) || Req(kImpactParZsigma) || Req(kLogDCAXY) || Req(kLogDCAZ)) GetDCA(particle, d0z0, dcaRes);
+  if(ctx.Req(kImpactParXY) || ctx.Req(kImpactParZ) || ctx.Req(kImpactParXYsigma) || ctx.Req(kImpactParZsigma) || ctx.Req(kLogDCAXY) || ctx.Req(kLogDCAZ)) GetDCA(particle, d0z0, dcaRes, ctx);
   values[AliDielectronVarManager::kImpactParXY]   = d0z0[0];
   values[AliDielectronVarManager::kImpactParZ]    = d0z0[1];
   values[AliDielectronVarManager::kImpactParXYsigma] = -999.0;
@@ -1458,12 +1502,12 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   values[AliDielectronVarManager::kTOFnSigmaKao]=0;
   values[AliDielectronVarManager::kTOFnSigmaPro]=0;
 
-  if(Req(kITSsignal))        values[AliDielectronVarManager::kITSsignal]        =   particle->GetITSsignal();
-  if(Req(kITSclusterMap))    values[AliDielectronVarManager::kITSclusterMap]    =   particle->GetITSClusterMap();
-  if(Req(kITSLayerFirstCls)) values[AliDielectronVarManager::kITSLayerFirstCls] = -1.;
+  if(ctx.Req(kITSsignal))        values[AliDielectronVarManager::kITSsignal]        =   particle->GetITSsignal();
+  if(ctx.Req(kITSclusterMap))    values[AliDielectronVarManager::kITSclusterMap]    =   particle->GetITSClusterMap();
+  if(ctx.Req(kITSLayerFirstCls)) values[AliDielectronVarManager::kITSLayerFirstCls] = -1.;
   for (Int_t iC=0; iC<6; iC++) {
     if (((particle->GetITSClusterMap()) & (1<<(iC))) > 0) {
-      if(Req(kITSLayerFirstCls)) values[AliDielectronVarManager::kITSLayerFirstCls] = iC;
+      if(ctx.Req(kITSLayerFirstCls)) values[AliDielectronVarManager::kITSLayerFirstCls] = iC;
       break;
     }
   }
@@ -1475,25 +1519,25 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
     pid->SetTPCsignal(origdEdx/AliDielectronPID::GetEtaCorr(particle)/AliDielectronPID::GetCorrValdEdx());
 
     Double_t tpcSignalN=0.0;
-    if(Req(kTPCsignalN) || Req(kTPCsignalNfrac) || Req(kTPCclsDiff)) tpcSignalN = pid->GetTPCsignalN();
+    if(ctx.Req(kTPCsignalN) || ctx.Req(kTPCsignalNfrac) || ctx.Req(kTPCclsDiff)) tpcSignalN = pid->GetTPCsignalN();
     values[AliDielectronVarManager::kTPCsignalN]     = tpcSignalN;
     values[AliDielectronVarManager::kTPCsignalNfrac] = tpcNcls>0?tpcSignalN/tpcNcls:0;
     values[AliDielectronVarManager::kTPCclsDiff]     = tpcSignalN-tpcNcls;
 
     values[AliDielectronVarManager::kPIn]         = pid->GetTPCmomentum();
-    if(Req(kTPCsignal))   values[AliDielectronVarManager::kTPCsignal]   = pid->GetTPCsignal();
-    if(Req(kTOFsignal))   values[AliDielectronVarManager::kTOFsignal]   = pid->GetTOFsignal();
-    if(Req(kTOFmismProb)) values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+    if(ctx.Req(kTPCsignal))   values[AliDielectronVarManager::kTPCsignal]   = pid->GetTPCsignal();
+    if(ctx.Req(kTOFsignal))   values[AliDielectronVarManager::kTOFsignal]   = pid->GetTOFsignal();
+    if(ctx.Req(kTOFmismProb)) values[AliDielectronVarManager::kTOFmismProb] = ctx.fPIDResponse->GetTOFMismatchProbability(particle);
 
     // TOF beta calculation
-    if(Req(kTOFbeta)) {
+    if(ctx.Req(kTOFbeta)) {
       Double32_t expt[5];
       particle->GetIntegratedTimes(expt);         // ps
       Double_t l  = TMath::C()* expt[0]*1e-12;    // m
       Double_t t  = pid->GetTOFsignal();          // ps start time subtracted (until v5-02-Rev09)
       AliTOFHeader* tofH=0x0;                     // from v5-02-Rev10 on subtract the start time
-      if(fgEvent) tofH = (AliTOFHeader*)fgEvent->GetTOFHeader();
-      if(tofH) t -= fgPIDResponse->GetTOFResponse().GetStartTime(particle->P()); // ps
+      if(ctx.fEvent) tofH = (AliTOFHeader*)ctx.fEvent->GetTOFHeader();
+      if(tofH) t -= ctx.fPIDResponse->GetTOFResponse().GetStartTime(particle->P()); // ps
 
     if( (l < 360.e-2 || l > 800.e-2) || (t <= 0.) ) {
       values[AliDielectronVarManager::kTOFbeta]  =0;
@@ -1508,56 +1552,56 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
     }
 
     // nsigma for various detectors
-    if(Req(kTPCnSigmaEleRaw)) values[kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-    if(Req(kTPCnSigmaEle))    values[kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorr(particle,AliPID::kElectron);
+    if(ctx.Req(kTPCnSigmaEleRaw)) values[kTPCnSigmaEleRaw]= ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
+    if(ctx.Req(kTPCnSigmaEle))    values[kTPCnSigmaEle]   =(ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorr(particle,AliPID::kElectron);
 
-    if(Req(kTPCnSigmaPio)) values[kTPCnSigmaPio] = (fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kPion  )) / AliDielectronPID::GetWdthCorr(particle,AliPID::kPion  );
-    if(Req(kTPCnSigmaMuo)) values[kTPCnSigmaMuo] = (fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kMuon  )) / AliDielectronPID::GetWdthCorr(particle,AliPID::kMuon  );
-    if(Req(kTPCnSigmaKao)) values[kTPCnSigmaKao] = (fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kKaon  )) / AliDielectronPID::GetWdthCorr(particle,AliPID::kKaon  );
-    if(Req(kTPCnSigmaPro)) values[kTPCnSigmaPro] = (fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kProton)) / AliDielectronPID::GetWdthCorr(particle,AliPID::kProton);
+    if(ctx.Req(kTPCnSigmaPio)) values[kTPCnSigmaPio] = (ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kPion  )) / AliDielectronPID::GetWdthCorr(particle,AliPID::kPion  );
+    if(ctx.Req(kTPCnSigmaMuo)) values[kTPCnSigmaMuo] = (ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kMuon  )) / AliDielectronPID::GetWdthCorr(particle,AliPID::kMuon  );
+    if(ctx.Req(kTPCnSigmaKao)) values[kTPCnSigmaKao] = (ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon)   - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kKaon  )) / AliDielectronPID::GetWdthCorr(particle,AliPID::kKaon  );
+    if(ctx.Req(kTPCnSigmaPro)) values[kTPCnSigmaPro] = (ctx.fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle,AliPID::kProton)) / AliDielectronPID::GetWdthCorr(particle,AliPID::kProton);
 
-    if(Req(kITSnSigmaEleRaw)) values[kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-    if(Req(kITSnSigmaEle))    values[kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kElectron);
+    if(ctx.Req(kITSnSigmaEleRaw)) values[kITSnSigmaEleRaw]= ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
+    if(ctx.Req(kITSnSigmaEle))    values[kITSnSigmaEle]   =(ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kElectron);
 
-    if(Req(kITSnSigmaPio)) values[kITSnSigmaPio] = (fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kPion  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kPion  );
-    if(Req(kITSnSigmaMuo)) values[kITSnSigmaMuo] = (fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kMuon  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kMuon  );
-    if(Req(kITSnSigmaKao)) values[kITSnSigmaKao] = (fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kKaon  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kKaon  );
-    if(Req(kITSnSigmaPro)) values[kITSnSigmaPro] = (fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton) - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kProton)) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kProton);
+    if(ctx.Req(kITSnSigmaPio)) values[kITSnSigmaPio] = (ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kPion  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kPion  );
+    if(ctx.Req(kITSnSigmaMuo)) values[kITSnSigmaMuo] = (ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kMuon  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kMuon  );
+    if(ctx.Req(kITSnSigmaKao)) values[kITSnSigmaKao] = (ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon)   - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kKaon  )) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kKaon  );
+    if(ctx.Req(kITSnSigmaPro)) values[kITSnSigmaPro] = (ctx.fPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton) - AliDielectronPID::GetCntrdCorrITS(particle,AliPID::kProton)) / AliDielectronPID::GetWdthCorrITS(particle,AliPID::kProton);
 
-    if(Req(kTOFnSigmaEleRaw)) values[kTOFnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-    if(Req(kTOFnSigmaEle))    values[kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kElectron);
+    if(ctx.Req(kTOFnSigmaEleRaw)) values[kTOFnSigmaEleRaw]= ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
+    if(ctx.Req(kTOFnSigmaEle))    values[kTOFnSigmaEle]   =(ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kElectron)) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kElectron);
 
-    if(Req(kTOFnSigmaPio)) values[kTOFnSigmaPio] = (fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kPion  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kPion  );
-    if(Req(kTOFnSigmaMuo)) values[kTOFnSigmaMuo] = (fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kMuon  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kMuon  );
-    if(Req(kTOFnSigmaKao)) values[kTOFnSigmaKao] = (fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kKaon  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kKaon  );
-    if(Req(kTOFnSigmaPro)) values[kTOFnSigmaPro] = (fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton) - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kProton)) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kProton);
+    if(ctx.Req(kTOFnSigmaPio)) values[kTOFnSigmaPio] = (ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kPion  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kPion  );
+    if(ctx.Req(kTOFnSigmaMuo)) values[kTOFnSigmaMuo] = (ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kMuon  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kMuon  );
+    if(ctx.Req(kTOFnSigmaKao)) values[kTOFnSigmaKao] = (ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon)   - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kKaon  )) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kKaon  );
+    if(ctx.Req(kTOFnSigmaPro)) values[kTOFnSigmaPro] = (ctx.fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton) - AliDielectronPID::GetCntrdCorrTOF(particle,AliPID::kProton)) / AliDielectronPID::GetWdthCorrTOF(particle,AliPID::kProton);
 
     Double_t prob[AliPID::kSPECIES]={0.0};
     // switch computation off since it takes 70% of the CPU time for filling all AODtrack variables
     // TODO: find a solution when this is needed (maybe at fill time in histos, CFcontainer and cut selection)
     // 1D TRD PID
-    if( Req(kTRDprobEle) || Req(kTRDprobPio) ){
-      fgPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob);
+    if( ctx.Req(kTRDprobEle) || ctx.Req(kTRDprobPio) ){
+      ctx.fPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob);
       values[AliDielectronVarManager::kTRDprobEle]      = prob[AliPID::kElectron];
       values[AliDielectronVarManager::kTRDprobPio]      = prob[AliPID::kPion];
     }
     // 2D TRD PID
-    if( Req(kTRDprob2DEle) || Req(kTRDprob2DPio) || Req(kTRDprob2DPro) ){
-      fgPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob, AliTRDPIDResponse::kLQ2D);
+    if( ctx.Req(kTRDprob2DEle) || ctx.Req(kTRDprob2DPio) || ctx.Req(kTRDprob2DPro) ){
+      ctx.fPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob, AliTRDPIDResponse::kLQ2D);
       values[AliDielectronVarManager::kTRDprob2DEle]    = prob[AliPID::kElectron];
       values[AliDielectronVarManager::kTRDprob2DPio]    = prob[AliPID::kPion];
       values[AliDielectronVarManager::kTRDprob2DPro]    = prob[AliPID::kProton];
     }
     // 3D TRD PID
-     if( Req(kTRDprob3DEle) || Req(kTRDprob3DPio) || Req(kTRDprob3DPro) ){
-       fgPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ3D);
+     if( ctx.Req(kTRDprob3DEle) || ctx.Req(kTRDprob3DPio) || ctx.Req(kTRDprob3DPro) ){
+       ctx.fPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ3D);
        values[AliDielectronVarManager::kTRDprob3DEle]    = prob[AliPID::kElectron];
        values[AliDielectronVarManager::kTRDprob3DPio]    = prob[AliPID::kPion];
        values[AliDielectronVarManager::kTRDprob3DPro]    = prob[AliPID::kProton];
      }
     // 7D TRD PID
-     if( Req(kTRDprob7DEle) || Req(kTRDprob7DPio) || Req(kTRDprob7DPro) ){
-       fgPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob, AliTRDPIDResponse::kLQ7D);
+     if( ctx.Req(kTRDprob7DEle) || ctx.Req(kTRDprob7DPio) || ctx.Req(kTRDprob7DPro) ){
+       ctx.fPIDResponse->ComputeTRDProbability(particle, AliPID::kSPECIES, prob, AliTRDPIDResponse::kLQ7D);
        values[AliDielectronVarManager::kTRDprob7DEle]    = prob[AliPID::kElectron];
        values[AliDielectronVarManager::kTRDprob7DPio]    = prob[AliPID::kPion];
        values[AliDielectronVarManager::kTRDprob7DPro]    = prob[AliPID::kProton];
@@ -1571,9 +1615,9 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   Double_t eop=0;
   Double_t showershape[4]={0.,0.,0.,0.};
 //   if(Req()) values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
-  if(Req(kEMCALnSigmaEle) || Req(kEMCALE) || Req(kEMCALEoverP) ||
-     Req(kEMCALNCells) || Req(kEMCALM02) || Req(kEMCALM20) || Req(kEMCALDispersion))
-    values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
+  if(ctx.Req(kEMCALnSigmaEle) || ctx.Req(kEMCALE) || ctx.Req(kEMCALEoverP) ||
+     ctx.Req(kEMCALNCells) || ctx.Req(kEMCALM02) || ctx.Req(kEMCALM20) || ctx.Req(kEMCALDispersion))
+    values[AliDielectronVarManager::kEMCALnSigmaEle]  = ctx.fPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
   values[AliDielectronVarManager::kEMCALEoverP]     = eop;
   values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
   values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
@@ -1599,7 +1643,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
       // Int_t trkLbl = particle->GetLabel();
       // using the label this will potentially crash since the label can be out of range for aods
 
-      if (Req(kMCLegSource)){
+      if (ctx.Req(kMCLegSource)){
         values[AliDielectronVarManager::kMCLegSource] = 0;
         if (mc->CheckParticleSource(mcParticle, AliDielectronSignalMC::kPrimary)) values[AliDielectronVarManager::kMCLegSource] += 1;
         if (mc->CheckParticleSource(mcParticle, AliDielectronSignalMC::kFinalState)) values[AliDielectronVarManager::kMCLegSource] += 2;
@@ -1609,31 +1653,31 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
         if (mc->CheckParticleSource(mcParticle, AliDielectronSignalMC::kSecondaryFromMaterial)) values[AliDielectronVarManager::kMCLegSource] +=32;
       }
 
-      if (Req(kPdgCode))           values[AliDielectronVarManager::kPdgCode]           = mcParticle->PdgCode();
-      if (Req(kHasCocktailMother)) values[AliDielectronVarManager::kHasCocktailMother] = mc->CheckParticleSource(mcParticle, AliDielectronSignalMC::kDirect);
-      if (Req(kPdgCodeMother))     values[AliDielectronVarManager::kPdgCodeMother] = mc->GetMotherPDG(mcParticle);
-      if (Req(kPdgCodeGrandMother)){
+      if (ctx.Req(kPdgCode))           values[AliDielectronVarManager::kPdgCode]           = mcParticle->PdgCode();
+      if (ctx.Req(kHasCocktailMother)) values[AliDielectronVarManager::kHasCocktailMother] = mc->CheckParticleSource(mcParticle, AliDielectronSignalMC::kDirect);
+      if (ctx.Req(kPdgCodeMother))     values[AliDielectronVarManager::kPdgCodeMother] = mc->GetMotherPDG(mcParticle);
+      if (ctx.Req(kPdgCodeGrandMother)){
         AliAODMCParticle *motherMC = mc->GetMCTrackMother(mcParticle); //mother
         if(motherMC) values[AliDielectronVarManager::kPdgCodeGrandMother]=mc->GetMotherPDG(motherMC);
       }
     }
-    if (Req(kNumberOfDaughters)) values[AliDielectronVarManager::kNumberOfDaughters] = mc->NumberOfDaughters(mcParticle);
+    if (ctx.Req(kNumberOfDaughters)) values[AliDielectronVarManager::kNumberOfDaughters] = mc->NumberOfDaughters(mcParticle);
   } //if(mc->HasMC())
 
-  if(Req(kTOFPIDBit))     values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
+  if(ctx.Req(kTOFPIDBit))     values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
   values[AliDielectronVarManager::kLegEff]=0.0;
   values[AliDielectronVarManager::kOneOverLegEff]=0.0;
-  if(Req(kLegEff) || Req(kOneOverLegEff)) {
-    values[AliDielectronVarManager::kLegEff] = GetSingleLegEff(values);
+  if(ctx.Req(kLegEff) || ctx.Req(kOneOverLegEff)) {
+    values[AliDielectronVarManager::kLegEff] = GetSingleLegEff(values, ctx);
     values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
   }
 
   //fill info from AliVTrdTrack
-  if(Req(kTRDonlineA)||Req(kTRDonlineLayerMask)||Req(kTRDonlinePID)||Req(kTRDonlinePt)||Req(kTRDonlineStack)||Req(kTRDonlineSector)||Req(kTRDonlineTrackInTime)||Req(kTRDonlineFlagsTiming)||Req(kTRDonlineLabel)||Req(kTRDonlineNTracklets)||Req(kTRDonlineFirstLayer))
-    FillVarVTrdTrack(particle,values);
+  if(ctx.Req(kTRDonlineA)||ctx.Req(kTRDonlineLayerMask)||ctx.Req(kTRDonlinePID)||ctx.Req(kTRDonlinePt)||ctx.Req(kTRDonlineStack)||ctx.Req(kTRDonlineSector)||ctx.Req(kTRDonlineTrackInTime)||ctx.Req(kTRDonlineFlagsTiming)||ctx.Req(kTRDonlineLabel)||ctx.Req(kTRDonlineNTracklets)||ctx.Req(kTRDonlineFirstLayer))
+    FillVarVTrdTrack(particle,values, ctx);
 }
 
-inline void AliDielectronVarManager::FillVarVTrdTrack(const AliVParticle *particle, Double_t * const values)
+inline void AliDielectronVarManager::FillVarVTrdTrack(const AliVParticle *particle, Double_t * const values, const Context &ctx)
 {
 
 
@@ -1695,7 +1739,7 @@ inline void AliDielectronVarManager::FillVarVTrdTrack(const AliVParticle *partic
 
 }
 
-inline void AliDielectronVarManager::FillVarMCParticle(const AliMCParticle *particle, Double_t * const values)
+inline void AliDielectronVarManager::FillVarMCParticle(const AliMCParticle *particle, Double_t * const values, const Context &ctx)
 {
   //
   // Fill track information available for histogramming into an array
@@ -1744,10 +1788,10 @@ inline void AliDielectronVarManager::FillVarMCParticle(const AliMCParticle *part
   values[AliDielectronVarManager::kHasCocktailGrandMother]=0;
 
   // Fill common AliVParticle interface information
-  FillVarVParticle(particle, values);
+  FillVarVParticle(particle, values, ctx);
 
   // Fill distance of primary vertex to secondary vertex (as a well-defined alternative to the IP-approximation below)
-  if (Req(kDistPrimToSecVtxXYMC) || Req(kDistPrimToSecVtxZMC)) {
+  if (ctx.Req(kDistPrimToSecVtxXYMC) || ctx.Req(kDistPrimToSecVtxZMC)) {
     values[AliDielectronVarManager::kDistPrimToSecVtxXYMC] = TMath::Sqrt(  TMath::Power(particle->Xv() - values[AliDielectronVarManager::kXvPrim],2) + TMath::Power(particle->Yv() - values[AliDielectronVarManager::kYvPrim],2));
     values[AliDielectronVarManager::kDistPrimToSecVtxZMC] = TMath::Abs(particle->Zv() - values[AliDielectronVarManager::kZvPrim]);
   }
@@ -1779,7 +1823,7 @@ inline void AliDielectronVarManager::FillVarMCParticle(const AliMCParticle *part
 }
 
 
-inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1, const AliVParticle *p2, Double_t * const values) {
+inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1, const AliVParticle *p2, Double_t * const values, const Context &ctx) {
   //
   // fill 2 track information starting from MC legs
   //
@@ -1829,7 +1873,7 @@ inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1,
 
   values[AliDielectronVarManager::kPseudoProperTime] = -2e10;
   if(mother) {    // same mother
-    FillVarVParticle(mother, values);
+    FillVarVParticle(mother, values, ctx);
     Double_t vtxX, vtxY, vtxZ;
     mc->GetPrimaryVertex(vtxX,vtxY,vtxZ);
     Double_t lxy = ((mother->Xv()- vtxX) * mother->Px() +
@@ -1868,7 +1912,7 @@ inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1,
   //values[AliDielectronVarManager::kMMC] = values[AliDielectronVarManager::kM];
   //values[AliDielectronVarManager::kPtMC] = values[AliDielectronVarManager::kPt];
 
-  if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
+  if ( ctx.fEvent ) AliDielectronVarManager::Fill(ctx.fEvent, values, ctx);
 
   values[AliDielectronVarManager::kThetaHE]   = AliDielectronPair::ThetaPhiCM(p1,p2,kTRUE,  kTRUE);
   values[AliDielectronVarManager::kPhiHE]     = AliDielectronPair::ThetaPhiCM(p1,p2,kTRUE,  kFALSE);
@@ -1883,7 +1927,7 @@ inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1,
 }
 
 
-inline void AliDielectronVarManager::FillVarAODMCParticle(const AliAODMCParticle *particle, Double_t * const values)
+inline void AliDielectronVarManager::FillVarAODMCParticle(const AliAODMCParticle *particle, Double_t * const values, const Context &ctx)
 {
   //
   // Fill track information available for histogramming into an array
@@ -1927,7 +1971,7 @@ inline void AliDielectronVarManager::FillVarAODMCParticle(const AliAODMCParticle
   values[AliDielectronVarManager::kHasCocktailGrandMother]=0;
 
   // Fill common AliVParticle interface information
-  FillVarVParticle(particle, values);
+  FillVarVParticle(particle, values, ctx);
 
   // Fill AliAODMCParticle interface specific information
   AliDielectronMC *mc=AliDielectronMC::Instance();
@@ -1942,7 +1986,7 @@ inline void AliDielectronVarManager::FillVarAODMCParticle(const AliAODMCParticle
   values[AliDielectronVarManager::kNumberOfDaughters]=mc->NumberOfDaughters(particle);
 
   // using AODMCHEader information
-  AliAODMCHeader *mcHeader = (AliAODMCHeader*)fgEvent->FindListObject(AliAODMCHeader::StdBranchName());
+  AliAODMCHeader *mcHeader = (AliAODMCHeader*)ctx.fEvent->FindListObject(AliAODMCHeader::StdBranchName());
   if(mcHeader) {
     values[AliDielectronVarManager::kImpactParZ]  = mcHeader->GetVtxZ()-particle->Zv();
     values[AliDielectronVarManager::kImpactParXY] = TMath::Sqrt(TMath::Power(mcHeader->GetVtxX()-particle->Xv(),2) +
@@ -1951,7 +1995,7 @@ inline void AliDielectronVarManager::FillVarAODMCParticle(const AliAODMCParticle
 
 }
 
-inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPair *pair, Double_t * const values)
+inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPair *pair, Double_t * const values, const Context &ctx)
 {
   //
   // Fill pair information available for histogramming into an array
@@ -1965,7 +2009,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 
   Double_t errPseudoProperTime2 = -1;
   // Fill common AliVParticle interface information
-  FillVarVParticle(pair, values); // this also filles the event information into 'values'.
+  FillVarVParticle(pair, values, ctx); // this also filles the event information into 'values'.
 
   // Fill AliDielectronPair specific information
   const AliKFParticle &kfPair = pair->GetKFParticle();
@@ -1987,7 +2031,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   Double_t phiHE=0;
   Double_t thetaCS=0;
   Double_t phiCS=0;
-  if(Req(kThetaHE) || Req(kPhiHE) || Req(kThetaCS) || Req(kPhiCS)) {
+  if(ctx.Req(kThetaHE) || ctx.Req(kPhiHE) || ctx.Req(kThetaCS) || ctx.Req(kPhiCS)) {
     pair->GetThetaPhiCM(thetaHE,phiHE,thetaCS,phiCS);
 
     values[AliDielectronVarManager::kThetaHE]      = thetaHE;
@@ -2002,32 +2046,32 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     values[AliDielectronVarManager::kCosTilPhiCS]  = (thetaCS>0)?(TMath::Cos(phiCS-TMath::Pi()/4.)):(TMath::Cos(phiCS-3*TMath::Pi()/4.));
   }
 
-  if(Req(kChi2NDF))          values[AliDielectronVarManager::kChi2NDF]          = kfPair.GetChi2()/kfPair.GetNDF();
-  if(Req(kDecayLength))      values[AliDielectronVarManager::kDecayLength]      = kfPair.GetDecayLength();
-  if(Req(kR))                values[AliDielectronVarManager::kR]                = kfPair.GetR();
-  if(Req(kOpeningAngle))     values[AliDielectronVarManager::kOpeningAngle]     = pair->OpeningAngle();
-  if(Req(kOpeningAngleXY))     values[AliDielectronVarManager::kOpeningAngleXY] = pair->OpeningAngleXY();
-  if(Req(kOpeningAngleRZ))     values[AliDielectronVarManager::kOpeningAngleRZ] = pair->OpeningAngleRZ();
-  if(Req(kCosPointingAngle)) values[AliDielectronVarManager::kCosPointingAngle] = fgEvent ? pair->GetCosPointingAngle(fgEvent->GetPrimaryVertex()) : -1;
+  if(ctx.Req(kChi2NDF))          values[AliDielectronVarManager::kChi2NDF]          = kfPair.GetChi2()/kfPair.GetNDF();
+  if(ctx.Req(kDecayLength))      values[AliDielectronVarManager::kDecayLength]      = kfPair.GetDecayLength();
+  if(ctx.Req(kR))                values[AliDielectronVarManager::kR]                = kfPair.GetR();
+  if(ctx.Req(kOpeningAngle))     values[AliDielectronVarManager::kOpeningAngle]     = pair->OpeningAngle();
+  if(ctx.Req(kOpeningAngleXY))     values[AliDielectronVarManager::kOpeningAngleXY] = pair->OpeningAngleXY();
+  if(ctx.Req(kOpeningAngleRZ))     values[AliDielectronVarManager::kOpeningAngleRZ] = pair->OpeningAngleRZ();
+  if(ctx.Req(kCosPointingAngle)) values[AliDielectronVarManager::kCosPointingAngle] = ctx.fEvent ? pair->GetCosPointingAngle(ctx.fEvent->GetPrimaryVertex()) : -1;
 
-  if(Req(kLegDist))   values[AliDielectronVarManager::kLegDist]      = pair->DistanceDaughters();
-  if(Req(kLegDistXY)) values[AliDielectronVarManager::kLegDistXY]    = pair->DistanceDaughtersXY();
-  if(Req(kDeltaEta))  values[AliDielectronVarManager::kDeltaEta]     = pair->DeltaEta();
-  if(Req(kDeltaPhi))  values[AliDielectronVarManager::kDeltaPhi]     = pair->DeltaPhi();
-  if(Req(kMerr))      values[AliDielectronVarManager::kMerr]         = kfPair.GetErrMass()>1e-30&&kfPair.GetMass()>1e-30?kfPair.GetErrMass()/kfPair.GetMass():1000000;
+  if(ctx.Req(kLegDist))   values[AliDielectronVarManager::kLegDist]      = pair->DistanceDaughters();
+  if(ctx.Req(kLegDistXY)) values[AliDielectronVarManager::kLegDistXY]    = pair->DistanceDaughtersXY();
+  if(ctx.Req(kDeltaEta))  values[AliDielectronVarManager::kDeltaEta]     = pair->DeltaEta();
+  if(ctx.Req(kDeltaPhi))  values[AliDielectronVarManager::kDeltaPhi]     = pair->DeltaPhi();
+  if(ctx.Req(kMerr))      values[AliDielectronVarManager::kMerr]         = kfPair.GetErrMass()>1e-30&&kfPair.GetMass()>1e-30?kfPair.GetErrMass()/kfPair.GetMass():1000000;
 
   values[AliDielectronVarManager::kPairType]     = pair->GetType();
   // Armenteros-Podolanski quantities
-  if(Req(kArmAlpha)) values[AliDielectronVarManager::kArmAlpha]     = pair->GetArmAlpha();
-  if(Req(kArmPt))    values[AliDielectronVarManager::kArmPt]        = pair->GetArmPt();
+  if(ctx.Req(kArmAlpha)) values[AliDielectronVarManager::kArmAlpha]     = pair->GetArmAlpha();
+  if(ctx.Req(kArmPt))    values[AliDielectronVarManager::kArmPt]        = pair->GetArmPt();
 
-  if(Req(kPsiPair))  values[AliDielectronVarManager::kPsiPair]      = fgEvent ? pair->PsiPair(fgEvent->GetMagneticField()) : -5;
-  if(Req(kPhivPair)) values[AliDielectronVarManager::kPhivPair]     = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) : -5;
+  if(ctx.Req(kPsiPair))  values[AliDielectronVarManager::kPsiPair]      = ctx.fEvent ? pair->PsiPair(ctx.fEvent->GetMagneticField()) : -5;
+  if(ctx.Req(kPhivPair)) values[AliDielectronVarManager::kPhivPair]     = ctx.fEvent ? pair->PhivPair(ctx.fEvent->GetMagneticField()) : -5;
   
   values[AliDielectronVarManager::kDeltaPhiSumDiff]=-999; 
   values[AliDielectronVarManager::kDeltaPhiSumPos]=-999; 
   values[AliDielectronVarManager::kDeltaPhiSumNeg]=-999; 
-  if(Req(kDeltaPhiSumDiff)||Req(kDeltaPhiSumPos)||Req(kDeltaPhiSumNeg)){
+  if(ctx.Req(kDeltaPhiSumDiff)||ctx.Req(kDeltaPhiSumPos)||ctx.Req(kDeltaPhiSumNeg)){
     // get track references from pair
     AliVParticle* d1 = pair->GetFirstDaughterP();
     AliVParticle* d2 = pair->GetSecondDaughterP();
@@ -2070,7 +2114,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   } 
     
   values[AliDielectronVarManager::kITSscPair]   = -999;
-  if(Req(kITSscPair)) {
+  if(ctx.Req(kITSscPair)) {
 
     // get track references from pair
     AliVParticle* d1 = pair-> GetFirstDaughterP();
@@ -2112,18 +2156,18 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     }
   }
 
-  if(Req(kDeltaCotTheta)) values[kDeltaCotTheta] =  pair->DeltaCotTheta();
-  if(Req(kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) - 21. * pair->M() : -999.;
-  if(Req(kPseudoProperTime) || Req(kPseudoProperTimeErr)) {
+  if(ctx.Req(kDeltaCotTheta)) values[kDeltaCotTheta] =  pair->DeltaCotTheta();
+  if(ctx.Req(kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = ctx.fEvent ? pair->PhivPair(ctx.fEvent->GetMagneticField()) - 21. * pair->M() : -999.;
+  if(ctx.Req(kPseudoProperTime) || ctx.Req(kPseudoProperTimeErr)) {
     values[AliDielectronVarManager::kPseudoProperTime] =
-      fgEvent ? kfPair.GetPseudoProperDecayTime(*(fgEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
+      ctx.fEvent ? kfPair.GetPseudoProperDecayTime(*(ctx.fEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
       // values[AliDielectronVarManager::kPseudoProperTime] = fgEvent ? pair->GetPseudoProperTime(fgEvent->GetPrimaryVertex()): -1e10;
     values[AliDielectronVarManager::kPseudoProperTimeErr] = (errPseudoProperTime2 > 0) ? TMath::Sqrt(errPseudoProperTime2) : -1e10;
   }
 
   // impact parameter
   Double_t d0z0[2]={-999., -999.};
-  if( (Req(kImpactParXY) || Req(kImpactParZ)) && fgEvent) pair->GetDCA(fgEvent->GetPrimaryVertex(), d0z0);
+  if( (ctx.Req(kImpactParXY) || ctx.Req(kImpactParZ)) && ctx.fEvent) pair->GetDCA(ctx.fEvent->GetPrimaryVertex(), d0z0);
   values[AliDielectronVarManager::kImpactParXY]   = d0z0[0];
   values[AliDielectronVarManager::kImpactParZ]    = d0z0[1];
 
@@ -2151,9 +2195,9 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   values[AliDielectronVarManager::kLeg2DCAresXY]     = -999.;
 
   // check if calculation is requested
-  if( Req(kPairDCAsigXY) || Req(kPairDCAsigZ) || Req(kPairDCAabsXY) || Req(kPairDCAabsZ) ||
-      Req(kPairLinDCAsigXY) || Req(kPairLinDCAsigZ) || Req(kPairLinDCAabsXY) || Req(kPairLinDCAabsZ) ||
-      Req(kPairDCAsigXYZ) || Req(kPairDCAabsXYZ) )
+  if( ctx.Req(kPairDCAsigXY) || ctx.Req(kPairDCAsigZ) || ctx.Req(kPairDCAabsXY) || ctx.Req(kPairDCAabsZ) ||
+      ctx.Req(kPairLinDCAsigXY) || ctx.Req(kPairLinDCAsigZ) || ctx.Req(kPairLinDCAabsXY) || ctx.Req(kPairLinDCAabsZ) ||
+      ctx.Req(kPairDCAsigXYZ) || ctx.Req(kPairDCAabsXYZ) )
      {
     // get track references from pair
     AliVParticle* d1 = pair-> GetFirstDaughterP();
@@ -2194,8 +2238,8 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
           //static_cast<AliESDtrack*>(d2)->GetImpactParametersTPC(dcaTPC2, dcaResTPC2);
         }
         else { // AOD
-          GetDCA(static_cast<AliAODTrack*>(d1), dca1, dcaRes1);
-          GetDCA(static_cast<AliAODTrack*>(d2), dca2, dcaRes2);
+          GetDCA(static_cast<AliAODTrack*>(d1), dca1, dcaRes1, ctx);
+          GetDCA(static_cast<AliAODTrack*>(d2), dca2, dcaRes2, ctx);
         }
 
         // compute normalized DCAs
@@ -2331,11 +2375,11 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   	values[AliDielectronVarManager::kDeltaEta]     = TMath::Abs(feta1 -feta2 );
   	values[AliDielectronVarManager::kDeltaPhi]     = lv1.DeltaPhi(lv2);
 
-         if( Req(kDeltaPhiChargeOrdered) && fgEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * fgEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
+         if( ctx.Req(kDeltaPhiChargeOrdered) && ctx.fEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * ctx.fEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
   	values[AliDielectronVarManager::kPairType]     = pair->GetType();
 
           // Calculate pair variables for corresponding generated pair
-          if(AliDielectronMC::Instance()->HasMC() && (Req(kMMC)||Req(kPtMC)||Req(kPMC)||Req(kEtaMC)||Req(kPhiMC))){
+          if(AliDielectronMC::Instance()->HasMC() && (ctx.Req(kMMC)||ctx.Req(kPtMC)||ctx.Req(kPMC)||ctx.Req(kEtaMC)||ctx.Req(kPhiMC))){
             values[AliDielectronVarManager::kMMC]   = -999.;
             values[AliDielectronVarManager::kPtMC]  = -999.;
             values[AliDielectronVarManager::kPMC]   = -999.;
@@ -2385,14 +2429,14 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 
   	 */
 
-      if(Req(kOpeningAngleCorr)) {
+      if(ctx.Req(kOpeningAngleCorr)) {
         Float_t a = 1.54e-01;
         values[AliDielectronVarManager::kOpeningAngleCorr]  =
           values[AliDielectronVarManager::kOpeningAngle]
           - a * TMath::Sqrt(  values[AliDielectronVarManager::kPairDCAabsXY] * values[AliDielectronVarManager::kOneOverPt] );
       }
 
-      if(Req(kMCorr)) {
+      if(ctx.Req(kMCorr)) {
         Float_t a =  7.59e-02;
         values[AliDielectronVarManager::kMCorr]  =
           values[AliDielectronVarManager::kM]
@@ -2404,8 +2448,8 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 
   // Flow quantities
   Double_t phi=values[AliDielectronVarManager::kPhi];
-  if(Req(kCosPhiH2)) values[AliDielectronVarManager::kCosPhiH2] = TMath::Cos(2*phi);
-  if(Req(kSinPhiH2)) values[AliDielectronVarManager::kSinPhiH2] = TMath::Sin(2*phi);
+  if(ctx.Req(kCosPhiH2)) values[AliDielectronVarManager::kCosPhiH2] = TMath::Cos(2*phi);
+  if(ctx.Req(kSinPhiH2)) values[AliDielectronVarManager::kSinPhiH2] = TMath::Sin(2*phi);
   // Double_t delta=0.0;
 
   // v2 calculation variables with eventplane estimators from run1 commented out to reduce the memory usage
@@ -2484,45 +2528,45 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
       }
     }
 
-  if(Req(kQnDeltaPhiTPCrpH2) || Req(kQnTPCrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiTPCrpH2]  = TVector2::Phi_mpi_pi(phi - qnTPCeventplane);
-  if(Req(kQnDeltaPhiV0ArpH2) || Req(kQnV0ArpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0ArpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0ArpH2]);
-  if(Req(kQnDeltaPhiV0CrpH2) || Req(kQnV0CrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0CrpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0CrpH2]);
-  if(Req(kQnDeltaPhiV0rpH2) || Req(kQnV0rpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0rpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0rpH2]);
-  if(Req(kQnDeltaPhiSPDrpH2) || Req(kQnSPDrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiSPDrpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnSPDrpH2]);
-  if(Req(kQnTPCrpH2FlowV2)) values[AliDielectronVarManager::kQnTPCrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiTPCrpH2] );
-  if(Req(kQnV0ArpH2FlowV2)) values[AliDielectronVarManager::kQnV0ArpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0ArpH2] );
-  if(Req(kQnV0CrpH2FlowV2)) values[AliDielectronVarManager::kQnV0CrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0CrpH2] );
-  if(Req(kQnV0rpH2FlowV2)) values[AliDielectronVarManager::kQnV0rpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0rpH2] );
-  if(Req(kQnSPDrpH2FlowV2)) values[AliDielectronVarManager::kQnSPDrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiSPDrpH2] );
+  if(ctx.Req(kQnDeltaPhiTPCrpH2) || ctx.Req(kQnTPCrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiTPCrpH2]  = TVector2::Phi_mpi_pi(phi - qnTPCeventplane);
+  if(ctx.Req(kQnDeltaPhiV0ArpH2) || ctx.Req(kQnV0ArpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0ArpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0ArpH2]);
+  if(ctx.Req(kQnDeltaPhiV0CrpH2) || ctx.Req(kQnV0CrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0CrpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0CrpH2]);
+  if(ctx.Req(kQnDeltaPhiV0rpH2) || ctx.Req(kQnV0rpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0rpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0rpH2]);
+  if(ctx.Req(kQnDeltaPhiSPDrpH2) || ctx.Req(kQnSPDrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiSPDrpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnSPDrpH2]);
+  if(ctx.Req(kQnTPCrpH2FlowV2)) values[AliDielectronVarManager::kQnTPCrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiTPCrpH2] );
+  if(ctx.Req(kQnV0ArpH2FlowV2)) values[AliDielectronVarManager::kQnV0ArpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0ArpH2] );
+  if(ctx.Req(kQnV0CrpH2FlowV2)) values[AliDielectronVarManager::kQnV0CrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0CrpH2] );
+  if(ctx.Req(kQnV0rpH2FlowV2)) values[AliDielectronVarManager::kQnV0rpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0rpH2] );
+  if(ctx.Req(kQnSPDrpH2FlowV2)) values[AliDielectronVarManager::kQnSPDrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiSPDrpH2] );
 
   // Eventplane Scalar-Product Second Harmonic
   Int_t harmonic = 2;
   TVector2 uDielectronSP( cos( harmonic * phi ), sin( harmonic * phi )); //Unitary Q vector of the dielectron pair
 
-  if(Req(kQnTPCrpH2FlowSPV2)){
+  if(ctx.Req(kQnTPCrpH2FlowSPV2)){
     TVector2 qVec2tpcACCorrected; qVec2tpcACCorrected.SetMagPhi(1,qnTPCeventplane); //Unitary Q vector from TPC
     values[AliDielectronVarManager::kQnTPCrpH2FlowSPV2]    = uDielectronSP * qVec2tpcACCorrected;
   }
-  if(Req(kQnV0ArpH2FlowSPV2)){
+  if(ctx.Req(kQnV0ArpH2FlowSPV2)){
     TVector2 qVec2V0A;
     qVec2V0A.Set(values[AliDielectronVarManager::kQnV0AxH2], values[AliDielectronVarManager::kQnV0AyH2]); //Unitary Q vector from V0A
     values[AliDielectronVarManager::kQnV0ArpH2FlowSPV2]    = uDielectronSP * qVec2V0A;
   }
-  if(Req(kQnV0CrpH2FlowSPV2)){
+  if(ctx.Req(kQnV0CrpH2FlowSPV2)){
     TVector2 qVec2V0C; qVec2V0C.Set(values[AliDielectronVarManager::kQnV0CxH2], values[AliDielectronVarManager::kQnV0CyH2]); //Unitary Q vector from V0C
     values[AliDielectronVarManager::kQnV0CrpH2FlowSPV2]    = uDielectronSP * qVec2V0C;
   }
-  if(Req(kQnV0rpH2FlowSPV2)){
+  if(ctx.Req(kQnV0rpH2FlowSPV2)){
     TVector2 qVec2V0; qVec2V0.Set(values[AliDielectronVarManager::kQnV0xH2], values[AliDielectronVarManager::kQnV0yH2]);     //Unitary Q vector from V0
     values[AliDielectronVarManager::kQnV0rpH2FlowSPV2]      = uDielectronSP * qVec2V0;
   }
-  if(Req(kQnSPDrpH2FlowSPV2)){
+  if(ctx.Req(kQnSPDrpH2FlowSPV2)){
     TVector2 qVec2SPD; qVec2SPD.Set(values[AliDielectronVarManager::kQnSPDxH2], values[AliDielectronVarManager::kQnSPDyH2]);     //Unitary Q vector from SPD
     values[AliDielectronVarManager::kQnSPDrpH2FlowSPV2]    = uDielectronSP * qVec2SPD;
   }
 
   // calculate inner Product of strong magnetic field (from ZDC 1st order event plane, correction framework) and ee plane
-  if(Req(kPairPlaneMagInProZDC)) values[AliDielectronVarManager::kPairPlaneMagInProZDC] = pair->PairPlaneMagInnerProduct(values[AliDielectronVarManager::kQnZDCCrpH1]);
+  if(ctx.Req(kPairPlaneMagInProZDC)) values[AliDielectronVarManager::kPairPlaneMagInProZDC] = pair->PairPlaneMagInnerProduct(values[AliDielectronVarManager::kQnZDCCrpH1]);
 
 
 
@@ -2537,15 +2581,15 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     // fill kPseudoProperTimeResolution
     values[AliDielectronVarManager::kPseudoProperTimeResolution] = -1e10;
     // values[AliDielectronVarManager::kPseudoProperTimePull] = -1e10;
-    if(samemother && fgEvent) {
+    if(samemother && ctx.fEvent) {
       if(pair->GetFirstDaughterP()->GetLabel() > 0) {
         const AliVParticle *motherMC = 0x0;
         Int_t motherLbl = 0;
-        if(fgEvent->IsA() == AliESDEvent::Class()){
+        if(ctx.fEvent->IsA() == AliESDEvent::Class()){
           motherMC = (AliMCParticle*) mc->GetMCTrackMother((AliESDtrack*) pair->GetFirstDaughterP());
           motherLbl = motherMC->GetLabel();
         }
-        else if(fgEvent->IsA() == AliAODEvent::Class()){
+        else if(ctx.fEvent->IsA() == AliAODEvent::Class()){
           motherMC = (AliAODMCParticle*) mc->GetMCTrackMother((AliAODTrack*) pair->GetFirstDaughterP());
           AliAODMCParticle *daughterMC = (AliAODMCParticle*) mc->GetMCTrack(pair->GetFirstDaughterP());
           motherLbl = daughterMC->GetMother();
@@ -2570,8 +2614,8 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 	  AliVParticle* leg1 = pair->GetFirstDaughterP();
 	  AliVParticle* leg2 = pair->GetSecondDaughterP();
 	  if (leg1 && leg2){
-		Fill(leg1, valuesLeg1);
-		Fill(leg2, valuesLeg2);
+		Fill(leg1, valuesLeg1, ctx);
+		Fill(leg2, valuesLeg2, ctx);
 		values[AliDielectronVarManager::kTRDpidEffPair] = valuesLeg1[AliDielectronVarManager::kTRDpidEffLeg]*valuesLeg2[AliDielectronVarManager::kTRDpidEffLeg];
 	  }
 	}
@@ -2595,23 +2639,25 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   values[AliDielectronVarManager::kPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEffSq]=0.0;
-  if (leg1 && leg2 && fgLegEffMap) {
-    Fill(leg1, valuesLeg1);
-    Fill(leg2, valuesLeg2);
+  // the legs are filled completely, only do it if the efficiency is requested
+  const Bool_t reqPairEff = ctx.Req(kPairEff) || ctx.Req(kOneOverPairEff) || ctx.Req(kOneOverPairEffSq);
+  if (reqPairEff && leg1 && leg2 && ctx.fLegEffMap) {
+    Fill(leg1, valuesLeg1, ctx);
+    Fill(leg2, valuesLeg2, ctx);
     values[AliDielectronVarManager::kPairEff] = valuesLeg1[AliDielectronVarManager::kLegEff] *valuesLeg2[AliDielectronVarManager::kLegEff];
   }
-  else if(fgPairEffMap) {
-    values[AliDielectronVarManager::kPairEff] = GetPairEff(values);
+  else if(reqPairEff && ctx.fPairEffMap) {
+    values[AliDielectronVarManager::kPairEff] = GetPairEff(values, ctx);
   }
-  if(fgLegEffMap || fgPairEffMap) {
+  if(reqPairEff && (ctx.fLegEffMap || ctx.fPairEffMap)) {
     values[AliDielectronVarManager::kOneOverPairEff] = (values[AliDielectronVarManager::kPairEff]>0.0 ? 1./values[AliDielectronVarManager::kPairEff] : 1.0);
     values[AliDielectronVarManager::kOneOverPairEffSq] = (values[AliDielectronVarManager::kPairEff]>0.0 ? 1./values[AliDielectronVarManager::kPairEff]/values[AliDielectronVarManager::kPairEff] : 1.0);
   }
 
-  if(Req(kRndmPair)) values[AliDielectronVarManager::kRndmPair] = gRandom->Rndm();
+  if(ctx.Req(kRndmPair)) values[AliDielectronVarManager::kRndmPair] = gRandom->Rndm();
 } // end FillVarDielectronPair
 
-inline void AliDielectronVarManager::FillVarKFParticle(const AliKFParticle *particle, Double_t * const values)
+inline void AliDielectronVarManager::FillVarKFParticle(const AliKFParticle *particle, Double_t * const values, const Context &ctx)
 {
   //
   // Fill track information available in AliVParticle into an array
@@ -2678,11 +2724,11 @@ inline void AliDielectronVarManager::FillVarKFParticle(const AliKFParticle *part
 
 //   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
   for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+    values[i]=ctx.fData[i];
 
 }
 
-inline void AliDielectronVarManager::FillVarVEvent(const AliVEvent *event, Double_t * const values)
+inline void AliDielectronVarManager::FillVarVEvent(const AliVEvent *event, Double_t * const values, const Context &ctx)
 {
   //
   // Fill event information available for histogramming into an array
@@ -2803,44 +2849,44 @@ inline void AliDielectronVarManager::FillVarVEvent(const AliVEvent *event, Doubl
   values[AliDielectronVarManager::kNSDDSSDclsEvent] = values[AliDielectronVarManager::kNSDDclsEvent] + values[AliDielectronVarManager::kNSSDclsEvent];
 
   values[AliDielectronVarManager::kNTrk]            = event->GetNumberOfTracks();
-  if(Req(kNacc))            values[AliDielectronVarManager::kNacc]            = AliDielectronHelper::GetNacc(event);
+  if(ctx.Req(kNacc))            values[AliDielectronVarManager::kNacc]            = AliDielectronHelper::GetNacc(event);
 
-  if(Req(kTransverseSpherocity))     values[AliDielectronVarManager::kTransverseSpherocity] = AliDielectronHelper::GetTransverseSpherocity(event);
-  if(Req(kTransverseSpherocityFast)) values[AliDielectronVarManager::kTransverseSpherocityFast] = AliDielectronHelper::GetTransverseSpherocityTracks(event);
+  if(ctx.Req(kTransverseSpherocity))     values[AliDielectronVarManager::kTransverseSpherocity] = AliDielectronHelper::GetTransverseSpherocity(event);
+  if(ctx.Req(kTransverseSpherocityFast)) values[AliDielectronVarManager::kTransverseSpherocityFast] = AliDielectronHelper::GetTransverseSpherocityTracks(event);
 
-  if(Req(kMatchEffITSTPCinPlane) || Req(kMatchEffITSTPCoutPlane)){
+  if(ctx.Req(kMatchEffITSTPCinPlane) || ctx.Req(kMatchEffITSTPCoutPlane)){
 
     Double_t efficiencies[2] = {-1.};
     values[AliDielectronVarManager::kMatchEffITSTPC]  = AliDielectronHelper::GetITSTPCMatchEff(event, efficiencies, kTRUE);
     values[AliDielectronVarManager::kMatchEffITSTPCinPlane]  = efficiencies[0];
     values[AliDielectronVarManager::kMatchEffITSTPCoutPlane]  = efficiencies[1];
   }
-  if(Req(kMatchEffITSTPCinPlaneV0C) || Req(kMatchEffITSTPCoutPlaneV0C)){
+  if(ctx.Req(kMatchEffITSTPCinPlaneV0C) || ctx.Req(kMatchEffITSTPCoutPlaneV0C)){
 
     Double_t efficiencies[2] = {-1.};
     values[AliDielectronVarManager::kMatchEffITSTPC]  = AliDielectronHelper::GetITSTPCMatchEff(event, efficiencies, kTRUE, kTRUE);
     values[AliDielectronVarManager::kMatchEffITSTPCinPlaneV0C]  = efficiencies[0];
     values[AliDielectronVarManager::kMatchEffITSTPCoutPlaneV0C]  = efficiencies[1];
   }
-  else if(Req(kMatchEffITSTPC))  values[AliDielectronVarManager::kMatchEffITSTPC]  = AliDielectronHelper::GetITSTPCMatchEff(event);
-  if(Req(kNaccTrcklts) || Req(kNaccTrckltsCorr))  values[AliDielectronVarManager::kNaccTrcklts]     = AliDielectronHelper::GetNaccTrcklts(event,1.6);
-  if(Req(kNaccTrcklts09))
+  else if(ctx.Req(kMatchEffITSTPC))  values[AliDielectronVarManager::kMatchEffITSTPC]  = AliDielectronHelper::GetITSTPCMatchEff(event);
+  if(ctx.Req(kNaccTrcklts) || ctx.Req(kNaccTrckltsCorr))  values[AliDielectronVarManager::kNaccTrcklts]     = AliDielectronHelper::GetNaccTrcklts(event,1.6);
+  if(ctx.Req(kNaccTrcklts09))
       values[AliDielectronVarManager::kNaccTrcklts09]     = AliDielectronHelper::GetNaccTrcklts(event,0.9);
-  if(Req(kNaccTrcklts10) || Req(kNaccTrcklts10Corr))
+  if(ctx.Req(kNaccTrcklts10) || ctx.Req(kNaccTrcklts10Corr))
     values[AliDielectronVarManager::kNaccTrcklts10]   = AliDielectronHelper::GetNaccTrcklts(event,1.0);
-  if(Req(kNaccTrcklts0916))
+  if(ctx.Req(kNaccTrcklts0916))
     values[AliDielectronVarManager::kNaccTrcklts0916] = AliDielectronHelper::GetNaccTrcklts(event,1.6)-AliDielectronHelper::GetNaccTrcklts(event,.9);
-  if(Req(kNaccTrckltsCorr))
+  if(ctx.Req(kNaccTrckltsCorr))
   values[AliDielectronVarManager::kNaccTrckltsCorr] =
     AliDielectronHelper::GetNaccTrckltsCorrected(event, values[AliDielectronVarManager::kNaccTrcklts],
 						 values[AliDielectronVarManager::kZvPrim],2);
-  if(Req(kNaccTrcklts10Corr))
+  if(ctx.Req(kNaccTrcklts10Corr))
   values[AliDielectronVarManager::kNaccTrcklts10Corr] =
     AliDielectronHelper::GetNaccTrckltsCorrected(event, values[AliDielectronVarManager::kNaccTrcklts10],
 						 values[AliDielectronVarManager::kZvPrim],1);
 
   Double_t ptMaxEv    = -1., phiptMaxEv= -1.;
-  if(Req(kMaxPt) || Req(kPhiMaxPt)) AliDielectronHelper::GetMaxPtAndPhi(event, ptMaxEv, phiptMaxEv);
+  if(ctx.Req(kMaxPt) || ctx.Req(kPhiMaxPt)) AliDielectronHelper::GetMaxPtAndPhi(event, ptMaxEv, phiptMaxEv);
   values[AliDielectronVarManager::kPhiMaxPt]          = phiptMaxEv;
   values[AliDielectronVarManager::kMaxPt]             = ptMaxEv;
 
@@ -3039,14 +3085,14 @@ inline void AliDielectronVarManager::FillVarVEvent(const AliVEvent *event, Doubl
 
 }
 
-inline void AliDielectronVarManager::FillVarESDEvent(const AliESDEvent *event, Double_t * const values)
+inline void AliDielectronVarManager::FillVarESDEvent(const AliESDEvent *event, Double_t * const values, const Context &ctx)
 {
   //
   // Fill event information available for histogramming into an array
   //
 
   // Fill common AliVEvent interface information
-  FillVarVEvent(event, values);
+  FillVarVEvent(event, values, ctx);
 
   // Centrality Run1
   Double_t centralityF=-1;
@@ -3076,20 +3122,20 @@ inline void AliDielectronVarManager::FillVarESDEvent(const AliESDEvent *event, D
   values[AliDielectronVarManager::kCentralityZNA] = centralityZNA;
 
   values[AliDielectronVarManager::kTransverseSpherocityESD] = -1.;
-  if(Req(kTransverseSpherocityESD)) values[AliDielectronVarManager::kTransverseSpherocityESD] = AliDielectronHelper::GetTransverseSpherocityESD(event);
+  if(ctx.Req(kTransverseSpherocityESD)) values[AliDielectronVarManager::kTransverseSpherocityESD] = AliDielectronHelper::GetTransverseSpherocityESD(event);
   values[AliDielectronVarManager::kTransverseSpherocityFastESD] = -1.;
-  if(Req(kTransverseSpherocityFastESD)) values[AliDielectronVarManager::kTransverseSpherocityFastESD] = AliDielectronHelper::GetTransverseSpherocityESDtracks(event);
+  if(ctx.Req(kTransverseSpherocityFastESD)) values[AliDielectronVarManager::kTransverseSpherocityFastESD] = AliDielectronHelper::GetTransverseSpherocityESDtracks(event);
   values[AliDielectronVarManager::kTransverseSpherocityESDwoPtWeight] = -1.;
-  if(Req(kTransverseSpherocityESDwoPtWeight)) values[AliDielectronVarManager::kTransverseSpherocityESDwoPtWeight] = AliDielectronHelper::GetTransverseSpherocityESDwoPtWeight(event);
+  if(ctx.Req(kTransverseSpherocityESDwoPtWeight)) values[AliDielectronVarManager::kTransverseSpherocityESDwoPtWeight] = AliDielectronHelper::GetTransverseSpherocityESDwoPtWeight(event);
   values[AliDielectronVarManager::kTransverseSpherocityFastESDwoPtWeight] = -1.;
-  if(Req(kTransverseSpherocityFastESDwoPtWeight)) values[AliDielectronVarManager::kTransverseSpherocityFastESDwoPtWeight] = AliDielectronHelper::GetTransverseSpherocityESDtracksWoPtWeight(event);
+  if(ctx.Req(kTransverseSpherocityFastESDwoPtWeight)) values[AliDielectronVarManager::kTransverseSpherocityFastESDwoPtWeight] = AliDielectronHelper::GetTransverseSpherocityESDtracksWoPtWeight(event);
 
   const AliESDVertex *vtxTPC = event->GetPrimaryVertexTPC();
   values[AliDielectronVarManager::kNVtxContribTPC] = (vtxTPC ? vtxTPC->GetNContributors() : 0);
 
   // The true vertex is needed for the pair DCA analysis (needs DCA of reco track w.r.t. true vertex).
   if (AliDielectronMC::Instance()->HasMC()){
-    if (Req(kDistPrimToSecVtxXYMC) || Req(kDistPrimToSecVtxZMC) || Req(kXvPrimMCtruth) || Req(kYvPrimMCtruth) || Req(kZvPrimMCtruth)) {
+    if (ctx.Req(kDistPrimToSecVtxXYMC) || ctx.Req(kDistPrimToSecVtxZMC) || ctx.Req(kXvPrimMCtruth) || ctx.Req(kYvPrimMCtruth) || ctx.Req(kZvPrimMCtruth)) {
       AliMCEvent* mcevent = AliDielectronMC::Instance()->GetMCEvent();
       const AliVVertex* mcvtx = (mcevent ? mcevent->GetPrimaryVertex() : 0);
       values[AliDielectronVarManager::kXvPrimMCtruth] = (mcvtx ? mcvtx->GetX() : 0.0);
@@ -3157,14 +3203,14 @@ inline void AliDielectronVarManager::FillVarESDEvent(const AliESDEvent *event, D
 
 }
 
-inline void AliDielectronVarManager::FillVarAODEvent(const AliAODEvent *event, Double_t * const values)
+inline void AliDielectronVarManager::FillVarAODEvent(const AliAODEvent *event, Double_t * const values, const Context &ctx)
 {
   //
   // Fill event information available for histogramming into an array
   //
 
   // Fill common AliVEvent interface information
-  FillVarVEvent(event, values);
+  FillVarVEvent(event, values, ctx);
 
   // Fill AliAODEvent interface specific information
   AliAODHeader *header = dynamic_cast<AliAODHeader*>(event->GetHeader());
@@ -3202,13 +3248,13 @@ inline void AliDielectronVarManager::FillVarAODEvent(const AliAODEvent *event, D
 
   values[AliDielectronVarManager::kRefMult]        = header->GetRefMultiplicity();        // similar to Ntrk
   values[AliDielectronVarManager::kRefMultTPConly] = header->GetTPConlyRefMultiplicity(); // similar to Nacc
-  if(Req(kNTPCtrkswITSout)) values[AliDielectronVarManager::kNTPCtrkswITSout] = header->GetNumberOfTPCTracks();
-  if(Req(kNTPCclsEvent)) values[AliDielectronVarManager::kNTPCclsEvent] = header->GetNumberOfTPCClusters();
+  if(ctx.Req(kNTPCtrkswITSout)) values[AliDielectronVarManager::kNTPCtrkswITSout] = header->GetNumberOfTPCTracks();
+  if(ctx.Req(kNTPCclsEvent)) values[AliDielectronVarManager::kNTPCclsEvent] = header->GetNumberOfTPCClusters();
   values[AliDielectronVarManager::kRefMultOvRefMultTPConly] = (values[AliDielectronVarManager::kRefMultTPConly] > 0. ? (values[AliDielectronVarManager::kRefMult]/values[AliDielectronVarManager::kRefMultTPConly]) : 0.);
 
   // The true vertex is needed for the pair DCA analysis (needs DCA of reco track w.r.t. true vertex).
   if (AliDielectronMC::Instance()->HasMC()){
-    if (Req(kDistPrimToSecVtxXYMC) || Req(kDistPrimToSecVtxZMC) || Req(kXvPrimMCtruth) || Req(kYvPrimMCtruth) || Req(kZvPrimMCtruth)) {
+    if (ctx.Req(kDistPrimToSecVtxXYMC) || ctx.Req(kDistPrimToSecVtxZMC) || ctx.Req(kXvPrimMCtruth) || ctx.Req(kYvPrimMCtruth) || ctx.Req(kZvPrimMCtruth)) {
       // @TODO: adopt the code from FillVarESDEvent() for AOD...
       printf("WARNING: filling of MC true vertex not implemented for AOD tracks!\n");
       values[AliDielectronVarManager::kXvPrimMCtruth] = 0.;
@@ -3233,7 +3279,7 @@ inline void AliDielectronVarManager::FillVarAODEvent(const AliAODEvent *event, D
     // TPC
 
     TList *qnlist = (TList*) event->FindListObject("qnVectorList");
-    if((Req(kQnTPCrpH2) || Req(kQnV0rpH2)) && qnlist == NULL){
+    if((ctx.Req(kQnTPCrpH2) || ctx.Req(kQnV0rpH2)) && qnlist == NULL){
       for (Int_t i = AliDielectronVarManager::kQnTPCrpH2; i <= AliDielectronVarManager::kQnCorrFMDAy_FMDCy; i++) {
         values[i] = -999.;
       }
@@ -3306,7 +3352,7 @@ inline void AliDielectronVarManager::FillVarAODEvent(const AliAODEvent *event, D
 
 }
 
-inline void AliDielectronVarManager::FillVarMCEvent(const AliMCEvent *event, Double_t * const values)
+inline void AliDielectronVarManager::FillVarMCEvent(const AliMCEvent *event, Double_t * const values, const Context &ctx)
 {
   //
   // Fill event information available for histogramming into an array
@@ -3415,7 +3461,7 @@ inline void AliDielectronVarManager::InitESDpid(Int_t type)
   // type=0 is simulation
   // type=1 is data
 
-  if (!fgPIDResponse) fgPIDResponse=new AliESDpid((Bool_t)(type==0));
+  if (!fgContext.fPIDResponse) fgContext.fPIDResponse=new AliESDpid((Bool_t)(type==0));
   Double_t alephParameters[5];
   // simulation
   alephParameters[0] = 2.15898e+00/50.;
@@ -3423,7 +3469,7 @@ inline void AliDielectronVarManager::InitESDpid(Int_t type)
   alephParameters[2] = 3.40030e-09;
   alephParameters[3] = 1.96178e+00;
   alephParameters[4] = 3.91720e+00;
-  fgPIDResponse->GetTOFResponse().SetTimeResolution(80.);
+  fgContext.fPIDResponse->GetTOFResponse().SetTimeResolution(80.);
 
   // data
   if (type==1){
@@ -3432,20 +3478,20 @@ inline void AliDielectronVarManager::InitESDpid(Int_t type)
     alephParameters[2] = 5.04114e-11;
     alephParameters[3] = 2.12543e+00;
     alephParameters[4] = 4.88663e+00;
-    fgPIDResponse->GetTOFResponse().SetTimeResolution(130.);
-    fgPIDResponse->GetTPCResponse().SetMip(50.);
+    fgContext.fPIDResponse->GetTOFResponse().SetTimeResolution(130.);
+    fgContext.fPIDResponse->GetTPCResponse().SetMip(50.);
   }
 
-  fgPIDResponse->GetTPCResponse().SetBetheBlochParameters(
+  fgContext.fPIDResponse->GetTPCResponse().SetBetheBlochParameters(
     alephParameters[0],alephParameters[1],alephParameters[2],
     alephParameters[3],alephParameters[4]);
 
-  fgPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
+  fgContext.fPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
 }
 
 inline void AliDielectronVarManager::InitAODpidUtil(Int_t type)
 {
-  if (!fgPIDResponse) fgPIDResponse=new AliAODpidUtil;
+  if (!fgContext.fPIDResponse) fgContext.fPIDResponse=new AliAODpidUtil;
   Double_t alephParameters[5];
   // simulation
   alephParameters[0] = 2.15898e+00/50.;
@@ -3453,7 +3499,7 @@ inline void AliDielectronVarManager::InitAODpidUtil(Int_t type)
   alephParameters[2] = 3.40030e-09;
   alephParameters[3] = 1.96178e+00;
   alephParameters[4] = 3.91720e+00;
-  fgPIDResponse->GetTOFResponse().SetTimeResolution(80.);
+  fgContext.fPIDResponse->GetTOFResponse().SetTimeResolution(80.);
 
   // data
   if (type==1){
@@ -3462,15 +3508,15 @@ inline void AliDielectronVarManager::InitAODpidUtil(Int_t type)
     alephParameters[2] = 5.04114e-11;
     alephParameters[3] = 2.12543e+00;
     alephParameters[4] = 4.88663e+00;
-    fgPIDResponse->GetTOFResponse().SetTimeResolution(130.);
-    fgPIDResponse->GetTPCResponse().SetMip(50.);
+    fgContext.fPIDResponse->GetTOFResponse().SetTimeResolution(130.);
+    fgContext.fPIDResponse->GetTPCResponse().SetMip(50.);
   }
 
-  fgPIDResponse->GetTPCResponse().SetBetheBlochParameters(
+  fgContext.fPIDResponse->GetTPCResponse().SetBetheBlochParameters(
     alephParameters[0],alephParameters[1],alephParameters[2],
     alephParameters[3],alephParameters[4]);
 
-  fgPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
+  fgContext.fPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
 }
 
 
@@ -3577,14 +3623,14 @@ inline void AliDielectronVarManager::InitTRDpidEffHistograms(const Char_t* filen
   }
 }
 
-inline Double_t AliDielectronVarManager::GetSingleLegEff(Double_t * const values) {
+inline Double_t AliDielectronVarManager::GetSingleLegEff(Double_t * const values, const Context &ctx) {
   //
   // get the single leg efficiency for a given particle
   //
-  if(!fgLegEffMap) return -1.;
+  if(!ctx.fLegEffMap) return -1.;
 
-  if(fgLegEffMap->InheritsFrom(THnBase::Class())) {
-    THnBase *eff = static_cast<THnBase*>(fgLegEffMap);
+  if(ctx.fLegEffMap->InheritsFrom(THnBase::Class())) {
+    THnBase *eff = static_cast<THnBase*>(ctx.fLegEffMap);
     Int_t dim=eff->GetNdimensions();
     Int_t idx[dim];
     for(Int_t idim=0; idim<dim; idim++) {
@@ -3598,14 +3644,14 @@ inline Double_t AliDielectronVarManager::GetSingleLegEff(Double_t * const values
   return -1.;
 }
 
-inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
+inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values, const Context &ctx) {
   //
   // get the pair efficiency for given pair kinematics
   //
-  if(!fgPairEffMap) return -1.;
+  if(!ctx.fPairEffMap) return -1.;
 
-  if(fgPairEffMap->IsA()== THnBase::Class()) {
-    THnBase *eff = static_cast<THnBase*>(fgPairEffMap);
+  if(ctx.fPairEffMap->IsA()== THnBase::Class()) {
+    THnBase *eff = static_cast<THnBase*>(ctx.fPairEffMap);
     Int_t dim=eff->GetNdimensions();
     Int_t idx[dim];
     for(Int_t idim=0; idim<dim; idim++) {
@@ -3616,8 +3662,8 @@ inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
     const Double_t ret=(eff->GetBinContent(idx));
     return ret;
   }
-  if(fgPairEffMap->IsA()== TSpline3::Class()) {
-    TSpline3 *eff = static_cast<TSpline3*>(fgPairEffMap);
+  if(ctx.fPairEffMap->IsA()== TSpline3::Class()) {
+    TSpline3 *eff = static_cast<TSpline3*>(ctx.fPairEffMap);
     if(!eff->GetHistogram()) { printf("no histogram added to the spline\n"); return -1.;}
     UInt_t var = GetValueType(eff->GetHistogram()->GetXaxis()->GetName());
     return (eff->Eval(values[var]));
@@ -3766,26 +3812,26 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
 }
 
 
-inline void AliDielectronVarManager::SetEvent(AliVEvent * const ev)
+inline void AliDielectronVarManager::Context::SetEvent(AliVEvent * const ev)
 {
-  fgEvent = ev;
-  if (fgKFVertex) delete fgKFVertex;
-  fgKFVertex=0x0;
+  fEvent = ev;
+  if (fKFVertex) delete fKFVertex;
+  fKFVertex=0x0;
   if (!ev) return;
-  if (ev->GetPrimaryVertex()) fgKFVertex=new AliKFVertex(*ev->GetPrimaryVertex());
-  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
-  AliDielectronVarManager::Fill(fgEvent, fgData);
+  if (ev->GetPrimaryVertex()) fKFVertex=new AliKFVertex(*ev->GetPrimaryVertex());
+  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fData[i]=0.;
+  AliDielectronVarManager::Fill(fEvent, fData, *this);
 }
 
-inline void AliDielectronVarManager::SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues])
+inline void AliDielectronVarManager::Context::SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues])
 {
-  for (Int_t i=0; i<kNMaxValues;++i) fgData[i]=0.;
-  for (Int_t i=kPairMax; i<kNMaxValues;++i) fgData[i]=data[i];
+  for (Int_t i=0; i<kNMaxValues;++i) fData[i]=0.;
+  for (Int_t i=kPairMax; i<kNMaxValues;++i) fData[i]=data[i];
 }
 
 
 //______________________________________________________________________________
-inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t* d0z0, Double_t* covd0z0)
+inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t* d0z0, Double_t* covd0z0, const Context &ctx)
 {
   if(track->TestBit(AliAODTrack::kIsDCA)){
     d0z0[0]=track->DCA();
@@ -3795,7 +3841,7 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
   }
 
   Bool_t ok=kFALSE;
-  if(fgEvent) {
+  if(ctx.fEvent) {
     AliExternalTrackParam etp; etp.CopyFromVTrack(track);
 
     Float_t xstart = etp.GetX();
@@ -3805,8 +3851,8 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
       return kFALSE;
     }
 
-    AliAODVertex *vtx =(AliAODVertex*)(fgEvent->GetPrimaryVertex());
-    Double_t fBzkG = fgEvent->GetMagneticField(); // z componenent of field in kG
+    AliAODVertex *vtx =(AliAODVertex*)(ctx.fEvent->GetPrimaryVertex());
+    Double_t fBzkG = ctx.fEvent->GetMagneticField(); // z componenent of field in kG
     ok = etp.PropagateToDCA(vtx,fBzkG,kVeryBig,d0z0,covd0z0);
   }
   if(!ok){
@@ -3816,13 +3862,13 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
   return ok;
 }
 
-inline void AliDielectronVarManager::SetTPCEventPlane(AliEventplane *const evplane)
+inline void AliDielectronVarManager::Context::SetTPCEventPlane(AliEventplane *const evplane)
 {
 
-  fgTPCEventPlane = evplane;
-  FillVarTPCEventPlane(evplane,fgData);
-  //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
-  //  AliDielectronVarManager::Fill(fgEvent, fgData);
+  fTPCEventPlane = evplane;
+  FillVarTPCEventPlane(evplane,fData);
+  //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fData[i]=0.;
+  //  AliDielectronVarManager::Fill(fEvent, fData, *this);
 }
 
 
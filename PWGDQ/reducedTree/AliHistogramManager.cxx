@@ -49,7 +49,18 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fPlanClasses(),
+  fPlanClassIds(),
+  fPlanBegin(),
+  fPlanEnd(),
+  fPlanHist(),
+  fPlanType(),
+  fPlanVarBegin(),
+  fPlanNVars(),
+  fPlanVarW(),
+  fPlanVars(),
+  fPlansCompiled(kFALSE)
 {
   //
   // Constructor
@@ -71,7 +82,18 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fPlanClasses(),
+  fPlanClassIds(),
+  fPlanBegin(),
+  fPlanEnd(),
+  fPlanHist(),
+  fPlanType(),
+  fPlanVarBegin(),
+  fPlanNVars(),
+  fPlanVarW(),
+  fPlanVars(),
+  fPlansCompiled(kFALSE)
 {
   //
   // Constructor
@@ -131,6 +153,7 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
   fMainList.Add(hList);
+  fPlansCompiled = kFALSE;
 }
 
 //_________________________________________________________________
@@ -144,6 +167,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a histogram
   //
+  fPlansCompiled = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -286,6 +310,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a histogram
   //
+  fPlansCompiled = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -431,6 +456,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a multi-dimensional histogram THnF or THnFSparseF
   //
+  fPlansCompiled = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -484,6 +510,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a multi-dimensional histogram THnF or THnSparseF with equal or variable bin widths
   //
+  fPlansCompiled = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -624,148 +651,178 @@ void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values
   //
   //  fill a class of histograms
   //
+  FillHistClass(GetHistClassId(className), values);
+}
+
+//_________________________________________________________________
+Int_t AliHistogramManager::GetHistClassId(const Char_t* className) {
+  //
+  //  integer id of a histogram class, to be used with FillHistClass(Int_t, ...)
+  //  The ids are kept in fPlanClassIds, the histogram lists themselves are not modified
+  //
   THashList* hList = (THashList*)fMainList.FindObject(className);
   if(!hList) {
     /*cout << "Warning in AliHistogramManager::FillHistClass(): Histogram list " << className << " not found!" << endl;
     cout << "         Histogram list not filled" << endl; */
-    return;
+    return -1;
   }
-  if(!hList) {
-    return;
-  }
-    
-  TIter next(hList);
-  TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
-  Bool_t isSparse=kFALSE;
-  Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
-  while((h=next())) {
-    Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    if(isTHn && ((TString)h->ClassName()).Contains("Sparse")) isSparse = kTRUE;
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
-    uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
-    if(uid>0) {
-      varW = uid%(fNVars+1)-1;
-      if(varW==0) varW=AliReducedVarManager::kNothing;
-      uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
-      if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
-    }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
-        switch(dimension) {
-          case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
-          break;
-          case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
-          break;
-          case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
-            if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
-            }
-          break;
-          default:
-          break;
-        }  // end switch
+  std::map<const THashList*, Int_t>::const_iterator it = fPlanClassIds.find(hList);
+  if(it!=fPlanClassIds.end()) return it->second;
+  Int_t classId = fPlanClasses.size();
+  fPlanClasses.push_back(hList);
+  fPlanClassIds[hList] = classId;
+  fPlansCompiled = kFALSE;
+  return classId;
+}
+
+//_________________________________________________________________
+void AliHistogramManager::CompileFillPlans() {
+  //
+  //  decode the histogram setup of all registered classes into flat fill plans
+  //  Histograms which would never be filled (unused fill or weight variable) are left out
+  //
+  fPlanBegin.assign(fPlanClasses.size(), 0);
+  fPlanEnd.assign(fPlanClasses.size(), 0);
+  fPlanHist.clear();
+  fPlanType.clear();
+  fPlanVarBegin.clear();
+  fPlanNVars.clear();
+  fPlanVarW.clear();
+  fPlanVars.clear();
+  
+  for(UInt_t iclass=0; iclass<fPlanClasses.size(); ++iclass) {
+    fPlanBegin[iclass] = fPlanHist.size();
+    TIter next(fPlanClasses[iclass]);
+    TObject* h=0x0;
+    while((h=next())) {
+      Int_t uid = h->GetUniqueID();
+      Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
+      Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+      Int_t thnDim = (isTHn ? (uid%100)-10 : 0);         // the excess over 10 from the last 2 digits give the dimension of the THn
+      Int_t dimension = (isTHn ? 0 : ((TH1*)h)->GetDimension());
+      
+      uid = (uid-(uid%100))/100;
+      Int_t varT = -1, varW = -1;
+      if(uid>0) {
+        varW = uid%(fNVars+1)-1;
+        if(varW==0) varW=AliReducedVarManager::kNothing;
+        uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
+        if(uid>0) varT = uid - 1;
       }
-    }  // end if(!isTHn)
-    else {
-      for(Int_t idim=0;idim<thnDim;++idim) {
-        if (isSparse) {
-          allVarsGood &= fUsedVars[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-        } else {
-          allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
+      if(varW>AliReducedVarManager::kNothing && !fUsedVars[varW]) continue;
+      
+      Int_t vars[20];
+      Int_t nVars = 0;
+      Int_t type = kPlanTHn;
+      if(!isTHn) {
+        vars[nVars++] = ((TH1*)h)->GetXaxis()->GetUniqueID();
+        if(dimension==1) {
+          type = (isProfile ? kPlanTProfile : kPlanTH1);
+          if(isProfile) vars[nVars++] = ((TH1*)h)->GetYaxis()->GetUniqueID();
         }
-      }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW]) {
-            if (isSparse) ((THnSparseF*)h)->Fill(fillValues,values[varW]);
-            else          ((THnF*)h)->Fill(fillValues,values[varW]);
-          }
+        else if(dimension==2) {
+          type = (isProfile ? kPlanTProfile2D : kPlanTH2);
+          vars[nVars++] = ((TH1*)h)->GetYaxis()->GetUniqueID();
+          if(isProfile) vars[nVars++] = ((TH1*)h)->GetZaxis()->GetUniqueID();
         }
-        else {
-          if (isSparse) ((THnSparseF*)h)->Fill(fillValues);
-          else          ((THnF*)h)->Fill(fillValues);
+        else if(dimension==3) {
+          type = (isProfile ? kPlanTProfile3D : kPlanTH3);
+          vars[nVars++] = ((TH1*)h)->GetYaxis()->GetUniqueID();
+          vars[nVars++] = ((TH1*)h)->GetZaxis()->GetUniqueID();
+          if(isProfile) {
+            if(varT<0) continue;
+            vars[nVars++] = varT;
+          }
         }
+        else continue;
+      }
+      else {
+        for(Int_t idim=0;idim<thnDim;++idim) vars[nVars++] = ((THnBase*)h)->GetAxis(idim)->GetUniqueID();
       }
+      Bool_t allVarsGood = kTRUE;
+      for(Int_t ivar=0; ivar<nVars; ++ivar) allVarsGood &= fUsedVars[vars[ivar]];
+      if(!allVarsGood) continue;
+      
+      fPlanHist.push_back(h);
+      fPlanType.push_back(type);
+      fPlanVarBegin.push_back(fPlanVars.size());
+      fPlanNVars.push_back(nVars);
+      fPlanVarW.push_back(varW);
+      for(Int_t ivar=0; ivar<nVars; ++ivar) fPlanVars.push_back(vars[ivar]);
     }
+    fPlanEnd[iclass] = fPlanHist.size();
   }
+  fPlansCompiled = kTRUE;
+}
+
+//_________________________________________________________________
+void AliHistogramManager::FillPlanEntry(Int_t entry, const Float_t* values) {
+  //
+  //  fill one histogram of a compiled plan
+  //
+  TObject* h = fPlanHist[entry];
+  const Int_t* v = &fPlanVars[fPlanVarBegin[entry]];
+  Int_t varW = fPlanVarW[entry];
+  Bool_t weighted = (varW>AliReducedVarManager::kNothing);
+  switch(fPlanType[entry]) {
+    case kPlanTH1:
+      if(weighted) ((TH1F*)h)->Fill(values[v[0]],values[varW]);
+      else         ((TH1F*)h)->Fill(values[v[0]]);
+      break;
+    case kPlanTProfile:
+      if(weighted) ((TProfile*)h)->Fill(values[v[0]],values[v[1]],values[varW]);
+      else         ((TProfile*)h)->Fill(values[v[0]],values[v[1]]);
+      break;
+    case kPlanTH2:
+      if(weighted) ((TH2F*)h)->Fill(values[v[0]],values[v[1]],values[varW]);
+      else         ((TH2F*)h)->Fill(values[v[0]],values[v[1]]);
+      break;
+    case kPlanTProfile2D:
+      if(weighted) ((TProfile2D*)h)->Fill(values[v[0]],values[v[1]],values[v[2]],values[varW]);
+      else         ((TProfile2D*)h)->Fill(values[v[0]],values[v[1]],values[v[2]]);
+      break;
+    case kPlanTH3:
+      if(weighted) ((TH3F*)h)->Fill(values[v[0]],values[v[1]],values[v[2]],values[varW]);
+      else         ((TH3F*)h)->Fill(values[v[0]],values[v[1]],values[v[2]]);
+      break;
+    case kPlanTProfile3D:
+      if(weighted) ((TProfile3D*)h)->Fill(values[v[0]],values[v[1]],values[v[2]],values[v[3]],values[varW]);
+      else         ((TProfile3D*)h)->Fill(values[v[0]],values[v[1]],values[v[2]],values[v[3]]);
+      break;
+    case kPlanTHn: {
+      Double_t fillValues[20]={0.0};
+      for(Int_t idim=0; idim<fPlanNVars[entry]; ++idim) fillValues[idim] = values[v[idim]];
+      if(weighted) ((THnBase*)h)->Fill(fillValues,values[varW]);
+      else         ((THnBase*)h)->Fill(fillValues);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+//_________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classId, Float_t* values) {
+  //
+  //  fill a class of histograms identified by its id (see GetHistClassId())
+  //
+  if(classId<0) return;
+  if(!fPlansCompiled) CompileFillPlans();
+  if(classId>=(Int_t)fPlanBegin.size()) return;
+  for(Int_t i=fPlanBegin[classId]; i<fPlanEnd[classId]; ++i) FillPlanEntry(i, values);
+}
+
+//_________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classId, Int_t nEntries, Float_t** values) {
+  //
+  //  fill a class of histograms with several value vectors; each histogram receives
+  //  the entries in the given order
+  //
+  if(classId<0) return;
+  if(!fPlansCompiled) CompileFillPlans();
+  if(classId>=(Int_t)fPlanBegin.size()) return;
+  for(Int_t i=fPlanBegin[classId]; i<fPlanEnd[classId]; ++i)
+    for(Int_t ientry=0; ientry<nEntries; ++ientry) FillPlanEntry(i, values[ientry]);
 }
 
 //__________________________________________________________________
@@ -14,6 +14,9 @@
 #include <TList.h>
 #include <THashList.h>
 
+#include <vector>
+#include <map>
+
 #include "AliReducedVarManager.h"
 
 class TAxis;
@@ -69,6 +72,12 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  // Fill by class id: the histograms of each class are compiled once into a flat
+  // fill plan (histogram type, variable indices, weight index), so the pair loop
+  // does neither string look-ups nor per-fill decoding of the histogram setup
+  Int_t GetHistClassId(const Char_t* className);     // -1 if the class does not exist
+  void FillHistClass(Int_t classId, Float_t* values);
+  void FillHistClass(Int_t classId, Int_t nEntries, Float_t** values);   // batched fill of nEntries value vectors
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -107,8 +116,26 @@ class AliHistogramManager : public TObject {
   Int_t fNVars;                          // maximum number of variables
   
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
+  void CompileFillPlans();
+  void FillPlanEntry(Int_t entry, const Float_t* values);
+  
+  enum FillPlanTypes {
+    kPlanTH1=0, kPlanTProfile, kPlanTH2, kPlanTProfile2D, kPlanTH3, kPlanTProfile3D, kPlanTHn
+  };
+  // fill plans; class ids index fPlanClasses, entries index the per-histogram arrays
+  std::vector<THashList*> fPlanClasses;    //! histogram list of each class id
+  std::map<const THashList*, Int_t> fPlanClassIds;   //! class id of each registered histogram list
+  std::vector<Int_t> fPlanBegin;           //! first plan entry of each class id
+  std::vector<Int_t> fPlanEnd;             //! end of the plan entries of each class id
+  std::vector<TObject*> fPlanHist;         //! histogram of each plan entry
+  std::vector<Int_t> fPlanType;            //! FillPlanTypes value of each plan entry
+  std::vector<Int_t> fPlanVarBegin;        //! first index in fPlanVars of each plan entry
+  std::vector<Int_t> fPlanNVars;           //! number of fill variables of each plan entry
+  std::vector<Int_t> fPlanVarW;            //! weight variable of each plan entry (kNothing for none)
+  std::vector<Int_t> fPlanVars;            //! fill variable indices of all plan entries
+  Bool_t fPlansCompiled;                   //! plans are up to date with the histogram lists
   
-  ClassDef(AliHistogramManager, 4)
+  ClassDef(AliHistogramManager, 5)
 };
 
 #endif
@@ -15,6 +15,8 @@ using std::cout;
 using std::endl;
 using std::flush;
 
+#include <algorithm>
+
 #include <TMath.h>
 #include <TTimeStamp.h>
 #include <TRandom.h>
@@ -34,6 +36,8 @@ AliMixingHandler::AliMixingHandler(Int_t mixingSetup /* = kMixResonanceLegs*/) :
   fDownscaleTracks(1.0),
   fPoolsLeg1("TClonesArray"),
   fPoolsLeg2("TClonesArray"),
+  fLegPools(),
+  fHistClassIds(),
   fNParallelCuts(0),
   fNParallelPairCuts(0),
   fHistClassNames(""),
@@ -74,6 +78,8 @@ AliMixingHandler::AliMixingHandler(const Char_t* name, const Char_t* title, Int_
   fDownscaleTracks(1.0),
   fPoolsLeg1("TClonesArray"),
   fPoolsLeg2("TClonesArray"),
+  fLegPools(),
+  fHistClassIds(),
   fNParallelCuts(0),
   fNParallelPairCuts(0),
   fHistClassNames(""),
@@ -178,8 +184,12 @@ void AliMixingHandler::Init() {
 
   Int_t size = 1;
   for(Int_t iVar = 0; iVar<fNMixingVariables; ++iVar) size *= (fVariableLimits[iVar].GetSize()-1);
-  fPoolsLeg1.Expand(size); fPoolsLeg1.SetOwner(kTRUE);
-  fPoolsLeg2.Expand(size); fPoolsLeg2.SetOwner(kTRUE);
+  if(fMixingSetup==kMixResonanceLegs) 
+    fLegPools.assign(size, LegPool());
+  else {
+    fPoolsLeg1.Expand(size); fPoolsLeg1.SetOwner(kTRUE);
+    fPoolsLeg2.Expand(size); fPoolsLeg2.SetOwner(kTRUE);
+  }
   
   fPoolSize.Set(fNParallelCuts*size);
   for(Int_t i=0;i<fNParallelCuts*size;++i) fPoolSize[i] = 0;
@@ -220,6 +230,20 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   Int_t category = FindEventCategory(values);
   if(category<0) return;   // event characteristics outside the defined ranges
   
+  if(fMixingSetup==kMixResonanceLegs) {
+    if(category>=(Int_t)fLegPools.size()) fLegPools.resize(category+1);
+    LegPool& pool = fLegPools[category];
+    AddEventToPool(pool, leg1List, leg2List);
+    
+    // increment the size of the pools in this category and run the event mixing if full pool(s) were found
+    ULong_t mixingMask = IncrementPoolSizes(leg1List,leg2List,category);
+    if(mixingMask) {
+      RunEventMixing(pool,mixingMask,type,values);
+      ResetPoolSizes(mixingMask,category);
+    }
+    return;
+  }
+  
   TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(category));
   if(!leg1PoolP) leg1PoolP = new(fPoolsLeg1[category]) TClonesArray("TList",1);
   leg1PoolP->SetOwner(kTRUE);
@@ -253,6 +277,30 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
 }
 
 
+//_________________________________________________________________________
+void AliMixingHandler::AddEventToPool(LegPool& pool, TList* leg1List, TList* leg2List) {
+  //
+  // Append the legs of an event to a compact pool
+  //
+  const Int_t nLegVars = AliReducedVarManager::kNMixLegVariables;
+  Float_t leg[nLegVars];
+  TList* lists[2] = {leg1List, leg2List};
+  for(Int_t il=0; il<2; ++il) {
+    if(pool.fEventBegin[il].empty()) pool.fEventBegin[il].push_back(0);
+    if(lists[il]) {
+      TIter nextTrack(lists[il]);
+      AliReducedBaseTrack* track=0x0;
+      while((track=(AliReducedBaseTrack*)nextTrack())) {
+        AliReducedVarManager::FillMixingLegInfo(track, leg);
+        pool.fLegs[il].insert(pool.fLegs[il].end(), leg, leg+nLegVars);
+        pool.fLegFlags[il].push_back(track->GetFlags());
+      }
+    }
+    pool.fEventBegin[il].push_back(pool.fLegFlags[il].size());
+  }
+}
+
+
 //_________________________________________________________________________
 Int_t AliMixingHandler::FindEventCategory(Float_t* values) {
    //
@@ -399,6 +447,19 @@ void AliMixingHandler::RunLeftoverMixing(Int_t type) {
   for(Int_t i=0; i<fNParallelCuts; ++i) mixingMask |= (ULong_t(1)<<i);
   Float_t values[AliReducedVarManager::kNVars];
   
+  if(fMixingSetup==kMixResonanceLegs) {
+    for(Int_t icateg=0; icateg<(Int_t)fLegPools.size(); ++icateg) {
+      if(!fLegPools[icateg].GetNEvents()) continue;
+      for(Int_t iVar=0; iVar<fNMixingVariables; ++iVar) {
+        Int_t bin = GetBinFromCategory(iVar, icateg);
+        values[fVariables[iVar]] = 0.5*(fVariableLimits[iVar][bin] + fVariableLimits[iVar][bin+1]);
+      }
+      RunEventMixing(fLegPools[icateg],mixingMask,type,values);
+      ResetPoolSizes(mixingMask,icateg);
+    }  // end loop over categories
+    return;
+  }
+  
   for(Int_t icateg=0; icateg<fPoolsLeg1.GetEntries(); ++icateg) {
     TClonesArray *leg1Pool = static_cast<TClonesArray*>(fPoolsLeg1.At(icateg));
     TClonesArray *leg2Pool = static_cast<TClonesArray*>(fPoolsLeg2.At(icateg));
@@ -417,31 +478,163 @@ void AliMixingHandler::RunLeftoverMixing(Int_t type) {
 
 
 //_________________________________________________________________________
-void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask,
-				      Int_t type, Float_t* values) {
+void AliMixingHandler::RunEventMixing(LegPool& pool, ULong_t mixingMask, Int_t type, Float_t* values) {
   //
-  // Run event mixing
+  // Run event mixing on a compact pool of resonance legs
   // NOTE: The mixingMask is a bit map with bits toggled for the pools which need mixing
   //       The type is the pair candidate type. It is used in AliReducedPairInfo::CandidateType, mainly to know which mass assumption to be made for the legs
   //
-  Int_t entries = leg1Pool->GetEntries();
+  Int_t entries = pool.GetNEvents();
   if(entries<2) return;
+  if(fHistClassIds.empty()) ResolveHistClassIds();
+  
+  const Int_t nLegVars = AliReducedVarManager::kNMixLegVariables;
+  ULong_t testFlags1 = 0;
+  for(Int_t iev1=0; iev1<entries; ++iev1) {                            // first event loop
+    for(Int_t iev2=0; iev2<entries; ++iev2) {                         // second event loop
+      if(iev1==iev2) continue;
+      
+      // loop over the ev1-leg1 legs
+      for(Int_t i=pool.fEventBegin[0][iev1]; i<pool.fEventBegin[0][iev1+1]; ++i) {
+        // check that this leg has at least one common bit with the mixing mask
+        testFlags1 = mixingMask & pool.fLegFlags[0][i];
+        if(!testFlags1) continue;
+        const Float_t* leg = &pool.fLegs[0][i*nLegVars];
+        // cross-pairs (leg1 - leg2)
+        MixLegWithEvent(leg, testFlags1, pool, 1, iev2, 1, type, values);
+        // like-pairs (leg1 - leg1)
+        if(fMixLikeSign) MixLegWithEvent(leg, testFlags1, pool, 0, iev2, 0, type, values);
+      }
+      
+      if(!fMixLikeSign) continue;
+      // loop over the ev1-leg2 legs, like-pairs (leg2 - leg2)
+      for(Int_t i=pool.fEventBegin[1][iev1]; i<pool.fEventBegin[1][iev1+1]; ++i) {
+        testFlags1 = mixingMask & pool.fLegFlags[1][i];
+        if(!testFlags1) continue;
+        MixLegWithEvent(&pool.fLegs[1][i*nLegVars], testFlags1, pool, 1, iev2, 2, type, values);
+      }
+    }  // end second event loop
+  }  // end first event loop
+  
+  CleanPool(pool, mixingMask);
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::MixLegWithEvent(const Float_t* leg, ULong_t testFlags1, const LegPool& pool, Int_t legId, Int_t iev, 
+                                       Int_t pairType, Int_t type, Float_t* values) {
+  //
+  // Pair a leg with the legId (0 = leg1, 1 = leg2) legs of event iev from the pool and fill the histograms
+  // NOTE: pairType is 0, 1 or 2 for leg1-leg1, leg1-leg2 and leg2-leg2 pairs and selects the pair cuts and histogram class
+  //
+  const Int_t nLegVars = AliReducedVarManager::kNMixLegVariables;
+  const ULong_t* flags = &pool.fLegFlags[legId][0];
+  const Float_t* legs = &pool.fLegs[legId][0];
+  for(Int_t j=pool.fEventBegin[legId][iev]; j<pool.fEventBegin[legId][iev+1]; ++j) {
+    // check that this leg has at least one common bit with the mixing mask and with the first leg
+    ULong_t testFlags2 = testFlags1 & flags[j];
+    if(!testFlags2) continue;
+    
+    AliReducedVarManager::FillPairInfoME(leg, legs+j*nLegVars, type, values);
+    ULong_t pairCutMask = IsPairSelected(values, pairType);
+    if(!pairCutMask) continue;   // fill histograms only if pair cuts are fulfilled
+    for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
+      if(!(testFlags2&(ULong_t(1)<<ibit))) continue;
+      if (fNParallelPairCuts>1) {
+        for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
+          if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
+          fHistos->FillHistClass(fHistClassIds[ibit*3+jbit*3*fNParallelCuts+pairType], values);
+        }
+      } else {
+        fHistos->FillHistClass(fHistClassIds[ibit*3+pairType], values);
+      }
+    }
+  }
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::CleanPool(LegPool& pool, ULong_t mixingMask) {
+  //
+  // Unset the mixing flags, remove the legs without enabled mixing flags and the events without legs left
+  //
+  const Int_t nLegVars = AliReducedVarManager::kNMixLegVariables;
+  Int_t entries = pool.GetNEvents();
+  for(Int_t il=0; il<2; ++il) {
+    std::vector<Int_t>& eventBegin = pool.fEventBegin[il];
+    std::vector<Float_t>& legs = pool.fLegs[il];
+    std::vector<ULong_t>& flags = pool.fLegFlags[il];
+    Int_t nKept = 0;
+    for(Int_t iev=0; iev<entries; ++iev) {
+      Int_t first = eventBegin[iev];
+      Int_t last = eventBegin[iev+1];
+      eventBegin[iev] = nKept;
+      for(Int_t i=first; i<last; ++i) {
+        flags[i] &= ~mixingMask;
+        if(!flags[i]) continue;
+        if(i!=nKept) {
+          flags[nKept] = flags[i];
+          std::copy(legs.begin()+i*nLegVars, legs.begin()+(i+1)*nLegVars, legs.begin()+nKept*nLegVars);
+        }
+        ++nKept;
+      }
+    }
+    eventBegin[entries] = nKept;
+    flags.resize(nKept);
+    legs.resize(nKept*nLegVars);
+  }
   
+  // remove the events without legs; their (empty) ranges are merged into the next kept event
+  Int_t nKeptEvents = 0;
+  for(Int_t iev=0; iev<entries; ++iev) {
+    Int_t n1 = pool.fEventBegin[0][iev+1]-pool.fEventBegin[0][iev];
+    Int_t n2 = pool.fEventBegin[1][iev+1]-pool.fEventBegin[1][iev];
+    if(!n1 && !n2) continue;
+    pool.fEventBegin[0][nKeptEvents] = pool.fEventBegin[0][iev];
+    pool.fEventBegin[1][nKeptEvents] = pool.fEventBegin[1][iev];
+    ++nKeptEvents;
+  }
+  for(Int_t il=0; il<2; ++il) {
+    pool.fEventBegin[il][nKeptEvents] = pool.fEventBegin[il][entries];
+    pool.fEventBegin[il].resize(nKeptEvents+1);
+  }
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::ResolveHistClassIds() {
+  //
+  // Look up the histogram manager ids of the histogram classes, in the order given in fHistClassNames
+  //
+  fHistClassIds.clear();
   TObjArray* histClassArr = fHistClassNames.Tokenize(";");
+  for(Int_t i=0; i<histClassArr->GetEntries(); ++i)
+    fHistClassIds.push_back(fHistos->GetHistClassId(histClassArr->At(i)->GetName()));
+  delete histClassArr;
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask,
+				      Int_t /*type*/, Float_t* values) {
+  //
+  // Run event mixing for the correlation setup (kMixCorrelation); resonance legs use the compact pools
+  // NOTE: The mixingMask is a bit map with bits toggled for the pools which need mixing
+  //
+  Int_t entries = leg1Pool->GetEntries();
+  if(entries<2) return;
+  if(fHistClassIds.empty()) ResolveHistClassIds();
   
   TIter iterEv1Leg1Pool(leg1Pool);
   TIter iterEv1Leg2Pool(leg2Pool);
   ULong_t testFlags1 = 0;
   ULong_t testFlags2 = 0;
   for(Int_t iev1=0; iev1<entries; ++iev1) {                            // first event loop
-    // get the lists of leg1 and leg2 tracks for the first event
+    // get the list of leg1 tracks for the first event
     TList* ev1Leg1List = (TList*)iterEv1Leg1Pool();
-    TList* ev1Leg2List = (TList*)iterEv1Leg2Pool();
     
-    TIter iterEv2Leg1Pool(leg1Pool);
     TIter iterEv2Leg2Pool(leg2Pool);
     for(Int_t iev2=0; iev2<entries; ++iev2) {                         // second event loop
-      TList* ev2Leg1List = (TList*)iterEv2Leg1Pool();
       TList* ev2Leg2List = (TList*)iterEv2Leg2Pool();
       if(iev1==iev2) continue;
       
@@ -462,105 +655,27 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
           if(!testFlags2) continue;
 	  
           // fill cross-pairs (leg1 - leg2) for the enabled bits
-          if(fMixingSetup==kMixResonanceLegs) AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg2, type, values);
-          if(fMixingSetup==kMixCorrelation)   AliReducedVarManager::FillCorrelationInfo(ev1Leg1, ev2Leg2, values);
+          AliReducedVarManager::FillCorrelationInfo(ev1Leg1, ev2Leg2, values);
           ULong_t pairCutMask = IsPairSelected(values, 1);
           if(!pairCutMask) continue;   // fill histograms only if pair cuts are fulfilled
           for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
             if((testFlags2)&(ULong_t(1)<<ibit)) { 
-              if(fMixingSetup==kMixResonanceLegs) {
-                if (fNParallelPairCuts>1) {
-                  for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
-                    if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
-                    fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*3*fNParallelCuts+1)->GetName(), values);
-                  }
-                } else {
-                  fHistos->FillHistClass(histClassArr->At(ibit*3+1)->GetName(), values);
-                }
-              }
-              if(fMixingSetup==kMixCorrelation) {
-                Int_t pairType = (reinterpret_cast<AliReducedPairInfo*>(ev1Leg1))->PairType();
-                if (fNParallelPairCuts>1) {
-                  ULong_t pairCutMaskCorr = (reinterpret_cast<AliReducedPairInfo*>(ev1Leg1))->GetQualityFlags();
-                  for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
-                    if (!((pairCutMaskCorr)&(ULong_t(1)<<jbit))) continue;
-                    if (fMixLikeSign) fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*fNParallelCuts+pairType)->GetName(), values);
-                    else              fHistos->FillHistClass(histClassArr->At(ibit+jbit*fNParallelCuts)->GetName(), values);
-                  }
-                } else {
-                  if (fMixLikeSign) fHistos->FillHistClass(histClassArr->At(ibit*3+pairType)->GetName(), values);
-                  else              fHistos->FillHistClass(histClassArr->At(ibit)->GetName(), values);
+              Int_t pairType = (reinterpret_cast<AliReducedPairInfo*>(ev1Leg1))->PairType();
+              if (fNParallelPairCuts>1) {
+                ULong_t pairCutMaskCorr = (reinterpret_cast<AliReducedPairInfo*>(ev1Leg1))->GetQualityFlags();
+                for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
+                  if (!((pairCutMaskCorr)&(ULong_t(1)<<jbit))) continue;
+                  if (fMixLikeSign) fHistos->FillHistClass(fHistClassIds[ibit*3+jbit*fNParallelCuts+pairType], values);
+                  else              fHistos->FillHistClass(fHistClassIds[ibit+jbit*fNParallelCuts], values);
                 }
+              } else {
+                if (fMixLikeSign) fHistos->FillHistClass(fHistClassIds[ibit*3+pairType], values);
+                else              fHistos->FillHistClass(fHistClassIds[ibit], values);
               }
             }
           }  
 	}  // end loop over the ev2-leg2 list
-	
-	if(fMixingSetup==kMixCorrelation) continue;
-	if(!fMixLikeSign) continue;
-	// loop over the ev2-leg1 list
-	TIter iterLeg1LS(ev2Leg1List);
-	AliReducedBaseTrack* ev2Leg1=0x0;
-	while((ev2Leg1=(AliReducedBaseTrack*)iterLeg1LS())) {
-	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg1->GetFlags();
-          if(!testFlags2) continue;
-	  
-	  // fill like-pairs (leg1 - leg1) for the enabled bits
-	  AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg1, type, values);
-    ULong_t pairCutMask = IsPairSelected(values, 0);
-    if(!pairCutMask) continue;   // fill histograms only if pair cuts are fulfilled
-	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-      if((testFlags2)&(ULong_t(1)<<ibit)) {
-        if (fNParallelPairCuts>1) {
-          for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
-            if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
-            fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*3*fNParallelCuts+0)->GetName(), values);
-          }
-        } else {
-          fHistos->FillHistClass(histClassArr->At(ibit*3+0)->GetName(), values);
-        }
-      }
-    }
-	}  // end loop over the ev2-leg1 list
       }  // end loop over the ev1-leg1 list
-      
-      if(fMixingSetup==kMixCorrelation) continue;
-      if(!fMixLikeSign) continue;
-      //loop over the ev1-leg2 list
-      TIter iterLeg2(ev1Leg2List);
-      AliReducedBaseTrack* ev1Leg2=0x0;
-      while((ev1Leg2=(AliReducedBaseTrack*)iterLeg2())) {
-	// check that this track has at least one common bit with the mixing mask
-	testFlags1 = mixingMask & ev1Leg2->GetFlags();
-        if(!testFlags1) continue;
-	
-	//loop over the ev2-leg2 list 
-	TIter iterLeg2LS(ev2Leg2List);
-	AliReducedBaseTrack* ev2Leg2=0x0;
-	while((ev2Leg2=(AliReducedBaseTrack*)iterLeg2LS())) {
-	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg2->GetFlags();
-          if(!testFlags2) continue;
-	  
-	  // fill like-pairs (leg2 - leg2) for the enabled bits
-	  AliReducedVarManager::FillPairInfoME(ev1Leg2, ev2Leg2, type, values);
-    ULong_t pairCutMask = IsPairSelected(values, 2);
-    if(!pairCutMask) continue;   // fill histograms only if pair cuts are fulfilled
-	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-      if((testFlags2)&(ULong_t(1)<<ibit)) {
-        if (fNParallelPairCuts>1) {
-          for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
-            if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
-            fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*3*fNParallelCuts+2)->GetName(), values);
-          }
-        } else {
-          fHistos->FillHistClass(histClassArr->At(ibit*3+2)->GetName(), values);
-        }
-      }
-    }
-	}  // end loop over the ev2-leg2 list
-      }  // end loop over the ev1-leg2 list
     }  // end second event loop
   }  // end first event loop
   
@@ -707,6 +822,30 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
       cout << endl;
       if(debugLevel<2) continue;
       
+      if(fMixingSetup==kMixResonanceLegs) {
+         if(iCateg>=(Int_t)fLegPools.size()) continue;
+         const LegPool& pool = fLegPools[iCateg];
+         const Int_t nLegVars = AliReducedVarManager::kNMixLegVariables;
+         for(Int_t iev=0; iev<pool.GetNEvents(); ++iev) {
+            cout << "	Event #" << iev << ";  No. of tracks (leg1/leg2) :: " 
+            << pool.fEventBegin[0][iev+1]-pool.fEventBegin[0][iev] << " / " << pool.fEventBegin[1][iev+1]-pool.fEventBegin[1][iev] << endl;
+            if(debugLevel<3) continue;
+            for(Int_t il=0; il<2; ++il) {
+               cout << "		Leg" << il+1 << " list" << endl;
+               for(Int_t itrack=pool.fEventBegin[il][iev]; itrack<pool.fEventBegin[il][iev+1]; ++itrack) {
+                  const Float_t* leg = &pool.fLegs[il][itrack*nLegVars];
+                  cout << "		track #" << itrack-pool.fEventBegin[il][iev] << " (p/px/py/pz/charge/flags) :: "
+                  << leg[AliReducedVarManager::kMixLegP] << " / " << leg[AliReducedVarManager::kMixLegPx] << " / " 
+                  << leg[AliReducedVarManager::kMixLegPy] << " / " << leg[AliReducedVarManager::kMixLegPz] << "/" 
+                  << leg[AliReducedVarManager::kMixLegCharge] << " / " << flush;
+                  AliReducedVarManager::PrintBits(pool.fLegFlags[il][itrack], fNParallelCuts);	 
+                  cout << endl;
+               }  // end loop over tracks
+            }
+         }  // end loop over events
+         continue;
+      }
+      
       TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(iCateg));
       if(!leg1PoolP) continue;
       TClonesArray &leg1Pool=*leg1PoolP;
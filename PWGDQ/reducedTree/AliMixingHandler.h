@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <TString.h>
 
+#include <vector>
+
 #include "AliHistogramManager.h"
 #include "AliReducedVarManager.h"
 #include "AliReducedInfoCut.h"
@@ -92,8 +94,20 @@ private:
   Float_t fDownscaleEvents;      // random downscale adding events to the pools
   Float_t fDownscaleTracks;      // random downscale adding tracks fo the pools
   
-  TClonesArray fPoolsLeg1;         // array of pools
-  TClonesArray fPoolsLeg2;         // array of pools
+  TClonesArray fPoolsLeg1;         // array of pools (kMixCorrelation)
+  TClonesArray fPoolsLeg2;         // array of pools (kMixCorrelation)
+  
+  // Compact pool of one event category used for kMixResonanceLegs: only the leg kinematics
+  // (AliReducedVarManager::MixingLegVariables) and the cut flags are kept, in contiguous arrays.
+  // The legs of event i are the entries [fEventBegin[i], fEventBegin[i+1]) of the leg arrays.
+  struct LegPool {
+    std::vector<Int_t>   fEventBegin[2];  // first leg of each event, one entry more than events
+    std::vector<Float_t> fLegs[2];        // leg kinematics, kNMixLegVariables values per leg
+    std::vector<ULong_t> fLegFlags[2];    // cut flags of each leg
+    Int_t GetNEvents() const {return (fEventBegin[0].empty() ? 0 : fEventBegin[0].size()-1);}
+  };
+  std::vector<LegPool> fLegPools;  //! compact pools (kMixResonanceLegs), one per event category
+  std::vector<Int_t> fHistClassIds; //! histogram manager ids of the classes in fHistClassNames
   Int_t fNParallelCuts;            // number of parallel cuts which are run
   Int_t fNParallelPairCuts;        // number of parallel pair cuts which are run
   TString fHistClassNames;         // name of the histogram classes for each cut, separated by a semicolon ";"
@@ -112,10 +126,16 @@ private:
   TList fLikePairsLeg2Cuts;    // cut object for LEG2 like pairs
   
   void RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
+  void RunEventMixing(LegPool& pool, ULong_t mixingMask, Int_t type, Float_t* values);
+  void MixLegWithEvent(const Float_t* leg, ULong_t testFlags1, const LegPool& pool, Int_t legId, Int_t iev, 
+                       Int_t pairType, Int_t type, Float_t* values);
+  void AddEventToPool(LegPool& pool, TList* leg1List, TList* leg2List);
+  void CleanPool(LegPool& pool, ULong_t mixingMask);
+  void ResolveHistClassIds();
   ULong_t IncrementPoolSizes(TList* list1, TList* list2, Int_t eventCategory);
   void ResetPoolSizes(ULong_t mixingMask, Int_t category);  
   
-  ClassDef(AliMixingHandler,4);
+  ClassDef(AliMixingHandler,5);
 };
 
 #endif
@@ -61,7 +61,9 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee() :
   fClusterTrackMatcherMultipleMatchesBefore(0x0),
   fClusterTrackMatcherMultipleMatchesAfter(0x0),
   fSkipMCEvent(kFALSE),
-  fMCJpsiPtWeights(0x0)
+  fMCJpsiPtWeights(0x0),
+  fPairClassNames(),
+  fPairClassIds()
 {
   //
   // default constructor
@@ -103,7 +105,9 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
   fClusterTrackMatcherMultipleMatchesBefore(0x0),
   fClusterTrackMatcherMultipleMatchesAfter(0x0),
   fSkipMCEvent(kFALSE),
-  fMCJpsiPtWeights(0x0)
+  fMCJpsiPtWeights(0x0),
+  fPairClassNames(),
+  fPairClassIds()
 {
   //
   // named constructor
@@ -559,19 +563,16 @@ void AliReducedAnalysisJpsi2ee::FillPairHistograms(ULong_t trackMask, ULong_t pa
    //
    // fill pair level histograms
    // NOTE: pairType can be 0,1 or 2 corresponding to ++, +- or -- pairs
-   TString typeStr[3] = {"PP", "PM", "MM"};
+   Int_t nMCcuts = fLegCandidatesMCcuts.GetEntries();
    if (fPairCuts.GetEntries()>1) {
       for(Int_t iTrackCut=0; iTrackCut<fTrackCuts.GetEntries(); ++iTrackCut) {
          for(Int_t iPairCut=0; iPairCut<fPairCuts.GetEntries(); ++iPairCut) {
             if((trackMask & (ULong_t(1)<<iTrackCut)) && (pairMask & (ULong_t(1)<<iPairCut))) {
-               fHistosManager->FillHistClass(Form("%s%s_%s_%s", pairClass.Data(), typeStr[pairType].Data(),
-                                                  fTrackCuts.At(iTrackCut)->GetName(), fPairCuts.At(iPairCut)->GetName()), fValues);
+               fHistosManager->FillHistClass(GetPairHistClassId(pairClass, pairType, iTrackCut, iPairCut, -1), fValues);
                if(mcDecisions && pairType==1) {
-                  for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
+                  for(Int_t iMC=0; iMC<=nMCcuts; ++iMC) {
                      if(mcDecisions & (UInt_t(1)<<iMC))
-                        fHistosManager->FillHistClass(Form("%s%s_%s_%s_%s", pairClass.Data(), typeStr[pairType].Data(),
-                                                           fTrackCuts.At(iTrackCut)->GetName(), fPairCuts.At(iPairCut)->GetName(),
-                                                           fLegCandidatesMCcuts.At(iMC)->GetName()), fValues);
+                        fHistosManager->FillHistClass(GetPairHistClassId(pairClass, pairType, iTrackCut, iPairCut, iMC), fValues);
                   }
                }
             }
@@ -580,11 +581,11 @@ void AliReducedAnalysisJpsi2ee::FillPairHistograms(ULong_t trackMask, ULong_t pa
    } else {
       for(Int_t iTrackCut=0; iTrackCut<fTrackCuts.GetEntries(); ++iTrackCut) {
          if(trackMask & (ULong_t(1)<<iTrackCut)) {
-            fHistosManager->FillHistClass(Form("%s%s_%s", pairClass.Data(), typeStr[pairType].Data(), fTrackCuts.At(iTrackCut)->GetName()), fValues);
+            fHistosManager->FillHistClass(GetPairHistClassId(pairClass, pairType, iTrackCut, 0, -1), fValues);
             if(mcDecisions && pairType==1) {
-               for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
+               for(Int_t iMC=0; iMC<=nMCcuts; ++iMC) {
                   if(mcDecisions & (UInt_t(1)<<iMC))
-                     fHistosManager->FillHistClass(Form("%s%s_%s_%s", pairClass.Data(), typeStr[pairType].Data(), fTrackCuts.At(iTrackCut)->GetName(), fLegCandidatesMCcuts.At(iMC)->GetName()), fValues);
+                     fHistosManager->FillHistClass(GetPairHistClassId(pairClass, pairType, iTrackCut, 0, iMC), fValues);
                }
             }
          }
@@ -592,6 +593,43 @@ void AliReducedAnalysisJpsi2ee::FillPairHistograms(ULong_t trackMask, ULong_t pa
    }
 }
 
+//___________________________________________________________________________
+Int_t AliReducedAnalysisJpsi2ee::GetPairHistClassId(const TString& pairClass, Int_t pairType, Int_t iTrackCut, Int_t iPairCut, Int_t iMC) {
+   //
+   // histogram manager id of a pair histogram class; the class names are built only once
+   // per pair class prefix and cut combination, afterwards the id is taken from the cache
+   // NOTE: iMC = -1 selects the class without MC selection
+   //
+   if(iMC>=fLegCandidatesMCcuts.GetEntries()) return -1;      // no leg candidate MC cut with this index
+   Int_t nTrackCuts = fTrackCuts.GetEntries();
+   Int_t nPairCuts = (fPairCuts.GetEntries()>1 ? fPairCuts.GetEntries() : 1);
+   Int_t nMCslots = fLegCandidatesMCcuts.GetEntries()+1;
+   
+   UInt_t iClass = 0;
+   for(; iClass<fPairClassNames.size(); ++iClass)
+      if(fPairClassNames[iClass]==pairClass) break;
+   if(iClass==fPairClassNames.size()) {
+      fPairClassNames.push_back(pairClass);
+      fPairClassIds.push_back(std::vector<Int_t>(3*nTrackCuts*nPairCuts*nMCslots, -2));
+   }
+   
+   Int_t& id = fPairClassIds[iClass][((pairType*nTrackCuts+iTrackCut)*nPairCuts+iPairCut)*nMCslots+iMC+1];
+   if(id>-2) return id;
+   
+   TString typeStr[3] = {"PP", "PM", "MM"};
+   TString className = Form("%s%s_%s", pairClass.Data(), typeStr[pairType].Data(), fTrackCuts.At(iTrackCut)->GetName());
+   if(fPairCuts.GetEntries()>1) {
+      className += "_";
+      className += fPairCuts.At(iPairCut)->GetName();
+   }
+   if(iMC>=0) {
+      className += "_";
+      className += fLegCandidatesMCcuts.At(iMC)->GetName();
+   }
+   id = fHistosManager->GetHistClassId(className.Data());
+   return id;
+}
+
 //___________________________________________________________________________
 void AliReducedAnalysisJpsi2ee::FillClusterHistograms(TString clusterClass/*="CaloCluster"*/) {
   //
@@ -6,6 +6,9 @@
 #define ALIREDUCEDANALYSISJPSI2EE_H
 
 #include <TList.h>
+#include <TString.h>
+
+#include <vector>
 
 #include "AliReducedAnalysisTaskSE.h"
 #include "AliReducedInfoCut.h"
@@ -158,6 +161,7 @@ protected:
   void FillTrackHistograms(TString trackClass = "Track");
   void FillTrackHistograms(AliReducedBaseTrack* track, TString trackClass = "Track");
   void FillPairHistograms(ULong_t trackMask, ULong_t pairMask, Int_t pairType, TString pairClass = "PairSE", UInt_t mcDecisions = 0);
+  Int_t GetPairHistClassId(const TString& pairClass, Int_t pairType, Int_t iTrackCut, Int_t iPairCut, Int_t iMC);
   void FillClusterHistograms(TString clusterClass="CaloCluster");
   void FillClusterHistograms(AliReducedCaloClusterInfo* cluster, TString clusterClass="CaloCluster");
   void FillMCTruthHistograms();
@@ -169,7 +173,12 @@ protected:
   Bool_t fSkipMCEvent;          // decision to skip MC event
   TH1F*  fMCJpsiPtWeights;            // weights vs pt to reject events depending on the jpsi true pt (needed to re-weights jpsi Pt distribution)
   
-  ClassDef(AliReducedAnalysisJpsi2ee,12);
+  // histogram manager class ids of the pair histogram classes, resolved on first use
+  // per pair class prefix; indexed as [type][track cut][pair cut][MC cut+1] (see GetPairHistClassId())
+  std::vector<TString> fPairClassNames;                 //! pair class prefixes with cached ids
+  std::vector<std::vector<Int_t> > fPairClassIds;       //! cached class ids, -2 if not yet resolved
+  
+  ClassDef(AliReducedAnalysisJpsi2ee,13);
 };
 
 #endif
@@ -2354,19 +2354,47 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
   // type - Parameter encoding the resonance type 
   //        This is needed for making a mass assumption on the legs
   //
+  Float_t leg1[kNMixLegVariables]; Float_t leg2[kNMixLegVariables];
+  FillMixingLegInfo(t1, leg1);
+  FillMixingLegInfo(t2, leg2);
+  FillPairInfoME(leg1, leg2, type, values);
+}
+
+
+//_________________________________________________________________
+void AliReducedVarManager::FillMixingLegInfo(BASETRACK* t, Float_t* leg) {
+  //
+  // fill the compact leg representation (see MixingLegVariables) used in the event mixing pools
+  //
+  leg[kMixLegPx] = t->Px();
+  leg[kMixLegPy] = t->Py();
+  leg[kMixLegPz] = t->Pz();
+  leg[kMixLegPt] = t->Pt();
+  leg[kMixLegP]  = t->P();
+  leg[kMixLegCharge] = t->Charge();
+  leg[kMixLegSPDHit] = (t->IsA()==TRACK::Class() ? ((TRACK*)t)->ITSLayerHit(0) : -1.);
+}
+
+
+//_________________________________________________________________
+void AliReducedVarManager::FillPairInfoME(const Float_t* leg1, const Float_t* leg2, Int_t type, Float_t* values) {
+  //
+  // Fill pair information from 2 legs in the compact mixing representation (see FillMixingLegInfo())
+  // NOTE: This is the pairing kernel of the event mixing; only the variables in use are computed
+  // type - Parameter encoding the resonance type 
+  //        This is needed for making a mass assumption on the legs
+  //
   PAIR p;
-  p.PxPyPz(t1->Px()+t2->Px(), t1->Py()+t2->Py(), t1->Pz()+t2->Pz());
+  p.PxPyPz(leg1[kMixLegPx]+leg2[kMixLegPx], leg1[kMixLegPy]+leg2[kMixLegPy], leg1[kMixLegPz]+leg2[kMixLegPz]);
   p.CandidateId(type);
  
   values[kPairTypeSPD] = -1.;
-   if(t1->IsA()==TRACK::Class() && t2->IsA()==TRACK::Class() ){
-   TRACK* ti1=(TRACK*)t1; TRACK* ti2=(TRACK*)t2;
-   values[kPairTypeSPD] = ti1->ITSLayerHit(0)+ti2->ITSLayerHit(0);
-   }
+  if(leg1[kMixLegSPDHit]>-0.5 && leg2[kMixLegSPDHit]>-0.5)
+    values[kPairTypeSPD] = leg1[kMixLegSPDHit]+leg2[kMixLegSPDHit];
    
-  if(t1->Charge()*t2->Charge()<0) p.PairType(1);
-  else if(t1->Charge()>0)         p.PairType(0);
-  else                            p.PairType(2);
+  if(leg1[kMixLegCharge]*leg2[kMixLegCharge]<0) p.PairType(1);
+  else if(leg1[kMixLegCharge]>0)                p.PairType(0);
+  else                                          p.PairType(2);
   values[kPairType] = p.PairType();
   values[kCandidateId] = type;
   values[kPairChisquare] = -999.;
@@ -2376,14 +2404,14 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
     
   if(fgUsedVars[kMass]) {     
     values[kMass] = m1*m1+m2*m2 + 
-                    2.0*(TMath::Sqrt(m1*m1+t1->P()*t1->P())*TMath::Sqrt(m2*m2+t2->P()*t2->P()) - 
-                    t1->Px()*t2->Px() - t1->Py()*t2->Py() - t1->Pz()*t2->Pz());
+                    2.0*(TMath::Sqrt(m1*m1+leg1[kMixLegP]*leg1[kMixLegP])*TMath::Sqrt(m2*m2+leg2[kMixLegP]*leg2[kMixLegP]) - 
+                    leg1[kMixLegPx]*leg2[kMixLegPx] - leg1[kMixLegPy]*leg2[kMixLegPy] - leg1[kMixLegPz]*leg2[kMixLegPz]);
     if(values[kMass]<0.0) {
       cout << "FillPairInfoME(track, track, type, values): Warning: Very small squared mass found. "
            << "   Could be negative due to resolution of Float_t so it will be set to a small positive value." << endl; 
       cout << "   mass2: " << values[kMass] << endl;
-      cout << "p1(p,x,y,z): " << t1->P() << ", " << t1->Px() << ", " << t1->Py() << ", " << t1->Pz() << endl;
-      cout << "p2(p,x,y,z): " << t2->P() << ", " << t2->Px() << ", " << t2->Py() << ", " << t2->Pz() << endl;
+      cout << "p1(p,x,y,z): " << leg1[kMixLegP] << ", " << leg1[kMixLegPx] << ", " << leg1[kMixLegPy] << ", " << leg1[kMixLegPz] << endl;
+      cout << "p2(p,x,y,z): " << leg2[kMixLegP] << ", " << leg2[kMixLegPx] << ", " << leg2[kMixLegPy] << ", " << leg2[kMixLegPz] << endl;
       values[kMass] = 0.0;
     }
     else
@@ -2398,9 +2426,9 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
     values[kPt] = p.Pt();
     if(fgUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
   }
-  values[kPairLegPt] = t1->Pt();
-  values[kPairLegPt+1] = t2->Pt();
-  values[kPairLegPtSum] = t1->Pt() + t2->Pt();
+  values[kPairLegPt] = leg1[kMixLegPt];
+  values[kPairLegPt+1] = leg2[kMixLegPt];
+  values[kPairLegPtSum] = leg1[kMixLegPt] + leg2[kMixLegPt];
   if(fgUsedVars[kP])      values[kP]      = p.P();
   if(fgUsedVars[kEta])    values[kEta]    = p.Eta();
   if(fgUsedVars[kRap])    values[kRap]    = p.Rapidity();
@@ -190,6 +190,18 @@ class AliReducedVarManager : public TObject {
    kPoissonSmearing,
    kNSmearingMethods
   };
+  
+  // compact leg representation used by the event mixing pools (see FillMixingLegInfo())
+  enum MixingLegVariables {
+   kMixLegPx=0,
+   kMixLegPy,
+   kMixLegPz,
+   kMixLegPt,
+   kMixLegP,
+   kMixLegCharge,
+   kMixLegSPDHit,          // hit in the first ITS layer, -1 if the leg is not an AliReducedTrackInfo
+   kNMixLegVariables
+  };
 
   
   static const Float_t fgkParticleMass[kNSpecies];
@@ -739,6 +751,8 @@ class AliReducedVarManager : public TObject {
   static void FillPairInfo(AliReducedBaseTrack* t1, AliReducedBaseTrack* t2, Int_t type, Float_t* values);
   static void FillPairInfo(AliReducedPairInfo* leg1, AliReducedBaseTrack* leg2, Int_t type, Float_t* values);
   static void FillPairInfoME(AliReducedBaseTrack* t1, AliReducedBaseTrack* t2, Int_t type, Float_t* values);
+  static void FillPairInfoME(const Float_t* leg1, const Float_t* leg2, Int_t type, Float_t* values);
+  static void FillMixingLegInfo(AliReducedBaseTrack* t, Float_t* leg);
   static void FillCorrelationInfo(AliReducedBaseTrack* p, AliReducedBaseTrack* t, Float_t* values);
   static void FillCaloClusterInfo(AliReducedCaloClusterInfo* cl, Float_t* values);
   static void FillTrackingStatus(AliReducedTrackInfo* p, Float_t* values);
@@ -47,7 +47,8 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	fBGEvents(),
 	fBGEventsENeg(),
 	fBGEventsMeson(),
-	fBGEventsMCParticle()
+	fBGEventsMCParticle(),
+	fBGPhotons()
 {
 	// constructor
 }
@@ -70,7 +71,8 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t binsZ,Int_t
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
-	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents)))
+	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents))),
+	fBGPhotons()
 {
 	// constructor
 }
@@ -95,7 +97,8 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t collisionSy
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
-	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents)))
+	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents))),
+	fBGPhotons()
 {
 	// constructor
     if(fNBinsMultiplicity>5) fNBinsMultiplicity = 5;
@@ -400,7 +403,8 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(const AliGammaCon
 	fBGEvents(original.fBGEvents),
 	fBGEventsENeg(original.fBGEventsENeg),
 	fBGEventsMeson(original.fBGEventsMeson),
-	fBGEventsMCParticle(original.fBGEventsMCParticle)
+	fBGEventsMCParticle(original.fBGEventsMCParticle),
+	fBGPhotons(original.fBGPhotons)
 {
 	//copy constructor	
 }
@@ -567,6 +571,9 @@ void AliGammaConversionAODBGHandler::Initialize(Double_t * const zBinLimitsArray
         }
 
 
+	// value-based photon pool; the slots keep their capacity when they are refilled
+	fBGPhotons.assign(fNBinsZ*fNBinsMultiplicity*fNEvents,AliGammaConversionBGPhotonVector());
+
 	if(fBGProbability == NULL){
 		fBGProbability = new Double_t*[fNBinsZ];
 	}
@@ -789,6 +796,51 @@ void AliGammaConversionAODBGHandler::AddMCParticleEvent(TList* const eventGammas
 	}
 	fBGMCParticleEventCounter[z][m]++;
 }
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::AddPhotonEvent(TList* const eventGammas,Double_t xvalue, Double_t yvalue, Double_t zvalue, Int_t multiplicity, Double_t epvalue){
+
+	// same bookkeeping as AddEvent, but only the kinematics needed for the
+	// mixed-event mother are kept, in place of a heap copy of every photon
+	Int_t z = GetZBinIndex(zvalue);
+	Int_t m = GetMultiplicityBinIndex(multiplicity);
+
+	if(fBGEventCounter[z][m] >= fNEvents){
+		fBGEventCounter[z][m]=0;
+	}
+	Int_t eventCounter=fBGEventCounter[z][m];
+
+	fBGEventVertex[z][m][eventCounter].fX = xvalue;
+	fBGEventVertex[z][m][eventCounter].fY = yvalue;
+	fBGEventVertex[z][m][eventCounter].fZ = zvalue;
+	fBGEventVertex[z][m][eventCounter].fEP = epvalue;
+
+	AliGammaConversionBGPhotonVector &slot = fBGPhotons[(z*fNBinsMultiplicity+m)*fNEvents+eventCounter];
+	slot.clear();
+	for(Int_t i=0; i< eventGammas->GetEntries();i++){
+		AliAODConversionPhoton *gamma = (AliAODConversionPhoton*)(eventGammas->At(i));
+		GammaConversionBGPhoton stored;
+		stored.fPx = gamma->Px();
+		stored.fPy = gamma->Py();
+		stored.fPz = gamma->Pz();
+		stored.fE = gamma->E();
+		stored.fConvX = gamma->GetConversionX();
+		stored.fConvY = gamma->GetConversionY();
+		stored.fConvZ = gamma->GetConversionZ();
+		stored.fQuality = gamma->GetPhotonQuality();
+		slot.push_back(stored);
+	}
+	fBGEventCounter[z][m]++;
+}
+
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::SetBGPhoton(AliAODConversionPhoton *photon, const GammaConversionBGPhoton &stored){
+	// load a stored photon into a reusable photon object
+	photon->SetPxPyPzE(stored.fPx,stored.fPy,stored.fPz,stored.fE);
+	Double_t convPoint[3] = {stored.fConvX,stored.fConvY,stored.fConvZ};
+	photon->SetConversionPoint(convPoint);
+	photon->SetPhotonQuality(stored.fQuality);
+}
+
 //_____________________________________________________________________________________________________________________________
 AliGammaConversionAODVector* AliGammaConversionAODBGHandler::GetBGGoodV0s(Int_t zbin, Int_t mbin, Int_t event){
 	//see headerfile for documentation
@@ -38,6 +38,21 @@ class AliGammaConversionAODBGHandler : public TObject {
 	
 	typedef struct GammaConversionVertex GammaConversionVertex; 																//!
 
+	// kinematic payload of a stored photon, enough to rebuild the mixed-event mother
+	struct GammaConversionBGPhoton{
+		Double_t fPx;
+		Double_t fPy;
+		Double_t fPz;
+		Double_t fE;
+		Double_t fConvX;
+		Double_t fConvY;
+		Double_t fConvZ;
+		UChar_t fQuality;
+	};
+
+	typedef struct GammaConversionBGPhoton GammaConversionBGPhoton;															//!
+	typedef std::vector<GammaConversionBGPhoton> AliGammaConversionBGPhotonVector;
+
 	typedef std::vector<AliGammaConversionAODVector> AliGammaConversionBGEventVector;
 	typedef std::vector<AliGammaConversionBGEventVector> AliGammaConversionMultipicityVector;
 	typedef std::vector<AliGammaConversionMultipicityVector> AliGammaConversionBGVector;
@@ -71,6 +86,7 @@ class AliGammaConversionAODBGHandler : public TObject {
 	void AddMesonEvent(const std::vector<AliAODConversionMother> &eventMother, Double_t xvalue, Double_t yvalue, Double_t zvalue, Int_t multiplicity, Double_t epvalue = -100);
 	void AddElectronEvent(TClonesArray* const eventENeg, Double_t zvalue, Int_t multiplicity);
         void AddMCParticleEvent(TList* const eventGammas, Double_t xvalue,Double_t yvalue,Double_t zvalue, Int_t multiplicity, Double_t epvalue = -100);
+	void AddPhotonEvent(TList* const eventGammas, Double_t xvalue,Double_t yvalue,Double_t zvalue, Int_t multiplicity, Double_t epvalue = -100);
 
 	Int_t GetNBGEvents()const {return fNEvents;}
 
@@ -78,6 +94,10 @@ class AliGammaConversionAODBGHandler : public TObject {
 	AliGammaConversionAODVector* GetBGGoodV0s(Int_t zbin, Int_t mbin, Int_t event);
         AliAODMCParticleVector* GetBGGoodV0sMC(Int_t zbin, Int_t mbin, Int_t event);
 	
+	// Get BG photons stored by value with AddPhotonEvent
+	const AliGammaConversionBGPhotonVector* GetBGPhotons(Int_t zbin, Int_t mbin, Int_t event) const {return &fBGPhotons[(zbin*fNBinsMultiplicity+mbin)*fNEvents+event];}
+	static void SetBGPhoton(AliAODConversionPhoton *photon, const GammaConversionBGPhoton &stored);
+
 	// Get BG mesons
 	AliGammaConversionMotherAODVector* GetBGGoodMesons(Int_t zbin, Int_t mbin, Int_t event);
 	
@@ -108,7 +128,8 @@ class AliGammaConversionAODBGHandler : public TObject {
 		AliGammaConversionBGVector 			fBGEventsENeg; 					// electron background electron events
 		AliGammaConversionMotherBGVector                fBGEventsMeson; 				// neutral meson background events
 		AliAODMCParticleBGVector 	                fBGEventsMCParticle; 				// MC Particle background events
+		std::vector<AliGammaConversionBGPhotonVector>	fBGPhotons;					//! photon background events by value, one slot per (z, mult, event)
 		
-	ClassDef(AliGammaConversionAODBGHandler,8)
+	ClassDef(AliGammaConversionAODBGHandler,9)
 };
 #endif
@@ -36,6 +36,7 @@
 #include "TH1F.h"
 #include "TF1.h"
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <utility>
@@ -47,6 +48,69 @@ using namespace std;
 
 ClassImp(AliCaloTrackMatcher)
 
+//________________________________________________________________________
+void AliCaloTrackMatchTable::Clear(){
+  fTrackKey.clear();
+  fTrackID.clear();
+  fClusterID.clear();
+  fDEta.clear();
+  fDPhi.clear();
+  fClusterNext.clear();
+  fTrackNext.clear();
+  fClusterRows.clear();
+  fTrackRows.clear();
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatchTable::Reserve(Int_t n){
+  fTrackKey.reserve(n);
+  fTrackID.reserve(n);
+  fClusterID.reserve(n);
+  fDEta.reserve(n);
+  fDPhi.reserve(n);
+  fClusterNext.reserve(n);
+  fTrackNext.reserve(n);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatchTable::AddMatch(Int_t trackKey, Int_t trackID, Int_t clusterID, Float_t dEta, Float_t dPhi){
+  Int_t i = fTrackKey.size();
+  fTrackKey.push_back(trackKey);
+  fTrackID.push_back(trackID);
+  fClusterID.push_back(clusterID);
+  fDEta.push_back(dEta);
+  fDPhi.push_back(dPhi);
+  AppendToRow(fClusterRows,fClusterNext,clusterID,i);
+  AppendToRow(fTrackRows,fTrackNext,trackKey,i);
+  return i;
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatchTable::AppendToRow(rowMap &rows, vector<Int_t> &next, Int_t key, Int_t i){
+  // link entry i at the end of the row of key
+  next.push_back(-1);
+  pair<rowMap::iterator,Bool_t> ins = rows.insert(make_pair(key,make_pair(i,i)));
+  if(!ins.second){
+    next[ins.first->second.second] = i;
+    ins.first->second.second = i;
+  }
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatchTable::RowFirst(const rowMap &rows, Int_t key){
+  rowMap::const_iterator it = rows.find(key);
+  return (it == rows.end()) ? -1 : it->second.first;
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatchTable::FindMatch(Int_t trackID, Int_t clusterID) const {
+  Int_t found = -1;
+  for(Int_t i = GetClusterRowFirst(clusterID); i >= 0; i = fClusterNext[i]){
+    if(fTrackID[i] == trackID) found = i;
+  }
+  return found;
+}
+
 //________________________________________________________________________
 AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, Int_t runningMode) : AliAnalysisTaskSE(name),
   fClusterType(clusterType),
@@ -59,17 +123,17 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
   fRunNumber(-1),
   fGeomEMCAL(NULL),
   fGeomPHOS(NULL),
-  fMapTrackToCluster(),
-  fMapClusterToTrack(),
-  fNEntries(1),
-  fVectorDeltaEtaDeltaPhi(0),
-  fMap_TrID_ClID_ToIndex(),
-  fSecMapTrackToCluster(),
-  fSecMapClusterToTrack(),
-  fSecNEntries(1),
-  fSecVectorDeltaEtaDeltaPhi(0),
-  fSecMap_TrID_ClID_ToIndex(),
+  fMatches(),
+  fSecMatches(),
   fSecMap_TrID_ClID_AlreadyTried(),
+  fClusterX(),
+  fClusterY(),
+  fClusterZ(),
+  fClusterPhiSorted(),
+  fClusterPhiOrder(),
+  fClusterCandidates(),
+  fTrackPosEvent(NULL),
+  fTrackIDToPos(),
   fListHistos(NULL),
   fHistControlMatches(NULL),
   fSecHistControlMatches(NULL)
@@ -84,15 +148,8 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
 //________________________________________________________________________
 AliCaloTrackMatcher::~AliCaloTrackMatcher(){
     // default deconstructor
-    fMapTrackToCluster.clear();
-    fMapClusterToTrack.clear();
-    fVectorDeltaEtaDeltaPhi.clear();
-    fMap_TrID_ClID_ToIndex.clear();
-
-    fSecMapTrackToCluster.clear();
-    fSecMapClusterToTrack.clear();
-    fSecVectorDeltaEtaDeltaPhi.clear();
-    fSecMap_TrID_ClID_ToIndex.clear();
+    fMatches.Clear();
+    fSecMatches.Clear();
     fSecMap_TrID_ClID_AlreadyTried.clear();
 
     if(fHistControlMatches) delete fHistControlMatches;
@@ -106,15 +163,8 @@ AliCaloTrackMatcher::~AliCaloTrackMatcher(){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::Terminate(Option_t *){
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
-  fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
-
-  fSecMapTrackToCluster.clear();
-  fSecMapClusterToTrack.clear();
-  fSecVectorDeltaEtaDeltaPhi.clear();
-  fSecMap_TrID_ClID_ToIndex.clear();
+  fMatches.Clear();
+  fSecMatches.Clear();
   fSecMap_TrID_ClID_AlreadyTried.clear();
 }
 
@@ -162,18 +212,11 @@ void AliCaloTrackMatcher::UserCreateOutputObjects(){
 //________________________________________________________________________
 void AliCaloTrackMatcher::Initialize(Int_t runNumber){
   // Initialize function to be called once before analysis
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
-  fNEntries = 1;
-  fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
-
-  fSecMapTrackToCluster.clear();
-  fSecMapClusterToTrack.clear();
-  fSecNEntries = 1;
-  fSecVectorDeltaEtaDeltaPhi.clear();
-  fSecMap_TrID_ClID_ToIndex.clear();
+  fMatches.Clear();
+  fSecMatches.Clear();
   fSecMap_TrID_ClID_AlreadyTried.clear();
+  fTrackPosEvent = NULL;
+  fTrackIDToPos.clear();
 
   if(fRunNumber == -1 || fRunNumber != runNumber){
     if(fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
@@ -233,6 +276,41 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       return;
     }
   }
+
+  // cache the cluster positions once per event and order them in phi,
+  // so that each track only visits the clusters near its impact point
+  fClusterX.assign(nClus,0.);
+  fClusterY.assign(nClus,0.);
+  fClusterZ.assign(nClus,0.);
+  fClusterPhiOrder.clear();
+  vector<pair<Float_t,Int_t> > phiIndex;
+  phiIndex.reserve(nClus);
+  Double_t clusterRMin = -1;
+  for(Int_t iclus=0;iclus < nClus;iclus++){
+    AliVCluster* cluster = NULL;
+    if(arrClusters)
+      cluster = (AliVCluster*)arrClusters->At(iclus);
+    else
+      cluster = event->GetCaloCluster(iclus);
+    if (!cluster) continue;
+    Float_t clsPos[3] = {0.,0.,0.};
+    cluster->GetPosition(clsPos);
+    fClusterX[iclus] = clsPos[0];
+    fClusterY[iclus] = clsPos[1];
+    fClusterZ[iclus] = clsPos[2];
+    phiIndex.push_back(make_pair((Float_t)TMath::ATan2(clsPos[1],clsPos[0]),iclus));
+    Double_t clusterR = TMath::Sqrt(clsPos[0]*clsPos[0]+clsPos[1]*clsPos[1]);
+    if(clusterRMin < 0 || clusterR < clusterRMin) clusterRMin = clusterR;
+  }
+  sort(phiIndex.begin(),phiIndex.end());
+  fClusterPhiSorted.resize(phiIndex.size());
+  fClusterPhiOrder.resize(phiIndex.size());
+  for(UInt_t i=0;i < phiIndex.size();i++){
+    fClusterPhiSorted[i] = phiIndex[i].first;
+    fClusterPhiOrder[i] = phiIndex[i].second;
+  }
+  fMatches.Reserve(nClus);
+
   static AliESDtrackCuts *EsdTrackCuts = 0x0;
   static int prevRun = -1;
   // Using standard function for setting Cuts
@@ -430,51 +508,34 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     // cout << "eta/phi: " << eta << ", " << phi << endl;
     // cout << "nClus: " << nClus << endl;
     Int_t nClusterMatchesToTrack = 0;
-    for(Int_t iclus=0;iclus < nClus;iclus++){
+    FillClusterCandidates(exPos, clusterRMin);
+    for(UInt_t icand=0;icand < fClusterCandidates.size();icand++){
+      Int_t iclus = fClusterCandidates[icand];
       AliVCluster* cluster = NULL;
-      if(arrClusters){
-        if(esdev){
-          if(arrClusters)
-            cluster = new AliESDCaloCluster(*(AliESDCaloCluster*)arrClusters->At(iclus));
-        } else if(aodev){
-          if(arrClusters)
-            cluster = new AliAODCaloCluster(*(AliAODCaloCluster*)arrClusters->At(iclus));
-        }
-      }
+      if(arrClusters)
+        cluster = (AliVCluster*)arrClusters->At(iclus);
       else
         cluster = event->GetCaloCluster(iclus);
-      if (!cluster){
-        if(arrClusters) delete cluster;
-        continue;
-      }
+      if (!cluster) continue;
       // cout << "-------------------------LOOPING: " << iclus << ", " << cluster->GetID() << endl;
-      cluster->GetPosition(clsPos);
+      clsPos[0] = fClusterX[iclus];
+      clsPos[1] = fClusterY[iclus];
+      clsPos[2] = fClusterZ[iclus];
       Double_t dR = TMath::Sqrt(TMath::Power(exPos[0]-clsPos[0],2)+TMath::Power(exPos[1]-clsPos[1],2)+TMath::Power(exPos[2]-clsPos[2],2));
       //cout << "dR: " << dR << endl;
-      if (dR > fMatchingWindow){
-        if(arrClusters) delete cluster;
-        continue;
-      }
+      if (dR > fMatchingWindow) continue;
       Double_t clusterR = TMath::Sqrt( clsPos[0]*clsPos[0] + clsPos[1]*clsPos[1] );
       AliExternalTrackParam trackParamTmp(emcParam);//Retrieve the starting point every time before the extrapolation
       if(fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
-        if (!cluster->IsEMCAL()){
-          if(arrClusters) delete cluster;
-          continue;
-        }
+        if (!cluster->IsEMCAL()) continue;
         if(!AliEMCALRecoUtils::ExtrapolateTrackToCluster(&trackParamTmp, cluster, 0.139, 5., dEta, dPhi)){
           fHistControlMatches->Fill(4.,inTrack->Pt());
-          if(arrClusters) delete cluster;
           continue;
         }
       }else if(fClusterType == 2){
-        if (!cluster->IsPHOS()){
-          if(arrClusters) delete cluster;
-          continue;
-        }
+        if (!cluster->IsPHOS()) continue;
         if(!AliTrackerBase::PropagateTrackToBxByBz(&trackParamTmp, clusterR, 0.139, 5., kTRUE, 0.8, -1)){
           fHistControlMatches->Fill(4.,inTrack->Pt());
-          if(arrClusters) delete cluster;
           continue;
         }
         Double_t trkPos[3] = {0,0,0};
@@ -488,22 +549,10 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       Float_t dR2 = dPhi*dPhi + dEta*dEta;
 
       //cout << dEta << " - " << dPhi << " - " << dR2 << endl;
-      if(dR2 > fMatchingResidual){
-        if(arrClusters) delete cluster;
-        continue;
-      }
+      if(dR2 > fMatchingResidual) continue;
       nClusterMatchesToTrack++;
-      if(aodev){
-        fMapTrackToCluster.insert(make_pair(itr,cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),itr));
-      }else{
-        fMapTrackToCluster.insert(make_pair(inTrack->GetID(),cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),inTrack->GetID()));
-      }
-      fVectorDeltaEtaDeltaPhi.push_back(make_pair(dEta,dPhi));
-      fMap_TrID_ClID_ToIndex[make_pair(inTrack->GetID(),cluster->GetID())] = fNEntries++;
-      if( (Int_t)fVectorDeltaEtaDeltaPhi.size() != (fNEntries-1)) AliFatal("Fatal error in AliCaloTrackMatcher, vector and map are not in sync!");
-      if(arrClusters) delete cluster;
+      // track side is keyed by the position in the event for AODs and by the ID for ESDs
+      fMatches.AddMatch(aodev ? itr : inTrack->GetID(), inTrack->GetID(), cluster->GetID(), dEta, dPhi);
     }
     if(nClusterMatchesToTrack == 0) fHistControlMatches->Fill(5.,inTrack->Pt());
     else fHistControlMatches->Fill(6.,inTrack->Pt());
@@ -513,6 +562,39 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
   return;
 }
 
+//________________________________________________________________________
+void AliCaloTrackMatcher::FillClusterCandidates(const Double_t *exPos, Double_t rMin){
+  // Clusters which can be within fMatchingWindow of the extrapolated track
+  // position, in ascending index order. In the transverse plane two points
+  // at radii r1, r2 and azimuthal distance dphi are at least
+  // 2*sqrt(r1*r2)*sin(dphi/2) apart, which bounds dphi from the smallest
+  // cluster radius rMin. The exact window cut is applied by the caller.
+  fClusterCandidates.clear();
+  Int_t nSorted = fClusterPhiSorted.size();
+  if(nSorted == 0) return;
+
+  Double_t rTrack = TMath::Sqrt(exPos[0]*exPos[0]+exPos[1]*exPos[1]);
+  Double_t scale = 2*TMath::Sqrt(rTrack*rMin);
+  if(scale <= 0 || fMatchingWindow >= scale){
+    fClusterCandidates.assign(fClusterPhiOrder.begin(),fClusterPhiOrder.end());
+    sort(fClusterCandidates.begin(),fClusterCandidates.end());
+  } else {
+    Double_t dPhiMax = 2*TMath::ASin(fMatchingWindow/scale) + 1e-3; // margin for float positions
+    Double_t phiTrack = TMath::ATan2(exPos[1],exPos[0]);
+    for(Int_t shift = -1; shift <= 1; shift++){ // periodic images of the window
+      Double_t lo = phiTrack - dPhiMax + shift*TMath::TwoPi();
+      Double_t hi = phiTrack + dPhiMax + shift*TMath::TwoPi();
+      if(hi < -TMath::Pi() || lo > TMath::Pi()) continue;
+      vector<Float_t>::const_iterator first = lower_bound(fClusterPhiSorted.begin(),fClusterPhiSorted.end(),lo);
+      vector<Float_t>::const_iterator last  = upper_bound(fClusterPhiSorted.begin(),fClusterPhiSorted.end(),hi);
+      for(vector<Float_t>::const_iterator it = first; it < last; ++it)
+        fClusterCandidates.push_back(fClusterPhiOrder[it-fClusterPhiSorted.begin()]);
+    }
+    sort(fClusterCandidates.begin(),fClusterCandidates.end());
+    fClusterCandidates.erase(unique(fClusterCandidates.begin(),fClusterCandidates.end()),fClusterCandidates.end());
+  }
+}
+
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliVTrack* inSecTrack, AliVCluster* cluster, AliVEvent* event, Float_t &dEta, Float_t &dPhi){
 
@@ -705,24 +787,12 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
 
     if(aodev){
       //need to search for position in case of AOD
-      Int_t TrackPos = -1;
-      for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-        AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-        if(currTrack->GetID() == inSecTrack->GetID()){
-          TrackPos = iTrack;
-          break;
-        }
-      }
+      Int_t TrackPos = GetTrackPosition(event,inSecTrack->GetID());
       if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: PropagateV0TrackToClusterAndGetMatchingResidual - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",inSecTrack->GetID()));
-      fSecMapTrackToCluster.insert(make_pair(TrackPos,cluster->GetID()));
-      fSecMapClusterToTrack.insert(make_pair(cluster->GetID(),TrackPos));
+      fSecMatches.AddMatch(TrackPos,inSecTrack->GetID(),cluster->GetID(),dEtaTemp,dPhiTemp);
     }else{
-      fSecMapTrackToCluster.insert(make_pair(inSecTrack->GetID(),cluster->GetID()));
-      fSecMapClusterToTrack.insert(make_pair(cluster->GetID(),inSecTrack->GetID()));
+      fSecMatches.AddMatch(inSecTrack->GetID(),inSecTrack->GetID(),cluster->GetID(),dEtaTemp,dPhiTemp);
     }
-    fSecVectorDeltaEtaDeltaPhi.push_back(make_pair(dEtaTemp,dPhiTemp));
-    fSecMap_TrID_ClID_ToIndex[make_pair(inSecTrack->GetID(),cluster->GetID())] = fSecNEntries++;
-    if( (Int_t)fSecVectorDeltaEtaDeltaPhi.size() != (fSecNEntries-1)) AliFatal("Fatal error in AliCaloTrackMatcher, vector and map are not in sync!");
 
     fSecHistControlMatches->Fill(6.,inSecTrack->Pt());
     dEta = dEtaTemp;
@@ -740,33 +810,51 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
 //________________________________________________________________________
 //________________________________________________________________________
 //________________________________________________________________________
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetTrackPosition(AliVEvent *event, Int_t trackID){
+  // position of the first track with the given ID in the event, -1 if not
+  // found; the (ID, position) table is built once per event and reset
+  // in Initialize()
+  if(event != fTrackPosEvent){
+    fTrackPosEvent = event;
+    fTrackIDToPos.clear();
+    fTrackIDToPos.reserve(event->GetNumberOfTracks());
+    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
+      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
+      if(!currTrack) continue;
+      fTrackIDToPos.push_back(make_pair(currTrack->GetID(),iTrack));
+    }
+    // sorting (ID, position) keeps the first position of duplicated IDs in front
+    sort(fTrackIDToPos.begin(),fTrackIDToPos.end());
+  }
+  vector<pairInt>::const_iterator it = lower_bound(fTrackIDToPos.begin(),fTrackIDToPos.end(),make_pair(trackID,-1));
+  if(it == fTrackIDToPos.end() || it->first != trackID) return -1;
+  return it->second;
+}
+
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  Int_t position = fMatches.FindMatch(trackID,clusterID);
+  if(position < 0) return kFALSE;
 
-  pairFloat tempEtaPhi = fVectorDeltaEtaDeltaPhi.at(position-1);
-  dEta = tempEtaPhi.first;
-  dPhi = tempEtaPhi.second;
+  dEta = fMatches.GetDEta(position);
+  dPhi = fMatches.GetDPhi(position);
   return kTRUE;
 }
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
+  for (Int_t entry = fMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      if(tempTrack->Charge()>0){
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
+      }else if(tempTrack->Charge()<0){
+        dPhiMin*=-1;
+        dPhiMax*=-1;
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
       }
     }
   }
@@ -777,23 +865,20 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )matched++;
-      }
+  for (Int_t entry = fMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      Bool_t match_dEta = kFALSE;
+      Bool_t match_dPhi = kFALSE;
+      if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+      else match_dEta = kFALSE;
+
+      if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+      else match_dPhi = kFALSE;
+
+      if (match_dPhi && match_dEta )matched++;
     }
   }
   return matched;
@@ -802,15 +887,12 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
+  for (Int_t entry = fMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
     }
   }
   return matched;
@@ -821,31 +903,22 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
+  for (Int_t entry = fMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      if(tempTrack->Charge()>0){
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
+      }else if(tempTrack->Charge()<0){
+        dPhiMin*=-1;
+        dPhiMax*=-1;
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
       }
     }
   }
@@ -856,35 +929,26 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
+  for (Int_t entry = fMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      Bool_t match_dEta = kFALSE;
+      Bool_t match_dPhi = kFALSE;
+      if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+      else match_dEta = kFALSE;
 
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
+      if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+      else match_dPhi = kFALSE;
 
-        if (match_dPhi && match_dEta )matched++;
+      if (match_dPhi && match_dEta )matched++;
 
-      }
     }
   }
   return matched;
@@ -894,26 +958,17 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
+  for (Int_t entry = fMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
     }
   }
   return matched;
@@ -922,20 +977,17 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }
+  for (Int_t entry = fMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      if(tempTrack->Charge()>0){
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(fMatches.GetTrackKey(entry));
+      }else if(tempTrack->Charge()<0){
+        dPhiMin*=-1;
+        dPhiMax*=-1;
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(fMatches.GetTrackKey(entry));
       }
     }
   }
@@ -945,24 +997,21 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedTracks.push_back(it->second);
+  for (Int_t entry = fMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      Bool_t match_dEta = kFALSE;
+      Bool_t match_dPhi = kFALSE;
+      if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+      else match_dEta = kFALSE;
+
+      if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+      else match_dPhi = kFALSE;
+
+      if (match_dPhi && match_dEta )tempMatchedTracks.push_back(fMatches.GetTrackKey(entry));
 
-      }
     }
   }
   return tempMatchedTracks;
@@ -971,15 +1020,12 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  Float_t dR){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(it->second);
-      }
+  for (Int_t entry = fMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(fMatches.GetTrackKey(entry));
     }
   }
   return tempMatchedTracks;
@@ -989,31 +1035,22 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }
+  for (Int_t entry = fMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      if(tempTrack->Charge()>0){
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(fMatches.GetClusterID(entry));
+      }else if(tempTrack->Charge()<0){
+        dPhiMin*=-1;
+        dPhiMax*=-1;
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(fMatches.GetClusterID(entry));
       }
     }
   }
@@ -1025,34 +1062,25 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedClusters.push_back(it->second);
-      }
+  for (Int_t entry = fMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      Bool_t match_dEta = kFALSE;
+      Bool_t match_dPhi = kFALSE;
+      if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+      else match_dEta = kFALSE;
+
+      if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+      else match_dPhi = kFALSE;
+
+      if (match_dPhi && match_dEta )tempMatchedClusters.push_back(fMatches.GetClusterID(entry));
     }
   }
   return tempMatchedClusters;
@@ -1062,26 +1090,17 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(it->second);
-      }
+  for (Int_t entry = fMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(fMatches.GetClusterID(entry));
     }
   }
   return tempMatchedClusters;
@@ -1093,37 +1112,33 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetSecTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fSecMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  Int_t position = fSecMatches.FindMatch(trackID,clusterID);
+  if(position < 0) return kFALSE;
 
-  pairFloat tempEtaPhi = fSecVectorDeltaEtaDeltaPhi.at(position-1);
-  dEta = tempEtaPhi.first;
-  dPhi = tempEtaPhi.second;
+  dEta = fSecMatches.GetDEta(position);
+  dPhi = fSecMatches.GetDPhi(position);
   return kTRUE;
 }
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::IsSecTrackClusterAlreadyTried(Int_t trackID, Int_t clusterID){
-  Int_t position = fSecMap_TrID_ClID_AlreadyTried[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  mapT::const_iterator it = fSecMap_TrID_ClID_AlreadyTried.find(make_pair(trackID,clusterID));
+  if(it == fSecMap_TrID_ClID_AlreadyTried.end() || it->second == 0) return kFALSE;
   else return kTRUE;
 }
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
+  for (Int_t entry = fSecMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fSecMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fSecMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      if(tempTrack->Charge()>0){
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
+      }else if(tempTrack->Charge()<0){
+        dPhiMin*=-1;
+        dPhiMax*=-1;
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
       }
     }
   }
@@ -1134,23 +1149,20 @@ Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, In
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )matched++;
-      }
+  for (Int_t entry = fSecMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fSecMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fSecMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      Bool_t match_dEta = kFALSE;
+      Bool_t match_dPhi = kFALSE;
+      if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+      else match_dEta = kFALSE;
+
+      if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+      else match_dPhi = kFALSE;
+
+      if (match_dPhi && match_dEta )matched++;
     }
   }
 
@@ -1160,15 +1172,12 @@ Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, In
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
+  for (Int_t entry = fSecMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fSecMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fSecMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
     }
   }
 
@@ -1179,31 +1188,22 @@ Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, In
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
+  for (Int_t entry = fSecMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fSecMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fSecMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      if(tempTrack->Charge()>0){
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
+      }else if(tempTrack->Charge()<0){
+        dPhiMin*=-1;
+        dPhiMax*=-1;
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
       }
     }
   }
@@ -1215,35 +1215,26 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
+  for (Int_t entry = fSecMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fSecMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fSecMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      Bool_t match_dEta = kFALSE;
+      Bool_t match_dPhi = kFALSE;
+      if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+      else match_dEta = kFALSE;
 
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
+      if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+      else match_dPhi = kFALSE;
 
-        if (match_dPhi && match_dEta )matched++;
+      if (match_dPhi && match_dEta )matched++;
 
-      }
     }
   }
 
@@ -1254,26 +1245,17 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dR){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
+  for (Int_t entry = fSecMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fSecMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fSecMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
     }
   }
 
@@ -1283,20 +1265,17 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }
+  for (Int_t entry = fSecMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fSecMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fSecMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      if(tempTrack->Charge()>0){
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(fSecMatches.GetTrackKey(entry));
+      }else if(tempTrack->Charge()<0){
+        dPhiMin*=-1;
+        dPhiMax*=-1;
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(fSecMatches.GetTrackKey(entry));
       }
     }
   }
@@ -1307,23 +1286,20 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *ev
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedTracks.push_back(it->second);
-      }
+  for (Int_t entry = fSecMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fSecMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fSecMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      Bool_t match_dEta = kFALSE;
+      Bool_t match_dPhi = kFALSE;
+      if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+      else match_dEta = kFALSE;
+
+      if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+      else match_dPhi = kFALSE;
+
+      if (match_dPhi && match_dEta )tempMatchedTracks.push_back(fSecMatches.GetTrackKey(entry));
     }
   }
 
@@ -1333,15 +1309,12 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *ev
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(it->second);
-      }
+  for (Int_t entry = fSecMatches.GetClusterRowFirst(clusterID); entry >= 0; entry = fSecMatches.GetClusterRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fSecMatches.GetTrackKey(entry)));
+    if(!tempTrack) continue;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),clusterID,tempDEta,tempDPhi)){
+      if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(fSecMatches.GetTrackKey(entry));
     }
   }
 
@@ -1352,31 +1325,22 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *ev
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }
+  for (Int_t entry = fSecMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fSecMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fSecMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      if(tempTrack->Charge()>0){
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(fSecMatches.GetClusterID(entry));
+      }else if(tempTrack->Charge()<0){
+        dPhiMin*=-1;
+        dPhiMax*=-1;
+        if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(fSecMatches.GetClusterID(entry));
       }
     }
   }
@@ -1388,34 +1352,25 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedClusters.push_back(it->second);
-      }
+  for (Int_t entry = fSecMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fSecMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fSecMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      Bool_t match_dEta = kFALSE;
+      Bool_t match_dPhi = kFALSE;
+      if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+      else match_dEta = kFALSE;
+
+      if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+      else match_dPhi = kFALSE;
+
+      if (match_dPhi && match_dEta )tempMatchedClusters.push_back(fSecMatches.GetClusterID(entry));
     }
   }
 
@@ -1426,26 +1381,17 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dR){
   Int_t TrackPos = -1;
   if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
+    TrackPos = GetTrackPosition(event,trackID);
     if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
   }else TrackPos = trackID; // for ESD just take trackID
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(it->second);
-      }
+  for (Int_t entry = fSecMatches.GetTrackRowFirst(TrackPos); entry >= 0; entry = fSecMatches.GetTrackRowNext(entry)){
+    Float_t tempDEta, tempDPhi;
+    if(GetTrackClusterMatchingResidual(tempTrack->GetID(),fSecMatches.GetClusterID(entry),tempDEta,tempDPhi)){
+      if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(fSecMatches.GetClusterID(entry));
     }
   }
 
@@ -1486,18 +1432,17 @@ void AliCaloTrackMatcher::SetLogBinningYTH2(TH2* histoRebin){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::DebugV0Matching(){
-  if(fSecVectorDeltaEtaDeltaPhi.size()>0){
+  if(fSecMatches.GetNEntries()>0){
     cout << "******************************" << endl;
     cout << "******************************" << endl;
     cout << "NEW EVENT !" << endl;
     cout << "vector etaphi:" << endl;
-    cout << fSecVectorDeltaEtaDeltaPhi.size() << endl;
-    cout << "multimap" << endl;
-    mapT::iterator iter = fSecMap_TrID_ClID_ToIndex.begin();
-    for (iter = fSecMap_TrID_ClID_ToIndex.begin(); iter != fSecMap_TrID_ClID_ToIndex.end(); ++iter){
+    cout << fSecMatches.GetNEntries() << endl;
+    cout << "matches" << endl;
+    for (Int_t i = 0; i < fSecMatches.GetNEntries(); i++){
       Float_t dEta, dPhi = 0;
-      if(!GetSecTrackClusterMatchingResidual(iter->first.first,iter->first.second,dEta,dPhi)) continue;
-      cout << "  [" << iter->first.first << "/" << iter->first.second << ", " << iter->second << "] - (" << dEta << "/" << dPhi << ")" << endl;
+      if(!GetSecTrackClusterMatchingResidual(fSecMatches.GetTrackID(i),fSecMatches.GetClusterID(i),dEta,dPhi)) continue;
+      cout << "  [" << fSecMatches.GetTrackID(i) << "/" << fSecMatches.GetClusterID(i) << ", " << i << "] - (" << dEta << "/" << dPhi << ")" << endl;
     }
     cout << "mapTrackToCluster" << endl;
     AliESDEvent *esdev = dynamic_cast<AliESDEvent*>(fInputEvent);
@@ -1510,11 +1455,10 @@ void AliCaloTrackMatcher::DebugV0Matching(){
       cout << itr << " (" << tCharge << ") - " << GetNMatchedClusterIDsForSecTrack(fInputEvent,inTrack->GetID(),5,-5,0.2,-0.4) << "\t\t";
     }
     cout << endl;
-    multimap<Int_t,Int_t>::iterator it;
-    for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    for (Int_t i = 0; i < fSecMatches.GetNEntries(); i++) cout << fSecMatches.GetTrackKey(i) << " => " << fSecMatches.GetClusterID(i) << '\n';
     cout << "mapClusterToTrack" << endl;
-    Int_t tempClus = it->second;
-    for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    Int_t tempClus = fSecMatches.GetClusterID(fSecMatches.GetNEntries()-1);
+    for (Int_t i = 0; i < fSecMatches.GetNEntries(); i++) cout << fSecMatches.GetClusterID(i) << " => " << fSecMatches.GetTrackKey(i) << '\n';
     vector<Int_t> tempTracks = GetMatchedSecTrackIDsForCluster(fInputEvent,tempClus, 5, -5, 0.2, -0.4);
     for(UInt_t iJ=0; iJ<tempTracks.size();iJ++){
       cout << tempClus << " - " << tempTracks.at(iJ) << endl;
@@ -1525,18 +1469,17 @@ void AliCaloTrackMatcher::DebugV0Matching(){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::DebugMatching(){
-  if(fVectorDeltaEtaDeltaPhi.size()>0){
+  if(fMatches.GetNEntries()>0){
     cout << "******************************" << endl;
     cout << "******************************" << endl;
     cout << "NEW EVENT !" << endl;
     cout << "vector etaphi:" << endl;
-    cout << fVectorDeltaEtaDeltaPhi.size() << endl;
-    cout << "multimap" << endl;
-    mapT::iterator iter = fMap_TrID_ClID_ToIndex.begin();
-    for (iter = fMap_TrID_ClID_ToIndex.begin(); iter != fMap_TrID_ClID_ToIndex.end(); ++iter){
+    cout << fMatches.GetNEntries() << endl;
+    cout << "matches" << endl;
+    for (Int_t i = 0; i < fMatches.GetNEntries(); i++){
       Float_t dEta, dPhi = 0;
-      if(!GetTrackClusterMatchingResidual(iter->first.first,iter->first.second,dEta,dPhi)) continue;
-      cout << "  [" << iter->first.first << "/" << iter->first.second << ", " << iter->second << "] - (" << dEta << "/" << dPhi << ")" << endl;
+      if(!GetTrackClusterMatchingResidual(fMatches.GetTrackID(i),fMatches.GetClusterID(i),dEta,dPhi)) continue;
+      cout << "  [" << fMatches.GetTrackID(i) << "/" << fMatches.GetClusterID(i) << ", " << i << "] - (" << dEta << "/" << dPhi << ")" << endl;
     }
     cout << "mapTrackToCluster" << endl;
     AliESDEvent *esdev = dynamic_cast<AliESDEvent*>(fInputEvent);
@@ -1549,11 +1492,10 @@ void AliCaloTrackMatcher::DebugMatching(){
       cout << itr << " (" << tCharge << ") - " << GetNMatchedClusterIDsForTrack(fInputEvent,inTrack->GetID(),5,-5,0.2,-0.4) << "\t\t";
     }
     cout << endl;
-    multimap<Int_t,Int_t>::iterator it;
-    for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    for (Int_t i = 0; i < fMatches.GetNEntries(); i++) cout << fMatches.GetTrackKey(i) << " => " << fMatches.GetClusterID(i) << '\n';
     cout << "mapClusterToTrack" << endl;
-    Int_t tempClus = it->second;
-    for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    Int_t tempClus = fMatches.GetClusterID(fMatches.GetNEntries()-1);
+    for (Int_t i = 0; i < fMatches.GetNEntries(); i++) cout << fMatches.GetClusterID(i) << " => " << fMatches.GetTrackKey(i) << '\n';
     vector<Int_t> tempTracks = GetMatchedTrackIDsForCluster(fInputEvent,tempClus, 5, -5, 0.2, -0.4);
     for(UInt_t iJ=0; iJ<tempTracks.size();iJ++){
       cout << tempClus << " - " << tempTracks.at(iJ) << endl;
@@ -6,12 +6,62 @@
 #include "AliPHOSGeometry.h"
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <utility>
 
 class TF1;
 
 using namespace std;
 
+// Flat store of track <-> cluster matches of one event: the matches are
+// kept in insertion order together with their residuals. Each side is
+// indexed while the matches are added: a hash map gives the first and last
+// entry of every cluster and track, and every entry points to the next entry
+// of its cluster and of its track. Rows list their entries in insertion
+// order, i.e. in the order the former multimaps returned them, and matches
+// added between queries (V0 tracks) are indexed in constant time.
+class AliCaloTrackMatchTable {
+
+  public:
+    AliCaloTrackMatchTable() : fTrackKey(), fTrackID(), fClusterID(), fDEta(), fDPhi(),
+                               fClusterNext(), fTrackNext(), fClusterRows(), fTrackRows() {}
+
+    void    Clear();
+    void    Reserve(Int_t n);
+    Int_t   AddMatch(Int_t trackKey, Int_t trackID, Int_t clusterID, Float_t dEta, Float_t dPhi);
+
+    Int_t   GetNEntries()                const {return fTrackKey.size();}
+    Int_t   GetTrackKey(Int_t i)         const {return fTrackKey[i];}   // track position (AOD) or ID (ESD)
+    Int_t   GetTrackID(Int_t i)          const {return fTrackID[i];}
+    Int_t   GetClusterID(Int_t i)        const {return fClusterID[i];}
+    Float_t GetDEta(Int_t i)             const {return fDEta[i];}
+    Float_t GetDPhi(Int_t i)             const {return fDPhi[i];}
+
+    // row access: first entry of a cluster or track, then the next one, -1 at the end
+    Int_t   GetClusterRowFirst(Int_t clusterID) const {return RowFirst(fClusterRows,clusterID);}
+    Int_t   GetClusterRowNext(Int_t i)          const {return fClusterNext[i];}
+    Int_t   GetTrackRowFirst(Int_t trackKey)    const {return RowFirst(fTrackRows,trackKey);}
+    Int_t   GetTrackRowNext(Int_t i)            const {return fTrackNext[i];}
+
+    // entry of the last match stored for (trackID, clusterID), -1 if none
+    Int_t   FindMatch(Int_t trackID, Int_t clusterID) const;
+
+  private:
+    typedef unordered_map<Int_t, pair<Int_t,Int_t> > rowMap;   // key -> (first, last) entry
+    static void  AppendToRow(rowMap &rows, vector<Int_t> &next, Int_t key, Int_t i);
+    static Int_t RowFirst(const rowMap &rows, Int_t key);
+
+    vector<Int_t>   fTrackKey;       // per entry: track key used by the track side
+    vector<Int_t>   fTrackID;        // per entry: track ID (key of the residual look-up)
+    vector<Int_t>   fClusterID;      // per entry: cluster ID
+    vector<Float_t> fDEta;           // per entry: eta residual
+    vector<Float_t> fDPhi;           // per entry: phi residual
+    vector<Int_t>   fClusterNext;    // per entry: next entry of the same cluster, -1 for the last
+    vector<Int_t>   fTrackNext;      // per entry: next entry of the same track, -1 for the last
+    rowMap          fClusterRows;    // first and last entry of each cluster ID
+    rowMap          fTrackRows;      // first and last entry of each track key
+};
+
 class AliCaloTrackMatcher : public AliAnalysisTaskSE {
 
   public:
@@ -88,6 +138,8 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     void Initialize(Int_t runNumber);
     void ProcessEvent(AliVEvent *event);
     void SetLogBinningYTH2(TH2* histoRebin);
+    Int_t GetTrackPosition(AliVEvent *event, Int_t trackID);
+    void FillClusterCandidates(const Double_t *exPos, Double_t rMin);
 
     // debug methods
     void DebugMatching();
@@ -111,28 +163,30 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     AliEMCALGeometry*     fGeomEMCAL;              // pointer to EMCAL geometry
     AliPHOSGeometry*      fGeomPHOS;               // pointer to PHOS geometry
 
-    multimap<Int_t,Int_t> fMapTrackToCluster;      // connects a given track ID with all associated cluster IDs
-    multimap<Int_t,Int_t> fMapClusterToTrack;      // connects a given cluster ID with all associated track IDs
-
-    Int_t                 fNEntries;               // number of current TrackID/ClusterID -> Eta/Phi connections
-    vector<pairFloat>     fVectorDeltaEtaDeltaPhi; // vector of all matching residuals for a specific TrackID/ClusterID
-    mapT                  fMap_TrID_ClID_ToIndex;  // map tuple of (trackID,clusterID) to index in vector fVectorDeltaEtaDeltaPhi
+    AliCaloTrackMatchTable fMatches;               //! primary track <-> cluster matches of the current event, with residuals
 
     // for cluster <-> V0-track matching (running with different mass hypthesis)
-    multimap<Int_t,Int_t> fSecMapTrackToCluster;      // connects a given secondary track ID with all associated cluster IDs
-    multimap<Int_t,Int_t> fSecMapClusterToTrack;      // connects a given cluster ID with all associated secondary track IDs
-
-    Int_t                 fSecNEntries;               // number of current V0-trackIDs/clusterID -> Eta/Phi connections
-    vector<pairFloat>     fSecVectorDeltaEtaDeltaPhi; // vector of all matching residuals for a specific V0-trackIDs/clusterID
-    mapT                  fSecMap_TrID_ClID_ToIndex;  // map tuple of (V0-trackID,clusterID) to index in vector fSecVectorDeltaEtaDeltaPhi
+    AliCaloTrackMatchTable fSecMatches;            //! V0-track <-> cluster matches of the current event, filled on demand
     mapT                  fSecMap_TrID_ClID_AlreadyTried;  // map tuple of (V0-trackID,clusterID) to matching outcome, successful or not
 
+    // per-event cluster cache for the propagation step, clusters ordered in phi
+    vector<Float_t>       fClusterX;               //! cluster x position
+    vector<Float_t>       fClusterY;               //! cluster y position
+    vector<Float_t>       fClusterZ;               //! cluster z position
+    vector<Float_t>       fClusterPhiSorted;       //! cluster azimuth, ascending
+    vector<Int_t>         fClusterPhiOrder;        //! cluster index for each entry of fClusterPhiSorted
+    vector<Int_t>         fClusterCandidates;      //! clusters within the matching window of the current track
+
+    // AOD: position of a track ID in the event, built on the first query of an event
+    AliVEvent*            fTrackPosEvent;          //! event the look-up below was built for
+    vector<pairInt>       fTrackIDToPos;           //! (track ID, first position), sorted
+
     //histos
     TList*                fListHistos;             // list with histogram(s)
     TH2F*                 fHistControlMatches;     // bookkeeping for processed tracks/clusters and succesful matches
     TH2F*                 fSecHistControlMatches;  // bookkeeping for processed V0-tracks/clusters and succesful matches
 
-    ClassDef(AliCaloTrackMatcher,5)
+    ClassDef(AliCaloTrackMatcher,6)
 };
 
 #endif
@@ -76,12 +76,11 @@
 #include <TMVA/MethodCuts.h>
 
 #include "IClassifierReader.h"
+#include "AliHFFlatBDTReader.h"
 
 using std::cout;
 using std::endl;
 
-#include <dlfcn.h>
-
 /// \cond CLASSIMP
 ClassImp(AliAnalysisTaskSELc2V0bachelorTMVAApp);
 /// \endcond
@@ -201,7 +200,6 @@ AliAnalysisTaskSELc2V0bachelorTMVAApp::AliAnalysisTaskSELc2V0bachelorTMVAApp():
   fFillTree(0),
   fUseWeightsLibrary(kFALSE),
   fBDTReader(0),
-  fTMVAlibName(""),
   fTMVAlibPtBin(""),
   fNamesTMVAVar(""),
   fBDTHisto(0),
@@ -369,7 +367,6 @@ AliAnalysisTaskSELc2V0bachelorTMVAApp::AliAnalysisTaskSELc2V0bachelorTMVAApp(con
   fFillTree(0),
   fUseWeightsLibrary(kFALSE),
   fBDTReader(0),
-  fTMVAlibName(""),
   fTMVAlibPtBin(""),
   fNamesTMVAVar(""),
   fBDTHisto(0),
@@ -1109,10 +1106,19 @@ void AliAnalysisTaskSELc2V0bachelorTMVAApp::UserCreateOutputObjects() {
     }
     delete tokensSpectators;
     if (fUseWeightsLibrary) {
-      void* lib = dlopen(fTMVAlibName.Data(), RTLD_NOW);
-      void* p = dlsym(lib, Form("%s", fTMVAlibPtBin.Data()));
-      IClassifierReader* (*maker1)(std::vector<std::string>&) = (IClassifierReader* (*)(std::vector<std::string>&)) p;
-      fBDTReader = maker1(inputNamesVec);
+      // the generated BDT classes are not compiled anymore: the forest is read at
+      // runtime from the installed .class.cxx (or a weights file given directly)
+      TString weightsFile = fTMVAlibPtBin;
+      if (!weightsFile.EndsWith(".xml") && !weightsFile.EndsWith(".cxx")) {
+        weightsFile.ReplaceAll("ReadBDT_maker_", "");
+        Int_t firstUnderscore = weightsFile.First('_');
+        TString period = weightsFile(0, firstUnderscore);
+        TString ptBin = weightsFile(firstUnderscore + 1, weightsFile.Length());
+        weightsFile = Form("$ALICE_PHYSICS/PWGHF/vertexingHF/TMVA/%s_TMVAClassification_BDT_%s.class.cxx", period.Data(), ptBin.Data());
+      }
+      gSystem->ExpandPathName(weightsFile);
+      fBDTReader = new AliHFFlatBDTReader(inputNamesVec, weightsFile.Data());
+      if (!fBDTReader->IsStatusClean()) AliFatal(Form("Cannot load BDT from %s", weightsFile.Data()));
     }
     
     if (fUseXmlWeightsFile) fReader->BookMVA("BDT method", fXmlWeightsFile);
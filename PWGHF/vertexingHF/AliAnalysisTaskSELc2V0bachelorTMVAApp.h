@@ -99,8 +99,6 @@ class AliAnalysisTaskSELc2V0bachelorTMVAApp : public AliAnalysisTaskSE
   
   void SetMVReader(IClassifierReader* r) {fBDTReader = r;}
   IClassifierReader* const GetMVReader() {return fBDTReader;}
-  void SetTMVAlibName(const char* libName) {fTMVAlibName = libName;}
-  TString GetTMVAlibName() {return fTMVAlibName;}
   void SetTMVAlibPtBin(const char* libPtBin) {fTMVAlibPtBin = libPtBin;}
   TString GetTMVAlibPtBin() {return fTMVAlibPtBin;}
   void SetNamesTMVAVariables(TString names) {fNamesTMVAVar = names;}
@@ -562,8 +560,7 @@ class AliAnalysisTaskSELc2V0bachelorTMVAApp : public AliAnalysisTaskSE
 
   Bool_t fUseWeightsLibrary;           // flag to decide whether to use or not the BDT class
   IClassifierReader *fBDTReader;       //!<! BDT reader using BDT class
-  TString fTMVAlibName;                /// Name of the library to load to have the TMVA weights
-  TString fTMVAlibPtBin;               /// Pt bin that will be in the library to be loaded for the TMVA
+  TString fTMVAlibPtBin;               /// Pt bin of the generated BDT class (ReadBDT_maker_<period>_<bin>), or path to a .xml/.class.cxx file
   TString fNamesTMVAVar;               /// vector of the names of the input variables
   TH2D *fBDTHisto;                     //!<!
   TH2D *fBDTHistoVsMassK0S;            //!<! BDT classifier vs mass (pi+pi-) pairs
@@ -624,7 +621,7 @@ class AliAnalysisTaskSELc2V0bachelorTMVAApp : public AliAnalysisTaskSE
   TH2F* fHistoVzVsNtrCorr;           //!<! hist. Vz vs corrected tracklets
   
   /// \cond CLASSIMP    
-  ClassDef(AliAnalysisTaskSELc2V0bachelorTMVAApp, 12); /// class for Lc->p K0
+  ClassDef(AliAnalysisTaskSELc2V0bachelorTMVAApp, 13); /// class for Lc->p K0
   /// \endcond    
 };
 
@@ -69,7 +69,9 @@
 #include "AliAODv0.h"
 #include "AliCodeTimer.h"
 #include "AliMultSelection.h"
+#include <TH1F.h>
 #include <cstring>
+#include <algorithm>
 
 /// \cond CLASSIMP
 ClassImp(AliAnalysisVertexingHF);
@@ -153,6 +155,10 @@ fOKInvMassD0to4p(kFALSE),
 fOKInvMassLctoV0(kFALSE),
 fnTrksTotal(0),
 fnSeleTrksTotal(0),
+fMaxTracksPairDCACache(1000),
+fHistCandidateStages(0x0),
+fNPairDCACache(0),
+fPairDCACache(),
 fMakeReducedRHF(kFALSE),
 fMassDzero(0.),
 fMassDplus(0.),
@@ -172,6 +178,7 @@ fMassK(0.)
   fMassCalc3 = new AliAODRecoDecay(0x0,3,1,d03);
   fMassCalc4 = new AliAODRecoDecay(0x0,4,0,d04);
   SetMasses();
+  for(Int_t i=0; i<kNStages; i++) fStageCounts[i]=0;
 }
 //--------------------------------------------------------------------------
 AliAnalysisVertexingHF::AliAnalysisVertexingHF(const AliAnalysisVertexingHF &source) :
@@ -252,6 +259,10 @@ fOKInvMassD0to4p(source.fOKInvMassD0to4p),
 fOKInvMassLctoV0(source.fOKInvMassLctoV0),
 fnTrksTotal(0),
 fnSeleTrksTotal(0),
+fMaxTracksPairDCACache(source.fMaxTracksPairDCACache),
+fHistCandidateStages(source.fHistCandidateStages),
+fNPairDCACache(0),
+fPairDCACache(),
 fMakeReducedRHF(kFALSE),
 fMassDzero(source.fMassDzero),
 fMassDplus(source.fMassDplus),
@@ -265,6 +276,7 @@ fMassK(source.fMassK)
   ///
   /// Copy constructor
   ///
+  for(Int_t i=0; i<kNStages; i++) fStageCounts[i]=0;
 }
 //--------------------------------------------------------------------------
 AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVertexingHF &source)
@@ -336,6 +348,8 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fFindVertexForCascades = source.fFindVertexForCascades;
   fV0TypeForCascadeVertex = source.fV0TypeForCascadeVertex;
   fMassCutBeforeVertexing = source.fMassCutBeforeVertexing;
+  fMaxTracksPairDCACache = source.fMaxTracksPairDCACache;
+  fHistCandidateStages = source.fHistCandidateStages;
   fMassCalc2 = source.fMassCalc2;
   fMassCalc3 = source.fMassCalc3;
   fMassCalc4 = source.fMassCalc4;
@@ -434,6 +448,16 @@ TList *AliAnalysisVertexingHF::FillListOfCuts() {
     list->Add(cutsDStartoKpipi);
   }
 
+  // counters of the candidate building stages
+  fHistCandidateStages = new TH1F("hCandidateStages","Candidate building stages",kNStages,-0.5,kNStages-0.5);
+  const char* stageNames[kNStages]={"selected tracks","pairs","pairs rej. DCA","pairs rej. vertex",
+				    "triplets","triplets rej. mass","triplets rej. DCA","3 prong fits",
+				    "quadruplets","quadruplets rej. mass","quadruplets rej. DCA","4 prong fits",
+				    "pair DCA computed","pair DCA from cache"};
+  for(Int_t i=0; i<kNStages; i++) fHistCandidateStages->GetXaxis()->SetBinLabel(i+1,stageNames[i]);
+  fHistCandidateStages->SetDirectory(0);
+  list->Add(fHistCandidateStages);
+
   //___ Check consitstency of cuts between vertexer and analysis tasks
   Bool_t bCutsOk = CheckCutsConsistency();
   if (bCutsOk == kFALSE) {AliFatal("AliAnalysisVertexingHF::FillListOfCuts vertexing and the analysis task cuts are not consistent!");}
@@ -629,6 +653,26 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // compact table of the selected tracks: momenta at the primary vertex and
+  // indices of the displaced tracks split by charge (tracks with charge 0 in both lists)
+  for(Int_t i=0; i<kNStages; i++) fStageCounts[i]=0;
+  fStageCounts[kStageSeleTrks]=nSeleTrks;
+  std::vector<Double_t> pxAtVtx(nSeleTrks),pyAtVtx(nSeleTrks),pzAtVtx(nSeleTrks);
+  std::vector<Int_t> displTrks,posDisplTrks,negDisplTrks;
+  for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++) {
+    Double_t mom[3];
+    ((AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrk))->GetPxPyPz(mom);
+    pxAtVtx[iTrk]=mom[0]; pyAtVtx[iTrk]=mom[1]; pzAtVtx[iTrk]=mom[2];
+    if(!TESTBIT(seleFlags[iTrk],kBitDispl)) continue;
+    displTrks.push_back(iTrk);
+    Short_t charge=((AliESDtrack*)seleTrksArray.UncheckedAt(iTrk))->Charge();
+    if(charge>=0) posDisplTrks.push_back(iTrk);
+    if(charge<=0) negDisplTrks.push_back(iTrk);
+  }
+  // DCAs between the tracks at the primary vertex, filled on demand
+  fNPairDCACache = (nSeleTrks<=fMaxTracksPairDCACache) ? nSeleTrks : 0;
+  fPairDCACache.clear();
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -837,7 +881,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
     if(postrack1->Charge()<0 && !fLikeSign) continue;
 
     // LOOP ON  NEGATIVE  TRACKS
-    for(iTrkN1=0; iTrkN1<nSeleTrks; iTrkN1++) {
+    const std::vector<Int_t> &trksN1 = fLikeSign ? displTrks : negDisplTrks;
+    for(size_t jTrkN1=0; jTrkN1<trksN1.size(); jTrkN1++) {
+      iTrkN1=trksN1[jTrkN1];
 
       //if(iTrkN1%1==0) AliDebug(1,Form("    1st loop on neg: track number %d of %d",iTrkN1,nSeleTrks));
       //if(iTrkN1%1==0) printf("    1st loop on neg: track number %d of %d\n",iTrkN1,nSeleTrks);
@@ -871,19 +917,21 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       // back to primary vertex
       //      postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
       //      negtrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
+      fStageCounts[kStagePairs]++;
       SetParametersAtVertex(postrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP1));
       SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
-      negtrack1->GetPxPyPz(momneg1);
+      momneg1[0]=pxAtVtx[iTrkN1]; momneg1[1]=pyAtVtx[iTrkN1]; momneg1[2]=pzAtVtx[iTrkN1];
 
       // DCA between the two tracks
-      dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
-      if(dcap1n1>dcaMax) { negtrack1=0; continue; }
+      dcap1n1 = GetPairDCA(postrack1,iTrkP1,negtrack1,iTrkN1);
+      if(dcap1n1>dcaMax) { fStageCounts[kStagePairsRejDCA]++; negtrack1=0; continue; }
 
       // Vertexing
       twoTrackArray1->AddAt(postrack1,0);
       twoTrackArray1->AddAt(negtrack1,1);
       AliAODVertex *vertexp1n1 = ReconstructSecondaryVertex(twoTrackArray1,dispersion);
       if(!vertexp1n1) {
+	fStageCounts[kStagePairsRejVertex]++;
 	twoTrackArray1->Clear();
 	negtrack1=0;
 	continue;
@@ -1058,7 +1106,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 
       // 2nd LOOP  ON  POSITIVE  TRACKS
-      for(iTrkP2=iTrkP1+1; iTrkP2<nSeleTrks; iTrkP2++) {
+      for(std::vector<Int_t>::const_iterator itP2=std::upper_bound(posDisplTrks.begin(),posDisplTrks.end(),iTrkP1);
+	  itP2!=posDisplTrks.end(); ++itP2) {
+	iTrkP2=*itP2;
 
 	if(iTrkP2==iTrkP1 || iTrkP2==iTrkN1) continue;
 
@@ -1129,6 +1179,26 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  if(!TESTBIT(seleFlags[iTrkP1],kBitKaonCompat) &&
 	     !TESTBIT(seleFlags[iTrkP2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
 	}
+	fStageCounts[kStageTriplets]++;
+
+	// check invariant mass cuts for D+,Ds,Lc (momenta at the primary vertex, before the DCAs)
+        massCutOK=kTRUE;
+	if(f3Prong && fMassCutBeforeVertexing){
+	  mompos2[0]=pxAtVtx[iTrkP2]; mompos2[1]=pyAtVtx[iTrkP2]; mompos2[2]=pzAtVtx[iTrkP2];
+	  Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
+	  Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
+	  Double_t pzDau[3]={mompos1[2],momneg1[2],mompos2[2]};
+	  //	    massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
+	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
+	  if(!massCutOK) {
+	    fStageCounts[kStageTripletsRejMass]++;
+	    if(!f4Prong) {
+	      postrack2=0;
+	      continue;
+	    }
+	  }
+	}
+
 	// back to primary vertex
 	//	postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
 	//	postrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1139,14 +1209,12 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
-	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
-	if(dcap2n1>dcaMax) { postrack2=0; continue; }
-	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
-	if(dcap1p2>dcaMax) { postrack2=0; continue; }
+	dcap2n1 = GetPairDCA(postrack2,iTrkP2,negtrack1,iTrkN1);
+	if(dcap2n1>dcaMax) { fStageCounts[kStageTripletsRejDCA]++; postrack2=0; continue; }
+	dcap1p2 = GetPairDCA(postrack2,iTrkP2,postrack1,iTrkP1);
+	if(dcap1p2>dcaMax) { fStageCounts[kStageTripletsRejDCA]++; postrack2=0; continue; }
 
-	// check invariant mass cuts for D+,Ds,Lc
-        massCutOK=kTRUE;
-	if(f3Prong) {
+	if(f3Prong && massCutOK) {
 	  if(postrack2->Charge()>0) {
 	    threeTrackArray->AddAt(postrack1,0);
 	    threeTrackArray->AddAt(negtrack1,1);
@@ -1156,22 +1224,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    threeTrackArray->AddAt(postrack1,1);
 	    threeTrackArray->AddAt(postrack2,2);
 	  }
-	  if(fMassCutBeforeVertexing){
-	    postrack2->GetPxPyPz(mompos2);
-	    Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
-	    Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
-	    Double_t pzDau[3]={mompos1[2],momneg1[2],mompos2[2]};
-	    //	    massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
-	    massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
-	  }
-	}
-
-	if(f3Prong && !massCutOK) {
-	  threeTrackArray->Clear();
-	  if(!f4Prong) {
-	    postrack2=0;
-	    continue;
-	  }
 	}
 
 	// Vertexing
@@ -1181,6 +1233,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	// 3 prong candidates
 	if(f3Prong && massCutOK) {
 	  
+	  fStageCounts[kStage3ProngFits]++;
 	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
 	  io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,twoTrackArray2,dcap1n1,dcap2n1,dcap1p2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
 	  if(ok3Prong) {
@@ -1246,7 +1299,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
           AliAODVertex* vertexp1n1p2 = ReconstructSecondaryVertex(threeTrackArray,dispersion);
 
 	  // 3rd LOOP  ON  NEGATIVE  TRACKS (for 4 prong)
-	  for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
+	  for(std::vector<Int_t>::const_iterator itN2=std::upper_bound(negDisplTrks.begin(),negDisplTrks.end(),iTrkN1);
+	      itN2!=negDisplTrks.end(); ++itN2) {
+	    iTrkN2=*itN2;
 
 	    if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2 || iTrkN2==iTrkN1) continue;
 
@@ -1266,6 +1321,21 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 		 evtNumber[iTrkP1]==evtNumber[iTrkP2] ||
 		 evtNumber[iTrkN1]==evtNumber[iTrkP2]) continue;
 	    }
+	    fStageCounts[kStageQuadruplets]++;
+
+	    // check invariant mass cuts for D0 (momenta at the primary vertex, before the DCAs)
+	    massCutOK=kTRUE;
+	    if(fMassCutBeforeVertexing) {
+	      Double_t pxDau[4]={pxAtVtx[iTrkP1],pxAtVtx[iTrkN1],pxAtVtx[iTrkP2],pxAtVtx[iTrkN2]};
+	      Double_t pyDau[4]={pyAtVtx[iTrkP1],pyAtVtx[iTrkN1],pyAtVtx[iTrkP2],pyAtVtx[iTrkN2]};
+	      Double_t pzDau[4]={pzAtVtx[iTrkP1],pzAtVtx[iTrkN1],pzAtVtx[iTrkP2],pzAtVtx[iTrkN2]};
+	      massCutOK = SelectInvMassAndPt4prong(pxDau,pyDau,pzDau);
+	    }
+	    if(!massCutOK) {
+	      fStageCounts[kStageQuadrupletsRejMass]++;
+	      negtrack2=0;
+	      continue;
+	    }
 
 	    // back to primary vertex
 	    // postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1277,10 +1347,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
-	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
-            dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-            if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
+	    dcap1n2 = GetPairDCA(postrack1,iTrkP1,negtrack2,iTrkN2);
+	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { fStageCounts[kStageQuadrupletsRejDCA]++; negtrack2=0; continue; }
+            dcap2n2 = GetPairDCA(postrack2,iTrkP2,negtrack2,iTrkN2);
+            if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { fStageCounts[kStageQuadrupletsRejDCA]++; negtrack2=0; continue; }
 
 
 	    fourTrackArray->AddAt(postrack1,0);
@@ -1288,18 +1358,8 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    fourTrackArray->AddAt(postrack2,2);
 	    fourTrackArray->AddAt(negtrack2,3);
 
-	    // check invariant mass cuts for D0
-	    massCutOK=kTRUE;
-	    if(fMassCutBeforeVertexing)
-	      massCutOK = SelectInvMassAndPt4prong(fourTrackArray);
-
-	    if(!massCutOK) {
-	      fourTrackArray->Clear();
-	      negtrack2=0;
-	      continue;
-	    }
-
 	    // Vertexing
+	    fStageCounts[kStage4ProngFits]++;
 	    AliAODVertex* secVert4PrAOD = ReconstructSecondaryVertex(fourTrackArray,dispersion);
 	    io4Prong = Make4Prong(fourTrackArray,event,secVert4PrAOD,vertexp1n1,vertexp1n1p2,dcap1n1,dcap1n2,dcap2n1,dcap2n2,ok4Prong);
 	    if(ok4Prong) {
@@ -1331,12 +1391,18 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
       } // end 2nd loop on positive tracks
 
+      // index excluded as second positive track in the -+- loop: the loop over all
+      // the selected tracks used to leave nSeleTrks there, i.e. no track is excluded
+      const Int_t iTrkP2Excluded=nSeleTrks;
+
       twoTrackArray2->Clear();
 
       // 2nd LOOP  ON  NEGATIVE  TRACKS (for 3 prong -+-)
-      for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
+      for(std::vector<Int_t>::const_iterator itN2=std::upper_bound(negDisplTrks.begin(),negDisplTrks.end(),iTrkN1);
+	  itN2!=negDisplTrks.end(); ++itN2) {
+	iTrkN2=*itN2;
 
-	if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2 || iTrkN2==iTrkN1) continue;
+	if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2Excluded || iTrkN2==iTrkN1) continue;
 
 	//if(iTrkN2%1==0) AliDebug(1,Form("    2nd loop on neg: track number %d of %d",iTrkN2,nSeleTrks));
 
@@ -1400,6 +1466,23 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  if(!TESTBIT(seleFlags[iTrkN1],kBitKaonCompat) &&
 	     !TESTBIT(seleFlags[iTrkN2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
 	}
+	fStageCounts[kStageTriplets]++;
+
+	// check invariant mass cuts for D+,Ds,Lc (momenta at the primary vertex, before the DCAs)
+        massCutOK=kTRUE;
+	if(fMassCutBeforeVertexing && f3Prong){
+	  momneg2[0]=pxAtVtx[iTrkN2]; momneg2[1]=pyAtVtx[iTrkN2]; momneg2[2]=pzAtVtx[iTrkN2];
+	  Double_t pxDau[3]={momneg1[0],mompos1[0],momneg2[0]};
+	  Double_t pyDau[3]={momneg1[1],mompos1[1],momneg2[1]};
+	  Double_t pzDau[3]={momneg1[2],mompos1[2],momneg2[2]};
+	  //	  massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
+	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
+	}
+	if(!massCutOK) {
+	  fStageCounts[kStageTripletsRejMass]++;
+	  negtrack2=0;
+	  continue;
+	}
 
 	// back to primary vertex
 	// postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1410,36 +1493,21 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
-	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
-	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
+	dcap1n2 = GetPairDCA(postrack1,iTrkP1,negtrack2,iTrkN2);
+	if(dcap1n2>dcaMax) { fStageCounts[kStageTripletsRejDCA]++; negtrack2=0; continue; }
+	dcan1n2 = GetPairDCA(negtrack1,iTrkN1,negtrack2,iTrkN2);
+	if(dcan1n2>dcaMax) { fStageCounts[kStageTripletsRejDCA]++; negtrack2=0; continue; }
 
 	threeTrackArray->AddAt(negtrack1,0);
 	threeTrackArray->AddAt(postrack1,1);
 	threeTrackArray->AddAt(negtrack2,2);
 
-	// check invariant mass cuts for D+,Ds,Lc
-        massCutOK=kTRUE;
-	if(fMassCutBeforeVertexing && f3Prong){
-	  negtrack2->GetPxPyPz(momneg2);
-	  Double_t pxDau[3]={momneg1[0],mompos1[0],momneg2[0]};
-	  Double_t pyDau[3]={momneg1[1],mompos1[1],momneg2[1]};
-	  Double_t pzDau[3]={momneg1[2],mompos1[2],momneg2[2]};
-	  //	  massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
-	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
-	}
-	if(!massCutOK) {
-	  threeTrackArray->Clear();
-	  negtrack2=0;
-	  continue;
-	}
-
 	// Vertexing
 	twoTrackArray2->AddAt(postrack1,0);
 	twoTrackArray2->AddAt(negtrack2,1);
 
 	if(f3Prong) {
+	  fStageCounts[kStage3ProngFits]++;
 	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
 	  io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,twoTrackArray2,dcap1n1,dcap1n2,dcan1n2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
 	  if(ok3Prong) {
@@ -1494,6 +1562,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
  }  // end 1st loop on positive tracks
 
 
+  if(fHistCandidateStages) {
+    for(Int_t i=0; i<kNStages; i++) fHistCandidateStages->AddBinContent(i+1,fStageCounts[i]);
+    fHistCandidateStages->SetEntries(fHistCandidateStages->GetEntries()+1);
+  }
+
   //  AliDebug(1,Form(" Total HF vertices in event = %d;",
   //		  (Int_t)aodVerticesHFTClArr->GetEntriesFast()));
   if(fD0toKpi) {
@@ -3775,6 +3848,28 @@ void AliAnalysisVertexingHF::SetParametersAtVertex(AliESDtrack* esdt, const AliE
   return;
 }
 //-----------------------------------------------------------------------------
+Double_t AliAnalysisVertexingHF::GetPairDCA(AliESDtrack *trk1,Int_t iTrk1,AliESDtrack *trk2,Int_t iTrk2){
+  /// DCA between trk1 and trk2 (indices in the array of selected tracks), with the
+  /// parameters at the primary vertex. Each ordered pair is computed only once per event,
+  /// the tracks have to be at the primary vertex when the DCA is not cached yet.
+
+  Double_t xdummy,ydummy;
+  if(iTrk1>=fNPairDCACache || iTrk2>=fNPairDCACache) {
+    fStageCounts[kStagePairDCAComputed]++;
+    return trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  }
+  Long64_t key=(Long64_t)iTrk1*fNPairDCACache+iTrk2;
+  std::unordered_map<Long64_t,Double_t>::const_iterator it=fPairDCACache.find(key);
+  if(it!=fPairDCACache.end()) {
+    fStageCounts[kStagePairDCACached]++;
+    return it->second;
+  }
+  fStageCounts[kStagePairDCAComputed]++;
+  Double_t dca=trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  fPairDCACache[key]=dca;
+  return dca;
+}
+//-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::SetMasses(){
   /// Set the hadron mass values from TDatabasePDG
 
@@ -13,6 +13,9 @@
 /// \author Contact: andrea.dainese@pd.infn.it
 //-------------------------------------------------------------------------
 
+#include <vector>
+#include <unordered_map>
+
 #include <TNamed.h>
 #include <TList.h>
 
@@ -45,6 +48,7 @@ class AliAODVertex;
 class AliVertexerTracks;
 class AliESDv0;
 class AliAODv0;
+class TH1F;
 
 //-----------------------------------------------------------------------------
 class AliAnalysisVertexingHF : public TNamed {
@@ -179,6 +183,11 @@ class AliAnalysisVertexingHF : public TNamed {
   void SetCutsDStartoKpipi(AliRDHFCutsDStartoKpipi* cuts) { fCutsDStartoKpipi = cuts; }
   AliRDHFCutsDStartoKpipi* GetCutsDStartoKpipi() const { return fCutsDStartoKpipi; }
   void SetMassCutBeforeVertexing(Bool_t flag) { fMassCutBeforeVertexing=flag; }
+  /// pair DCAs are computed once per event and track pair if at most nTrks tracks are selected (0: never)
+  void SetMaxTracksForPairDCACache(Int_t nTrks) { fMaxTracksPairDCACache=nTrks; }
+  Int_t GetMaxTracksForPairDCACache() const { return fMaxTracksPairDCACache; }
+  /// number of combinations entering and rejected at each stage of FindCandidates (in the list of cuts)
+  TH1F* GetHistoCandidateStages() const { return fHistCandidateStages; }
 
   void SetMasses();
   Bool_t CheckCutsConsistency();
@@ -250,6 +259,11 @@ class AliAnalysisVertexingHF : public TNamed {
  private:
   //
   enum { kBitDispl = 0, kBitSoftPi = 1, kBit3Prong = 2, kBitPionCompat = 3, kBitKaonCompat = 4, kBitProtonCompat = 5, kBitBachelor = 6};
+  /// stages of the candidate building, bins of fHistCandidateStages
+  enum { kStageSeleTrks = 0, kStagePairs, kStagePairsRejDCA, kStagePairsRejVertex,
+         kStageTriplets, kStageTripletsRejMass, kStageTripletsRejDCA, kStage3ProngFits,
+         kStageQuadruplets, kStageQuadrupletsRejMass, kStageQuadrupletsRejDCA, kStage4ProngFits,
+         kStagePairDCAComputed, kStagePairDCACached, kNStages };
 
   Bool_t fInputAOD; /// input from AOD (kTRUE) or ESD (kFALSE)
   Int_t fAODMapSize; /// size of fAODMap
@@ -344,6 +358,11 @@ class AliAnalysisVertexingHF : public TNamed {
 
   Int_t  fnTrksTotal;
   Int_t  fnSeleTrksTotal;
+  Int_t  fMaxTracksPairDCACache; /// max. number of selected tracks for the caching of pair DCAs
+  TH1F  *fHistCandidateStages;   //!<! counters of the candidate building stages (owned by fListOfCuts)
+  Long64_t fStageCounts[kNStages]; //!<! counters of the current event
+  Int_t  fNPairDCACache;         //!<! number of tracks in the pair DCA cache of the current event
+  std::unordered_map<Long64_t,Double_t> fPairDCACache; //!<! DCA of track i (caller) to track j, key i*fNPairDCACache+j
   Bool_t fMakeReducedRHF;// switch the reduction of dAOD size on/off
 
   Double_t fMassDzero;
@@ -420,6 +439,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				   Int_t &nSeleTrks,
 				   UChar_t *seleFlags,Int_t *evtNumber);
   void SetParametersAtVertex(AliESDtrack* esdt, const AliExternalTrackParam* extpar) const;
+  Double_t GetPairDCA(AliESDtrack *trk1,Int_t iTrk1,AliESDtrack *trk2,Int_t iTrk2);
 
   Bool_t SingleTrkCuts(AliESDtrack *trk,Float_t centralityperc, Bool_t &okDisplaced,Bool_t &okSoftPi, Bool_t &ok3prong, Bool_t &okBachelor) const;
 
@@ -429,7 +449,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,30);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,31);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
@@ -0,0 +1,475 @@
+/// \class AliHFFlatBDTReader
+/// \brief Generic evaluator of TMVA BDTs loaded at runtime
+
+#include "AliHFFlatBDTReader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#include <TXMLEngine.h>
+
+namespace {
+
+  /// minimal tokenizer of the NN( ... ) expressions written by MethodBDT::MakeClass
+  class ClassFileParser {
+   public:
+    ClassFileParser(const std::string& text, size_t pos) : fText(text), fPos(pos) {}
+
+    size_t GetPos() const { return fPos; }
+
+    void SkipBlanks() {
+      while (fPos < fText.size() && (std::isspace((unsigned char)fText[fPos]) || fText[fPos] == ',')) ++fPos;
+    }
+    bool Expect(const char* token) {
+      SkipBlanks();
+      size_t len = std::strlen(token);
+      if (fText.compare(fPos, len, token) != 0) return false;
+      fPos += len;
+      return true;
+    }
+    bool Peek(const char* token) {
+      SkipBlanks();
+      return fText.compare(fPos, std::strlen(token), token) == 0;
+    }
+    bool Number(double& value) {
+      SkipBlanks();
+      const char* begin = fText.c_str() + fPos;
+      char* end = 0;
+      value = std::strtod(begin, &end);
+      if (end == begin) return false;
+      fPos += end - begin;
+      return true;
+    }
+
+   private:
+    const std::string& fText;
+    size_t fPos;
+  };
+
+  template <typename Node>
+  int ParseClassNode(ClassFileParser& parser, std::vector<Node>& nodes, bool& ok) {
+    // a daughter is either a nested NN( ... ) or a null pointer written as 0
+    if (!parser.Peek("NN(")) {
+      double null = -1.;
+      if (!parser.Number(null) || null != 0.) ok = false;
+      return -1;
+    }
+    parser.Expect("NN(");
+    int left = ParseClassNode(parser, nodes, ok);
+    int right = ParseClassNode(parser, nodes, ok);
+    double par[6] = {0.};
+    for (int ipar = 0; ipar < 6; ++ipar) {
+      if (!parser.Number(par[ipar])) ok = false;
+    }
+    if (!parser.Expect(")")) ok = false;
+    Node node;
+    node.fLeft = left;
+    node.fRight = right;
+    node.fSelector = (int)par[0];
+    node.fCutValue = par[1];
+    node.fCutType = par[2] != 0.;
+    node.fNodeType = (int)par[3];
+    node.fPurity = par[4];
+    node.fResponse = par[5];
+    nodes.push_back(node);
+    return (int)nodes.size() - 1;
+  }
+
+  const char* GetXMLAttr(TXMLEngine& xml, XMLNodePointer_t node, const char* name) {
+    const char* value = xml.GetAttr(node, name);
+    return value ? value : "";
+  }
+
+  XMLNodePointer_t FindXMLChild(TXMLEngine& xml, XMLNodePointer_t node, const char* name) {
+    for (XMLNodePointer_t child = xml.GetChild(node); child; child = xml.GetNext(child)) {
+      if (std::strcmp(xml.GetNodeName(child), name) == 0) return child;
+    }
+    return 0;
+  }
+
+  template <typename Node>
+  int ReadXMLNode(TXMLEngine& xml, XMLNodePointer_t xmlNode, std::vector<Node>& nodes, bool& ok) {
+    int left = -1, right = -1;
+    for (XMLNodePointer_t child = xml.GetChild(xmlNode); child; child = xml.GetNext(child)) {
+      if (std::strcmp(xml.GetNodeName(child), "Node") != 0) continue;
+      const std::string pos = GetXMLAttr(xml, child, "pos");
+      if (pos == "l") left = ReadXMLNode(xml, child, nodes, ok);
+      else if (pos == "r") right = ReadXMLNode(xml, child, nodes, ok);
+    }
+    // multivariate (Fisher) cuts are not supported by the flat tables
+    if (std::atoi(GetXMLAttr(xml, xmlNode, "NCoef")) != 0) ok = false;
+    Node node;
+    node.fLeft = left;
+    node.fRight = right;
+    node.fSelector = std::atoi(GetXMLAttr(xml, xmlNode, "IVar"));
+    node.fCutValue = std::atof(GetXMLAttr(xml, xmlNode, "Cut"));
+    node.fCutType = std::atoi(GetXMLAttr(xml, xmlNode, "cType")) != 0;
+    node.fNodeType = std::atoi(GetXMLAttr(xml, xmlNode, "nType"));
+    node.fPurity = std::atof(GetXMLAttr(xml, xmlNode, "purity"));
+    node.fResponse = std::atof(GetXMLAttr(xml, xmlNode, "res"));
+    nodes.push_back(node);
+    return (int)nodes.size() - 1;
+  }
+}
+
+//________________________________________________________________
+AliHFFlatBDTReader::AliHFFlatBDTReader()
+  : IClassifierReader()
+  , fNvars(0)
+  , fInputVars()
+  , fBoostType(kAdaBoostYesNoLeaf)
+  , fCutInclusive(false)
+  , fMaxDepth(0)
+  , fVar()
+  , fCut()
+  , fCutType()
+  , fLeft()
+  , fValue()
+  , fTreeRoot()
+  , fBoostWeights()
+  , fNorm(0.)
+{
+  /// default constructor, the forest has to be loaded with LoadWeightsXML or LoadClassFile
+  fStatusIsClean = false;
+}
+
+//________________________________________________________________
+AliHFFlatBDTReader::AliHFFlatBDTReader(std::vector<std::string>& theInputVars, const std::string& weightsFile)
+  : IClassifierReader()
+  , fNvars(theInputVars.size())
+  , fInputVars()
+  , fBoostType(kAdaBoostYesNoLeaf)
+  , fCutInclusive(false)
+  , fMaxDepth(0)
+  , fVar()
+  , fCut()
+  , fCutType()
+  , fLeft()
+  , fValue()
+  , fTreeRoot()
+  , fBoostWeights()
+  , fNorm(0.)
+{
+  /// standard constructor
+  const std::string xmlSuffix = ".xml";
+  bool isXML = weightsFile.size() >= xmlSuffix.size() &&
+               weightsFile.compare(weightsFile.size() - xmlSuffix.size(), xmlSuffix.size(), xmlSuffix) == 0;
+  bool loaded = isXML ? LoadWeightsXML(weightsFile) : LoadClassFile(weightsFile);
+  if (loaded) CheckInputVariables(theInputVars);
+}
+
+//________________________________________________________________
+void AliHFFlatBDTReader::Reset()
+{
+  fInputVars.clear();
+  fMaxDepth = 0;
+  fVar.clear();
+  fCut.clear();
+  fCutType.clear();
+  fLeft.clear();
+  fValue.clear();
+  fTreeRoot.clear();
+  fBoostWeights.clear();
+  fNorm = 0.;
+  fStatusIsClean = false;
+}
+
+//________________________________________________________________
+bool AliHFFlatBDTReader::LoadClassFile(const std::string& path)
+{
+  /// read the forest from a class generated by MethodBDT::MakeClass; the
+  /// cut values and boost weights are the same decimal literals the compiler
+  /// would read, so the scores match the generated class bit by bit
+  Reset();
+  fCutInclusive = false;
+
+  std::ifstream file(path.c_str());
+  if (!file.good()) {
+    std::cout << "AliHFFlatBDTReader: cannot open " << path << std::endl;
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  const std::string text = buffer.str();
+  fStatusIsClean = true; // cleared below if the forest is malformed
+
+  // the leaf value entering the sum is fixed by the options used at training
+  if (text.find("current->GetResponse()") != std::string::npos) fBoostType = kGrad;
+  else if (text.find("current->GetPurity()") != std::string::npos) fBoostType = kAdaBoostPurity;
+  else fBoostType = kAdaBoostYesNoLeaf;
+
+  const std::string weightTag = "fBoostWeights.push_back(";
+  const std::string forestTag = "fForest.push_back(";
+  std::vector<BDTInputNode> nodes;
+  size_t pos = text.find("::Initialize()");
+  double weight = 1.;
+  bool ok = pos != std::string::npos;
+  while (ok) {
+    size_t posWeight = text.find(weightTag, pos);
+    size_t posForest = text.find(forestTag, pos);
+    if (posForest == std::string::npos) break;
+    if (posWeight < posForest) {
+      ClassFileParser parser(text, posWeight + weightTag.size());
+      ok = parser.Number(weight) && parser.Expect(")");
+      pos = parser.GetPos();
+      continue;
+    }
+    ClassFileParser parser(text, posForest + forestTag.size());
+    nodes.clear();
+    int root = ParseClassNode(parser, nodes, ok);
+    ok = ok && root >= 0 && parser.Expect(")");
+    if (ok) AddTree(nodes, root, weight);
+    weight = 1.;
+    pos = parser.GetPos();
+  }
+  if (!ok || fTreeRoot.empty()) {
+    std::cout << "AliHFFlatBDTReader: failed to read the forest from " << path << std::endl;
+    Reset();
+    return false;
+  }
+
+  // the number of variables is only known from the selectors if not given
+  if (!fNvars) {
+    for (size_t inode = 0; inode < fVar.size(); ++inode) fNvars = std::max(fNvars, (size_t)fVar[inode] + 1);
+  }
+  Finalise();
+  return true;
+}
+
+//________________________________________________________________
+bool AliHFFlatBDTReader::LoadWeightsXML(const std::string& path)
+{
+  /// read the forest from a TMVA weights file, with the TMVA::Reader convention
+  /// for the cuts (x >= cut goes right)
+  Reset();
+  fCutInclusive = true;
+
+  TXMLEngine xml;
+  XMLDocPointer_t doc = xml.ParseFile(path.c_str());
+  if (!doc) {
+    std::cout << "AliHFFlatBDTReader: cannot parse " << path << std::endl;
+    return false;
+  }
+  fStatusIsClean = true; // cleared below if the forest is malformed
+  XMLNodePointer_t setup = xml.DocGetRootElement(doc);
+  bool ok = true;
+
+  std::string boostType = "AdaBoost";
+  bool useYesNoLeaf = true;
+  XMLNodePointer_t options = FindXMLChild(xml, setup, "Options");
+  for (XMLNodePointer_t opt = options ? xml.GetChild(options) : 0; opt; opt = xml.GetNext(opt)) {
+    const std::string name = GetXMLAttr(xml, opt, "name");
+    const char* content = xml.GetNodeContent(opt);
+    if (!content) continue;
+    if (name == "BoostType") boostType = content;
+    else if (name == "UseYesNoLeaf") useYesNoLeaf = std::string(content) == "True";
+  }
+  if (boostType == "Grad") fBoostType = kGrad;
+  else fBoostType = useYesNoLeaf ? kAdaBoostYesNoLeaf : kAdaBoostPurity;
+
+  XMLNodePointer_t variables = FindXMLChild(xml, setup, "Variables");
+  for (XMLNodePointer_t var = variables ? xml.GetChild(variables) : 0; var; var = xml.GetNext(var)) {
+    if (std::strcmp(xml.GetNodeName(var), "Variable") == 0) fInputVars.push_back(GetXMLAttr(xml, var, "Expression"));
+  }
+  fNvars = fInputVars.size();
+
+  // variable transformations are not applied by the flat evaluator
+  XMLNodePointer_t transformations = FindXMLChild(xml, setup, "Transformations");
+  if (transformations && std::atoi(GetXMLAttr(xml, transformations, "NTransformations")) != 0) ok = false;
+
+  XMLNodePointer_t weights = FindXMLChild(xml, setup, "Weights");
+  std::vector<BDTInputNode> nodes;
+  for (XMLNodePointer_t tree = weights ? xml.GetChild(weights) : 0; ok && tree; tree = xml.GetNext(tree)) {
+    if (std::strcmp(xml.GetNodeName(tree), "BinaryTree") != 0) continue;
+    XMLNodePointer_t rootNode = FindXMLChild(xml, tree, "Node");
+    if (!rootNode) {
+      ok = false;
+      break;
+    }
+    nodes.clear();
+    int root = ReadXMLNode(xml, rootNode, nodes, ok);
+    const char* boostWeight = xml.GetAttr(tree, "boostWeight");
+    AddTree(nodes, root, boostWeight ? std::atof(boostWeight) : 1.);
+  }
+  xml.FreeDoc(doc);
+
+  if (!ok || fTreeRoot.empty()) {
+    std::cout << "AliHFFlatBDTReader: unsupported or empty forest in " << path << std::endl;
+    Reset();
+    return false;
+  }
+  Finalise();
+  return true;
+}
+
+//________________________________________________________________
+void AliHFFlatBDTReader::AddTree(const std::vector<BDTInputNode>& nodes, int root, double boostWeight)
+{
+  /// flatten one tree breadth first, so that the daughters of each internal node are adjacent
+  std::vector<int> queue(1, root);
+  std::vector<int> depth(1, 0);
+  const int first = (int)fVar.size();
+  fTreeRoot.push_back(first);
+  fBoostWeights.push_back(boostWeight);
+
+  for (size_t iq = 0; iq < queue.size(); ++iq) {
+    const BDTInputNode& node = nodes[queue[iq]];
+    const int index = first + (int)iq;
+    // as in the generated classes, a node is internal as long as its type is 0
+    if (node.fNodeType == 0 && node.fLeft >= 0 && node.fRight >= 0) {
+      fVar.push_back(node.fSelector);
+      fCut.push_back(node.fCutValue);
+      fCutType.push_back(node.fCutType ? 1 : 0);
+      fLeft.push_back(first + (int)queue.size());
+      fValue.push_back(0.);
+      queue.push_back(node.fLeft);
+      queue.push_back(node.fRight);
+      depth.push_back(depth[iq] + 1);
+      depth.push_back(depth[iq] + 1);
+      fMaxDepth = std::max(fMaxDepth, depth[iq] + 1);
+    } else {
+      if (node.fNodeType == 0) fStatusIsClean = false; // internal node without daughters
+      fVar.push_back(0);
+      fCut.push_back(std::numeric_limits<double>::quiet_NaN());
+      fCutType.push_back(1);
+      fLeft.push_back(index);
+      switch (fBoostType) {
+        case kGrad:
+          fValue.push_back(node.fResponse);
+          break;
+        case kAdaBoostPurity:
+          fValue.push_back(node.fPurity);
+          break;
+        default:
+          fValue.push_back(node.fNodeType);
+          break;
+      }
+    }
+  }
+}
+
+//________________________________________________________________
+void AliHFFlatBDTReader::Finalise()
+{
+  // same order of the sum as in the generated GetMvaValue__
+  fNorm = 0.;
+  for (size_t itree = 0; itree < fBoostWeights.size(); ++itree) fNorm += fBoostWeights[itree];
+  if (fBoostType == kGrad) {
+    for (size_t itree = 0; itree < fBoostWeights.size(); ++itree) fBoostWeights[itree] = 1.;
+  }
+  for (size_t inode = 0; inode < fVar.size(); ++inode) {
+    if (fVar[inode] < 0 || fVar[inode] >= (int)fNvars) fStatusIsClean = false;
+  }
+}
+
+//________________________________________________________________
+void AliHFFlatBDTReader::CheckInputVariables(const std::vector<std::string>& theInputVars)
+{
+  // same sanity checks as in the generated classes
+  if (theInputVars.size() != fNvars) {
+    std::cout << "Problem in class \"AliHFFlatBDTReader\": mismatch in number of input values: "
+              << theInputVars.size() << " != " << fNvars << std::endl;
+    fStatusIsClean = false;
+    return;
+  }
+  if (fInputVars.empty()) {
+    fInputVars = theInputVars;
+    return;
+  }
+  for (size_t ivar = 0; ivar < theInputVars.size(); ivar++) {
+    if (theInputVars[ivar] != fInputVars[ivar]) {
+      std::cout << "Problem in class \"AliHFFlatBDTReader\": mismatch in input variable names" << std::endl
+                << " for variable [" << ivar << "]: " << theInputVars[ivar].c_str() << " != " << fInputVars[ivar] << std::endl;
+      fStatusIsClean = false;
+    }
+  }
+}
+
+//________________________________________________________________
+double AliHFFlatBDTReader::Response(double sum) const
+{
+  if (fBoostType == kGrad) return 2.0/(1.0+std::exp(-2.0*sum))-1.0;
+  return sum /= fNorm;
+}
+
+//________________________________________________________________
+double AliHFFlatBDTReader::GetMvaValue(const std::vector<double>& inputValues) const
+{
+  if (!IsStatusClean() || inputValues.size() < fNvars) {
+    std::cout << "Problem in class \"AliHFFlatBDTReader\": cannot return classifier response"
+              << " because status is dirty" << std::endl;
+    return 0;
+  }
+  const double* x = &inputValues[0];
+  double sum = 0.;
+  for (size_t itree = 0; itree < fTreeRoot.size(); ++itree) {
+    int inode = fTreeRoot[itree];
+    for (int idepth = 0; idepth < fMaxDepth; ++idepth) {
+      const int goesRight = fCutInclusive ? (x[fVar[inode]] >= fCut[inode]) : (x[fVar[inode]] > fCut[inode]);
+      inode = fLeft[inode] + (goesRight == fCutType[inode]);
+    }
+    sum += fBoostWeights[itree] * fValue[inode];
+  }
+  return Response(sum);
+}
+
+//________________________________________________________________
+void AliHFFlatBDTReader::GetMvaValues(const double* inputValues, int nCand, double* mvaValues) const
+{
+  /// candidates are processed in blocks, with the tree loop outside and the
+  /// candidate loop inside so that the traversal step vectorises (gathers)
+  /// over candidates; the sum over trees keeps the order of GetMvaValue
+  if (!IsStatusClean()) {
+    std::cout << "Problem in class \"AliHFFlatBDTReader\": cannot return classifier response"
+              << " because status is dirty" << std::endl;
+    for (int icand = 0; icand < nCand; ++icand) mvaValues[icand] = 0;
+    return;
+  }
+  const int kBlock = 16;
+  const int nvars = (int)fNvars;
+  int inode[kBlock];
+  double sum[kBlock];
+  for (int first = 0; first < nCand; first += kBlock) {
+    const int n = std::min(kBlock, nCand - first);
+    const double* x = inputValues + (size_t)first * nvars;
+    for (int icand = 0; icand < n; ++icand) sum[icand] = 0.;
+    for (size_t itree = 0; itree < fTreeRoot.size(); ++itree) {
+      for (int icand = 0; icand < n; ++icand) inode[icand] = fTreeRoot[itree];
+      for (int idepth = 0; idepth < fMaxDepth; ++idepth) {
+        if (fCutInclusive) {
+          for (int icand = 0; icand < n; ++icand) {
+            const int node = inode[icand];
+            const int goesRight = x[icand * nvars + fVar[node]] >= fCut[node];
+            inode[icand] = fLeft[node] + (goesRight == fCutType[node]);
+          }
+        } else {
+          for (int icand = 0; icand < n; ++icand) {
+            const int node = inode[icand];
+            const int goesRight = x[icand * nvars + fVar[node]] > fCut[node];
+            inode[icand] = fLeft[node] + (goesRight == fCutType[node]);
+          }
+        }
+      }
+      const double weight = fBoostWeights[itree];
+      for (int icand = 0; icand < n; ++icand) sum[icand] += weight * fValue[inode[icand]];
+    }
+    for (int icand = 0; icand < n; ++icand) mvaValues[first + icand] = Response(sum[icand]);
+  }
+}
+
+//________________________________________________________________
+std::vector<double> AliHFFlatBDTReader::GetCutValues(int ivar) const
+{
+  std::vector<double> cuts;
+  for (size_t inode = 0; inode < fVar.size(); ++inode) {
+    if (fLeft[inode] != (int)inode && fVar[inode] == ivar) cuts.push_back(fCut[inode]);
+  }
+  return cuts;
+}
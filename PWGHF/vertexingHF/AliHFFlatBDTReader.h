@@ -0,0 +1,86 @@
+#ifndef ALIHFFLATBDTREADER_H
+#define ALIHFFLATBDTREADER_H
+
+/// \class AliHFFlatBDTReader
+/// \brief Generic evaluator of TMVA BDTs loaded at runtime, replacing the
+///        ReadBDT_* classes generated by MethodBase::MakeClass.
+///
+/// The forest is read either from the TMVA weights file (.weights.xml) or
+/// from a generated .class.cxx file used as plain text, and stored as flat
+/// node tables (one array per node property). Leaves point to themselves,
+/// so that every tree is traversed with a fixed number of branch-free steps.
+/// When loaded from a generated class, the scores are bit-identical to the
+/// ones of the generated ReadBDT_* class.
+
+#include <string>
+#include <vector>
+
+#include "IClassifierReader.h"
+
+class AliHFFlatBDTReader : public IClassifierReader {
+
+ public:
+
+  enum EBoostType {kAdaBoostYesNoLeaf, kAdaBoostPurity, kGrad};
+
+  AliHFFlatBDTReader();
+  /// load weightsFile (.xml or generated .class.cxx) and check the input variables as the generated classes do
+  AliHFFlatBDTReader(std::vector<std::string>& theInputVars, const std::string& weightsFile);
+  virtual ~AliHFFlatBDTReader() {}
+
+  bool LoadWeightsXML(const std::string& path);
+  bool LoadClassFile(const std::string& path);
+
+  /// classifier response, inputValues in the order of the training variables
+  virtual double GetMvaValue(const std::vector<double>& inputValues) const;
+  /// classifier response for nCand candidates stored row-major (nCand x GetNvar()) in inputValues
+  void GetMvaValues(const double* inputValues, int nCand, double* mvaValues) const;
+
+  size_t GetNvar() const { return fNvars; }
+  size_t GetNTrees() const { return fTreeRoot.size(); }
+  size_t GetNNodes() const { return fVar.size(); }
+  int GetMaxDepth() const { return fMaxDepth; }
+  EBoostType GetBoostType() const { return fBoostType; }
+  const std::vector<std::string>& GetInputVariables() const { return fInputVars; }
+  /// cut values used on variable ivar, handy to sample inputs close to the decision boundaries
+  std::vector<double> GetCutValues(int ivar) const;
+
+ private:
+
+  /// temporary node used while reading the forest, before flattening
+  struct BDTInputNode {
+    int fLeft;
+    int fRight;
+    int fSelector;
+    double fCutValue;
+    bool fCutType;
+    int fNodeType;
+    double fPurity;
+    double fResponse;
+  };
+
+  void Reset();
+  void AddTree(const std::vector<BDTInputNode>& nodes, int root, double boostWeight);
+  void Finalise();
+  void CheckInputVariables(const std::vector<std::string>& theInputVars);
+  double Response(double sum) const;
+
+  size_t fNvars;                        /// number of input variables
+  std::vector<std::string> fInputVars;  /// names of the input variables (if known)
+  EBoostType fBoostType;                /// how the tree responses are combined
+  bool fCutInclusive;                   /// true: x >= cut goes right (TMVA::Reader), false: x > cut (generated classes)
+  int fMaxDepth;                        /// number of traversal steps per tree
+
+  // flat node tables, children of an internal node are stored next to each other (right = left + 1)
+  std::vector<int> fVar;                /// selector of each node (0 for leaves)
+  std::vector<double> fCut;             /// cut value of each node (NaN for leaves, so that they never move)
+  std::vector<int> fCutType;            /// cut type of each node (1 for leaves)
+  std::vector<int> fLeft;               /// index of the left daughter (the node itself for leaves)
+  std::vector<double> fValue;           /// leaf value entering the sum (node type, purity or response)
+
+  std::vector<int> fTreeRoot;           /// index of the root node of each tree
+  std::vector<double> fBoostWeights;    /// boost weight of each tree
+  double fNorm;                         /// sum of the boost weights
+};
+
+#endif
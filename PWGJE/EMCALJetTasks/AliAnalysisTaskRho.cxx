@@ -12,6 +12,7 @@
 #include "AliClusterContainer.h"
 #include "AliVEventHandler.h"
 #include "AliAnalysisDataContainer.h"
+#include "AliEmcalJetBackgroundCache.h"
 
 ClassImp(AliAnalysisTaskRho)
 
@@ -77,7 +78,9 @@ Bool_t AliAnalysisTaskRho::Run()
   }
 
   static Double_t rhovec[999];
+  static AliEmcalJetBackgroundCache::JetList_t accJets;
   Int_t NjetAcc = 0;
+  accJets.clear();
 
   // push all jets within selected acceptance into stack
   for (Int_t iJets = 0; iJets < Njets; ++iJets) {
@@ -96,13 +99,15 @@ Bool_t AliAnalysisTaskRho::Run()
       continue;
 
     rhovec[NjetAcc] = jet->Pt() / jet->Area();
+    accJets.push_back(jet);
     ++NjetAcc;
   }
 
 
   if (NjetAcc > 0) {
-    //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    //find median value, shared with the other rho tasks selecting the same jets
+    AliEmcalJetBackgroundCache *cache = AliEmcalJetBackgroundCache::GetCache(InputEvent());
+    Double_t rho = cache ? cache->GetMedian("rho", accJets, rhovec) : TMath::Median(NjetAcc, rhovec);
     fOutRho->SetVal(rho);
 
     if (fOutRhoScaled) {
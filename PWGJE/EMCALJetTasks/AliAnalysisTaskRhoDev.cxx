@@ -36,6 +36,7 @@
 #include "AliEmcalJet.h"
 #include "AliRhoParameter.h"
 #include "AliJetContainer.h"
+#include "AliEmcalJetBackgroundCache.h"
 
 ClassImp(AliAnalysisTaskRhoDev);
 
@@ -92,7 +93,9 @@ void AliAnalysisTaskRhoDev::CalculateRho()
   auto maxJets = GetLeadingJets();
 
   static Double_t rhovec[999];
+  static AliEmcalJetBackgroundCache::JetList_t accJets;
   Int_t NjetAcc = 0;
+  accJets.clear();
   Double_t TotaljetArea = 0; // Total area of background jets (including ghost jets)
   Double_t TotaljetAreaPhys = 0; // Total area of physical background jets (excluding ghost jets)
   // Ghost jet is a jet made only of ghost particles
@@ -104,6 +107,15 @@ void AliAnalysisTaskRhoDev::CalculateRho()
     if (sigJetContIt != fJetCollArray.end()) sigJetCont = sigJetContIt->second;
   }
 
+  // The overlap test results and the median are shared with the other rho tasks
+  AliEmcalJetBackgroundCache* cache = AliEmcalJetBackgroundCache::GetCache(InputEvent());
+  Int_t signalHandle = -1;
+  if (sigJetCont && cache) {
+    AliEmcalJetBackgroundCache::JetList_t signalJets;
+    for (auto sigJet : sigJetCont->accepted()) signalJets.push_back(sigJet);
+    signalHandle = cache->RegisterSignalJets(signalJets);
+  }
+
   // push all jets within selected acceptance into stack
   for (auto jet : bkgJetCont->accepted()) {
 
@@ -117,7 +129,10 @@ void AliAnalysisTaskRhoDev::CalculateRho()
     if (jet == maxJets.first || jet == maxJets.second) continue;
 
     Bool_t overlapsWithSignal = kFALSE;
-    if (sigJetCont) {
+    if (signalHandle >= 0) {
+      overlapsWithSignal = cache->IsOverlapping(signalHandle, jet);
+    }
+    else if (sigJetCont) {
       for (auto sigJet : sigJetCont->accepted()) {
         if (AreJetsOverlapping(jet, sigJet)) {
           overlapsWithSignal = kTRUE;
@@ -129,6 +144,7 @@ void AliAnalysisTaskRhoDev::CalculateRho()
     if (overlapsWithSignal) continue;
 
     rhovec[NjetAcc] = jet->Pt() / jet->Area();
+    accJets.push_back(jet);
     ++NjetAcc;
   }
 
@@ -142,7 +158,7 @@ void AliAnalysisTaskRhoDev::CalculateRho()
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = cache ? cache->GetMedian("rho", accJets, rhovec) : TMath::Median(NjetAcc, rhovec);
 
     if (fRhoSparse) rho = rho * fOccupancyFactor;
 
@@ -26,6 +26,8 @@
  ************************************************************************************/
 #include "AliAnalysisTaskRhoMass.h"
 
+#include <algorithm>
+
 #include <TClonesArray.h>
 #include <TMath.h>
 
@@ -33,6 +35,7 @@
 #include "AliEmcalJet.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
+#include "AliEmcalJetBackgroundCache.h"
 
 ClassImp(AliAnalysisTaskRhoMass)
 
@@ -112,7 +115,10 @@ Bool_t AliAnalysisTaskRhoMass::Run()
   static Double_t rhomvec[999];
   static Double_t Evec[999];
   static Double_t Mvec[999];
+  static AliEmcalJet* jetvec[999];
+  static AliEmcalJetBackgroundCache::JetList_t accJets;
   Int_t NjetAcc = 0;
+  accJets.clear();
 
   // push all jets within selected acceptance into stack
   for (Int_t iJets = 0; iJets < Njets; ++iJets) {
@@ -135,17 +141,35 @@ Bool_t AliAnalysisTaskRhoMass::Run()
     if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
       //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
       // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
       Evec[NjetAcc] = jet->E();
       Mvec[NjetAcc] = jet->M();
+      jetvec[NjetAcc] = jet;
+      accJets.push_back(jet);
       ++NjetAcc;
     }
   }
 
+  // Md/Area loops over the jet constituents: reuse it if another rho_m task
+  // with the same settings already computed it for the same jets
+  AliEmcalJetBackgroundCache *cache = AliEmcalJetBackgroundCache::GetCache(InputEvent());
+  TString quantity = TString::Format("rhom_%d_%d_%s_%s", fJetRhoMassType, fPionMassClusters,
+                                     fTracks ? fTracks->GetName() : "", fCaloClusters ? fCaloClusters->GetName() : "");
+  Int_t cacheIndex = cache ? cache->FindDensities(quantity, accJets) : -1;
+  if (cacheIndex >= 0) {
+    std::copy(cache->GetDensities(cacheIndex).begin(), cache->GetDensities(cacheIndex).end(), rhomvec);
+  }
+  else {
+    for (Int_t i = 0; i < NjetAcc; ++i) {
+      rhomvec[i] = GetMd(jetvec[i]) / jetvec[i]->Area();
+    }
+    if (cache) cacheIndex = cache->AddDensities(quantity, accJets, rhomvec);
+  }
+
+  for (Int_t i = 0; i < NjetAcc; ++i) fHistMdAreavsCent->Fill(fCent,rhomvec[i]);
+
   if (NjetAcc > 0) {
     //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = cache ? cache->GetMedian(cacheIndex) : TMath::Median(NjetAcc, rhomvec);
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
@@ -17,6 +17,7 @@
 #include "AliLog.h"
 #include "AliRhoParameter.h"
 #include "AliJetContainer.h"
+#include "AliEmcalJetBackgroundCache.h"
 
 ClassImp(AliAnalysisTaskRhoSparse)
 
@@ -122,8 +123,28 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
     }
   }
 
+  // Signal jets used to veto overlapping background jets; the outcome of the
+  // overlap test is shared with the other rho tasks using the same signal jets
+  AliEmcalJetBackgroundCache *cache = AliEmcalJetBackgroundCache::GetCache(InputEvent());
+  static AliEmcalJetBackgroundCache::JetList_t signalJets;
+  signalJets.clear();
+  if (sigjets && fExcludeOverlaps) {
+    for(Int_t j=0;j<NjetsSig;j++)
+    {
+      AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
+      if(!signalJet)
+        continue;
+      if(!IsJetSignal(signalJet))
+        continue;
+      signalJets.push_back(signalJet);
+    }
+  }
+  Int_t signalHandle = (cache && !signalJets.empty()) ? cache->RegisterSignalJets(signalJets) : -1;
+
   static Double_t rhovec[999];
+  static AliEmcalJetBackgroundCache::JetList_t accJets;
   Int_t NjetAcc = 0;
+  accJets.clear();
   Double_t TotaljetAreaPhys=0;
   Double_t TotalAreaCovered=0;
   Double_t TotalTPCArea=2*TMath::Pi()*0.9;
@@ -161,16 +182,13 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
 
     // Search for overlap with signal jets
     Bool_t isOverlapping = kFALSE;
-    if (sigjets) {
-      for(Int_t j=0;j<NjetsSig;j++)
+    if (cache && signalHandle >= 0) {
+      isOverlapping = cache->IsOverlapping(signalHandle, jet);
+    }
+    else {
+      for (auto signalJet : signalJets)
       {
-        AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
-        if(!signalJet)
-          continue;
-        if(!IsJetSignal(signalJet))
-          continue;
-
-        if(IsJetOverlapping(signalJet, jet))
+        if(AliEmcalJetBackgroundCache::AreJetsOverlapping(signalJet, jet))
         {
           isOverlapping = kTRUE;
           break;
@@ -202,6 +220,7 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
     if(jet->GetNumberOfTracks()>0)
     {
       rhovec[NjetAcc] = jet->Pt() / jet->Area();
+      accJets.push_back(jet);
       ++NjetAcc;
     }
   }
@@ -223,7 +242,7 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = cache ? cache->GetMedian("rho", accJets, rhovec) : TMath::Median(NjetAcc, rhovec);
 
     if(fRhoCMS){
       rho = rho * OccCorr;
@@ -0,0 +1,180 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include "AliEmcalJetBackgroundCache.h"
+
+#include <TMath.h>
+#include <TTree.h>
+
+#include <AliAnalysisManager.h>
+#include <AliVEvent.h>
+
+#include "AliEmcalJet.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalJetBackgroundCache);
+/// \endcond
+
+const char *AliEmcalJetBackgroundCache::fgkCacheName = "EmcalJetBackgroundCache";
+
+AliEmcalJetBackgroundCache::AliEmcalJetBackgroundCache() :
+  TNamed(),
+  fEntry(-1),
+  fTreeNumber(-1),
+  fDensities(),
+  fOverlaps()
+{
+}
+
+AliEmcalJetBackgroundCache::AliEmcalJetBackgroundCache(const char *name) :
+  TNamed(name, name),
+  fEntry(-1),
+  fTreeNumber(-1),
+  fDensities(),
+  fOverlaps()
+{
+}
+
+AliEmcalJetBackgroundCache* AliEmcalJetBackgroundCache::GetCache(AliVEvent* event)
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!event || !mgr || mgr->GetCurrentEntry() < 0) return nullptr;
+
+  TObject *obj = event->FindListObject(fgkCacheName);
+  AliEmcalJetBackgroundCache *cache = dynamic_cast<AliEmcalJetBackgroundCache*>(obj);
+  if (!cache) {
+    if (obj) {
+      ::Error("AliEmcalJetBackgroundCache::GetCache", "Object %s already in the event is not a background cache", fgkCacheName);
+      return nullptr;
+    }
+    cache = new AliEmcalJetBackgroundCache(fgkCacheName);
+    event->AddObject(cache);
+  }
+
+  // Chain entries are numbered per tree: the tree number is needed to tell events apart
+  TTree *tree = mgr->GetTree();
+  cache->Validate(mgr->GetCurrentEntry(), tree ? tree->GetTreeNumber() : -1);
+
+  return cache;
+}
+
+void AliEmcalJetBackgroundCache::Validate(Long64_t entry, Int_t treeNumber)
+{
+  if (entry == fEntry && treeNumber == fTreeNumber) return;
+
+  Clear();
+  fEntry = entry;
+  fTreeNumber = treeNumber;
+}
+
+void AliEmcalJetBackgroundCache::Clear(Option_t*)
+{
+  fDensities.clear();
+  fOverlaps.clear();
+  fEntry = -1;
+  fTreeNumber = -1;
+}
+
+Int_t AliEmcalJetBackgroundCache::FindDensities(const char* quantity, const JetList_t& jets) const
+{
+  for (UInt_t i = 0; i < fDensities.size(); i++) {
+    if (fDensities[i].fJets == jets && fDensities[i].fQuantity == quantity) return i;
+  }
+  return -1;
+}
+
+Int_t AliEmcalJetBackgroundCache::AddDensities(const char* quantity, const JetList_t& jets, const Double_t* values)
+{
+  DensityEntry_t entry;
+  entry.fQuantity = quantity;
+  entry.fJets = jets;
+  entry.fValues.assign(values, values + jets.size());
+  entry.fMedian = 0;
+  entry.fHasMedian = kFALSE;
+  fDensities.push_back(entry);
+
+  return fDensities.size() - 1;
+}
+
+Double_t AliEmcalJetBackgroundCache::GetMedian(Int_t i)
+{
+  DensityEntry_t &entry = fDensities[i];
+  if (!entry.fHasMedian) {
+    entry.fMedian = entry.fValues.empty() ? 0 : TMath::Median(entry.fValues.size(), entry.fValues.data());
+    entry.fHasMedian = kTRUE;
+  }
+  return entry.fMedian;
+}
+
+Double_t AliEmcalJetBackgroundCache::GetMedian(const char* quantity, const JetList_t& jets, const Double_t* values)
+{
+  Int_t i = FindDensities(quantity, jets);
+  if (i < 0) i = AddDensities(quantity, jets, values);
+  return GetMedian(i);
+}
+
+Int_t AliEmcalJetBackgroundCache::RegisterSignalJets(const JetList_t& signalJets)
+{
+  for (UInt_t i = 0; i < fOverlaps.size(); i++) {
+    if (fOverlaps[i].fSignalJets == signalJets) return i;
+  }
+
+  OverlapEntry_t entry;
+  entry.fSignalJets = signalJets;
+  fOverlaps.push_back(entry);
+
+  return fOverlaps.size() - 1;
+}
+
+Bool_t AliEmcalJetBackgroundCache::IsOverlapping(Int_t i, const AliEmcalJet* jet)
+{
+  OverlapEntry_t &entry = fOverlaps[i];
+
+  auto it = entry.fOverlaps.find(jet);
+  if (it != entry.fOverlaps.end()) return it->second;
+
+  Bool_t overlapping = kFALSE;
+  for (auto signalJet : entry.fSignalJets) {
+    if (AreJetsOverlapping(signalJet, jet)) {
+      overlapping = kTRUE;
+      break;
+    }
+  }
+  entry.fOverlaps[jet] = overlapping;
+
+  return overlapping;
+}
+
+Bool_t AliEmcalJetBackgroundCache::AreJetsOverlapping(const AliEmcalJet* jet1, const AliEmcalJet* jet2)
+{
+  for (Int_t i = 0; i < jet1->GetNumberOfTracks(); ++i) {
+    Int_t jet1Track = jet1->TrackAt(i);
+    for (Int_t j = 0; j < jet2->GetNumberOfTracks(); ++j) {
+      if (jet1Track == jet2->TrackAt(j)) return kTRUE;
+    }
+  }
+  return kFALSE;
+}
@@ -0,0 +1,150 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALJETBACKGROUNDCACHE_H
+#define ALIEMCALJETBACKGROUNDCACHE_H
+
+#include <map>
+#include <vector>
+
+#include <TNamed.h>
+#include <TString.h>
+
+class AliEmcalJet;
+class AliVEvent;
+
+/**
+ * @class AliEmcalJetBackgroundCache
+ * @brief Per-event store of background densities shared by the rho tasks
+ * @ingroup PWGJEBASE
+ * @since Oct 17, 2026
+ *
+ * Several rho tasks usually run on the same kt jet collection within one train.
+ * The cache is attached to the event (same mechanism as AliRhoParameter) and
+ * memoises, for a given list of background jets, the per-jet densities together
+ * with their median, as well as the outcome of the (track sharing) overlap test
+ * between background jets and a list of signal jets.
+ *
+ * Entries are keyed by the name of the density ("rho", "rhom_...") and by the
+ * exact ordered list of jets entering it, so two tasks only share a result if
+ * their jet selections coincide. The cache is emptied whenever the analysis
+ * manager moves to a new entry; without a current entry GetCache() returns null
+ * and the tasks compute everything locally.
+ */
+class AliEmcalJetBackgroundCache : public TNamed {
+ public:
+  typedef std::vector<const AliEmcalJet*> JetList_t;
+
+  AliEmcalJetBackgroundCache();
+  AliEmcalJetBackgroundCache(const char *name);
+  virtual ~AliEmcalJetBackgroundCache() {}
+
+  /**
+   * @brief Find the cache attached to the event, creating it if needed
+   * @param event Input event
+   * @return Cache valid for the current entry, or null if the entry is unknown
+   */
+  static AliEmcalJetBackgroundCache* GetCache(AliVEvent* event);
+
+  void                  Clear(Option_t *option="");
+
+  /**
+   * @brief Look up the densities stored for a jet list
+   * @param quantity Name of the density
+   * @param jets Ordered list of jets the densities were computed from
+   * @return Handle of the entry, -1 if not yet stored
+   */
+  Int_t                 FindDensities(const char* quantity, const JetList_t& jets) const;
+
+  /**
+   * @brief Store densities computed by a task for a jet list
+   * @param quantity Name of the density
+   * @param jets Ordered list of jets the densities were computed from
+   * @param values One density per jet
+   * @return Handle of the entry
+   */
+  Int_t                 AddDensities(const char* quantity, const JetList_t& jets, const Double_t* values);
+
+  const std::vector<Double_t>& GetDensities(Int_t i) const      { return fDensities[i].fValues; }
+  Double_t              GetMedian(Int_t i);
+
+  /**
+   * @brief Median of the densities, stored on first use
+   *
+   * Shortcut for tasks that have the densities at hand anyway.
+   */
+  Double_t              GetMedian(const char* quantity, const JetList_t& jets, const Double_t* values);
+
+  /**
+   * @brief Register the signal jets used to veto background jets
+   * @param signalJets List of accepted signal jets
+   * @return Handle to be passed to IsOverlapping()
+   */
+  Int_t                 RegisterSignalJets(const JetList_t& signalJets);
+
+  /**
+   * @brief Whether a background jet shares at least one track with any of the signal jets
+   * @param i Handle returned by RegisterSignalJets()
+   * @param jet Background jet
+   */
+  Bool_t                IsOverlapping(Int_t i, const AliEmcalJet* jet);
+
+  static Bool_t         AreJetsOverlapping(const AliEmcalJet* jet1, const AliEmcalJet* jet2);
+
+ protected:
+  /// Densities of one jet list
+  struct DensityEntry_t {
+    TString                fQuantity;   ///< name of the density
+    JetList_t              fJets;       ///< jets entering the density, in the order of the values
+    std::vector<Double_t>  fValues;     ///< density of each jet
+    Double_t               fMedian;     ///< median of the values
+    Bool_t                 fHasMedian;  ///< whether the median was computed
+  };
+
+  /// Overlap test results for one list of signal jets
+  struct OverlapEntry_t {
+    JetList_t                               fSignalJets;  ///< signal jets
+    std::map<const AliEmcalJet*, Bool_t>    fOverlaps;    ///< result of the overlap test per background jet
+  };
+
+  void                  Validate(Long64_t entry, Int_t treeNumber);
+
+  Long64_t                     fEntry;       //!<! entry the content belongs to
+  Int_t                        fTreeNumber;  //!<! tree number (in the chain) the content belongs to
+  std::vector<DensityEntry_t>  fDensities;   //!<! memoised densities
+  std::vector<OverlapEntry_t>  fOverlaps;    //!<! memoised overlap tests
+
+  static const char           *fgkCacheName; ///< name of the cache in the event
+
+ private:
+  AliEmcalJetBackgroundCache(const AliEmcalJetBackgroundCache&);            // not implemented
+  AliEmcalJetBackgroundCache& operator=(const AliEmcalJetBackgroundCache&); // not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalJetBackgroundCache, 1); // Per-event cache of background densities
+  /// \endcond
+};
+#endif
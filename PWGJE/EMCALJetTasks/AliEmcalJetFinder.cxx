@@ -93,7 +93,7 @@ Bool_t AliEmcalJetFinder::FindJets()
     AliEmcalJet* jet = new AliEmcalJet(fastjets[i].perp(), fastjets[i].eta(), fastjets[i].phi(), fastjets[i].m());
 
     // Set the most important properties of the jet
-    Int_t nConstituents(fFastjetWrapper->GetJetConstituents(i).size());
+    Int_t nConstituents(fFastjetWrapper->GetJetConstituentSpan(i).size());
     jet->SetArea(fFastjetWrapper->GetJetArea(i));
     jet->SetNumberOfTracks(nConstituents);
     jet->SetNumberOfClusters(nConstituents);
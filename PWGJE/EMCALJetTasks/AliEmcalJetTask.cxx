@@ -25,6 +25,7 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
  **************************************************************************************/
 #include <vector>
+#include <thread>
 
 #include <TClonesArray.h>
 #include <TMath.h>
@@ -91,6 +92,9 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fRandom(0),
   fLocked(0),
   fFillConstituents(kTRUE),
+  fAdditionalJetAlgos(),
+  fAdditionalJetRadii(),
+  fNThreads(1),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -100,6 +104,8 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fFillGhost(kFALSE),
   fJets(0),
   fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
+  fAdditionalWrappers(),
+  fAdditionalJets(),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
 {
@@ -133,6 +139,9 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fRandom(0),
   fLocked(0),
   fFillConstituents(kTRUE),
+  fAdditionalJetAlgos(),
+  fAdditionalJetRadii(),
+  fNThreads(1),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -142,6 +151,8 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fFillGhost(kFALSE),
   fJets(0),
   fFastJetWrapper(name,name),
+  fAdditionalWrappers(),
+  fAdditionalJets(),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
 {
@@ -152,6 +163,7 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  for (UInt_t i = 0; i < fAdditionalWrappers.size(); i++) delete fAdditionalWrappers[i];
 }
 
 /**
@@ -171,6 +183,24 @@ AliEmcalJetUtility* AliEmcalJetTask::AddUtility(AliEmcalJetUtility* utility)
   return utility;
 }
 
+/**
+ * Add a jet definition that is run on the same input as the main jet definition
+ * of this task. The input vectors (including the artificial tracking inefficiency
+ * and the q/pt shift, if any) are built only once per event and shared by all jet
+ * definitions. The jets are written to a separate collection, named as the one of
+ * a jet finder task with the same settings and the given algorithm and radius.
+ * Jet utilities are only executed for the main jet definition.
+ * @param algo Jet algorithm (anti-kt, kt, etc.)
+ * @param r Jet resolution parameter
+ */
+void AliEmcalJetTask::AddJetDefinition(EJetAlgo_t algo, Double_t r)
+{
+  if (IsLocked()) return;
+
+  fAdditionalJetAlgos.push_back(algo);
+  fAdditionalJetRadii.push_back(r);
+}
+
 /**
  * This method is called once before analyzing the first event. It executes
  * the Init() method of all utilities (if any).
@@ -235,11 +265,21 @@ Bool_t AliEmcalJetTask::Run()
   InitEvent();
   // clear the jet array (normally a null operation)
   fJets->Delete();
+  for (UInt_t i = 0; i < fAdditionalJets.size(); i++) {
+    if (fAdditionalJets[i]) fAdditionalJets[i]->Delete();
+  }
   Int_t n = FindJets();
 
-  if (n == 0) return kFALSE;
+  if (n > 0) FillJetBranch();
+
+  // the additional jet definitions were run only if there was any input
+  for (UInt_t i = 0; i < fAdditionalWrappers.size() && fFastJetWrapper.GetInputVectors().size() > 0; i++) {
+    if (!fAdditionalWrappers[i] || fAdditionalWrappers[i]->GetInclusiveJets().size() == 0) continue;
+    FillJetBranch(*fAdditionalWrappers[i], fAdditionalJets[i], fAdditionalJetRadii[i], kFALSE);
+    n += fAdditionalWrappers[i]->GetInclusiveJets().size();
+  }
 
-  FillJetBranch();
+  if (n == 0) return kFALSE;
 
   return kTRUE;
 }
@@ -322,12 +362,47 @@ Int_t AliEmcalJetTask::FindJets()
 
   if (fFastJetWrapper.GetInputVectors().size() == 0) return 0;
 
-  // run jet finder
-  fFastJetWrapper.Run();
+  // the additional jet definitions get a copy of the input vectors, including the constituent ids
+  for (UInt_t i = 0; i < fAdditionalWrappers.size(); i++) {
+    if (!fAdditionalWrappers[i]) continue;
+    fAdditionalWrappers[i]->Clear();
+    fAdditionalWrappers[i]->AddInputVectors(fFastJetWrapper.GetInputVectors());
+  }
+
+  // run jet finders
+#ifdef FASTJET_HAVE_THREAD_SAFETY
+  Int_t nThreads = TMath::Min(fNThreads, (Int_t)fAdditionalWrappers.size() + 1);
+  if (nThreads > 1) {
+    std::vector<std::thread> threads;
+    for (Int_t t = 0; t < nThreads; t++) threads.push_back(std::thread(&AliEmcalJetTask::RunJetFinders, this, t, nThreads));
+    for (Int_t t = 0; t < nThreads; t++) threads[t].join();
+    return fFastJetWrapper.GetInclusiveJets().size();
+  }
+#endif
+  RunJetFinders(0, 1);
 
   return fFastJetWrapper.GetInclusiveJets().size();
 }
 
+/**
+ * Runs the jet finders of the jet definitions first, first + step, ... where 0 is the main
+ * jet definition and i > 0 the additional jet definition i - 1. Each jet definition has its own
+ * FastJet wrapper, hence different threads can run disjoint sets of jet definitions.
+ * @param first Index of the first jet definition
+ * @param step Index step
+ */
+void AliEmcalJetTask::RunJetFinders(Int_t first, Int_t step)
+{
+  for (Int_t i = first; i <= (Int_t)fAdditionalWrappers.size(); i += step) {
+    if (i == 0) {
+      fFastJetWrapper.Run();
+    }
+    else if (fAdditionalWrappers[i-1]) {
+      fAdditionalWrappers[i-1]->Run();
+    }
+  }
+}
+
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
@@ -335,10 +410,22 @@ Int_t AliEmcalJetTask::FindJets()
  */
 void AliEmcalJetTask::FillJetBranch()
 {
-  PrepareUtilities();
+  FillJetBranch(fFastJetWrapper, fJets, fRadius, kTRUE);
+}
+
+/**
+ * This method fills a jet output branch (TClonesArray) with the jets found by a FastJet wrapper.
+ * @param wrapper FastJet wrapper that found the jets
+ * @param jets Output jet branch
+ * @param radius Jet resolution parameter (used for the fiducial acceptance)
+ * @param useUtilities If kTRUE, the jet utilities are executed (only for the main jet definition)
+ */
+void AliEmcalJetTask::FillJetBranch(AliFJWrapper& wrapper, TClonesArray* jets, Double_t radius, Bool_t useUtilities)
+{
+  if (useUtilities) PrepareUtilities();
 
   // loop over fastjet jets
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
+  const std::vector<fastjet::PseudoJet>& jets_incl = wrapper.GetInclusiveJets();
   // sort jets according to jet pt
   static Int_t indexes[9999] = {-1};
   GetSortedArray(indexes, jets_incl);
@@ -346,28 +433,28 @@ void AliEmcalJetTask::FillJetBranch()
   AliDebug(1,Form("%d jets found", (Int_t)jets_incl.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
     Int_t ij = indexes[ijet];
-    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fFastJetWrapper.GetJetArea(ij)));
+    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), wrapper.GetJetArea(ij)));
 
     if (jets_incl[ij].perp() < fMinJetPt) continue;
-    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
+    if (wrapper.GetJetArea(ij) < fMinJetArea) continue;
     if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
         (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
       continue;
 
-    AliEmcalJet *jet = new ((*fJets)[jetCount])
+    AliEmcalJet *jet = new ((*jets)[jetCount])
     		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
     jet->SetLabel(ij);
 
-    fastjet::PseudoJet area(fFastJetWrapper.GetJetAreaVector(ij));
+    fastjet::PseudoJet area(wrapper.GetJetAreaVector(ij));
     jet->SetArea(area.perp());
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
     jet->SetAreaE(area.E());
-    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
+    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), radius));
 
     // Fill constituent info
-    std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
-    FillJetConstituents(jet, constituents, constituents);
+    AliFJWrapper::ConstituentSpan_t constituents(wrapper.GetJetConstituentSpan(ij));
+    FillJetConstituents(jet, constituents.begin(), constituents.size());
 
     if (fGeom) {
       if ((jet->Phi() > fGeom->GetArm1PhiMin() * TMath::DegToRad()) &&
@@ -377,13 +464,13 @@ void AliEmcalJetTask::FillJetBranch()
         jet->SetAxisInEmcal(kTRUE);
     }
 
-    ExecuteUtilities(jet, ij);
+    if (useUtilities) ExecuteUtilities(jet, ij);
 
     AliDebug(2,Form("Added jet n. %d, pt = %f, area = %f, constituents = %d", jetCount, jet->Pt(), jet->Area(), jet->GetNumberOfConstituents()));
     jetCount++;
   }
 
-  TerminateUtilities();
+  if (useUtilities) TerminateUtilities();
 }
 
 /**
@@ -392,7 +479,7 @@ void AliEmcalJetTask::FillJetBranch()
  * @param[in] array Vector containing the list of jets obtained by the FastJet wrapper
  * @return kTRUE if at least one jet was found in array; kFALSE otherwise
  */
-Bool_t AliEmcalJetTask::GetSortedArray(Int_t indexes[], std::vector<fastjet::PseudoJet> array) const
+Bool_t AliEmcalJetTask::GetSortedArray(Int_t indexes[], const std::vector<fastjet::PseudoJet>& array) const
 {
   static Float_t pt[9999] = {0};
 
@@ -474,6 +561,36 @@ void AliEmcalJetTask::ExecOnce()
     fFastJetWrapper.SetLegacyMode(kTRUE);
   }
 
+  // setup the additional jet definitions: same settings and input, different algorithm and/or radius
+  for (UInt_t i = 0; i < fAdditionalJetAlgos.size(); i++) {
+    EJetAlgo_t algo = static_cast<EJetAlgo_t>(fAdditionalJetAlgos[i]);
+    TString jetsName = AliJetContainer::GenerateJetName(fJetType, algo, fRecombScheme, fAdditionalJetRadii[i], GetParticleContainer(0), GetClusterContainer(0), fJetsTag);
+    AliFJWrapper* wrapper = 0;
+    TClonesArray* jets = 0;
+    if (InputEvent()->FindListObject(jetsName)) {
+      AliError(Form("%s: Object with name %s already in event! Skipping this jet definition", GetName(), jetsName.Data()));
+    }
+    else {
+      jets = new TClonesArray("AliEmcalJet");
+      jets->SetName(jetsName);
+      ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", jetsName.Data());
+      InputEvent()->AddObject(jets);
+
+      wrapper = new AliFJWrapper(jetsName, jetsName);
+      wrapper->CopySettingsFrom(fFastJetWrapper);
+      wrapper->SetAlgorithm(ConvertToFJAlgo(algo));
+      wrapper->SetR(fAdditionalJetRadii[i]);
+    }
+    fAdditionalWrappers.push_back(wrapper);
+    fAdditionalJets.push_back(jets);
+  }
+
+#ifndef FASTJET_HAVE_THREAD_SAFETY
+  if (fNThreads > 1) {
+    AliWarning(Form("%s: FastJet was not built with thread safety, the jet definitions are run sequentially.", GetName()));
+  }
+#endif
+
   InitUtilities();
 
   AliAnalysisTaskEmcal::ExecOnce();
@@ -494,7 +611,22 @@ void AliEmcalJetTask::ExecOnce()
  * @param particles_sub Array containing subtracted constituents
  */
 void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet::PseudoJet>& constituents,
-    std::vector<fastjet::PseudoJet>& constituents_unsub, Int_t flag, TString particlesSubName)
+    std::vector<fastjet::PseudoJet>& /*constituents_unsub*/, Int_t flag, TString particlesSubName)
+{
+  FillJetConstituents(jet, constituents.data(), constituents.size(), flag, particlesSubName);
+}
+
+/**
+ * Same as above, reading the constituents from contiguous memory (e.g. the
+ * constituent arena of the FastJet wrapper) so that no per-jet vector is needed.
+ * @param jet Pointer to the AliEmcalJet object where the jet constituents will be added
+ * @param constituents Pointer to the first jet constituent
+ * @param nConstituents Number of jet constituents
+ * @param flag If kTRUE it means that the argument "constituents" is a list of subtracted constituents
+ * @param particles_sub Array containing subtracted constituents
+ */
+void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, const fastjet::PseudoJet* constituents, UInt_t nConstituents,
+    Int_t flag, TString particlesSubName)
 {
   Int_t nt            = 0;
   Int_t nc            = 0;
@@ -512,10 +644,10 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
 
   Int_t uid   = -1;
 
-  jet->SetNumberOfTracks(constituents.size());
-  jet->SetNumberOfClusters(constituents.size());
+  jet->SetNumberOfTracks(nConstituents);
+  jet->SetNumberOfClusters(nConstituents);
 
-  for (UInt_t ic = 0; ic < constituents.size(); ++ic) {
+  for (UInt_t ic = 0; ic < nConstituents; ++ic) {
 
     if (flag == 0) {
       uid = constituents[ic].user_index();
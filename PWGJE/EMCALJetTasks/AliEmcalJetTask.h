@@ -32,6 +32,8 @@ class TObjArray;
 class AliVEvent;
 class AliEmcalJetUtility;
 
+#include <vector>
+
 #include "TF1.h"
 #include "TRandom3.h"
 
@@ -71,6 +73,11 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Additional jet definitions (algorithm, R) can be added via AddJetDefinition(EJetAlgo_t, Double_t).
+ * They are run on the same input vectors as the main jet definition, which are built only once per event,
+ * and their jets are written to separate collections named as if they were found by a dedicated jet finder task.
+ * With a thread-safe FastJet build, the jet definitions can be run in parallel (see SetNumberOfThreads(Int_t)).
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -108,6 +115,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
+  void                   SetNumberOfThreads(Int_t n)                { if (IsLocked()) return; fNThreads         = n     ; }
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
   void                   SetMinJetClusPt(Double_t min);
@@ -116,6 +124,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetPhiRange(Double_t pmi, Double_t pma);
 
   AliEmcalJetUtility*    AddUtility(AliEmcalJetUtility* utility);
+  void                   AddJetDefinition(EJetAlgo_t algo, Double_t r);
 
   Double_t               GetGhostArea()                   { return fGhostArea         ; }
   const char*            GetJetsName()                    { return fJetsName.Data()   ; }
@@ -136,10 +145,15 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
+  Int_t                  GetNumberOfAdditionalJetDefinitions() const { return fAdditionalJetAlgos.size(); }
+  TClonesArray*          GetAdditionalJets(Int_t i)       { return i >= 0 && i < (Int_t)fAdditionalJets.size() ? fAdditionalJets[i] : 0; }
+  Int_t                  GetNumberOfThreads() const       { return fNThreads          ; }
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
 
   void                   FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet::PseudoJet>& constituents,
                                              std::vector<fastjet::PseudoJet>& constituents_sub, Int_t flag = 0, TString particlesSubName = "");
+  void                   FillJetConstituents(AliEmcalJet *jet, const fastjet::PseudoJet* constituents, UInt_t nConstituents,
+                                             Int_t flag = 0, TString particlesSubName = "");
 
   UInt_t                 FindJetAcceptanceType(Double_t eta, Double_t phi, Double_t r);
   
@@ -183,14 +197,16 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  protected:
 
   Int_t                  FindJets();
+  void                   RunJetFinders(Int_t first, Int_t step);
   void                   FillJetBranch();
+  void                   FillJetBranch(AliFJWrapper& wrapper, TClonesArray* jets, Double_t radius, Bool_t useUtilities);
   void                   ExecOnce();
   void                   InitEvent();
   void                   InitUtilities();
   void                   PrepareUtilities();
   void                   ExecuteUtilities(AliEmcalJet* jet, Int_t ij);
   void                   TerminateUtilities();
-  Bool_t                 GetSortedArray(Int_t indexes[], std::vector<fastjet::PseudoJet> array) const;
+  Bool_t                 GetSortedArray(Int_t indexes[], const std::vector<fastjet::PseudoJet>& array) const;
   Bool_t                 IsJetInEmcal(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInDcal(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInDcalOnly(Double_t eta, Double_t phi, Double_t r);
@@ -219,6 +235,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   TRandom3               fRandom;                 //!<! Random number generator for artificial tracking efficiency
   Bool_t                 fLocked;                 ///< true if lock is set
   Bool_t	               fFillConstituents;		 ///< If true jet consituents will be filled to the AliEmcalJet
+  std::vector<Int_t>     fAdditionalJetAlgos;     ///< algorithms of the additional jet definitions run on the same input
+  std::vector<Double_t>  fAdditionalJetRadii;     ///< radii of the additional jet definitions run on the same input
+  Int_t                  fNThreads;               ///< number of threads used to run the jet definitions (needs a thread-safe FastJet)
 
   TString                fJetsName;               //!<!name of jet collection
   Bool_t                 fIsInit;                 //!<!=true if already initialized
@@ -230,6 +249,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   TClonesArray          *fJets;                   //!<!jet collection
   AliFJWrapper           fFastJetWrapper;         //!<!fastjet wrapper
+  std::vector<AliFJWrapper*> fAdditionalWrappers; //!<!fastjet wrappers of the additional jet definitions (0 if disabled)
+  std::vector<TClonesArray*> fAdditionalJets;     //!<!jet collections of the additional jet definitions (0 if disabled)
 
   static const Int_t     fgkConstIndexShift;      //!<!contituent index shift
 
@@ -244,7 +265,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 30);
+  ClassDef(AliEmcalJetTask, 31);
   /// \endcond
 };
 #endif
@@ -208,9 +208,8 @@ void AliEmcalJetUtilityConstSubtractor::Terminate(AliFJWrapper& fjw)
       jet_sub->SetAreaEmc(area.perp());
       
       // Fill constituent info
-      std::vector<fastjet::PseudoJet> constituents_unsub(fjw.GetJetConstituents(ijet));
       std::vector<fastjet::PseudoJet> constituents_sub = jets_sub[ijet].constituents();
-      fJetTask->FillJetConstituents(jet_sub, constituents_sub, constituents_unsub, 1, fParticlesSubName);
+      fJetTask->FillJetConstituents(jet_sub, constituents_sub.data(), constituents_sub.size(), 1, fParticlesSubName);
       jetCount++;
     }
   }
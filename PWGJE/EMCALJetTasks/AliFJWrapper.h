@@ -13,6 +13,17 @@
 class AliFJWrapper
 {
  public:
+  /// Read-only view of the constituents of one jet, pointing into the constituent arena
+  struct ConstituentSpan_t {
+    const fastjet::PseudoJet *fBegin;
+    const fastjet::PseudoJet *fEnd;
+    const fastjet::PseudoJet* begin()                     const { return fBegin;         }
+    const fastjet::PseudoJet* end()                       const { return fEnd;           }
+    UInt_t                    size()                      const { return fEnd - fBegin;  }
+    Bool_t                    empty()                     const { return fEnd == fBegin; }
+    const fastjet::PseudoJet& operator[](UInt_t i)        const { return fBegin[i];      }
+  };
+
   AliFJWrapper(const char *name, const char *title);
   virtual ~AliFJWrapper();
 
@@ -35,6 +46,7 @@ class AliFJWrapper
   const std::vector<fastjet::PseudoJet>&  GetEventSubJets()   const { return fEventSubJets;              }
   const std::vector<fastjet::PseudoJet>&  GetFilteredJets()    const { return fFilteredJets;               }
   std::vector<fastjet::PseudoJet>         GetJetConstituents(UInt_t idx) const;
+  ConstituentSpan_t                       GetJetConstituentSpan(UInt_t idx) const;
   std::vector<fastjet::PseudoJet>         GetEventSubJetConstituents(UInt_t idx) const;
   std::vector<fastjet::PseudoJet>         GetFilteredJetConstituents(UInt_t idx) const;
   Double_t                                GetMedianUsedForBgSubtraction() const { return fMedUsedForBgSub; }
@@ -153,6 +165,10 @@ class AliFJWrapper
   std::vector<fastjet::PseudoJet>        fEventSubCorrectedVectors;       //!
   std::vector<fastjet::PseudoJet>        fInputGhosts;        //!
   std::vector<fastjet::PseudoJet>        fInclusiveJets;      //!
+  // constituents of all inclusive jets back to back, jet i in [fConstituentOffsets[i], fConstituentOffsets[i+1])
+  mutable std::vector<fastjet::PseudoJet> fConstituentArena;   //!
+  mutable std::vector<UInt_t>            fConstituentOffsets; //!
+  mutable Bool_t                         fConstituentArenaFilled; //!
   std::vector<fastjet::PseudoJet>        fEventSubJets;      //!
   std::vector<fastjet::PseudoJet>        fFilteredJets;       //!
   std::vector<double>                    fSubtractedJetsPt;   //!
@@ -238,6 +254,7 @@ class AliFJWrapper
   std::vector<double>                      fGRDenominatorSub; //!
 
   virtual void   SubtractBackground(const Double_t median_pt = -1);
+  void           FillConstituentArena() const;
 
  private:
   AliFJWrapper();
@@ -266,6 +283,9 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fEventSubCorrectedVectors      ( )
   , fInputGhosts       ( )
   , fInclusiveJets     ( )
+  , fConstituentArena  ( )
+  , fConstituentOffsets( )
+  , fConstituentArenaFilled(kFALSE)
   , fEventSubJets     ( )
   , fFilteredJets      ( )
   , fSubtractedJetsPt  ( )
@@ -362,6 +382,7 @@ void AliFJWrapper::ClearMemory()
   if (fPlugin)            { delete fPlugin;            fPlugin          = NULL; }
   if (fRange)             { delete fRange;             fRange           = NULL; }
   if (fClustSeq)          { delete fClustSeq;          fClustSeq        = NULL; }
+  fConstituentArenaFilled = kFALSE;
   if (fClustSeqES)          { delete fClustSeqES;        fClustSeqES        = NULL; }
   if (fClustSeqSA)        { delete fClustSeqSA;        fClustSeqSA        = NULL; }
   if (fClustSeqActGhosts) { delete fClustSeqActGhosts; fClustSeqActGhosts = NULL; }
@@ -621,7 +642,8 @@ AliFJWrapper::GetJetConstituents(UInt_t idx) const
   std::vector<fastjet::PseudoJet> retval;
 
   if ( idx < fInclusiveJets.size() ) {
-    retval = fClustSeq->constituents(fInclusiveJets[idx]);
+    ConstituentSpan_t span = GetJetConstituentSpan(idx);
+    retval.assign(span.begin(), span.end());
   } else {
     AliError(Form("[e] ::GetJetConstituents wrong index: %d",idx));
   }
@@ -629,6 +651,46 @@ AliFJWrapper::GetJetConstituents(UInt_t idx) const
   return retval;
 }
 
+//_________________________________________________________________________________________________
+AliFJWrapper::ConstituentSpan_t
+AliFJWrapper::GetJetConstituentSpan(UInt_t idx) const
+{
+  // Get jet constituents without copying them.
+  // The span is valid until the next call to Run() or Clear().
+
+  ConstituentSpan_t retval = {0, 0};
+
+  if ( idx < fInclusiveJets.size() ) {
+    if (!fConstituentArenaFilled) FillConstituentArena();
+    const fastjet::PseudoJet *arena = fConstituentArena.data();
+    retval.fBegin = arena + fConstituentOffsets[idx];
+    retval.fEnd   = arena + fConstituentOffsets[idx + 1];
+  } else {
+    AliError(Form("[e] ::GetJetConstituentSpan wrong index: %d",idx));
+  }
+
+  return retval;
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::FillConstituentArena() const
+{
+  // Collect the constituents of all inclusive jets in one contiguous buffer.
+  // add_constituents() appends in the same order as ClusterSequence::constituents();
+  // the buffers keep their capacity from one event to the next.
+
+  fConstituentArena.clear();
+  fConstituentOffsets.clear();
+  fConstituentOffsets.push_back(0);
+
+  for (UInt_t ij = 0; ij < fInclusiveJets.size(); ij++) {
+    if (fClustSeq) fClustSeq->add_constituents(fInclusiveJets[ij], fConstituentArena);
+    fConstituentOffsets.push_back(fConstituentArena.size());
+  }
+
+  fConstituentArenaFilled = kTRUE;
+}
+
 //_________________________________________________________________________________________________
 std::vector<fastjet::PseudoJet>
 AliFJWrapper::GetEventSubJetConstituents(UInt_t idx) const
@@ -768,6 +830,7 @@ Int_t AliFJWrapper::Run()
   fInclusiveJets.clear();
   fEventSubJets.clear();
   fInclusiveJets = fClustSeq->inclusive_jets(0.0);
+  fConstituentArenaFilled = kFALSE;
   if(fEventSub) fEventSubJets  = fClustSeqES->inclusive_jets(0.0);
 
   return 0;
@@ -44,6 +44,8 @@ class AliPIDResponse;
 class AliCFContainer;
 class AliV0Result;
 class AliCascadeResult;
+class AliV0ResultCutTable;
+class AliCascadeResultCutTable;
 class AliExternalTrackParam;
 
 //#include "TString.h"
@@ -257,6 +259,9 @@ private:
 
     TRandom3 *fRand; //!
 
+    AliV0ResultCutTable      *fV0CutTable;      //! columnar cuts of the V0 configurations
+    AliCascadeResultCutTable *fCascadeCutTable; //! columnar cuts of the cascade configurations
+
     //Objects Controlling Task Behaviour
     Bool_t fkSaveEventTree;           //if true, save Event TTree
     Bool_t fkDownScaleEvent;
@@ -663,8 +668,9 @@ private:
     AliAnalysisTaskStrangenessVsMultiplicityRun2(const AliAnalysisTaskStrangenessVsMultiplicityRun2&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityRun2& operator=(const AliAnalysisTaskStrangenessVsMultiplicityRun2&); // not implemented
 
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 4);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 5);
     //1: first implementation
+    //5: configurations evaluated with columnar cut tables
 };
 
 #endif
@@ -0,0 +1,322 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Columnar table of the cuts of a set of AliCascadeResult configurations
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include <cstring>
+#include "TList.h"
+#include "TH3F.h"
+#include "TMath.h"
+#include "AliCascadeResult.h"
+#include "AliCascadeResultCutTable.h"
+
+namespace {
+    //As used in the analysis task for the proper lifetime
+    const Float_t kCascPDGMass[AliCascadeResultCutTable::kNHypo] = { 1.32171, 1.32171, 1.67245, 1.67245 };
+
+    Int_t FindFirstSetBit(ULong64_t lWord) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(lWord);
+#else
+        Int_t lBit = 0;
+        while( !(lWord & 1) ) { lWord >>= 1; lBit++; }
+        return lBit;
+#endif
+    }
+}
+
+//________________________________________________________________
+AliCascadeResultCutTable::AliCascadeResultCutTable() :
+fNConfig(0)
+{
+}
+
+//________________________________________________________________
+void AliCascadeResultCutTable::Clear()
+{
+    fNConfig = 0;
+    fRunFirst.clear(); fListEnd.clear();
+    fResult.clear(); fHisto.clear(); fHypo.clear();
+    fCharge.clear();
+    fMinEtaTracks.clear(); fMaxEtaTracks.clear();
+    fMinRapidity.clear(); fMaxRapidity.clear();
+    fDCANegToPV.clear(); fDCAPosToPV.clear(); fDCAV0Daughters.clear(); fV0Radius.clear();
+    fDCAV0ToPV.clear(); fV0Mass.clear(); fDCABachToPV.clear(); fCascRadius.clear();
+    fV0MassSigma.clear(); fProperLifetime.clear(); fLeastNumberOfClusters.clear();
+    fTPCdEdx.clear(); fUseTOFUnchecked.clear(); fXiRejection.clear(); fDCABachToBaryon.clear();
+    fMinV0Lifetime.clear(); fMaxV0Lifetime.clear();
+    fUseITSRefitTracks.clear(); fMaxChi2PerCluster.clear();
+    fMinTrackLength.clear(); fUseParametricLength.clear();
+    fUse276TeVV0CosPA.clear(); fDCACascadeToPV.clear(); fAtLeastOneTOF.clear();
+    fUseITSRefitNegative.clear(); fUseITSRefitPositive.clear(); fUseITSRefitBachelor.clear();
+    fIsCowboy.clear(); fIsCascadeCowboy.clear();
+    fMinCrossedRowsOverLength.clear(); fLeastNumberOfCrossedRows.clear(); fITSorTOF.clear();
+    for(Int_t ivar=0; ivar<kNVarCuts; ivar++){
+        fBaseCut[ivar].clear(); fVarCutConfig[ivar].clear(); fVarCutPar[ivar].clear(); fEffCut[ivar].clear();
+    }
+    fPass.clear(); fSelected.clear();
+}
+
+//________________________________________________________________
+void AliCascadeResultCutTable::Build(TList *lListXiMinus, TList *lListXiPlus, TList *lListOmegaMinus, TList *lListOmegaPlus)
+{
+    Clear();
+    TList *lLists[kNHypo] = { lListXiMinus, lListXiPlus, lListOmegaMinus, lListOmegaPlus };
+    for(Int_t il=0; il<kNHypo; il++){
+        if( lLists[il] )
+            for(Int_t icfg=0; icfg<lLists[il]->GetEntries(); icfg++)
+                AddConfiguration( (AliCascadeResult*) lLists[il]->At(icfg) );
+        fListEnd.push_back(fNConfig);
+    }
+    //Runs of consecutive configurations with the same mass hypothesis
+    for(Long_t lcfg=0; lcfg<fNConfig; lcfg++)
+        if( lcfg==0 || fHypo[lcfg]!=fHypo[lcfg-1] ) fRunFirst.push_back(lcfg);
+    fRunFirst.push_back(fNConfig);
+    for(Int_t ivar=0; ivar<kNVarCuts; ivar++) fEffCut[ivar].resize(fNConfig);
+    fPass.resize(fNConfig);
+    fSelected.resize((fNConfig+63)/64);
+}
+
+//________________________________________________________________
+void AliCascadeResultCutTable::AddConfiguration(AliCascadeResult *lCascadeResult)
+{
+    AliCascadeResult::EMassHypo lHypo = lCascadeResult->GetMassHypothesis();
+    fResult.push_back( lCascadeResult );
+    fHisto .push_back( lCascadeResult->GetHistogram() );
+    fHypo  .push_back( lHypo );
+
+    Int_t lCharge = -2;
+    if( lHypo == AliCascadeResult::kXiMinus || lHypo == AliCascadeResult::kOmegaMinus ) lCharge = -1;
+    if( lHypo == AliCascadeResult::kXiPlus  || lHypo == AliCascadeResult::kOmegaPlus  ) lCharge = +1;
+    if( lCharge != -2 && lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
+    fCharge.push_back( lCharge );
+
+    fMinEtaTracks.push_back( lCascadeResult->GetCutMinEtaTracks() );
+    fMaxEtaTracks.push_back( lCascadeResult->GetCutMaxEtaTracks() );
+    fMinRapidity .push_back( lCascadeResult->GetCutMinRapidity() );
+    fMaxRapidity .push_back( lCascadeResult->GetCutMaxRapidity() );
+
+    fDCANegToPV    .push_back( lCascadeResult->GetCutDCANegToPV() );
+    fDCAPosToPV    .push_back( lCascadeResult->GetCutDCAPosToPV() );
+    fDCAV0Daughters.push_back( lCascadeResult->GetCutDCAV0Daughters() );
+    fV0Radius      .push_back( lCascadeResult->GetCutV0Radius() );
+    fDCAV0ToPV     .push_back( lCascadeResult->GetCutDCAV0ToPV() );
+    fV0Mass        .push_back( lCascadeResult->GetCutV0Mass() );
+    fDCABachToPV   .push_back( lCascadeResult->GetCutDCABachToPV() );
+    fCascRadius    .push_back( lCascadeResult->GetCutCascRadius() );
+    fV0MassSigma   .push_back( lCascadeResult->GetCutV0MassSigma() );
+    fProperLifetime.push_back( lCascadeResult->GetCutProperLifetime() );
+    fLeastNumberOfClusters.push_back( lCascadeResult->GetCutLeastNumberOfClusters() );
+
+    fTPCdEdx        .push_back( lCascadeResult->GetCutTPCdEdx() );
+    fUseTOFUnchecked.push_back( lCascadeResult->GetCutUseTOFUnchecked() );
+    fXiRejection    .push_back( lCascadeResult->GetCutXiRejection() );
+    fDCABachToBaryon.push_back( lCascadeResult->GetCutDCABachToBaryon() );
+    fMinV0Lifetime  .push_back( lCascadeResult->GetCutMinV0Lifetime() );
+    fMaxV0Lifetime  .push_back( lCascadeResult->GetCutMaxV0Lifetime() );
+
+    fUseITSRefitTracks  .push_back( lCascadeResult->GetCutUseITSRefitTracks() );
+    fMaxChi2PerCluster  .push_back( lCascadeResult->GetCutMaxChi2PerCluster() );
+    fMinTrackLength     .push_back( lCascadeResult->GetCutMinTrackLength() );
+    fUseParametricLength.push_back( lCascadeResult->GetCutUseParametricLength() );
+    fUse276TeVV0CosPA   .push_back( lCascadeResult->GetCutUse276TeVV0CosPA() );
+    fDCACascadeToPV     .push_back( lCascadeResult->GetCutDCACascadeToPV() );
+    fAtLeastOneTOF      .push_back( lCascadeResult->GetCutAtLeastOneTOF() );
+    fUseITSRefitNegative.push_back( lCascadeResult->GetCutUseITSRefitNegative() );
+    fUseITSRefitPositive.push_back( lCascadeResult->GetCutUseITSRefitPositive() );
+    fUseITSRefitBachelor.push_back( lCascadeResult->GetCutUseITSRefitBachelor() );
+    fIsCowboy           .push_back( lCascadeResult->GetCutIsCowboy() );
+    fIsCascadeCowboy    .push_back( lCascadeResult->GetCutIsCascadeCowboy() );
+    fMinCrossedRowsOverLength.push_back( lCascadeResult->GetCutMinCrossedRowsOverLength() );
+    fLeastNumberOfCrossedRows.push_back( lCascadeResult->GetCutLeastNumberOfCrossedRows() );
+    fITSorTOF           .push_back( lCascadeResult->GetCutITSorTOF() );
+
+    //Constant cuts and parameters of the pt-dependent versions, if requested
+    fBaseCut[0].push_back( lCascadeResult->GetCutCascCosPA() );
+    fBaseCut[1].push_back( lCascadeResult->GetCutV0CosPA() );
+    fBaseCut[2].push_back( lCascadeResult->GetCutBachBaryonCosPA() );
+    fBaseCut[3].push_back( lCascadeResult->GetCutDCACascDaughters() );
+    if( lCascadeResult->GetCutUseVarCascCosPA() ){
+        fVarCutConfig[0].push_back( fNConfig );
+        fVarCutPar[0].push_back( lCascadeResult->GetCutVarCascCosPAExp0Const() );
+        fVarCutPar[0].push_back( lCascadeResult->GetCutVarCascCosPAExp0Slope() );
+        fVarCutPar[0].push_back( lCascadeResult->GetCutVarCascCosPAExp1Const() );
+        fVarCutPar[0].push_back( lCascadeResult->GetCutVarCascCosPAExp1Slope() );
+        fVarCutPar[0].push_back( lCascadeResult->GetCutVarCascCosPAConst() );
+    }
+    if( lCascadeResult->GetCutUseVarV0CosPA() ){
+        fVarCutConfig[1].push_back( fNConfig );
+        fVarCutPar[1].push_back( lCascadeResult->GetCutVarV0CosPAExp0Const() );
+        fVarCutPar[1].push_back( lCascadeResult->GetCutVarV0CosPAExp0Slope() );
+        fVarCutPar[1].push_back( lCascadeResult->GetCutVarV0CosPAExp1Const() );
+        fVarCutPar[1].push_back( lCascadeResult->GetCutVarV0CosPAExp1Slope() );
+        fVarCutPar[1].push_back( lCascadeResult->GetCutVarV0CosPAConst() );
+    }
+    if( lCascadeResult->GetCutUseVarBBCosPA() ){
+        fVarCutConfig[2].push_back( fNConfig );
+        fVarCutPar[2].push_back( lCascadeResult->GetCutVarBBCosPAExp0Const() );
+        fVarCutPar[2].push_back( lCascadeResult->GetCutVarBBCosPAExp0Slope() );
+        fVarCutPar[2].push_back( lCascadeResult->GetCutVarBBCosPAExp1Const() );
+        fVarCutPar[2].push_back( lCascadeResult->GetCutVarBBCosPAExp1Slope() );
+        fVarCutPar[2].push_back( lCascadeResult->GetCutVarBBCosPAConst() );
+    }
+    if( lCascadeResult->GetCutUseVarDCACascDau() ){
+        fVarCutConfig[3].push_back( fNConfig );
+        fVarCutPar[3].push_back( lCascadeResult->GetCutVarDCACascDauExp0Const() );
+        fVarCutPar[3].push_back( lCascadeResult->GetCutVarDCACascDauExp0Slope() );
+        fVarCutPar[3].push_back( lCascadeResult->GetCutVarDCACascDauExp1Const() );
+        fVarCutPar[3].push_back( lCascadeResult->GetCutVarDCACascDauExp1Slope() );
+        fVarCutPar[3].push_back( lCascadeResult->GetCutVarDCACascDauConst() );
+    }
+    fNConfig++;
+}
+
+//________________________________________________________________
+Long_t AliCascadeResultCutTable::Select(const Candidate &lCand)
+{
+    if( fNConfig == 0 ) return 0;
+
+    //Cuts in use: the pt-dependent CosPA cuts only if tighter (BB CosPA: if looser),
+    //the pt-dependent DCA between cascade daughters only if tighter
+    for(Int_t ivar=0; ivar<kNVarCuts; ivar++){
+        for(Long_t lcfg=0; lcfg<fNConfig; lcfg++) fEffCut[ivar][lcfg] = fBaseCut[ivar][lcfg];
+        for(size_t ientry=0; ientry<fVarCutConfig[ivar].size(); ientry++){
+            const Float_t *lPar = &fVarCutPar[ivar][5*ientry];
+            Long_t lcfg = fVarCutConfig[ivar][ientry];
+            if( ivar < 3 ){
+                Float_t lVarCut = TMath::Cos(
+                                             lPar[0]*TMath::Exp(lPar[1]*lCand.fPt) +
+                                             lPar[2]*TMath::Exp(lPar[3]*lCand.fPt) +
+                                             lPar[4]);
+                if( lVarCut > fEffCut[ivar][lcfg] ) fEffCut[ivar][lcfg] = lVarCut;
+            } else {
+                Float_t lVarCut = lPar[0]*TMath::Exp(lPar[1]*lCand.fPt) +
+                lPar[2]*TMath::Exp(lPar[3]*lCand.fPt) +
+                lPar[4];
+                if( lVarCut < fEffCut[ivar][lcfg] ) fEffCut[ivar][lcfg] = lVarCut;
+            }
+        }
+    }
+
+    for(size_t irun=0; irun+1<fRunFirst.size(); irun++)
+        SelectRange(lCand, fHypo[fRunFirst[irun]], fRunFirst[irun], fRunFirst[irun+1]);
+
+    //Lists disabled by the pre-selection
+    for(Int_t il=0; il<kNHypo; il++){
+        if( lCand.fValid[il] ) continue;
+        Long_t lFirst = il>0 ? fListEnd[il-1] : 0;
+        for(Long_t lcfg=lFirst; lcfg<fListEnd[il]; lcfg++) fPass[lcfg] = 0;
+    }
+
+    //Pack into the bitmask
+    memset(&fSelected[0], 0, fSelected.size()*sizeof(ULong64_t));
+    Long_t lNSelected = 0;
+    for(Long_t lcfg=0; lcfg<fNConfig; lcfg++){
+        fSelected[lcfg>>6] |= ((ULong64_t)fPass[lcfg]) << (lcfg&63);
+        lNSelected += fPass[lcfg];
+    }
+    return lNSelected;
+}
+
+//________________________________________________________________
+void AliCascadeResultCutTable::SelectRange(const Candidate &lCand, Int_t lHypo, Long_t lFirst, Long_t lLast)
+{
+    //Unknown hypothesis: the charge check can never be satisfied
+    if( lHypo < 0 || lHypo >= kNHypo ){
+        for(Long_t lcfg=lFirst; lcfg<lLast; lcfg++) fPass[lcfg] = 0;
+        return;
+    }
+
+    //Candidate quantities that do not depend on the configuration
+    const Float_t  lRap          = lCand.fRap[lHypo];
+    const Float_t  lV0Mass       = lCand.fV0Mass[lHypo];
+    const Double_t lV0MassWindow = TMath::Abs(lV0Mass-1.116);
+    const Float_t  lV0MassNSigma = TMath::Abs( (lV0Mass-lCand.fExpV0Mass) / lCand.fExpV0Sigma );
+    const Float_t  lLifetime     = lCand.fDistOverTotMom*kCascPDGMass[lHypo];
+    const Float_t  lAbsNegdEdx   = TMath::Abs(lCand.fNegdEdx[lHypo]);
+    const Float_t  lAbsPosdEdx   = TMath::Abs(lCand.fPosdEdx[lHypo]);
+    const Float_t  lAbsBachdEdx  = TMath::Abs(lCand.fBachdEdx[lHypo]);
+    const Bool_t   lPassTOF      =
+    TMath::Abs(lCand.fNegTOFsigma[lHypo] )< 4 &&
+    TMath::Abs(lCand.fPosTOFsigma[lHypo] )< 4 &&
+    TMath::Abs(lCand.fBachTOFsigma[lHypo])< 4;
+    const Bool_t   lIsOmega      = (lHypo == AliCascadeResult::kOmegaMinus || lHypo == AliCascadeResult::kOmegaPlus);
+    const Double_t lXiMassDiff   = TMath::Abs( lCand.fMassAsXi - 1.32171 );
+    const Bool_t   lAllITSRefit  = lCand.fPosITSRefit && lCand.fNegITSRefit && lCand.fBachITSRefit;
+    const Double_t lLengthRelaxPt     = TMath::Power(1/(lCand.fPt+1e-6),1.5); //rough parametrization, as in the task
+    const Double_t lLengthRelaxRadius = TMath::Max(lCand.fV0Radius-85., 0.);
+    const Double_t lDCACascToPV  = TMath::Sqrt(lCand.fCascDCAtoPVz*lCand.fCascDCAtoPVz + lCand.fCascDCAtoPVxy*lCand.fCascDCAtoPVxy);
+    const Bool_t   lPass276TeVV0CosPA = lCand.fV0CosPA > lCand.f276TeVV0CosPA;
+
+    const Float_t *lCascCosPACut = &fEffCut[0][0];
+    const Float_t *lV0CosPACut   = &fEffCut[1][0];
+    const Float_t *lBBCosPACut   = &fEffCut[2][0];
+    const Float_t *lDCACascDauCut= &fEffCut[3][0];
+
+    for(Long_t lcfg=lFirst; lcfg<lLast; lcfg++){
+        Bool_t lPass =
+        (lCand.fCharge == fCharge[lcfg]) &
+        (fMinEtaTracks[lcfg] < lCand.fPosEta)  & (lCand.fPosEta  < fMaxEtaTracks[lcfg]) &
+        (fMinEtaTracks[lcfg] < lCand.fNegEta)  & (lCand.fNegEta  < fMaxEtaTracks[lcfg]) &
+        (fMinEtaTracks[lcfg] < lCand.fBachEta) & (lCand.fBachEta < fMaxEtaTracks[lcfg]) &
+        (lRap > fMinRapidity[lcfg]) & (lRap < fMaxRapidity[lcfg]) &
+        //V0 selections
+        (lCand.fDCANegToPV > fDCANegToPV[lcfg]) &
+        (lCand.fDCAPosToPV > fDCAPosToPV[lcfg]) &
+        (lCand.fDCAV0Daughters < fDCAV0Daughters[lcfg]) &
+        (lCand.fV0CosPA > lV0CosPACut[lcfg]) &
+        (lCand.fV0Radius > fV0Radius[lcfg]) &
+        //Cascade selections
+        (lCand.fDCAV0ToPV > fDCAV0ToPV[lcfg]) &
+        (lV0MassWindow < fV0Mass[lcfg]) &
+        (lCand.fDCABachToPV > fDCABachToPV[lcfg]) &
+        (lCand.fDCACascDaughters < lDCACascDauCut[lcfg]) &
+        (lCand.fCascCosPA > lCascCosPACut[lcfg]) &
+        (lCand.fCascRadius > fCascRadius[lcfg]) &
+        ((fV0MassSigma[lcfg] > 50) | (lV0MassNSigma < fV0MassSigma[lcfg])) &
+        //Miscellaneous
+        (lLifetime < fProperLifetime[lcfg]) &
+        (lCand.fLeastNbrClusters > fLeastNumberOfClusters[lcfg]) &
+        (lAbsNegdEdx < fTPCdEdx[lcfg]) & (lAbsPosdEdx < fTPCdEdx[lcfg]) & (lAbsBachdEdx < fTPCdEdx[lcfg]) &
+        (!fUseTOFUnchecked[lcfg] | lPassTOF) &
+        (!lIsOmega | (lXiMassDiff > fXiRejection[lcfg])) &
+        (lCand.fDCABachToBaryon > fDCABachToBaryon[lcfg]) &
+        (lCand.fWrongCosPA < lBBCosPACut[lcfg]) &
+        (lCand.fV0Lifetime > fMinV0Lifetime[lcfg]) &
+        ((lCand.fV0Lifetime < fMaxV0Lifetime[lcfg]) | (fMaxV0Lifetime[lcfg] > 1e+3)) &
+        (lAllITSRefit | !fUseITSRefitTracks[lcfg]) &
+        ((fMaxChi2PerCluster[lcfg] > 1e+3) | (lCand.fMaxChi2PerCluster < fMaxChi2PerCluster[lcfg])) &
+        ( (fMinTrackLength[lcfg] < 0) |
+         ((lCand.fMinTrackLength > fMinTrackLength[lcfg]) & !fUseParametricLength[lcfg]) |
+         ((lCand.fMinTrackLength > fMinTrackLength[lcfg] - lLengthRelaxPt - lLengthRelaxRadius) & (fUseParametricLength[lcfg]!=0)) ) &
+        (!fUse276TeVV0CosPA[lcfg] | lPass276TeVV0CosPA) &
+        ((fDCACascadeToPV[lcfg] > 999) | (lDCACascToPV < fDCACascadeToPV[lcfg])) &
+        (!fAtLeastOneTOF[lcfg] | lCand.fAtLeastOneTOF) &
+        (!fUseITSRefitNegative[lcfg] | lCand.fNegITSRefit) &
+        (!fUseITSRefitPositive[lcfg] | lCand.fPosITSRefit) &
+        (!fUseITSRefitBachelor[lcfg] | lCand.fBachITSRefit) &
+        ( (fIsCowboy[lcfg] == 0) |
+         ((fIsCowboy[lcfg] == 1) & lCand.fIsCowboy) |
+         ((fIsCowboy[lcfg] == -1) & !lCand.fIsCowboy) ) &
+        ( (fIsCascadeCowboy[lcfg] == 0) |
+         ((fIsCascadeCowboy[lcfg] == 1) & lCand.fIsCascadeCowboy) |
+         ((fIsCascadeCowboy[lcfg] == -1) & !lCand.fIsCascadeCowboy) ) &
+        ((fMinCrossedRowsOverLength[lcfg] < 0) | (lCand.fLeastNcrOverLength > fMinCrossedRowsOverLength[lcfg])) &
+        ((fLeastNumberOfCrossedRows[lcfg] < 0) | (lCand.fLeastNbrCrossedRows > fLeastNumberOfCrossedRows[lcfg])) &
+        (!fITSorTOF[lcfg] | lCand.fITSorTOF);
+        fPass[lcfg] = lPass;
+    }
+}
+
+//________________________________________________________________
+Long_t AliCascadeResultCutTable::NextSelected(Long_t lcfg) const
+{
+    Long_t lNext = lcfg+1;
+    if( lNext >= fNConfig ) return -1;
+    Long_t lWord = lNext>>6;
+    ULong64_t lBits = fSelected[lWord] & (~0ULL << (lNext&63));
+    while( !lBits ){
+        if( ++lWord >= (Long_t)fSelected.size() ) return -1;
+        lBits = fSelected[lWord];
+    }
+    return (lWord<<6) + FindFirstSetBit(lBits);
+}
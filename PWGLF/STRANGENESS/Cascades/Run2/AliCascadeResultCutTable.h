@@ -0,0 +1,156 @@
+#ifndef AliCascadeResultCutTable_H
+#define AliCascadeResultCutTable_H
+#include <vector>
+#include <Rtypes.h>
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Columnar table of the cuts of a set of AliCascadeResult configurations
+//
+// Cascade counterpart of AliV0ResultCutTable: one array per cut
+// variable, one pass over all configurations per candidate and a
+// selection bitmask as output, identical to the per-configuration
+// checks of AliAnalysisTaskStrangenessVsMultiplicityRun2.
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+class TList;
+class TH3F;
+class AliCascadeResult;
+
+class AliCascadeResultCutTable {
+
+public:
+    enum { kNHypo = 4 }; //XiMinus, XiPlus, OmegaMinus, OmegaPlus (as AliCascadeResult::EMassHypo)
+
+    //Candidate properties entering the selections
+    struct Candidate {
+        Int_t   fCharge;
+        Float_t fPt;
+        Float_t fPosEta;
+        Float_t fNegEta;
+        Float_t fBachEta;
+        Float_t fDCANegToPV;
+        Float_t fDCAPosToPV;
+        Float_t fDCAV0Daughters;
+        Float_t fV0CosPA;
+        Float_t fV0Radius;
+        Float_t fDCAV0ToPV;
+        Float_t fDCABachToPV;
+        Float_t fDCACascDaughters;
+        Float_t fCascCosPA;
+        Float_t fCascRadius;
+        Float_t fExpV0Mass;          //parametric Lambda mass mean at this V0 pt
+        Float_t fExpV0Sigma;         //parametric Lambda mass sigma at this V0 pt
+        Float_t fDistOverTotMom;
+        Int_t   fLeastNbrClusters;
+        Float_t fMassAsXi;
+        Float_t fDCABachToBaryon;
+        Float_t fWrongCosPA;
+        Float_t fV0Lifetime;
+        Bool_t  fPosITSRefit;
+        Bool_t  fNegITSRefit;
+        Bool_t  fBachITSRefit;
+        Float_t fMaxChi2PerCluster;
+        Float_t fMinTrackLength;
+        Float_t f276TeVV0CosPA;      //momentum-dependent 2.76TeV-like V0 CosPA cut
+        Float_t fCascDCAtoPVxy;
+        Float_t fCascDCAtoPVz;
+        Bool_t  fAtLeastOneTOF;      //at least one daughter with |TOF signal| < 100
+        Bool_t  fIsCowboy;
+        Bool_t  fIsCascadeCowboy;
+        Float_t fLeastNcrOverLength;
+        Int_t   fLeastNbrCrossedRows;
+        Bool_t  fITSorTOF;
+        //Per mass hypothesis
+        Bool_t  fValid[kNHypo];      //configuration list of this hypothesis enabled by the pre-selection
+        Float_t fMass[kNHypo];
+        Float_t fV0Mass[kNHypo];
+        Float_t fRap[kNHypo];
+        Float_t fNegdEdx[kNHypo];
+        Float_t fPosdEdx[kNHypo];
+        Float_t fBachdEdx[kNHypo];
+        Float_t fNegTOFsigma[kNHypo];
+        Float_t fPosTOFsigma[kNHypo];
+        Float_t fBachTOFsigma[kNHypo];
+    };
+
+    AliCascadeResultCutTable();
+    ~AliCascadeResultCutTable() {}
+
+    //Compile the configurations of the four lists (null lists are skipped)
+    void Build(TList *lListXiMinus, TList *lListXiPlus, TList *lListOmegaMinus, TList *lListOmegaPlus);
+    void Clear();
+
+    //Evaluate all configurations, returns the number of selected ones
+    Long_t Select(const Candidate &lCand);
+
+    Long_t GetNConfigurations() const { return fNConfig; }
+    Bool_t IsSelected(Long_t lcfg) const { return (fSelected[lcfg>>6] >> (lcfg&63)) & 1; }
+    //Next selected configuration after lcfg (-1 to start), -1 if none
+    Long_t NextSelected(Long_t lcfg) const;
+
+    AliCascadeResult *GetResult    (Long_t lcfg) const { return fResult[lcfg]; }
+    TH3F             *GetHistogram (Long_t lcfg) const { return fHisto[lcfg]; }
+    Int_t             GetHypothesis(Long_t lcfg) const { return fHypo[lcfg]; }
+
+private:
+    void AddConfiguration(AliCascadeResult *lCascadeResult);
+    void SelectRange(const Candidate &lCand, Int_t lHypo, Long_t lFirst, Long_t lLast);
+
+    Long_t fNConfig;
+    std::vector<Long_t> fRunFirst; //first configuration of each run with the same hypothesis (+ end)
+    std::vector<Long_t> fListEnd;  //end of the configurations of each list
+
+    std::vector<AliCascadeResult*> fResult;
+    std::vector<TH3F*>             fHisto;
+    std::vector<Int_t>             fHypo;
+
+    //Cut columns
+    std::vector<Int_t>    fCharge;  //expected charge (bachelor charge swap included)
+    std::vector<Double_t> fMinEtaTracks;
+    std::vector<Double_t> fMaxEtaTracks;
+    std::vector<Double_t> fMinRapidity;
+    std::vector<Double_t> fMaxRapidity;
+    std::vector<Double_t> fDCANegToPV;
+    std::vector<Double_t> fDCAPosToPV;
+    std::vector<Double_t> fDCAV0Daughters;
+    std::vector<Double_t> fV0Radius;
+    std::vector<Double_t> fDCAV0ToPV;
+    std::vector<Double_t> fV0Mass;
+    std::vector<Double_t> fDCABachToPV;
+    std::vector<Double_t> fCascRadius;
+    std::vector<Double_t> fV0MassSigma;
+    std::vector<Double_t> fProperLifetime;
+    std::vector<Double_t> fLeastNumberOfClusters;
+    std::vector<Double_t> fTPCdEdx;
+    std::vector<UChar_t>  fUseTOFUnchecked;
+    std::vector<Double_t> fXiRejection;
+    std::vector<Double_t> fDCABachToBaryon;
+    std::vector<Double_t> fMinV0Lifetime;
+    std::vector<Double_t> fMaxV0Lifetime;
+    std::vector<UChar_t>  fUseITSRefitTracks;
+    std::vector<Double_t> fMaxChi2PerCluster;
+    std::vector<Double_t> fMinTrackLength;
+    std::vector<UChar_t>  fUseParametricLength;
+    std::vector<UChar_t>  fUse276TeVV0CosPA;
+    std::vector<Double_t> fDCACascadeToPV;
+    std::vector<UChar_t>  fAtLeastOneTOF;
+    std::vector<UChar_t>  fUseITSRefitNegative;
+    std::vector<UChar_t>  fUseITSRefitPositive;
+    std::vector<UChar_t>  fUseITSRefitBachelor;
+    std::vector<Int_t>    fIsCowboy;
+    std::vector<Int_t>    fIsCascadeCowboy;
+    std::vector<Double_t> fMinCrossedRowsOverLength;
+    std::vector<Double_t> fLeastNumberOfCrossedRows;
+    std::vector<UChar_t>  fITSorTOF;
+
+    //Cuts with an optional pt-dependent version (0: casc CosPA, 1: V0 CosPA, 2: BB CosPA, 3: DCA casc daughters)
+    enum { kNVarCuts = 4 };
+    std::vector<Float_t>  fBaseCut[kNVarCuts];   //constant cut
+    std::vector<Long_t>   fVarCutConfig[kNVarCuts]; //configurations using the pt-dependent version
+    std::vector<Float_t>  fVarCutPar[kNVarCuts];  //5 per entry of fVarCutConfig
+    std::vector<Float_t>  fEffCut[kNVarCuts];     //cuts in use for the current candidate
+
+    std::vector<UChar_t>   fPass;     //outcome per configuration
+    std::vector<ULong64_t> fSelected; //bitmask of fPass
+};
+#endif
@@ -0,0 +1,214 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Columnar table of the cuts of a set of AliV0Result configurations
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include <cstring>
+#include "TList.h"
+#include "TH3F.h"
+#include "TMath.h"
+#include "AliV0Result.h"
+#include "AliV0ResultCutTable.h"
+
+namespace {
+    //As used in the analysis task for the proper lifetime
+    const Float_t kV0PDGMass[AliV0ResultCutTable::kNHypo] = { 0.497, 1.115683, 1.115683 };
+
+    Int_t FindFirstSetBit(ULong64_t lWord) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(lWord);
+#else
+        Int_t lBit = 0;
+        while( !(lWord & 1) ) { lWord >>= 1; lBit++; }
+        return lBit;
+#endif
+    }
+}
+
+//________________________________________________________________
+AliV0ResultCutTable::AliV0ResultCutTable() :
+fNConfig(0)
+{
+}
+
+//________________________________________________________________
+void AliV0ResultCutTable::Clear()
+{
+    fNConfig = 0;
+    fRunFirst.clear();
+    fResult.clear(); fHisto.clear(); fHypo.clear();
+    fUseOnTheFly.clear();
+    fMinEtaTracks.clear(); fMaxEtaTracks.clear();
+    fMinRapidity.clear(); fMaxRapidity.clear();
+    fV0Radius.clear(); fMaxV0Radius.clear();
+    fDCANegToPV.clear(); fDCAPosToPV.clear(); fDCAV0Daughters.clear();
+    fV0CosPA.clear(); fProperLifetime.clear();
+    fLeastNumberOfCrossedRows.clear(); fLeastNumberOfCrossedRowsOverFindable.clear();
+    fMinBaryonMomentum.clear(); fTPCdEdx.clear();
+    fArmenteros.clear(); fArmenterosParameter.clear();
+    fUseITSRefitTracks.clear(); fMaxChi2PerCluster.clear();
+    fMinTrackLength.clear(); fUseParametricLength.clear();
+    f276TeVLikedEdx.clear(); fAtLeastOneTOF.clear(); fIsCowboy.clear();
+    fMinCrossedRowsOverLength.clear(); fITSorTOF.clear();
+    fVarV0CosPAConfig.clear(); fVarV0CosPAPar.clear(); fEffV0CosPA.clear();
+    fPass.clear(); fSelected.clear();
+}
+
+//________________________________________________________________
+void AliV0ResultCutTable::Build(TList *lListK0Short, TList *lListLambda, TList *lListAntiLambda)
+{
+    Clear();
+    TList *lLists[kNHypo] = { lListK0Short, lListLambda, lListAntiLambda };
+    for(Int_t ih=0; ih<kNHypo; ih++){
+        if( !lLists[ih] ) continue;
+        for(Int_t icfg=0; icfg<lLists[ih]->GetEntries(); icfg++)
+            AddConfiguration( (AliV0Result*) lLists[ih]->At(icfg) );
+    }
+    //Runs of consecutive configurations with the same mass hypothesis
+    for(Long_t lcfg=0; lcfg<fNConfig; lcfg++)
+        if( lcfg==0 || fHypo[lcfg]!=fHypo[lcfg-1] ) fRunFirst.push_back(lcfg);
+    fRunFirst.push_back(fNConfig);
+    fEffV0CosPA.resize(fNConfig);
+    fPass.resize(fNConfig);
+    fSelected.resize((fNConfig+63)/64);
+}
+
+//________________________________________________________________
+void AliV0ResultCutTable::AddConfiguration(AliV0Result *lV0Result)
+{
+    fResult.push_back( lV0Result );
+    fHisto .push_back( lV0Result->GetHistogram() );
+    fHypo  .push_back( lV0Result->GetMassHypothesis() );
+
+    fUseOnTheFly .push_back( lV0Result->GetUseOnTheFly() );
+    fMinEtaTracks.push_back( lV0Result->GetCutMinEtaTracks() );
+    fMaxEtaTracks.push_back( lV0Result->GetCutMaxEtaTracks() );
+    fMinRapidity .push_back( lV0Result->GetCutMinRapidity() );
+    fMaxRapidity .push_back( lV0Result->GetCutMaxRapidity() );
+
+    fV0Radius      .push_back( lV0Result->GetCutV0Radius() );
+    fMaxV0Radius   .push_back( lV0Result->GetCutMaxV0Radius() );
+    fDCANegToPV    .push_back( lV0Result->GetCutDCANegToPV() );
+    fDCAPosToPV    .push_back( lV0Result->GetCutDCAPosToPV() );
+    fDCAV0Daughters.push_back( lV0Result->GetCutDCAV0Daughters() );
+    fV0CosPA       .push_back( lV0Result->GetCutV0CosPA() );
+    fProperLifetime.push_back( lV0Result->GetCutProperLifetime() );
+    fLeastNumberOfCrossedRows            .push_back( lV0Result->GetCutLeastNumberOfCrossedRows() );
+    fLeastNumberOfCrossedRowsOverFindable.push_back( lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() );
+
+    fMinBaryonMomentum  .push_back( lV0Result->GetCutMinBaryonMomentum() );
+    fTPCdEdx            .push_back( lV0Result->GetCutTPCdEdx() );
+    fArmenteros         .push_back( lV0Result->GetCutArmenteros() );
+    fArmenterosParameter.push_back( lV0Result->GetCutArmenterosParameter() );
+    fUseITSRefitTracks  .push_back( lV0Result->GetCutUseITSRefitTracks() );
+    fMaxChi2PerCluster  .push_back( lV0Result->GetCutMaxChi2PerCluster() );
+    fMinTrackLength     .push_back( lV0Result->GetCutMinTrackLength() );
+    fUseParametricLength.push_back( lV0Result->GetCutUseParametricLength() );
+    f276TeVLikedEdx     .push_back( lV0Result->GetCut276TeVLikedEdx() );
+    fAtLeastOneTOF      .push_back( lV0Result->GetCutAtLeastOneTOF() );
+    fIsCowboy           .push_back( lV0Result->GetCutIsCowboy() );
+    fMinCrossedRowsOverLength.push_back( lV0Result->GetCutMinCrossedRowsOverLength() );
+    fITSorTOF           .push_back( lV0Result->GetCutITSorTOF() );
+
+    if( lV0Result->GetCutUseVarV0CosPA() ){
+        fVarV0CosPAConfig.push_back( fNConfig );
+        fVarV0CosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp0Const() );
+        fVarV0CosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp0Slope() );
+        fVarV0CosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp1Const() );
+        fVarV0CosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp1Slope() );
+        fVarV0CosPAPar.push_back( lV0Result->GetCutVarV0CosPAConst() );
+    }
+    fNConfig++;
+}
+
+//________________________________________________________________
+Long_t AliV0ResultCutTable::Select(const Candidate &lCand)
+{
+    if( fNConfig == 0 ) return 0;
+
+    //Cut on the V0 CosPA in use: the pt-dependent one only if tighter
+    for(Long_t lcfg=0; lcfg<fNConfig; lcfg++) fEffV0CosPA[lcfg] = fV0CosPA[lcfg];
+    for(size_t ivar=0; ivar<fVarV0CosPAConfig.size(); ivar++){
+        const Float_t *lPar = &fVarV0CosPAPar[5*ivar];
+        Float_t lVarV0CosPA = TMath::Cos(
+                                         lPar[0]*TMath::Exp(lPar[1]*lCand.fPt) +
+                                         lPar[2]*TMath::Exp(lPar[3]*lCand.fPt) +
+                                         lPar[4]);
+        Long_t lcfg = fVarV0CosPAConfig[ivar];
+        if( lVarV0CosPA > fEffV0CosPA[lcfg] ) fEffV0CosPA[lcfg] = lVarV0CosPA;
+    }
+
+    for(size_t irun=0; irun+1<fRunFirst.size(); irun++)
+        SelectRange(lCand, fHypo[fRunFirst[irun]], fRunFirst[irun], fRunFirst[irun+1]);
+
+    //Pack into the bitmask
+    memset(&fSelected[0], 0, fSelected.size()*sizeof(ULong64_t));
+    Long_t lNSelected = 0;
+    for(Long_t lcfg=0; lcfg<fNConfig; lcfg++){
+        fSelected[lcfg>>6] |= ((ULong64_t)fPass[lcfg]) << (lcfg&63);
+        lNSelected += fPass[lcfg];
+    }
+    return lNSelected;
+}
+
+//________________________________________________________________
+void AliV0ResultCutTable::SelectRange(const Candidate &lCand, Int_t lHypo, Long_t lFirst, Long_t lLast)
+{
+    //Candidate quantities that do not depend on the configuration
+    const Float_t lRap = lCand.fRap[lHypo];
+    const Float_t lAbsNegdEdx = TMath::Abs(lCand.fNegdEdx[lHypo]);
+    const Float_t lAbsPosdEdx = TMath::Abs(lCand.fPosdEdx[lHypo]);
+    const Float_t lAbsAlpha   = TMath::Abs(lCand.fAlphaV0);
+    const Float_t lLifetime   = lCand.fDistOverTotMom*kV0PDGMass[lHypo];
+    const Bool_t  lIsK0Short  = (lHypo == AliV0Result::kK0Short);
+    const Float_t lBaryonMomentum = lCand.fBaryonMomentum[lHypo];
+    const Bool_t  lPass276dEdx = lIsK0Short ||
+    ( lCand.fBaryonPt[lHypo] > 1.0 || TMath::Abs(lCand.fBaryondEdxFromProton[lHypo])<3.0 );
+    const Double_t lLengthRelaxPt     = TMath::Power(1/(lCand.fPt+1e-6),1.5); //rough parametrization, as in the task
+    const Double_t lLengthRelaxRadius = TMath::Max(lCand.fV0Radius-85., 0.);
+
+    for(Long_t lcfg=lFirst; lcfg<lLast; lcfg++){
+        Bool_t lPass =
+        (lCand.fOnFlyStatus == fUseOnTheFly[lcfg]) &
+        (fMinEtaTracks[lcfg] < lCand.fNegEta) & (lCand.fNegEta < fMaxEtaTracks[lcfg]) &
+        (fMinEtaTracks[lcfg] < lCand.fPosEta) & (lCand.fPosEta < fMaxEtaTracks[lcfg]) &
+        (lRap > fMinRapidity[lcfg]) & (lRap < fMaxRapidity[lcfg]) &
+        (lCand.fV0Radius > fV0Radius[lcfg]) & (lCand.fV0Radius < fMaxV0Radius[lcfg]) &
+        (lCand.fDcaNegToPV > fDCANegToPV[lcfg]) &
+        (lCand.fDcaPosToPV > fDCAPosToPV[lcfg]) &
+        (lCand.fDcaV0Daughters < fDCAV0Daughters[lcfg]) &
+        (lCand.fV0CosPA > fEffV0CosPA[lcfg]) &
+        (lLifetime < fProperLifetime[lcfg]) &
+        (lCand.fLeastNbrCrossedRows > fLeastNumberOfCrossedRows[lcfg]) &
+        (lCand.fLeastRatioCrossedRowsOverFindable > fLeastNumberOfCrossedRowsOverFindable[lcfg]) &
+        (lIsK0Short | (lBaryonMomentum > fMinBaryonMomentum[lcfg])) &
+        (lAbsNegdEdx < fTPCdEdx[lcfg]) & (lAbsPosdEdx < fTPCdEdx[lcfg]) &
+        (!fArmenteros[lcfg] | !lIsK0Short | (lCand.fPtArmV0 > fArmenterosParameter[lcfg]*lAbsAlpha)) &
+        (lCand.fBothITSRefit | !fUseITSRefitTracks[lcfg]) &
+        ((fMaxChi2PerCluster[lcfg] > 1e+3) | (lCand.fMaxChi2PerCluster < fMaxChi2PerCluster[lcfg])) &
+        ( (fMinTrackLength[lcfg] < 0) |
+         ((lCand.fMinTrackLength > fMinTrackLength[lcfg]) & !fUseParametricLength[lcfg]) |
+         ((lCand.fMinTrackLength > fMinTrackLength[lcfg] - lLengthRelaxPt - lLengthRelaxRadius) & (fUseParametricLength[lcfg]!=0)) ) &
+        (!f276TeVLikedEdx[lcfg] | lPass276dEdx) &
+        (!fAtLeastOneTOF[lcfg] | lCand.fAtLeastOneTOF) &
+        ( (fIsCowboy[lcfg] == 0) |
+         ((fIsCowboy[lcfg] == 1) & lCand.fIsCowboy) |
+         ((fIsCowboy[lcfg] == -1) & !lCand.fIsCowboy) ) &
+        ((fMinCrossedRowsOverLength[lcfg] < 0) | (lCand.fLeastNcrOverLength > fMinCrossedRowsOverLength[lcfg])) &
+        (!fITSorTOF[lcfg] | lCand.fITSorTOF);
+        fPass[lcfg] = lPass;
+    }
+}
+
+//________________________________________________________________
+Long_t AliV0ResultCutTable::NextSelected(Long_t lcfg) const
+{
+    Long_t lNext = lcfg+1;
+    if( lNext >= fNConfig ) return -1;
+    Long_t lWord = lNext>>6;
+    ULong64_t lBits = fSelected[lWord] & (~0ULL << (lNext&63));
+    while( !lBits ){
+        if( ++lWord >= (Long_t)fSelected.size() ) return -1;
+        lBits = fSelected[lWord];
+    }
+    return (lWord<<6) + FindFirstSetBit(lBits);
+}
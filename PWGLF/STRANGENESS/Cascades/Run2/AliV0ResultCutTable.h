@@ -0,0 +1,127 @@
+#ifndef AliV0ResultCutTable_H
+#define AliV0ResultCutTable_H
+#include <vector>
+#include <Rtypes.h>
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Columnar table of the cuts of a set of AliV0Result configurations
+//
+// The configurations are compiled once into one array per cut variable;
+// a V0 candidate is then checked against all of them in a single pass
+// and the outcome is stored as a selection bitmask (one bit per
+// configuration, in the order of the lists given to Build). The checks
+// are the same as the per-configuration ones of
+// AliAnalysisTaskStrangenessVsMultiplicityRun2, with the same
+// precision, so that the selected configurations are identical.
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+class TList;
+class TH3F;
+class AliV0Result;
+
+class AliV0ResultCutTable {
+
+public:
+    enum { kNHypo = 3 }; //K0Short, Lambda, AntiLambda (as AliV0Result::EMassHypo)
+
+    //Candidate properties entering the selections
+    struct Candidate {
+        Int_t   fOnFlyStatus;
+        Float_t fNegEta;
+        Float_t fPosEta;
+        Float_t fPt;
+        Float_t fV0Radius;
+        Float_t fDcaNegToPV;
+        Float_t fDcaPosToPV;
+        Float_t fDcaV0Daughters;
+        Float_t fV0CosPA;
+        Float_t fDistOverTotMom;
+        Int_t   fLeastNbrCrossedRows;
+        Float_t fLeastRatioCrossedRowsOverFindable;
+        Float_t fPtArmV0;
+        Float_t fAlphaV0;
+        Bool_t  fBothITSRefit;      //both daughters with kITSrefit
+        Float_t fMaxChi2PerCluster;
+        Float_t fMinTrackLength;
+        Bool_t  fAtLeastOneTOF;     //at least one daughter with |TOF signal| < 100
+        Bool_t  fIsCowboy;
+        Float_t fLeastNcrOverLength;
+        Bool_t  fITSorTOF;
+        //Per mass hypothesis
+        Float_t fMass[kNHypo];
+        Float_t fRap[kNHypo];
+        Float_t fNegdEdx[kNHypo];
+        Float_t fPosdEdx[kNHypo];
+        Float_t fBaryonMomentum[kNHypo];
+        Float_t fBaryonPt[kNHypo];
+        Float_t fBaryondEdxFromProton[kNHypo];
+    };
+
+    AliV0ResultCutTable();
+    ~AliV0ResultCutTable() {}
+
+    //Compile the configurations of the three lists (null lists are skipped)
+    void Build(TList *lListK0Short, TList *lListLambda, TList *lListAntiLambda);
+    void Clear();
+
+    //Evaluate all configurations, returns the number of selected ones
+    Long_t Select(const Candidate &lCand);
+
+    Long_t GetNConfigurations() const { return fNConfig; }
+    Bool_t IsSelected(Long_t lcfg) const { return (fSelected[lcfg>>6] >> (lcfg&63)) & 1; }
+    //Next selected configuration after lcfg (-1 to start), -1 if none
+    Long_t NextSelected(Long_t lcfg) const;
+
+    AliV0Result *GetResult    (Long_t lcfg) const { return fResult[lcfg]; }
+    TH3F        *GetHistogram (Long_t lcfg) const { return fHisto[lcfg]; }
+    Int_t        GetHypothesis(Long_t lcfg) const { return fHypo[lcfg]; }
+
+private:
+    void AddConfiguration(AliV0Result *lV0Result);
+    void SelectRange(const Candidate &lCand, Int_t lHypo, Long_t lFirst, Long_t lLast);
+
+    Long_t fNConfig;
+    std::vector<Long_t> fRunFirst; //first configuration of each run with the same hypothesis (+ end)
+
+    std::vector<AliV0Result*> fResult;
+    std::vector<TH3F*>        fHisto;
+    std::vector<Int_t>        fHypo;
+
+    //Cut columns
+    std::vector<Int_t>    fUseOnTheFly;
+    std::vector<Double_t> fMinEtaTracks;
+    std::vector<Double_t> fMaxEtaTracks;
+    std::vector<Double_t> fMinRapidity;
+    std::vector<Double_t> fMaxRapidity;
+    std::vector<Double_t> fV0Radius;
+    std::vector<Double_t> fMaxV0Radius;
+    std::vector<Double_t> fDCANegToPV;
+    std::vector<Double_t> fDCAPosToPV;
+    std::vector<Double_t> fDCAV0Daughters;
+    std::vector<Float_t>  fV0CosPA;
+    std::vector<Double_t> fProperLifetime;
+    std::vector<Double_t> fLeastNumberOfCrossedRows;
+    std::vector<Double_t> fLeastNumberOfCrossedRowsOverFindable;
+    std::vector<Double_t> fMinBaryonMomentum;
+    std::vector<Double_t> fTPCdEdx;
+    std::vector<UChar_t>  fArmenteros;
+    std::vector<Double_t> fArmenterosParameter;
+    std::vector<UChar_t>  fUseITSRefitTracks;
+    std::vector<Double_t> fMaxChi2PerCluster;
+    std::vector<Double_t> fMinTrackLength;
+    std::vector<UChar_t>  fUseParametricLength;
+    std::vector<UChar_t>  f276TeVLikedEdx;
+    std::vector<UChar_t>  fAtLeastOneTOF;
+    std::vector<Int_t>    fIsCowboy;
+    std::vector<Double_t> fMinCrossedRowsOverLength;
+    std::vector<UChar_t>  fITSorTOF;
+
+    //pt-dependent V0 CosPA: parameters of the configurations using it
+    std::vector<Long_t>   fVarV0CosPAConfig;
+    std::vector<Float_t>  fVarV0CosPAPar;     //5 per entry of fVarV0CosPAConfig
+    std::vector<Float_t>  fEffV0CosPA;        //cut in use for the current candidate
+
+    std::vector<UChar_t>   fPass;     //outcome per configuration
+    std::vector<ULong64_t> fSelected; //bitmask of fPass
+};
+#endif
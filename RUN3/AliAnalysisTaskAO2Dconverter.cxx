@@ -19,8 +19,10 @@
  */
 
 #include <TChain.h>
+#include <TROOT.h>
 #include <TTree.h>
 #include <TMath.h>
+#include <chrono>
 #include "AliAnalysisTask.h"
 #include "AliAnalysisManager.h"
 #include "AliESDEvent.h"
@@ -91,6 +93,7 @@ AliAnalysisTaskAO2Dconverter::AliAnalysisTaskAO2Dconverter(const char* name)
     fTreeStatus[i] = kTRUE;
     DefineOutput(1 + i, TTree::Class());
   }
+  SetCompression(-1, 0);
 }
 
 AliAnalysisTaskAO2Dconverter::~AliAnalysisTaskAO2Dconverter()
@@ -125,7 +128,37 @@ void AliAnalysisTaskAO2Dconverter::FillTree(TreeIndex t)
 {
   if (!fTreeStatus[t])
     return;
+  // The baskets are compressed inside Fill when they are flushed, so the
+  // accumulated time is dominated by the compression
+  auto start = std::chrono::steady_clock::now();
   fTree[t]->Fill();
+  fFillTime[t] += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+}
+
+void AliAnalysisTaskAO2Dconverter::ConfigureWriter()
+{
+#ifdef R__USE_IMT
+  if (fNumberOfWriterThreads > 0 && !ROOT::IsImplicitMTEnabled())
+    ROOT::EnableImplicitMT(fNumberOfWriterThreads);
+#endif
+  for (Int_t i = 0; i < kTrees; i++) {
+    if (!fTreeStatus[i] || !fTree[i])
+      continue;
+    // With AutoFlush the baskets of a cluster are compressed together, which
+    // is what allows IMT to compress the branches in parallel
+    fTree[i]->SetAutoFlush(fAutoFlush[i] != 0 ? fAutoFlush[i] : fNumberOfEventsPerCluster);
+    if (fBasketSize[i] > 0)
+      fTree[i]->SetBasketSize("*", fBasketSize[i]);
+    if (fCompression[i] >= 0) {
+      TObjArray* branches = fTree[i]->GetListOfBranches();
+      for (Int_t k = 0; k < branches->GetEntries(); k++)
+        ((TBranch*)branches->At(k))->SetCompressionSettings(fCompression[i]);
+    }
+#ifdef R__USE_IMT
+    fTree[i]->SetImplicitMT(fNumberOfWriterThreads > 0);
+#endif
+    fFillTime[i] = 0;
+  }
 }
 
 void AliAnalysisTaskAO2Dconverter::UserCreateOutputObjects()
@@ -404,6 +437,7 @@ void AliAnalysisTaskAO2Dconverter::UserCreateOutputObjects()
 
 
   Prune(); //Removing all unwanted branches (if any)
+  ConfigureWriter(); // Compression, basket size and flushing of the trees
 }
 
 void AliAnalysisTaskAO2Dconverter::Prune()
@@ -972,6 +1006,31 @@ void AliAnalysisTaskAO2Dconverter::UserExec(Option_t *)
   fOffsetV0ID += nv0;
 }
 
+void AliAnalysisTaskAO2Dconverter::FinishTaskOutput()
+{
+  // Flush the last cluster of each tree and report the size and the time
+  // spent in filling and compressing each table
+  Long64_t totBytes = 0, zipBytes = 0;
+  Double_t totTime = 0;
+  AliInfo(Form("%-15s %12s %14s %14s %7s %12s", "Table", "Entries", "Bytes", "Zipped bytes", "Ratio", "Fill+zip [s]"));
+  for (Int_t i = 0; i < kTrees; i++) {
+    if (!fTreeStatus[i] || !fTree[i])
+      continue;
+    auto start = std::chrono::steady_clock::now();
+    fTree[i]->FlushBaskets();
+    fFillTime[i] += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+    Long64_t tot = fTree[i]->GetTotBytes();
+    Long64_t zip = fTree[i]->GetZipBytes();
+    AliInfo(Form("%-15s %12lld %14lld %14lld %7.2f %12.3f", TreeName[i].Data(), fTree[i]->GetEntries(), tot, zip,
+                 zip > 0 ? (Double_t)tot / zip : 0., fFillTime[i]));
+    totBytes += tot;
+    zipBytes += zip;
+    totTime += fFillTime[i];
+  }
+  AliInfo(Form("%-15s %12s %14lld %14lld %7.2f %12.3f", "Total", "", totBytes, zipBytes,
+               zipBytes > 0 ? (Double_t)totBytes / zipBytes : 0., totTime));
+}
+
 void AliAnalysisTaskAO2Dconverter::Terminate(Option_t *)
 {
   // terminate
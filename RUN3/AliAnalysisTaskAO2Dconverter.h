@@ -20,7 +20,7 @@ class AliESDEvent;
 class AliAnalysisTaskAO2Dconverter : public AliAnalysisTaskSE
 {
 public:
-  AliAnalysisTaskAO2Dconverter() = default;
+  AliAnalysisTaskAO2Dconverter() { SetCompression(-1, 0); }
   AliAnalysisTaskAO2Dconverter(const char *name);
   virtual ~AliAnalysisTaskAO2Dconverter();
 
@@ -32,6 +32,7 @@ public:
 
   virtual void UserCreateOutputObjects();
   virtual void UserExec(Option_t *option);
+  virtual void FinishTaskOutput();
   virtual void Terminate(Option_t *option);
 
   void SetNumberOfEventsPerCluster(int n) { fNumberOfEventsPerCluster = n; }
@@ -86,6 +87,14 @@ public:
   void Prune(TString p) { fPruneList = p; }; // Setter of the pruning list
   void SetMCMode() { fTaskMode = kMC; };     // Setter of the MC running mode
 
+  // Writer configuration, per table. The algorithm follows ROOT::ECompressionAlgorithm
+  // (1 zlib, 2 lzma, 4 lz4, 5 zstd), a negative value keeps the settings of the output file
+  void SetCompression(TreeIndex t, Int_t algorithm, Int_t level) { fCompression[t] = algorithm < 0 ? -1 : 100 * algorithm + level; }
+  void SetCompression(Int_t algorithm, Int_t level) { for (Int_t i = 0; i < kTrees; i++) SetCompression((TreeIndex)i, algorithm, level); }
+  void SetBasketSize(TreeIndex t, Int_t size) { fBasketSize[t] = size; }       // 0 keeps the ROOT default
+  void SetAutoFlush(TreeIndex t, Long64_t n) { fAutoFlush[t] = n; }             // 0 uses fNumberOfEventsPerCluster
+  void SetNumberOfWriterThreads(UInt_t n) { fNumberOfWriterThreads = n; }      // >0 compresses the baskets in parallel (ROOT IMT)
+
   AliAnalysisFilter fTrackFilter; // Standard track filter object
 private:
   Bool_t fUseEventCuts = kFALSE;         //! Use or not event cuts
@@ -96,12 +105,20 @@ private:
   // Output TTree
   TTree* fTree[kTrees] = { nullptr }; //! Array with all the output trees
   void Prune();                       // Function to perform tree pruning
+  void ConfigureWriter();             // Function to apply the compression, basket and flushing settings
   void FillTree(TreeIndex t);         // Function to fill the trees (only the active ones)
 
   // Task configuration variables
   TString fPruneList = "";                // Names of the branches that will not be saved to output file
   Bool_t fTreeStatus[kTrees] = { kTRUE }; // Status of the trees i.e. kTRUE (enabled) or kFALSE (disabled)
   int fNumberOfEventsPerCluster = 1000;   // Maximum basket size of the trees
+  Int_t fCompression[kTrees];             // Compression settings (100*algorithm+level) of each tree, -1 for the file default
+  Int_t fBasketSize[kTrees] = { 0 };      // Basket size of each tree (0 for the default)
+  Long64_t fAutoFlush[kTrees] = { 0 };    // AutoFlush of each tree (0 for fNumberOfEventsPerCluster)
+  UInt_t fNumberOfWriterThreads = 0;      // Number of threads for the implicit parallel compression (0 to disable)
+
+  // Writer statistics
+  Double_t fFillTime[kTrees] = { 0 };     //! Time spent in filling and flushing (i.e. compressing) each tree
 
   TaskModes fTaskMode = kStandard; // Running mode of the task. Useful to set for e.g. MC mode
 
@@ -385,7 +402,7 @@ private:
   Int_t fOffsetV0ID = 0;      ///! Offset of track IDs (used in cascades)
   Int_t fOffsetLabel = 0;      ///! Offset of track IDs (used in cascades)
 
-  ClassDef(AliAnalysisTaskAO2Dconverter, 6);
+  ClassDef(AliAnalysisTaskAO2Dconverter, 7);
 };
 
 #endif